@@ -0,0 +1,105 @@
+#include "AnimationClock.h"
+#include "duilib/Animation/AnimationPlayer.h"
+#include "duilib/Core/GlobalManager.h"
+
+//时钟默认的时间间隔（毫秒），按每秒60帧
+#define DEFAULT_ANIMATION_CLOCK_INTERVAL (1000 / 60)
+
+namespace ui
+{
+AnimationClock::AnimationClock():
+    m_frameIntervalMillSeconds(DEFAULT_ANIMATION_CLOCK_INTERVAL)
+{
+}
+
+AnimationClock::~AnimationClock()
+{
+    m_timerFlag.Cancel();
+    m_players.clear();
+}
+
+void AnimationClock::AddPlayer(AnimationPlayer* pAnimationPlayer, const std::weak_ptr<WeakFlag>& weakFlag)
+{
+    ASSERT((pAnimationPlayer != nullptr) && !weakFlag.expired());
+    if ((pAnimationPlayer == nullptr) || weakFlag.expired()) {
+        return;
+    }
+    TPlayerData playerData;
+    playerData.m_pAnimationPlayer = pAnimationPlayer;
+    playerData.m_weakFlag = weakFlag;
+    m_players.push_back(playerData);
+
+    if (!m_timerFlag.HasUsed()) {
+        GlobalManager::Instance().Timer().AddTimer(m_timerFlag.GetWeakFlag(),
+                                                   [this]() { OnTick(); },
+                                                   (uint32_t)m_frameIntervalMillSeconds);
+    }
+}
+
+void AnimationClock::SetFrameIntervalMillSeconds(int32_t frameIntervalMillSeconds)
+{
+    if (frameIntervalMillSeconds <= 0) {
+        frameIntervalMillSeconds = DEFAULT_ANIMATION_CLOCK_INTERVAL;
+    }
+    if (m_frameIntervalMillSeconds != frameIntervalMillSeconds) {
+        m_frameIntervalMillSeconds = frameIntervalMillSeconds;
+        if (m_timerFlag.HasUsed()) {
+            //按新的时间间隔重新启动定时器
+            m_timerFlag.Cancel();
+            GlobalManager::Instance().Timer().AddTimer(m_timerFlag.GetWeakFlag(),
+                                                       [this]() { OnTick(); },
+                                                       (uint32_t)m_frameIntervalMillSeconds);
+        }
+    }
+}
+
+int32_t AnimationClock::GetFrameIntervalMillSeconds() const
+{
+    return m_frameIntervalMillSeconds;
+}
+
+size_t AnimationClock::GetPlayerCount() const
+{
+    size_t nCount = 0;
+    for (const TPlayerData& playerData : m_players) {
+        if (!playerData.m_weakFlag.expired()) {
+            ++nCount;
+        }
+    }
+    return nCount;
+}
+
+void AnimationClock::OnTick()
+{
+    //同一帧内的所有动画使用相同的时间，播放回调中新添加的动画追加在列表末尾，下一帧开始播放
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const size_t nPlayerCount = m_players.size();
+    for (size_t nIndex = 0; nIndex < nPlayerCount; ++nIndex) {
+        //播放回调中可能添加新的动画，导致容器重新分配，所以每次按序号访问
+        if (m_players[nIndex].m_weakFlag.expired()) {
+            continue;
+        }
+        AnimationPlayer* pAnimationPlayer = m_players[nIndex].m_pAnimationPlayer;
+        if (pAnimationPlayer != nullptr) {
+            pAnimationPlayer->Play(now);
+        }
+    }
+
+    //移除已经停止的动画
+    size_t nValidCount = 0;
+    for (size_t nIndex = 0; nIndex < m_players.size(); ++nIndex) {
+        if (!m_players[nIndex].m_weakFlag.expired()) {
+            if (nValidCount != nIndex) {
+                m_players[nValidCount] = m_players[nIndex];
+            }
+            ++nValidCount;
+        }
+    }
+    m_players.resize(nValidCount);
+    if (m_players.empty()) {
+        //没有正在播放的动画，停止时钟
+        m_timerFlag.Cancel();
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,69 @@
+#ifndef UI_ANIMATION_ANIMATIONCLOCK_H_
+#define UI_ANIMATION_ANIMATIONCLOCK_H_
+
+#include "duilib/Core/Callback.h"
+#include <chrono>
+#include <vector>
+
+namespace ui
+{
+class AnimationPlayer;
+
+/** 窗口级别的动画时钟：窗口内所有正在播放的动画共用一个定时器，每帧触发一次，
+*   各个动画播放器按实际经过的时间计算当前值（UI线程繁忙时跳帧，动画总时长保持不变），
+*   同一帧内所有动画产生的重绘请求在下一次绘制时一并处理；没有正在播放的动画时，定时器停止
+*/
+class UILIB_API AnimationClock
+{
+public:
+    AnimationClock();
+    ~AnimationClock();
+    AnimationClock(const AnimationClock& r) = delete;
+    AnimationClock& operator=(const AnimationClock& r) = delete;
+
+public:
+    /** 添加一个正在播放的动画（动画播放完成或者weakFlag失效后，自动移除）
+    * @param [in] pAnimationPlayer 动画播放器
+    * @param [in] weakFlag 动画播放器的取消机制，weakFlag.expired()为true时表示动画已经停止
+    */
+    void AddPlayer(AnimationPlayer* pAnimationPlayer, const std::weak_ptr<WeakFlag>& weakFlag);
+
+    /** 设置时钟的时间间隔（毫秒），默认按每秒60帧
+    */
+    void SetFrameIntervalMillSeconds(int32_t frameIntervalMillSeconds);
+
+    /** 获取时钟的时间间隔（毫秒）
+    */
+    int32_t GetFrameIntervalMillSeconds() const;
+
+    /** 获取正在播放的动画个数
+    */
+    size_t GetPlayerCount() const;
+
+private:
+    /** 时钟触发一次（在定时器中触发调用）
+    */
+    void OnTick();
+
+private:
+    /** 正在播放的动画
+    */
+    struct TPlayerData
+    {
+        AnimationPlayer* m_pAnimationPlayer;
+        std::weak_ptr<WeakFlag> m_weakFlag;
+    };
+    std::vector<TPlayerData> m_players;
+
+    /** 时钟的时间间隔（毫秒）
+    */
+    int32_t m_frameIntervalMillSeconds;
+
+    /** 定时器终止标志
+    */
+    WeakCallbackFlag m_timerFlag;
+};
+
+} // namespace ui
+
+#endif // UI_ANIMATION_ANIMATIONCLOCK_H_
@@ -1,6 +1,7 @@
 #include "AnimationManager.h"
 #include "duilib/Core/Control.h"
 #include "duilib/Core/ControlPtrT.h"
+#include "duilib/Core/Window.h"
 
 namespace ui 
 {
@@ -377,6 +378,9 @@ AnimationPlayer* AnimationManager::CreateAnimationPlayer(AnimationType animation
     pAnimationPlayer->SetFrameIntervalMillSeconds(GetFrameIntervalMillSeconds());
     pAnimationPlayer->SetTotalMillSeconds(GetTotalMillSeconds());
     pAnimationPlayer->SetEasingFunctionType(GetEasingFunctionType());
+    if ((m_pControl != nullptr) && (m_pControl->GetWindow() != nullptr)) {
+        pAnimationPlayer->SetAnimationClock(m_pControl->GetWindow()->GetAnimationClock());
+    }
     return pAnimationPlayer;
 }
 
@@ -1,5 +1,6 @@
 #include "AnimationPlayer.h"
 #include "duilib/Animation/EasingFunctions.h"
+#include "duilib/Animation/AnimationClock.h"
 #include "duilib/Core/GlobalManager.h"
 
 #define AP_NO_VALUE -1
@@ -115,11 +116,8 @@ void AnimationPlayer::StartTimer(bool bContinueMode, bool bOldReversePlay)
         totalMillSeconds = 180; //默认按动画总时常为180毫秒播放
     }
 
-    //计算帧数
-    int32_t frameCount = totalMillSeconds / timerIntervalMs;
-    if (frameCount < 1) {
-        frameCount = 1;
-    }
+    //按实际经过的时间计算当前值，每毫秒对应一帧（定时器触发延迟时跳帧，动画总时长保持不变）
+    const int32_t frameCount = totalMillSeconds;
 
     //检查是否应继续操作（不重新开始播放，而是继续操作）
     if (m_pEasingFunctions == nullptr) {
@@ -152,8 +150,16 @@ void AnimationPlayer::StartTimer(bool bContinueMode, bool bOldReversePlay)
         m_frameIndex = 0;
         m_currentValue = m_startValue;
     }
-    auto playCallback = UiBind(&AnimationPlayer::Play, this);
-    GlobalManager::Instance().Timer().AddTimer(m_weakFlagOwner.GetWeakFlag(), playCallback, (uint32_t)timerIntervalMs);
+    m_startTime = std::chrono::steady_clock::now() - std::chrono::milliseconds(m_frameIndex);
+    std::shared_ptr<AnimationClock> spAnimationClock = m_pAnimationClock.lock();
+    if (spAnimationClock != nullptr) {
+        //由动画时钟统一驱动播放
+        spAnimationClock->AddPlayer(this, m_weakFlagOwner.GetWeakFlag());
+    }
+    else {
+        auto playCallback = [this]() { Play(); };
+        GlobalManager::Instance().Timer().AddTimer(m_weakFlagOwner.GetWeakFlag(), playCallback, (uint32_t)timerIntervalMs);
+    }
 
     //首次调用，初始化当前的值（避免延迟调用导致的错误，比如设置控件大小、位置时，必须做初始化，否则会出现异常）
     if (m_playCallback) {
@@ -162,15 +168,27 @@ void AnimationPlayer::StartTimer(bool bContinueMode, bool bOldReversePlay)
 }
 
 void AnimationPlayer::Play()
+{
+    Play(std::chrono::steady_clock::now());
+}
+
+void AnimationPlayer::Play(const std::chrono::steady_clock::time_point& now)
 {
     if (m_pEasingFunctions == nullptr) {
         m_weakFlagOwner.Cancel();
         return;
     }
-    ++m_frameIndex;
-    if (m_frameIndex > m_pEasingFunctions->GetFrameCount()) {
+    const int64_t nElapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_startTime).count();
+    if (nElapsedMs <= (int64_t)m_frameIndex) {
+        //时间未前进（同一帧内重复调用），不需要更新
+        return;
+    }
+    if (nElapsedMs > (int64_t)m_pEasingFunctions->GetFrameCount()) {
         m_frameIndex = m_pEasingFunctions->GetFrameCount();
     }
+    else {
+        m_frameIndex = (int32_t)nElapsedMs;
+    }
     int32_t newCurrentValue = m_pEasingFunctions->GetEasingValue(m_frameIndex);
     if (m_playCallback) {
         if (newCurrentValue != m_currentValue) {
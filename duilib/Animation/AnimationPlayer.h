@@ -3,6 +3,7 @@
 
 #include "duilib/Animation/EasingFunctions.h"
 #include "duilib/Core/Callback.h"
+#include <chrono>
 
 namespace ui 
 {
@@ -13,10 +14,14 @@ typedef std::function<void (void)> AnimationCompleteCallback;    //播放完成
 //缓动函数的实现
 class EasingFunctions;
 
+//窗口级别的动画时钟
+class AnimationClock;
+
 /** 控件动画播放器的基类接口
 */
 class UILIB_API AnimationPlayer : public virtual SupportWeakCallback
 {
+    friend class AnimationClock;
 public:
     AnimationPlayer();
     virtual ~AnimationPlayer() override;
@@ -60,7 +65,7 @@ public:
     */
     int32_t GetEndValue() const { return m_endValue; }
 
-    /** 设置播放动画的定时器时间间隔（毫秒）
+    /** 设置播放动画的定时器时间间隔（毫秒），仅当未设置动画时钟时有效（设置动画时钟时，按动画时钟的时间间隔播放）
     * @param [in] frameIntervalMillSeconds 播放动画的定时器时间间隔（毫秒）
     */
     void SetFrameIntervalMillSeconds(int32_t frameIntervalMillSeconds) { m_frameIntervalMillSeconds = frameIntervalMillSeconds; }
@@ -78,6 +83,11 @@ public:
     */
     int32_t GetTotalMillSeconds() const { return m_totalMillSeconds; }
 
+    /** 设置动画时钟（一般为控件所在窗口的动画时钟），设置后由动画时钟统一驱动播放，未设置时使用自己的定时器播放
+    * @param [in] spAnimationClock 动画时钟
+    */
+    void SetAnimationClock(const std::shared_ptr<AnimationClock>& spAnimationClock) { m_pAnimationClock = spAnimationClock; }
+
 public:
     /** 设置播放回调函数
     */
@@ -139,10 +149,15 @@ private:
     */
     void StartTimer(bool bContinueMode, bool bOldReversePlay);
 
-    /** 播放一次动画（在定时器中触发调用）
+    /** 播放一次动画（在自己的定时器中触发调用）
     */
     void Play();
 
+    /** 按实际经过的时间播放一次动画（在定时器或者动画时钟中触发调用）
+    * @param [in] now 当前时间
+    */
+    void Play(const std::chrono::steady_clock::time_point& now);
+
     /** 交换起始值和结束值
     */
     void ReverseAllValue();
@@ -181,10 +196,18 @@ private:
     */
     int32_t m_currentValue;
 
-    /** 当前播放的帧序号
+    /** 当前播放的帧序号（每毫秒一帧，即已经播放的时间）
     */
     int32_t m_frameIndex;
 
+    /** 开始播放的时间（继续播放时，为按已播放的时间倒推的开始时间）
+    */
+    std::chrono::steady_clock::time_point m_startTime;
+
+    /** 动画时钟
+    */
+    std::weak_ptr<AnimationClock> m_pAnimationClock;
+
     /** 定时器终止标志
     */
     WeakCallbackFlag m_weakFlagOwner;
@@ -19,6 +19,8 @@ enum ePaintSelectedColors
 ListBox::ListBox(Window* pWindow, Layout* pLayout) :
     ScrollBox(pWindow, pLayout),
     m_iCurSel(Box::InvalidIndex),
+    m_nUpdateItemIndexStart(Box::InvalidIndex),
+    m_nUpdateSelectIndex(Box::InvalidIndex),
     m_nLastNoShiftItem(0),
     m_pCompareFunc(nullptr),
     m_pCompareContext(nullptr),
@@ -1963,6 +1965,7 @@ bool ListBox::SetItemIndex(Control* pControl, size_t iIndex)
     if (iOrginIndex == iIndex) {
         return true;
     }
+    UpdateListBoxItemIndex();
 
     IListBoxItem* pSelectedListItem = nullptr;
     if (Box::IsValidItemIndex(m_iCurSel)) {
@@ -2028,17 +2031,27 @@ bool ListBox::AddItemAt(Control* pControl, size_t iIndex)
         }
     }
 
-    const size_t itemCount = GetItemCount();
-    for(size_t i = iIndex + 1; i < itemCount; ++i) {
-        Control* p = GetItemAt(i);
-        pListItem = dynamic_cast<IListBoxItem*>(p);
-        if( pListItem != nullptr ) {
-            pListItem->SetListBoxIndex(i);
+    if (IsUpdating()) {
+        //批量修改过程中，延迟更新后续子项的索引号
+        m_nUpdateItemIndexStart = std::min(m_nUpdateItemIndexStart, iIndex + 1);
+    }
+    else {
+        const size_t itemCount = GetItemCount();
+        for(size_t i = iIndex + 1; i < itemCount; ++i) {
+            Control* p = GetItemAt(i);
+            pListItem = dynamic_cast<IListBoxItem*>(p);
+            if( pListItem != nullptr ) {
+                pListItem->SetListBoxIndex(i);
+            }
         }
     }
     if (Box::IsValidItemIndex(m_iCurSel) && (m_iCurSel >= iIndex)) {
         m_iCurSel += 1;
     }
+    if (Box::IsValidItemIndex(m_nUpdateSelectIndex) && (m_nUpdateSelectIndex >= iIndex)) {
+        //批量修改过程中延迟选择的子项，索引号同步调整
+        m_nUpdateSelectIndex += 1;
+    }
     OnListBoxItemAdded(pControl);
     return true;
 }
@@ -2067,18 +2080,29 @@ bool ListBox::RemoveItemAt(size_t iIndex)
     if (!ScrollBox::RemoveItemAt(iIndex)) {
         return false;
     }
-    const size_t itemCount = GetItemCount();
-    for(size_t i = iIndex; i < itemCount; ++i) {
-        Control* p = GetItemAt(i);
-        IListBoxItem* pListItem = dynamic_cast<IListBoxItem*>(p);
-        if (pListItem != nullptr) {
-            pListItem->SetListBoxIndex(i);
+    if (IsUpdating()) {
+        //批量修改过程中，延迟更新后续子项的索引号
+        m_nUpdateItemIndexStart = std::min(m_nUpdateItemIndexStart, iIndex);
+    }
+    else {
+        const size_t itemCount = GetItemCount();
+        for(size_t i = iIndex; i < itemCount; ++i) {
+            Control* p = GetItemAt(i);
+            IListBoxItem* pListItem = dynamic_cast<IListBoxItem*>(p);
+            if (pListItem != nullptr) {
+                pListItem->SetListBoxIndex(i);
+            }
         }
     }
 
     if (Box::IsValidItemIndex(m_iCurSel)) {
         if (iIndex == m_iCurSel) {
-            if (!IsMultiSelect() && m_bSelectNextWhenActiveRemoved) {
+            if (!IsMultiSelect() && m_bSelectNextWhenActiveRemoved && IsUpdating()) {
+                //批量修改过程中，延迟到批量修改结束时选择
+                m_nUpdateSelectIndex = m_iCurSel;
+                m_iCurSel = Box::InvalidIndex;
+            }
+            else if (!IsMultiSelect() && m_bSelectNextWhenActiveRemoved) {
                 SelectItem(FindSelectable(m_iCurSel--, false));
             }
             else {
@@ -2088,7 +2112,11 @@ bool ListBox::RemoveItemAt(size_t iIndex)
         else if (iIndex < m_iCurSel) {
             m_iCurSel -= 1;
         }
-    }    
+    }
+    if (Box::IsValidItemIndex(m_nUpdateSelectIndex) && (iIndex < m_nUpdateSelectIndex)) {
+        //批量修改过程中延迟选择的子项，索引号同步调整
+        m_nUpdateSelectIndex -= 1;
+    }
     return true;
 }
 
@@ -2106,9 +2134,39 @@ void ListBox::RemoveAllItems()
         }
     }
     m_iCurSel = Box::InvalidIndex;
+    m_nUpdateItemIndexStart = Box::InvalidIndex;
+    m_nUpdateSelectIndex = Box::InvalidIndex;
     ScrollBox::RemoveAllItems();
 }
 
+void ListBox::UpdateListBoxItemIndex()
+{
+    if (!Box::IsValidItemIndex(m_nUpdateItemIndexStart)) {
+        return;
+    }
+    const size_t itemCount = GetItemCount();
+    for (size_t i = m_nUpdateItemIndexStart; i < itemCount; ++i) {
+        IListBoxItem* pListItem = dynamic_cast<IListBoxItem*>(GetItemAt(i));
+        if (pListItem != nullptr) {
+            pListItem->SetListBoxIndex(i);
+        }
+    }
+    m_nUpdateItemIndexStart = Box::InvalidIndex;
+}
+
+void ListBox::OnEndUpdate()
+{
+    UpdateListBoxItemIndex();
+    if (Box::IsValidItemIndex(m_nUpdateSelectIndex)) {
+        size_t nSelectIndex = m_nUpdateSelectIndex;
+        m_nUpdateSelectIndex = Box::InvalidIndex;
+        if (!Box::IsValidItemIndex(m_iCurSel)) {
+            SelectItem(FindSelectable(nSelectIndex, false));
+        }
+    }
+    BaseClass::OnEndUpdate();
+}
+
 bool ListBox::SortItems(PFNCompareFunc pfnCompare, void* pCompareContext)
 {
     if (pfnCompare == nullptr) {
@@ -2383,6 +2441,15 @@ void ListBox::PaintFrameSelection(IRender* pRender)
     }
 }
 
+bool ListBox::GetScrollCopyFixedRects(std::vector<UiRect>& fixedRects) const
+{
+    if ((m_pHelper != nullptr) && m_pHelper->IsInFrameSelection()) {
+        //框选框的位置不完全随内容平移
+        return false;
+    }
+    return BaseClass::GetScrollCopyFixedRects(fixedRects);
+}
+
 void ListBox::GetScrollDeltaValue(int32_t& nHScrollValue, int32_t& nVScrollValue) const
 {
     nHScrollValue = DUI_NOSET_VALUE;
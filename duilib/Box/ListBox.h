@@ -211,6 +211,10 @@ public:
      */
     virtual void RemoveAllItems() override;
 
+    /** 更新子项的索引号（批量修改过程中，子项索引号的更新延迟到批量修改结束时执行，如需在此之前使用子项的索引号，需要先调用该函数）
+     */
+    void UpdateListBoxItemIndex();
+
 public:
     /** 设置是否支持鼠标框选功能
     */
@@ -582,6 +586,10 @@ protected:
     */
     virtual void PaintFrameSelection(IRender* pRender);
 
+    /** 滚动复制时，获取视图中不随滚动内容平移的区域（鼠标框选过程中不支持滚动复制）
+    */
+    virtual bool GetScrollCopyFixedRects(std::vector<UiRect>& fixedRects) const override;
+
     /** 列表项的子项收到鼠标事件
     * @return true表示截获该消息，子项不再处理该消息；返回false表示子项继续处理该消息
     */
@@ -634,6 +642,10 @@ protected:
     */
     virtual void OnListBoxItemRemoved(Control* pControl);
 
+    /** 批量修改子控件结束时，更新子项的索引号，执行延迟的选择操作
+    */
+    virtual void OnEndUpdate() override;
+
 private:
     /** 横向布局，计算行数
     */
@@ -662,6 +674,12 @@ private:
     //当前选择的子项ID, 如果是多选，指向最后一个选择项
     size_t m_iCurSel;
 
+    //批量修改过程中，需要更新索引号的第一个子项索引（该子项之后的子项索引号均需要更新）
+    size_t m_nUpdateItemIndexStart;
+
+    //批量修改过程中，选择项被移除后，延迟到批量修改结束时选择的子项索引
+    size_t m_nUpdateSelectIndex;
+
     //没按Shift键时的最后一次选中项的界面控件索引号（用于按Shift键选择的逻辑）
     size_t m_nLastNoShiftItem;
 
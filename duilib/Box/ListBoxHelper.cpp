@@ -88,6 +88,11 @@ int32_t ListBoxHelper::GetNormalItemTop() const
     return m_nNormalItemTop;
 }
 
+bool ListBoxHelper::IsInFrameSelection() const
+{
+    return m_bInMouseMove;
+}
+
 void ListBoxHelper::PaintFrameSelection(IRender* pRender)
 {
     if (!m_bInMouseMove || (pRender == nullptr)) {
@@ -87,6 +87,10 @@ public:
     */
     void PaintFrameSelection(IRender* pRender);
 
+    /** 当前是否正在进行鼠标框选操作
+    */
+    bool IsInFrameSelection() const;
+
 private:
 
     /** 检查是否需要滚动视图
@@ -18,7 +18,8 @@ ScrollBox::ScrollBox(Window* pWindow, Layout* pLayout) :
     m_bHoldEnd(false),
     m_rcScrollBarPadding(),
     m_nVScrollUnitPixels(0),
-    m_nHScrollUnitPixels(0)
+    m_nHScrollUnitPixels(0),
+    m_bScrollCopyEnabled(true)
 {
     SetVerScrollUnitPixels(30, true);
     SetHorScrollUnitPixels(30, true);
@@ -84,6 +85,9 @@ void ScrollBox::SetAttribute(const DString& pstrName, const DString& pstrValue)
     else if ((pstrName == _T("hold_end")) || (pstrName == _T("holdend"))) {
         SetHoldEnd(pstrValue == _T("true"));
     }
+    else if (pstrName == _T("scroll_copy")) {
+        SetScrollCopyEnabled(pstrValue == _T("true"));
+    }
     else {
         Box::SetAttribute(pstrName, pstrValue);
     }
@@ -771,11 +775,17 @@ void ScrollBox::SetScrollPos(UiSize64 szPos)
         return;
     }
     UiSize newScrollOffset = GetScrollOffset();
+    bool bScrollCopied = false;
     if (newScrollOffset != oldScrollOffset) {
+        //需要在OnScrollOffsetChanged之前平移，该函数中标记的重绘区域已经是平移后的坐标
+        bScrollCopied = ScrollCopyView(oldScrollOffset.cx - newScrollOffset.cx,
+                                       oldScrollOffset.cy - newScrollOffset.cy);
         OnScrollOffsetChanged(oldScrollOffset, newScrollOffset);
     }
 
-    Invalidate();
+    if (!bScrollCopied) {
+        Invalidate();
+    }
     SendEvent(kEventScrollPosChanged, (cyOffset == 0) ? 0 : 1, (cxOffset == 0) ? 0 : 1);
 }
 
@@ -1047,6 +1057,136 @@ void ScrollBox::SetHoldEnd(bool bHoldEnd)
     m_bHoldEnd = bHoldEnd;
 }
 
+void ScrollBox::SetScrollCopyEnabled(bool bEnabled)
+{
+    m_bScrollCopyEnabled = bEnabled;
+}
+
+bool ScrollBox::IsScrollCopyEnabled() const
+{
+    return m_bScrollCopyEnabled;
+}
+
+bool ScrollBox::GetScrollCopyFixedRects(std::vector<UiRect>& fixedRects) const
+{
+    //滚动条悬浮在视图上面，不随内容平移
+    const UiPoint scrollBoxOffset = GetScrollOffsetInScrollBox();
+    ScrollBar* pScrollBars[] = { m_pVScrollBar.get(), m_pHScrollBar.get() };
+    for (ScrollBar* pScrollBar : pScrollBars) {
+        if ((pScrollBar != nullptr) && pScrollBar->IsVisible() && !pScrollBar->GetRect().IsEmpty()) {
+            UiRect rcScrollBar = pScrollBar->GetRect();
+            rcScrollBar.Offset(-scrollBoxOffset.x, -scrollBoxOffset.y);
+            fixedRects.push_back(rcScrollBar);
+        }
+    }
+    return true;
+}
+
+bool ScrollBox::ScrollCopyView(int32_t dx, int32_t dy)
+{
+    Window* pWindow = GetWindow();
+    if (!m_bScrollCopyEnabled || (pWindow == nullptr) || !IsVisible() || !IsClip()) {
+        return false;
+    }
+    //视图背景需要是不透明的纯色，内容平移后背景保持不变
+    if (IsAlpha() || !GetBoxShadowExpandedRect(GetRect()).Equals(GetRect()) || ShouldBeRoundRectFill() || IsLoading() ||
+        !GetBkImage().empty() || HasStateImage(kStateImageBk)) {
+        return false;
+    }
+    const DString bkColor = GetBkColor();
+    if (bkColor.empty() || (GetUiColor(bkColor).GetA() != 255)) {
+        return false;
+    }
+    if ((GetRenderOffset().x != 0) || (GetRenderOffset().y != 0)) {
+        return false;
+    }
+    //浮动的子控件位置不随内容平移
+    const size_t nItemCount = GetItemCount();
+    for (size_t nIndex = 0; nIndex < nItemCount; ++nIndex) {
+        Control* pControl = GetItemAt(nIndex);
+        if ((pControl != nullptr) && pControl->IsVisible() && pControl->IsFloat()) {
+            return false;
+        }
+    }
+
+    //视图区域（窗口客户区坐标）
+    const UiPoint scrollBoxOffset = GetScrollOffsetInScrollBox();
+    UiRect rcView = GetPosWithoutPadding();
+    rcView.Offset(-scrollBoxOffset.x, -scrollBoxOffset.y);
+
+    std::vector<UiRect> fixedRects;
+    if (!GetScrollCopyFixedRects(fixedRects)) {
+        return false;
+    }
+    //边框不随内容平移
+    const UiRectF rcBorderSize = GetBorderSize();
+    if ((rcBorderSize.left > 0) || (rcBorderSize.top > 0) || (rcBorderSize.right > 0) || (rcBorderSize.bottom > 0)) {
+        UiRect rcBorder = GetRect();
+        rcBorder.Offset(-scrollBoxOffset.x, -scrollBoxOffset.y);
+        const int32_t nLeft = (int32_t)std::ceil(rcBorderSize.left);
+        const int32_t nTop = (int32_t)std::ceil(rcBorderSize.top);
+        const int32_t nRight = (int32_t)std::ceil(rcBorderSize.right);
+        const int32_t nBottom = (int32_t)std::ceil(rcBorderSize.bottom);
+        fixedRects.push_back(UiRect(rcBorder.left, rcBorder.top, rcBorder.left + nLeft, rcBorder.bottom));
+        fixedRects.push_back(UiRect(rcBorder.left, rcBorder.top, rcBorder.right, rcBorder.top + nTop));
+        fixedRects.push_back(UiRect(rcBorder.right - nRight, rcBorder.top, rcBorder.right, rcBorder.bottom));
+        fixedRects.push_back(UiRect(rcBorder.left, rcBorder.bottom - nBottom, rcBorder.right, rcBorder.bottom));
+    }
+
+    //祖先控件：不能有透明度和位置偏移，视图区域受祖先控件的裁剪，绘制在视图上面的兄弟控件不随内容平移
+    const Control* pChild = this;
+    Box* pParent = GetParent();
+    while (pParent != nullptr) {
+        if (pParent->IsAlpha() || (pParent->GetRenderOffset().x != 0) || (pParent->GetRenderOffset().y != 0)) {
+            return false;
+        }
+        const UiPoint parentOffset = pParent->GetScrollOffsetInScrollBox();
+        if (pParent->IsClip()) {
+            UiRect rcParent = pParent->GetPosWithoutPadding();
+            rcParent.Offset(-parentOffset.x, -parentOffset.y);
+            if (!rcView.Intersect(rcParent)) {
+                return false;
+            }
+        }
+        ScrollBox* pParentScrollBox = dynamic_cast<ScrollBox*>(pParent);
+        if ((pParentScrollBox != nullptr) && !pParentScrollBox->GetScrollCopyFixedRects(fixedRects)) {
+            return false;
+        }
+        const size_t nCount = pParent->GetItemCount();
+        for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+            Control* pControl = pParent->GetItemAt(nIndex);
+            if ((pControl == nullptr) || (pControl == pChild) || !pControl->IsVisible()) {
+                continue;
+            }
+            UiRect rcControl = pControl->GetBoxShadowExpandedRect(pControl->GetRect());
+            const UiPoint controlOffset = pControl->GetScrollOffsetInScrollBox();
+            rcControl.Offset(-controlOffset.x, -controlOffset.y);
+            if (UiRect::Intersect(rcControl, rcControl, rcView)) {
+                fixedRects.push_back(rcControl);
+            }
+        }
+        pChild = pParent;
+        pParent = pParent->GetParent();
+    }
+
+    if (!pWindow->ScrollWindowRect(rcView, dx, dy)) {
+        return false;
+    }
+    //不随内容平移的区域：原位置的内容已被覆盖，平移后的位置残留了其旧内容，均需要重绘
+    for (const UiRect& rcFixed : fixedRects) {
+        UiRect rcDirty;
+        if (UiRect::Intersect(rcDirty, rcFixed, rcView)) {
+            pWindow->Invalidate(rcDirty);
+        }
+        UiRect rcMoved = rcFixed;
+        rcMoved.Offset(dx, dy);
+        if (UiRect::Intersect(rcDirty, rcMoved, rcView)) {
+            pWindow->Invalidate(rcDirty);
+        }
+    }
+    return true;
+}
+
 int32_t ScrollBox::GetVerScrollUnitPixels() const
 {
     return m_nVScrollUnitPixels;
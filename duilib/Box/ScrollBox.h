@@ -228,6 +228,15 @@ public:
      */
     void SetScrollBarPadding(UiPadding rcScrollBarPadding, bool bNeedDpiScale);
 
+    /** 设置是否启用滚动复制（滚动时平移已绘制的内容，只重绘新露出的区域），默认启用
+    *   不满足条件时（如有浮动子控件、设置了透明度、背景不是不透明的纯色、GPU绘制、层窗口等），自动改为重绘整个视图
+    */
+    void SetScrollCopyEnabled(bool bEnabled);
+
+    /** 获取是否启用滚动复制
+    */
+    bool IsScrollCopyEnabled() const;
+
     /** 监听滚动条位置变化事件
      * @param [in] callback 有变化后通知的回调函数
      * @param [in] callbackID 该回调函数对应的ID（用于删除回调函数）
@@ -265,7 +274,20 @@ protected:
     */
     virtual void OnSetMouseEnabled(bool bChanged) override;
 
+    /** 滚动复制时，获取视图中不随滚动内容平移的区域（如固定显示的表头），这些区域在滚动后需要重绘
+    * @param [out] fixedRects 返回不随滚动内容平移的区域，为窗口客户区坐标
+    * @return 返回false表示当前状态不支持滚动复制
+    */
+    virtual bool GetScrollCopyFixedRects(std::vector<UiRect>& fixedRects) const;
+
 private:
+    /** 滚动复制：平移视图中已绘制的内容，只重绘新露出的区域
+    * @param [in] dx 内容横向平移的距离
+    * @param [in] dy 内容纵向平移的距离
+    * @return 不满足条件时返回false，需要重绘整个视图
+    */
+    bool ScrollCopyView(int32_t dx, int32_t dy);
+
     /** 设置位置大小
     * @param [in] rc外部传入的矩形范围
     * @param [in] bScrollProcess true表示内部递归调用，false表示外部调用
@@ -331,6 +353,9 @@ private:
 
     //容器的滚动条是否在左侧显示
     bool m_bVScrollBarAtLeft;
+
+    //是否启用滚动复制
+    bool m_bScrollCopyEnabled;
 };
 
 /** 横向布局的ScrollBox
@@ -1,6 +1,7 @@
 #include "TabBox.h"
 #include "duilib/Animation/AnimationPlayer.h"
 #include "duilib/Core/Window.h"
+#include "duilib/Box/XmlBox.h"
 #include "duilib/Utils/StringUtil.h"
 
 namespace ui
@@ -294,6 +295,33 @@ void TabBox::OnShowTabItem(size_t index)
     if (pBox != nullptr) {
         pBox->SetMouseChildEnabled(true);
     }
+
+    //相邻的页面为延迟加载的XmlBox时，在工作线程中预读其XML文件，切换过去时直接使用
+    const size_t nItemCount = m_items.size();
+    for (size_t nAdjacent : { index - 1, index + 1 }) {
+        if (nAdjacent < nItemCount) {
+            XmlBox* pXmlBox = dynamic_cast<XmlBox*>(m_items.at(nAdjacent));
+            if ((pXmlBox != nullptr) && pXmlBox->IsLazyLoad()) {
+                pXmlBox->PreloadXmlData();
+            }
+        }
+    }
+}
+
+size_t TabBox::UnloadHiddenItems()
+{
+    size_t nUnloadCount = 0;
+    const size_t nItemCount = m_items.size();
+    for (size_t index = 0; index < nItemCount; ++index) {
+        if (index == m_nCurSel) {
+            continue;
+        }
+        XmlBox* pXmlBox = dynamic_cast<XmlBox*>(m_items.at(index));
+        if ((pXmlBox != nullptr) && pXmlBox->UnloadXmlData()) {
+            ++nUnloadCount;
+        }
+    }
+    return nUnloadCount;
 }
 
 bool TabBox::SelectItem(size_t iIndex)
@@ -428,6 +456,9 @@ bool TabBox::StartSwitchItemAnimationFadeInOutX(Control* pNewItemControl, Contro
     pAnimationPlayer->SetTotalMillSeconds(GetFadeSwitchTotalMillSeconds());
     pAnimationPlayer->SetFrameIntervalMillSeconds(GetFadeSwitchFrameIntervalMillSeconds());
     pAnimationPlayer->SetEasingFunctionType(GetFadeSwitchEasingFunctionType());
+    if (GetWindow() != nullptr) {
+        pAnimationPlayer->SetAnimationClock(GetWindow()->GetAnimationClock());
+    }
 
     //起始值和结束值
     const int32_t nMaxValue = 255;
@@ -521,6 +552,9 @@ bool TabBox::StartSwitchItemAnimationFadeInOut(Control* pNewItemControl, Control
     pAnimationPlayer->SetTotalMillSeconds(GetFadeSwitchTotalMillSeconds());
     pAnimationPlayer->SetFrameIntervalMillSeconds(GetFadeSwitchFrameIntervalMillSeconds());
     pAnimationPlayer->SetEasingFunctionType(GetFadeSwitchEasingFunctionType());
+    if (GetWindow() != nullptr) {
+        pAnimationPlayer->SetAnimationClock(GetWindow()->GetAnimationClock());
+    }
 
     //起始值和结束值
     const int32_t nMaxValue = 255;
@@ -48,6 +48,11 @@ public:
      * @return 成功返回 true，否则返回 false
      */
     bool SelectItem(const DString& pControlName);
+
+    /** 卸载隐藏页面中延迟加载的内容（页面为XmlBox时，释放其加载的控件，再次显示时重新加载），可在内存紧张时调用
+     * @return 返回卸载的页面个数
+     */
+    size_t UnloadHiddenItems();
    
     /** 监听Tab页面选择事件
      * @param [in] callback 事件处理的回调函数，请参考 EventCallback 声明
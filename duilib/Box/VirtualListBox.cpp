@@ -1,5 +1,6 @@
 #include "VirtualListBox.h"
 #include "duilib/Core/ScrollBar.h"
+#include "duilib/Core/GlobalManager.h"
 #include <algorithm>
 #include <set>
 
@@ -44,6 +45,26 @@ void VirtualListBoxElement::EmitCountChanged()
     }
 }
 
+ui::Control* VirtualListBoxElement::CreateElementWithCache(ui::VirtualListBox* pVirtualListBox, const FilePath& xmlPath,
+                                                           CreateControlCallback callback) const
+{
+    ASSERT(pVirtualListBox != nullptr);
+    if ((pVirtualListBox == nullptr) || (pVirtualListBox->GetWindow() == nullptr)) {
+        return nullptr;
+    }
+    return GlobalManager::Instance().CreateBoxWithCache(pVirtualListBox->GetWindow(), xmlPath, callback);
+}
+
+ui::Control* VirtualListBoxElement::CreateElementFromPrototype(ui::VirtualListBox* pVirtualListBox, const ControlPrototype& prototype,
+                                                               CreateControlCallback callback) const
+{
+    ASSERT(pVirtualListBox != nullptr);
+    if ((pVirtualListBox == nullptr) || (pVirtualListBox->GetWindow() == nullptr)) {
+        return nullptr;
+    }
+    return WindowBuilder::CreateControls(prototype, pVirtualListBox->GetWindow(), callback);
+}
+
 /////////////////////////////////////////////////////////////////////////////
 //
 VirtualListBox::VirtualListBox(Window* pWindow, Layout* pLayout)
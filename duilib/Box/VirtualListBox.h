@@ -7,6 +7,7 @@
 #include "duilib/Layout/VirtualHTileLayout.h"
 #include "duilib/Layout/VirtualVTileLayout.h"
 #include "duilib/Core/Callback.h"
+#include "duilib/Core/WindowBuilder.h"
 
 namespace ui {
 
@@ -89,6 +90,23 @@ protected:
     */
     void EmitCountChanged();
 
+    /** 使用XML模板创建一个数据项（在CreateElement函数中调用）：XML模板首次使用后编译为控件原型并缓存，
+    *   后续创建时不再遍历XML文档，也不再查找和解析Class的属性列表
+    * @param [in] pVirtualListBox 关联的虚表的接口
+    * @param [in] xmlPath 数据项模板的XML文件路径，XML文件的格式与GlobalManager::CreateBoxWithCache函数的要求相同
+    * @param [in] callback 自定义控件的回调处理函数
+    */
+    ui::Control* CreateElementWithCache(ui::VirtualListBox* pVirtualListBox, const FilePath& xmlPath,
+                                        CreateControlCallback callback = CreateControlCallback()) const;
+
+    /** 使用控件原型创建一个数据项（在CreateElement函数中调用）
+    * @param [in] pVirtualListBox 关联的虚表的接口
+    * @param [in] prototype 数据项的控件原型（由WindowBuilder::CreatePrototype函数创建）
+    * @param [in] callback 自定义控件的回调处理函数
+    */
+    ui::Control* CreateElementFromPrototype(ui::VirtualListBox* pVirtualListBox, const ControlPrototype& prototype,
+                                            CreateControlCallback callback = CreateControlCallback()) const;
+
 private:
     /** 回调函数关联的VirtualListBox对象
     */
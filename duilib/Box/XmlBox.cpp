@@ -4,13 +4,20 @@
 #include "duilib/Core/Shadow.h"
 #include "duilib/Utils/FilePathUtil.h"
 #include "duilib/Utils/FileUtil.h"
+#include "duilib/Utils/StringUtil.h"
 #include <set>
 
 namespace ui
 {
 XmlBox::XmlBox(Window* pWindow):
     Box(pWindow),
-    m_pSubBox(nullptr)
+    m_pSubBox(nullptr),
+    m_bLazyLoad(false),
+    m_bPreload(false),
+    m_bXmlDataLoaded(false),
+    m_bLoadPending(false),
+    m_bPreloading(false),
+    m_nUnloadIdleTime(0)
 {
     m_pXmlPreviewAttributes = std::make_unique<XmlPreviewAttributes>();
 }
@@ -19,6 +26,7 @@ XmlBox::~XmlBox()
 {
     size_t callbackId = (size_t)this;
     GlobalManager::Instance().RemoveResNotFoundCallback(callbackId);
+    m_unloadTimerFlag.Cancel();
     m_pShadow.reset();
 }
 
@@ -32,14 +40,50 @@ void XmlBox::SetAttribute(const DString& strName, const DString& strValue)
     else if (strName == _T("res_path")) {
         SetResPath(FilePath(strValue));
     }
+    else if (strName == _T("lazy_load")) {
+        SetLazyLoad(strValue == _T("true"));
+    }
+    else if (strName == _T("preload")) {
+        SetPreload(strValue == _T("true"));
+    }
+    else if (strName == _T("unload_idle_time")) {
+        SetUnloadIdleTime(StringUtil::StringToInt32(strValue));
+    }
     else {
         BaseClass::SetAttribute(strName, strValue);
     }
 }
 
+void XmlBox::SetPos(UiRect rc)
+{
+    if (m_bLoadPending && IsVisible() && !rc.IsEmpty()) {
+        //第一次显示（或者卸载后再次显示）：先加载XML中定义的控件，使其参与本次布局
+        EnsureXmlDataLoaded();
+    }
+    BaseClass::SetPos(rc);
+}
+
 bool XmlBox::SetXmlFilePath(const FilePath& xmlPath)
 {
-    if (IsInited()) {
+    if (IsInited() && m_bLazyLoad) {
+        //延迟加载：清除已加载的控件，在下次布局时加载
+        XmlPreviewAttributes xmlPreviewAttributes;
+        ClearLoadedXmlData(xmlPreviewAttributes);
+        m_pPreloadData.reset();
+        m_savedState.clear();
+        m_xmlPath = xmlPath;
+        m_bLoadPending = !m_xmlPath.IsEmpty();
+        if (m_bLoadPending) {
+            if (m_bPreload) {
+                PreloadXmlData();
+            }
+            Arrange();
+        }
+        return true;
+    }
+    else if (IsInited()) {
+        m_bLoadPending = false;
+        m_savedState.clear();
         bool bRet = LoadXmlData(xmlPath);
         if (bRet) {
             m_xmlPath = xmlPath;
@@ -74,6 +118,146 @@ void XmlBox::ClearXmlBox()
     XmlPreviewAttributes xmlPreviewAttributes;
     ClearLoadedXmlData(xmlPreviewAttributes);
     m_xmlPath.Clear();
+    m_bLoadPending = false;
+    m_pPreloadData.reset();
+    m_savedState.clear();
+}
+
+void XmlBox::SetLazyLoad(bool bLazyLoad)
+{
+    m_bLazyLoad = bLazyLoad;
+}
+
+bool XmlBox::IsLazyLoad() const
+{
+    return m_bLazyLoad;
+}
+
+void XmlBox::SetPreload(bool bPreload)
+{
+    m_bPreload = bPreload;
+}
+
+bool XmlBox::IsPreload() const
+{
+    return m_bPreload;
+}
+
+void XmlBox::SetUnloadIdleTime(int32_t nUnloadIdleTimeMs)
+{
+    if (nUnloadIdleTimeMs < 0) {
+        nUnloadIdleTimeMs = 0;
+    }
+    m_nUnloadIdleTime = nUnloadIdleTimeMs;
+    m_unloadTimerFlag.Cancel();
+    if (IsInited() && !IsVisible()) {
+        StartUnloadTimer();
+    }
+}
+
+int32_t XmlBox::GetUnloadIdleTime() const
+{
+    return m_nUnloadIdleTime;
+}
+
+bool XmlBox::IsXmlDataLoaded() const
+{
+    return m_bXmlDataLoaded;
+}
+
+bool XmlBox::EnsureXmlDataLoaded()
+{
+    if (!m_bLoadPending) {
+        return m_bXmlDataLoaded;
+    }
+    //加载失败时不再重试，避免每次布局都重复加载
+    m_bLoadPending = false;
+    bool bRet = LoadXmlData(m_xmlPath);
+    if (bRet && (m_pSubBox != nullptr) && !m_savedState.empty() && (m_restoreStateCallback != nullptr)) {
+        //恢复卸载前的控件状态
+        m_restoreStateCallback(m_pSubBox, m_savedState);
+    }
+    m_savedState.clear();
+    FilePath xmlFileFullPath = bRet ? m_xmlFileFullPath : m_xmlPath;
+    OnXmlDataLoaded(xmlFileFullPath, bRet);
+    return bRet;
+}
+
+void XmlBox::PreloadXmlData()
+{
+    if (!m_bLoadPending || m_bPreloading || m_xmlPath.IsEmpty()) {
+        return;
+    }
+    if ((m_pPreloadData != nullptr) && (m_pPreloadData->m_xmlPath == m_xmlPath)) {
+        //已经预读
+        return;
+    }
+    Window* pWindow = GetWindow();
+    if (pWindow == nullptr) {
+        return;
+    }
+    if (GlobalManager::Instance().Zip().IsUseZip() ||
+        !GlobalManager::Instance().Thread().HasThread(ui::kThreadWorker)) {
+        //压缩包资源的读取不支持多线程，在加载时读取
+        return;
+    }
+    std::shared_ptr<PreloadData> pPreloadData = std::make_shared<PreloadData>();
+    pPreloadData->m_xmlPath = m_xmlPath;
+    pPreloadData->m_windowResPath = pWindow->GetResourcePath();
+    pPreloadData->m_boxResPath = m_resPath;
+    m_bPreloading = true;
+
+    //预读完成的回调在UI线程中创建，工作线程中不访问容器对象（容器可能已经销毁）
+    StdClosure preloadCallback = ToWeakCallback([this, pPreloadData]() {
+            //这段代码在UI线程中执行
+            m_bPreloading = false;
+            if (m_bLoadPending && (pPreloadData->m_xmlPath == m_xmlPath) &&
+                (pPreloadData->m_boxResPath == m_resPath) && !pPreloadData->m_xmlFileData.empty()) {
+                m_pPreloadData = pPreloadData;
+            }
+        });
+    GlobalManager::Instance().Thread().PostTask(ui::kThreadWorker, [pPreloadData, preloadCallback]() {
+            //在工作线程中读取XML文件数据
+            ReadXmlFileData(pPreloadData->m_xmlPath, pPreloadData->m_windowResPath, pPreloadData->m_boxResPath,
+                            pPreloadData->m_xmlFileData, pPreloadData->m_xmlOutputPath, pPreloadData->m_xmlResPath);
+            GlobalManager::Instance().Thread().PostTask(ui::kThreadUI, preloadCallback);
+        });
+}
+
+bool XmlBox::UnloadXmlData()
+{
+    if (!m_bXmlDataLoaded || IsVisible()) {
+        return false;
+    }
+    m_unloadTimerFlag.Cancel();
+    m_savedState.clear();
+    if ((m_pSubBox != nullptr) && (m_saveStateCallback != nullptr)) {
+        //保存卸载前的控件状态
+        m_saveStateCallback(m_pSubBox, m_savedState);
+    }
+    XmlPreviewAttributes xmlPreviewAttributes;
+    ClearLoadedXmlData(xmlPreviewAttributes);
+    m_bLoadPending = true;
+    return true;
+}
+
+void XmlBox::SetStateCallback(SaveStateCallback saveStateCallback, RestoreStateCallback restoreStateCallback)
+{
+    m_saveStateCallback = saveStateCallback;
+    m_restoreStateCallback = restoreStateCallback;
+}
+
+void XmlBox::StartUnloadTimer()
+{
+    if ((m_nUnloadIdleTime <= 0) || !m_bXmlDataLoaded || m_unloadTimerFlag.HasUsed()) {
+        return;
+    }
+    GlobalManager::Instance().Timer().AddTimer(m_unloadTimerFlag.GetWeakFlag(),
+                                               [this]() {
+                                                   m_unloadTimerFlag.Cancel();
+                                                   UnloadXmlData();
+                                               },
+                                               (uint32_t)m_nUnloadIdleTime, 1);
 }
 
 void XmlBox::AddLoadXmlCallback(LoadXmlCallback callback, size_t callbackId)
@@ -123,11 +307,34 @@ void XmlBox::OnInit()
             return true;
         }, callbackId);
 
+    if (m_bLazyLoad && !m_xmlPath.IsEmpty()) {
+        //延迟加载：在第一次布局时加载
+        m_bLoadPending = true;
+        if (m_bPreload) {
+            PreloadXmlData();
+        }
+        return;
+    }
     bool bRet = LoadXmlData(m_xmlPath);
     FilePath xmlFileFullPath = bRet ? m_xmlFileFullPath : m_xmlPath;
     OnXmlDataLoaded(xmlFileFullPath, bRet);
 }
 
+void XmlBox::OnSetVisible(bool bChanged)
+{
+    BaseClass::OnSetVisible(bChanged);
+    if (!IsInited() || !bChanged) {
+        return;
+    }
+    if (IsVisible()) {
+        //再次显示，取消自动卸载
+        m_unloadTimerFlag.Cancel();
+    }
+    else {
+        StartUnloadTimer();
+    }
+}
+
 bool XmlBox::LoadXmlData(const FilePath& xmlPath)
 {
     if (xmlPath.IsEmpty()) {
@@ -147,7 +354,17 @@ bool XmlBox::LoadXmlData(const FilePath& xmlPath)
     std::vector<unsigned char> xmlFileData;
     FilePath xmlOutputPath;
     FilePath xmlResPath;
-    if (!ReadXmlFileData(xmlPath, pWindow->GetResourcePath(), xmlFileData, xmlOutputPath, xmlResPath)) {
+    std::shared_ptr<PreloadData> pPreloadData;
+    pPreloadData.swap(m_pPreloadData);
+    if ((pPreloadData != nullptr) && (pPreloadData->m_xmlPath == xmlPath) &&
+        (pPreloadData->m_windowResPath == pWindow->GetResourcePath()) &&
+        (pPreloadData->m_boxResPath == m_resPath)) {
+        //使用工作线程中预读的XML文件数据
+        xmlFileData.swap(pPreloadData->m_xmlFileData);
+        xmlOutputPath = pPreloadData->m_xmlOutputPath;
+        xmlResPath = pPreloadData->m_xmlResPath;
+    }
+    else if (!ReadXmlFileData(xmlPath, pWindow->GetResourcePath(), m_resPath, xmlFileData, xmlOutputPath, xmlResPath)) {
         //读取XML文件数据失败
         return bRet;
     }
@@ -190,6 +407,7 @@ bool XmlBox::LoadXmlData(const FilePath& xmlPath)
         m_pSubBox = pSubBox;
         *m_pXmlPreviewAttributes = xmlPreviewAttributes;
         m_xmlFileFullPath = xmlOutputPath;
+        m_bXmlDataLoaded = true;
         bRet = true;
     }
     else {
@@ -198,8 +416,8 @@ bool XmlBox::LoadXmlData(const FilePath& xmlPath)
     return bRet;
 }
 
-bool XmlBox::ReadXmlFileData(const FilePath& xmlInputPath, const FilePath& windowResPath,
-                             std::vector<unsigned char>& xmlFileData, FilePath& xmlOutputPath, FilePath& xmlResPath) const
+bool XmlBox::ReadXmlFileData(const FilePath& xmlInputPath, const FilePath& windowResPath, const FilePath& boxResPath,
+                             std::vector<unsigned char>& xmlFileData, FilePath& xmlOutputPath, FilePath& xmlResPath)
 {
     xmlFileData.clear();
     xmlOutputPath.Clear();
@@ -218,14 +436,14 @@ bool XmlBox::ReadXmlFileData(const FilePath& xmlInputPath, const FilePath& windo
                 xmlResPath = windowResPath;
             }
         }
-        if (!bFoundXmlFile && !m_resPath.IsEmpty()) {
+        if (!bFoundXmlFile && !boxResPath.IsEmpty()) {
             //在设置的资源路径中查找
-            sFile = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), m_resPath);
+            sFile = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), boxResPath);
             sFile = FilePathUtil::JoinFilePath(sFile, xmlFilePath);
             if (GlobalManager::Instance().Zip().IsZipResExist(sFile)) {
                 //在窗口资源目录查找成功
                 bFoundXmlFile = true;
-                xmlResPath = m_resPath;
+                xmlResPath = boxResPath;
             }
         }
         if (!bFoundXmlFile) {
@@ -258,14 +476,14 @@ bool XmlBox::ReadXmlFileData(const FilePath& xmlInputPath, const FilePath& windo
                 xmlResPath = windowResPath;
             }
         }        
-        if (!bFoundXmlFile && !m_resPath.IsEmpty()) {
+        if (!bFoundXmlFile && !boxResPath.IsEmpty()) {
             //在设置的资源路径中查找
-            xmlFileFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), m_resPath);
+            xmlFileFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), boxResPath);
             xmlFileFullPath = FilePathUtil::JoinFilePath(xmlFileFullPath, xmlFilePath);
             if (xmlFileFullPath.IsExistsFile()) {
                 //在窗口资源目录查找成功
                 bFoundXmlFile = true;
-                xmlResPath = m_resPath;
+                xmlResPath = boxResPath;
             }
         }
         if (!bFoundXmlFile) {
@@ -294,7 +512,7 @@ bool XmlBox::ReadXmlFileData(const FilePath& xmlInputPath, const FilePath& windo
     return false;
 }
 
-FilePath XmlBox::GetFirstDirectory(const FilePath& resPath) const
+FilePath XmlBox::GetFirstDirectory(const FilePath& resPath)
 {
     FilePath firstDir;
     if (!resPath.IsEmpty() && resPath.IsRelativePath()) {
@@ -307,7 +525,7 @@ FilePath XmlBox::GetFirstDirectory(const FilePath& resPath) const
     return firstDir;
 }
 
-FilePath XmlBox::GetResDirectory(FilePath xmlFilePath, const FilePath& windowResPath) const
+FilePath XmlBox::GetResDirectory(FilePath xmlFilePath, const FilePath& windowResPath)
 {
     FilePath resPath;
     if (!xmlFilePath.IsEmpty() && xmlFilePath.IsAbsolutePath()) {
@@ -350,6 +568,8 @@ void XmlBox::ClearLoadedXmlData(const XmlPreviewAttributes& xmlPreviewAttributes
         RemoveItem(m_pSubBox);
         m_pSubBox = nullptr;
     }
+    m_bXmlDataLoaded = false;
+    m_unloadTimerFlag.Cancel();
     m_pShadow.reset();
     m_xmlFileFullPath.Clear();
     m_xmlResPath.Clear();
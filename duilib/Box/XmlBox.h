@@ -21,6 +21,7 @@ public:
     //基类的虚函数
     virtual DString GetType() const override;
     virtual void SetAttribute(const DString& strName, const DString& strValue) override;
+    virtual void SetPos(UiRect rc) override;
 
 public:
     /** 设置XML文件的路径
@@ -49,6 +50,68 @@ public:
     */
     const FilePath& GetXmlFileFullPath() const;
 
+public:
+    /** 设置是否延迟加载：为true时，XML文件在容器第一次显示（布局）时才加载，隐藏的容器不加载
+    *   延迟加载的容器，其大小不应依赖于XML中的内容（不宜设置为"auto"），比如作为TabBox的页面使用
+    */
+    void SetLazyLoad(bool bLazyLoad);
+
+    /** 获取是否延迟加载
+    */
+    bool IsLazyLoad() const;
+
+    /** 设置是否预读XML文件：为true时，延迟加载的容器在初始化时，在工作线程中预先读取XML文件数据
+    */
+    void SetPreload(bool bPreload);
+
+    /** 获取是否预读XML文件
+    */
+    bool IsPreload() const;
+
+    /** 设置隐藏后自动卸载的时间（毫秒）：容器隐藏超过该时间后，释放已加载的控件，再次显示时重新加载
+    * @param [in] nUnloadIdleTimeMs 隐藏后自动卸载的时间，为0表示不自动卸载
+    */
+    void SetUnloadIdleTime(int32_t nUnloadIdleTimeMs);
+
+    /** 获取隐藏后自动卸载的时间（毫秒）
+    */
+    int32_t GetUnloadIdleTime() const;
+
+    /** 判断XML文件中定义的控件是否已经加载
+    */
+    bool IsXmlDataLoaded() const;
+
+    /** 确保XML文件中定义的控件已经加载（延迟加载或者已经卸载时，立即加载）
+    * @return 如果控件已经加载或者加载成功返回true，否则返回false
+    */
+    bool EnsureXmlDataLoaded();
+
+    /** 在工作线程中预先读取XML文件数据，加载时直接使用（创建控件仍在UI线程中进行）
+    *   仅当XML文件尚未加载时有效；使用压缩包资源时不支持预读
+    */
+    void PreloadXmlData();
+
+    /** 卸载XML文件中定义的控件（保留XML文件路径，再次显示时重新加载），可在内存紧张时调用
+    * @return 如果卸载了控件返回true；如果未加载或者容器处于显示状态，返回false
+    */
+    bool UnloadXmlData();
+
+    /** 卸载前保存控件状态的回调函数
+     * @param [in] pXmlBox XML文件中定义的根容器
+     * @param [out] state 保存的状态数据（格式由调用方定义）
+     */
+    using SaveStateCallback = std::function<void (Box* pXmlBox, DString& state)>;
+
+    /** 重新加载后恢复控件状态的回调函数
+     * @param [in] pXmlBox XML文件中定义的根容器
+     * @param [in] state 卸载前保存的状态数据
+     */
+    using RestoreStateCallback = std::function<void (Box* pXmlBox, const DString& state)>;
+
+    /** 设置控件状态的保存和恢复回调函数（卸载时保存状态，重新加载后恢复状态）
+    */
+    void SetStateCallback(SaveStateCallback saveStateCallback, RestoreStateCallback restoreStateCallback);
+
 public:
     /** 加载XML完成事件的回调函数
      * @param [in] xmlPath XML文件的路径
@@ -71,6 +134,11 @@ protected:
     //用于初始化xml属性
     virtual void OnInit() override;
 
+    /** 设置可见状态事件
+    * @param [in] bChanged true表示状态发生变化，false表示状态未发生变化
+    */
+    virtual void OnSetVisible(bool bChanged) override;
+
 private:
     /** 加载并填充XML中定义的控件
     */
@@ -80,6 +148,10 @@ private:
     */
     void OnXmlDataLoaded(const FilePath& xmlPath, bool bSuccess);
 
+    /** 隐藏后，启动自动卸载的定时器
+    */
+    void StartUnloadTimer();
+
     /** 清除已经加载的XML数据和界面的预览控件内容
     * @param [in] xmlPreviewAttributesNew 最新的窗口预览公共属性
     */
@@ -89,23 +161,24 @@ private:
     */
     void RemoveValuesInNewList(std::vector<DString>& oldList, const std::vector<DString>& newList) const;
 
-    /** 获取XML数据和XML路径
+    /** 获取XML数据和XML路径（不访问成员变量，可在工作线程中调用）
     * @param [in] xmlInputPath 输入的XML路径
     * @param [in] windowResPath 窗口的资源路径
+    * @param [in] boxResPath 容器设置的资源路径
     * @param [out] xmlFileData 读取的XML文件数据
     * @param [out] xmlOutputPath 输出的XML路径，解析时用于查找Include的XML文件路径
     * @param [out] xmlResPath XML文件对应的资源文件路径
     */
-    bool ReadXmlFileData(const FilePath& xmlInputPath, const FilePath& windowResPath,
-                         std::vector<unsigned char>& xmlFileData, FilePath& xmlOutputPath, FilePath& xmlResPath) const;
+    static bool ReadXmlFileData(const FilePath& xmlInputPath, const FilePath& windowResPath, const FilePath& boxResPath,
+                                std::vector<unsigned char>& xmlFileData, FilePath& xmlOutputPath, FilePath& xmlResPath);
 
     /** 从相对路径中，解析出第一级目录
     */
-    FilePath GetFirstDirectory(const FilePath& resPath) const;
+    static FilePath GetFirstDirectory(const FilePath& resPath);
 
     /** 从绝对路径中解析出资源路径
     */
-    FilePath GetResDirectory(FilePath xmlFilePath, const FilePath& windowResPath) const;
+    static FilePath GetResDirectory(FilePath xmlFilePath, const FilePath& windowResPath);
 
 private:
     /** XML文件的路径
@@ -144,6 +217,56 @@ private:
         size_t m_callbackId;
     };
     std::vector<LoadXmlCallbackData> m_loadXmlCallbacks;
+
+    /** 是否延迟加载
+    */
+    bool m_bLazyLoad;
+
+    /** 是否预读XML文件
+    */
+    bool m_bPreload;
+
+    /** XML文件中定义的控件是否已经加载
+    */
+    bool m_bXmlDataLoaded;
+
+    /** 是否有等待加载的XML文件（延迟加载或者已经卸载）
+    */
+    bool m_bLoadPending;
+
+    /** 是否正在工作线程中预读XML文件
+    */
+    bool m_bPreloading;
+
+    /** 隐藏后自动卸载的时间（毫秒）
+    */
+    int32_t m_nUnloadIdleTime;
+
+    /** 自动卸载定时器的取消机制
+    */
+    WeakCallbackFlag m_unloadTimerFlag;
+
+    /** 预读的XML文件数据
+    */
+    struct PreloadData
+    {
+        FilePath m_xmlPath;
+        FilePath m_windowResPath;
+        FilePath m_boxResPath;
+        std::vector<unsigned char> m_xmlFileData;
+        FilePath m_xmlOutputPath;
+        FilePath m_xmlResPath;
+    };
+    std::shared_ptr<PreloadData> m_pPreloadData;
+
+    /** 控件状态的保存和恢复回调函数
+    */
+    SaveStateCallback m_saveStateCallback;
+    RestoreStateCallback m_restoreStateCallback;
+
+    /** 卸载时保存的控件状态
+    */
+    DString m_savedState;
 };
 
 } //namespace ui
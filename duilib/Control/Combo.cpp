@@ -4,6 +4,10 @@
 #include "duilib/Box/ListBox.h"
 #include "duilib/Box/HBox.h"
 #include "duilib/Core/WindowCreateParam.h"
+#include "duilib/Core/GlobalManager.h"
+
+//下拉列表窗口在弹出窗口缓存池中的类型标识
+#define COMBO_WND_POOL_KEY _T("ComboWnd")
 
 namespace ui
 {
@@ -42,6 +46,10 @@ private:
     */
     UiRect GetComboWndRect() const;
 
+    /** 将下拉框的树控件从窗口中移除
+    */
+    void DetachTreeView();
+
 private:
     //关联的Combo接口
     ControlPtrT<Combo> m_pOwner;
@@ -52,6 +60,9 @@ private:
     //原来Edit控件的文本内容
     UiString m_editText;
 
+    //容纳树控件的容器（窗口复用时，重新添加树控件）
+    Box* m_pContentBox = nullptr;
+
     //是否已经关闭
     bool m_bIsClosed = false;
 };
@@ -67,19 +78,29 @@ void CComboWnd::InitComboWnd(Combo* pOwner, bool bActivated)
     m_editText = m_pOwner->GetText();
     m_bIsClosed = false;
 
-    //设置下拉框的显示位置和大小，避免弹出界面的时候出现黑屏现象
-    UiRect rcWnd = GetComboWndRect();
-    WindowCreateParam createWndParam;
-    createWndParam.m_dwStyle = kWS_POPUP;
-    createWndParam.m_dwExStyle = kWS_EX_LAYERED;
+    if (IsWindow()) {
+        //复用弹出窗口缓存池中的窗口：重新关联下拉框的属性和树控件
+        SetResourcePath(pOwner->GetWindow()->GetResourcePath());
+        SetShadowType(pOwner->GetComboWndShadowType());
+        if (m_pContentBox != nullptr) {
+            m_pContentBox->AddItem(pOwner->GetTreeView());
+        }
+    }
+    else {
+        //设置下拉框的显示位置和大小，避免弹出界面的时候出现黑屏现象
+        UiRect rcWnd = GetComboWndRect();
+        WindowCreateParam createWndParam;
+        createWndParam.m_dwStyle = kWS_POPUP;
+        createWndParam.m_dwExStyle = kWS_EX_LAYERED;
 #ifdef DUILIB_BUILD_FOR_SDL
-    createWndParam.m_dwExStyle |= kWS_EX_NOACTIVATE;
+        createWndParam.m_dwExStyle |= kWS_EX_NOACTIVATE;
 #endif
-    createWndParam.m_nX = rcWnd.left;
-    createWndParam.m_nY = rcWnd.top;
-    createWndParam.m_nWidth = rcWnd.Width();
-    createWndParam.m_nHeight = rcWnd.Height();
-    CreateWnd(pOwner->GetWindow(), createWndParam);
+        createWndParam.m_nX = rcWnd.left;
+        createWndParam.m_nY = rcWnd.top;
+        createWndParam.m_nWidth = rcWnd.Width();
+        createWndParam.m_nHeight = rcWnd.Height();
+        CreateWnd(pOwner->GetWindow(), createWndParam);
+    }
 
     UpdateComboWnd();
     if (bActivated) {
@@ -211,18 +232,25 @@ void CComboWnd::OnWindowShadowTypeChanged()
     }
 }
 
+void CComboWnd::DetachTreeView()
+{
+    if ((m_pContentBox != nullptr) && (m_pContentBox->GetItemCount() > 0)) {
+        if (m_pOwner != nullptr) {
+            m_pOwner->GetTreeView()->SetWindow(nullptr);
+            m_pOwner->GetTreeView()->SetParent(nullptr);
+        }
+        m_pContentBox->RemoveAllItems();
+    }
+}
+
 void CComboWnd::CloseComboWnd(bool bCanceled, bool needUpdateSelItem)
 {
     if (m_bIsClosed) {
         return;
     }
     m_bIsClosed = true;
-    Box* pRootBox = GetRoot();
-    if ((pRootBox != nullptr) && (pRootBox->GetItemCount() > 0)) {
-        m_pOwner->GetTreeView()->SetWindow(nullptr);
-        m_pOwner->GetTreeView()->SetParent(nullptr);
-        pRootBox->RemoveAllItems();
-    }
+    DetachTreeView();
+
     //先将前端窗口切换为父窗口，避免前端窗口关闭后，切换到其他窗口
     ControlPtrT<Combo> pOwner = m_pOwner;
     if ((pOwner != nullptr) && (pOwner->GetWindow() != nullptr)) {
@@ -231,13 +259,37 @@ void CComboWnd::CloseComboWnd(bool bCanceled, bool needUpdateSelItem)
         }
     }
 
-    CloseWnd();
+    //隐藏窗口并放入弹出窗口缓存池，下次弹出时复用；缓存池已满时，关闭窗口
+    bool bPooled = false;
+    if (pOwner != nullptr) {
+        ShowWindow(kSW_HIDE);
+        bPooled = GlobalManager::Instance().Windows().AddPopupWindow(COMBO_WND_POOL_KEY, this);
+    }
+    if (bPooled) {
+        //与窗口关闭时的处理相同
+        if (pOwner->m_pWindow == this) {
+            pOwner->m_pWindow = nullptr;
+            pOwner->SetState(kControlStateNormal);
+            pOwner->Invalidate();
+        }
+        if ((pOwner->GetWindow() != nullptr) && pOwner->GetWindow()->IsWindow()) {
+            pOwner->SetPos(pOwner->GetPos());
+            pOwner->SetFocus();
+        }
+    }
+    else {
+        CloseWnd();
+    }
     if (m_pOwner != nullptr) {
         if (bCanceled) {
             m_pOwner->GetTreeView()->SelectItem(m_iOldSel, false, false);
         }
         m_pOwner->OnComboWndClosed(bCanceled, needUpdateSelItem, m_editText.c_str());
     }
+    if (bPooled) {
+        //缓存池中的窗口不再关联下拉框
+        m_pOwner = nullptr;
+    }
 }
 
 void CComboWnd::OnInitWindow()
@@ -247,10 +299,10 @@ void CComboWnd::OnInitWindow()
     SetResourcePath(m_pOwner->GetWindow()->GetResourcePath());
     SetShadowType(m_pOwner->GetComboWndShadowType());
 
-    Box* pRoot = new Box(this);
-    pRoot->SetAutoDestroyChild(false);
-    pRoot->AddItem(m_pOwner->GetTreeView());
-    AttachBox(AttachShadow(pRoot));
+    m_pContentBox = new Box(this);
+    m_pContentBox->SetAutoDestroyChild(false);
+    m_pContentBox->AddItem(m_pOwner->GetTreeView());
+    AttachBox(AttachShadow(m_pContentBox));
 
     //更新窗口位置
     UpdateComboWnd();
@@ -258,13 +310,8 @@ void CComboWnd::OnInitWindow()
 
 void CComboWnd::OnCloseWindow()
 {
-    Box* pRootBox = GetRoot();
-    if ((pRootBox != nullptr) && (pRootBox->GetItemCount() > 0)) {
-        m_pOwner->GetTreeView()->SetWindow(nullptr);
-        m_pOwner->GetTreeView()->SetParent(nullptr);
-        pRootBox->RemoveAllItems();
-    }
-    if ((m_pOwner->GetWindow() != nullptr) && m_pOwner->GetWindow()->IsWindow()) {
+    DetachTreeView();
+    if ((m_pOwner != nullptr) && (m_pOwner->GetWindow() != nullptr) && m_pOwner->GetWindow()->IsWindow()) {
         m_pOwner->SetPos(m_pOwner->GetPos());
         m_pOwner->SetFocus();
     }    
@@ -1163,7 +1210,12 @@ void Combo::ShowComboList()
 {
     //显示下拉列表
     if ((m_pWindow == nullptr) || m_pWindow->IsClosingWnd()) {
-        m_pWindow = new CComboWnd();
+        //优先复用弹出窗口缓存池中的窗口
+        Window* pPooledWindow = GlobalManager::Instance().Windows().TakePopupWindow(COMBO_WND_POOL_KEY, GetWindow());
+        m_pWindow = dynamic_cast<CComboWnd*>(pPooledWindow);
+        if (m_pWindow == nullptr) {
+            m_pWindow = new CComboWnd();
+        }
         if (m_comboType == kCombo_DropList) {
             m_pWindow->InitComboWnd(this, true);
         }
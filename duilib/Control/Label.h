@@ -35,6 +35,16 @@ public:
      */
     virtual UiSize EstimateText(UiSize szAvailable) override;
 
+    /** 准备文本评估任务（在UI线程中调用），用于在多个线程中并行评估文本大小
+     *  @param [in] szAvailable 可用大小，与EstimateSize函数的参数相同
+     *  @param [out] task 返回文本评估任务
+     */
+    virtual bool PrepareMeasureText(UiSize szAvailable, TextMeasureTask& task) override;
+
+    /** 设置文本评估任务的结果，下次调用EstimateText函数时使用
+     */
+    virtual void SetMeasureTextResult(const TextMeasureTask& task) override;
+
 public:
     /** 获取文本内容
     */
@@ -520,6 +530,24 @@ UiSize LabelTemplate<T>::EstimateText(UiSize szAvailable)
     return m_impl->OnEstimateText(szAvailable);
 }
 
+template<typename T>
+bool LabelTemplate<T>::PrepareMeasureText(UiSize szAvailable, TextMeasureTask& task)
+{
+    UiFixedSize fixedSize;
+    UiEstSize estSize;
+    if (!this->PreEstimateSize(szAvailable, fixedSize, estSize)) {
+        //使用缓存中的估算结果，不需要评估文本
+        return false;
+    }
+    return m_impl->OnPrepareMeasureText(szAvailable, task);
+}
+
+template<typename T>
+void LabelTemplate<T>::SetMeasureTextResult(const TextMeasureTask& task)
+{
+    m_impl->OnSetMeasureTextResult(task);
+}
+
 template<typename T>
 void LabelTemplate<T>::PaintText(IRender* pRender)
 {
@@ -633,16 +633,26 @@ bool LabelImpl::HasHotColorState()
     return false;
 }
 
-UiSize LabelImpl::OnEstimateText(UiSize szAvailable)
-{
-    UiSize fixedSize;
-    const DString textValue = GetOwnerText();
-    if (textValue.empty()) {
-        //文本为空时，宽度和高度估算结果均为0
-        return fixedSize;
-    }
-    int32_t nWidth = szAvailable.cx;    //最终计算结果为最大宽度
-    int32_t nHeight = szAvailable.cy;   //最终计算结果为最大高度
+/** 判断文本评估任务与当前的评估条件是否一致
+*/
+static bool IsSameMeasureTask(const TextMeasureTask& task, const DString& text, const MeasureStringParam& measureParam)
+{
+    const MeasureStringParam& taskParam = task.measureParam;
+    return (taskParam.rectSize == measureParam.rectSize) &&
+           (taskParam.pFont == measureParam.pFont) &&
+           (taskParam.uFormat == measureParam.uFormat) &&
+           (taskParam.fSpacingMul == measureParam.fSpacingMul) &&
+           (taskParam.fSpacingAdd == measureParam.fSpacingAdd) &&
+           (taskParam.fWordSpacing == measureParam.fWordSpacing) &&
+           (taskParam.bUseFontHeight == measureParam.bUseFontHeight) &&
+           (taskParam.bRotate90ForAscii == measureParam.bRotate90ForAscii) &&
+           (task.text == text);
+}
+
+void LabelImpl::CalcMeasureTextSize(UiSize szAvailable, int32_t& nWidth, int32_t& nHeight) const
+{
+    nWidth = szAvailable.cx;    //最终计算结果为最大宽度
+    nHeight = szAvailable.cy;   //最终计算结果为最大高度
     const UiPadding rcTextPadding = this->GetTextPadding();
     const UiPadding rcPadding = m_pOwner->GetControlPadding();
     if (!m_bVerticalText) {
@@ -701,13 +711,38 @@ UiSize LabelImpl::OnEstimateText(UiSize szAvailable)
             nHeight = 0;
         }
     }
+}
+
+UiSize LabelImpl::OnEstimateText(UiSize szAvailable)
+{
+    //并行评估的结果只使用一次
+    std::unique_ptr<TextMeasureTask> pMeasureTextResult = std::move(m_pMeasureTextResult);
+
+    UiSize fixedSize;
+    const DString textValue = GetOwnerText();
+    if (textValue.empty()) {
+        //文本为空时，宽度和高度估算结果均为0
+        return fixedSize;
+    }
+    int32_t nWidth = 0;     //最终计算结果为最大宽度
+    int32_t nHeight = 0;    //最终计算结果为最大高度
+    CalcMeasureTextSize(szAvailable, nWidth, nHeight);
+    const UiPadding rcTextPadding = this->GetTextPadding();
+    const UiPadding rcPadding = m_pOwner->GetControlPadding();
     
     if (!textValue.empty() && (m_pOwner->GetWindow() != nullptr)) {
         auto pRender = m_pOwner->GetWindow()->GetRender();
         if (pRender != nullptr) {
             MeasureStringParam measureParam = GetMeasureParam();
             measureParam.rectSize = !m_bVerticalText ? nWidth : nHeight;
-            UiRect rect = m_pTextDrawer->MeasureString(pRender, textValue, measureParam, GetFontId(), IsRichText(), m_pOwner);
+            UiRect rect;
+            if ((pMeasureTextResult != nullptr) && IsSameMeasureTask(*pMeasureTextResult, textValue, measureParam)) {
+                //评估条件未变化，使用并行评估的结果
+                rect = pMeasureTextResult->rcResult;
+            }
+            else {
+                rect = m_pTextDrawer->MeasureString(pRender, textValue, measureParam, GetFontId(), IsRichText(), m_pOwner);
+            }
             fixedSize.cx = std::min(rect.Width(), nWidth);
             if (fixedSize.cx > 0) {
                 fixedSize.cx += (rcTextPadding.left + rcTextPadding.right);
@@ -724,6 +759,38 @@ UiSize LabelImpl::OnEstimateText(UiSize szAvailable)
     return fixedSize;
 }
 
+bool LabelImpl::OnPrepareMeasureText(UiSize szAvailable, TextMeasureTask& task)
+{
+    m_pMeasureTextResult.reset();
+    DString textValue = GetOwnerText();
+    if (textValue.empty()) {
+        return false;
+    }
+    int32_t nWidth = 0;
+    int32_t nHeight = 0;
+    CalcMeasureTextSize(szAvailable, nWidth, nHeight);
+    task.measureParam = GetMeasureParam();
+    task.measureParam.rectSize = !m_bVerticalText ? nWidth : nHeight;
+    if (task.measureParam.pFont == nullptr) {
+        return false;
+    }
+    if (IsRichText() && !(task.measureParam.uFormat & TEXT_VERTICAL)) {
+        //RichText文本的解析依赖控件和窗口，不支持在其他线程中评估
+        return false;
+    }
+    task.text = std::move(textValue);
+    task.rcResult = UiRect();
+    return true;
+}
+
+void LabelImpl::OnSetMeasureTextResult(const TextMeasureTask& task)
+{
+    if (m_pMeasureTextResult == nullptr) {
+        m_pMeasureTextResult = std::make_unique<TextMeasureTask>();
+    }
+    *m_pMeasureTextResult = task;
+}
+
 void LabelImpl::OnPaintText(IRender* pRender)
 {
     UiRect rc = m_pOwner->GetRect();
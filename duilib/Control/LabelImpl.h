@@ -67,6 +67,17 @@ public:
      */
     UiSize OnEstimateText(UiSize szAvailable);
 
+    /** 准备文本评估任务（在UI线程中调用），用于在多个线程中并行评估文本大小
+     *  @param [in] szAvailable 可用大小，不包含内边距，不包含外边距
+     *  @param [out] task 返回文本评估任务
+     *  @return 如果文本可以在其他线程中评估，返回true（RichText文本不支持）
+     */
+    bool OnPrepareMeasureText(UiSize szAvailable, TextMeasureTask& task);
+
+    /** 设置文本评估任务的结果，下次调用OnEstimateText函数时，如果评估条件未变化，直接使用该结果
+     */
+    void OnSetMeasureTextResult(const TextMeasureTask& task);
+
 public:
     /** 获取文本内容
     */
@@ -288,6 +299,13 @@ private:
     */
     DString GetOwnerText() const;
 
+    /** 计算文本评估的限制宽度和高度
+     *  @param [in] szAvailable 可用大小，不包含内边距，不包含外边距
+     *  @param [out] nWidth 返回文本的最大宽度
+     *  @param [out] nHeight 返回文本的最大高度
+     */
+    void CalcMeasureTextSize(UiSize szAvailable, int32_t& nWidth, int32_t& nHeight) const;
+
 private:
     /** 关联控件
     */
@@ -297,6 +315,10 @@ private:
     */
     std::unique_ptr<TextDrawer> m_pTextDrawer;
 
+    /** 并行评估文本大小的结果（只使用一次）
+    */
+    std::unique_ptr<TextMeasureTask> m_pMeasureTextResult;
+
     //文本内容
     UiString m_sText;
 
@@ -5,6 +5,7 @@
 #include "duilib/Control/RichEdit.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/Keyboard.h"
+#include "duilib/Core/MemoryStat.h"
 #include <set>
 
 namespace ui
@@ -145,6 +146,9 @@ void ListCtrl::SetAttribute(const DString& strName, const DString& strValue)
     else if (strName == _T("column_grid_line_color")) {
         SetColumnGridLineColor(strValue);
     }
+    else if (strName == _T("column_overscan")) {
+        SetColumnOverscan(StringUtil::StringToInt32(strValue));
+    }
     else if (strName == _T("report_view_class")) {
         SetReportViewClass(strValue);
     }
@@ -267,6 +271,16 @@ void ListCtrl::ChangeDpiScale(uint32_t nOldDpiScale, uint32_t nNewDpiScale)
     Refresh();
 }
 
+void ListCtrl::GetMemoryStat(WindowMemoryStat& stat) const
+{
+    BaseClass::GetMemoryStat(stat);
+    if (m_pData != nullptr) {
+        MemoryStatItem& item = stat.m_items[(size_t)MemoryCategory::kListCtrlData];
+        item.m_nBytes += m_pData->GetMemoryBytes();
+        item.m_nCount += m_pData->GetDataItemCount();
+    }
+}
+
 void ListCtrl::HandleEvent(const EventArgs& msg)
 {
     BaseClass::HandleEvent(msg);
@@ -977,6 +991,16 @@ DString ListCtrl::GetColumnGridLineColor() const
     return m_pReportView->GetColumnGridLineColor();
 }
 
+void ListCtrl::SetColumnOverscan(int32_t nColumnOverscan)
+{
+    m_pReportView->SetColumnOverscan(nColumnOverscan);
+}
+
+int32_t ListCtrl::GetColumnOverscan() const
+{
+    return m_pReportView->GetColumnOverscan();
+}
+
 void ListCtrl::SetEnableColumnWidthAuto(bool bEnable)
 {
     m_bEnableColumnWidthAuto = bEnable;
@@ -2264,7 +2288,7 @@ void ListCtrl::Refresh(bool bSync)
     if (!IsInited()) {
         return;
     }
-    if (m_bEnableRefresh) {
+    if (IsEnableRefresh()) {
         if (m_listCtrlType == ListCtrlType::Report) {
             if (m_pReportView != nullptr) {
                 m_pReportView->Refresh(bSync);
@@ -2285,7 +2309,7 @@ void ListCtrl::Refresh(bool bSync)
 
 void ListCtrl::RefreshDataItems(const std::vector<size_t>& dataItemIndexs)
 {
-    if (m_bEnableRefresh && !dataItemIndexs.empty()) {
+    if (IsEnableRefresh() && !dataItemIndexs.empty()) {
         if (m_listCtrlType == ListCtrlType::Report) {
             if (m_pReportView != nullptr) {
                 m_pReportView->RefreshElements(dataItemIndexs);
@@ -2313,7 +2337,14 @@ bool ListCtrl::SetEnableRefresh(bool bEnable)
 
 bool ListCtrl::IsEnableRefresh() const
 {
-    return m_bEnableRefresh;
+    return m_bEnableRefresh && !IsUpdating();
+}
+
+void ListCtrl::OnEndUpdate()
+{
+    BaseClass::OnEndUpdate();
+    //批量修改过程中的数据变化，统一刷新一次
+    Refresh();
 }
 
 void ListCtrl::SetAutoCheckSelect(bool bAutoCheckSelect)
@@ -55,6 +55,11 @@ public:
     */
     virtual void ChangeDpiScale(uint32_t nOldDpiScale, uint32_t nNewDpiScale) override;
 
+    /** 统计控件自身占用的内存（包括数据存储）
+     *  @param [in,out] stat 窗口的内存统计数据
+     */
+    virtual void GetMemoryStat(WindowMemoryStat& stat) const override;
+
 public:
     /** 设置表格类型（默认为Report类型）
     */
@@ -627,7 +632,7 @@ public:
     */
     bool SetEnableRefresh(bool bEnable);
 
-    /** 判断是否允许刷新界面
+    /** 判断是否允许刷新界面（在BeginUpdate/EndUpdate批量修改过程中返回false，批量修改结束时统一刷新一次）
     */
     bool IsEnableRefresh() const;
 
@@ -781,6 +786,12 @@ public:
     void SetColumnGridLineColor(const DString& color);
     DString GetColumnGridLineColor() const;
 
+    /** Report视图中，横向可见区域两侧额外创建的列数（每行只为横向可见区域附近的列创建子控件）
+    * @param [in] nColumnOverscan 可见区域左右两侧各额外创建的列数
+    */
+    void SetColumnOverscan(int32_t nColumnOverscan);
+    int32_t GetColumnOverscan() const;
+
     /** 是否支持双击Header的分割条自动调整列宽
     */
     void SetEnableColumnWidthAuto(bool bEnable);
@@ -1038,6 +1049,10 @@ protected:
     */
     virtual void OnInit() override;
 
+    /** 批量修改结束时，刷新界面
+    */
+    virtual void OnEndUpdate() override;
+
     /** 初始化Report视图
     */
     void InitReportView();
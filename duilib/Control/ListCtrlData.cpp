@@ -393,6 +393,29 @@ bool ListCtrlData::IsNormalMode() const
     return (m_hideRowCount == 0) && (m_heightRowCount == 0) && (m_atTopRowCount == 0);
 }
 
+size_t ListCtrlData::GetMemoryBytes() const
+{
+    size_t nBytes = m_rowDataList.capacity() * sizeof(ListCtrlItemData);
+    for (const auto& iter : m_dataMap) {
+        const StoragePtrList& storageList = iter.second;
+        nBytes += storageList.capacity() * sizeof(StoragePtr);
+        for (const StoragePtr& pStorage : storageList) {
+            if (pStorage == nullptr) {
+                continue;
+            }
+            nBytes += sizeof(Storage);
+            //短字符串存储在对象内部，只有驻留字符串在堆上有数据块（多个对象共享时会重复计算）
+            if (pStorage->text.IsInterned()) {
+                nBytes += (pStorage->text.size() + 1) * sizeof(DString::value_type);
+            }
+            if (pStorage->userDataS.IsInterned()) {
+                nBytes += (pStorage->userDataS.size() + 1) * sizeof(DString::value_type);
+            }
+        }
+    }
+    return nBytes;
+}
+
 size_t ListCtrlData::GetDataItemCount() const
 {
 #ifdef _DEBUG
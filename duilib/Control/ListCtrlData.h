@@ -565,6 +565,10 @@ public:
     */
     bool IsNormalMode() const;
 
+    /** 估算数据存储占用的内存（字节，包含行属性数据、列数据和堆上的字符串数据）
+    */
+    size_t GetMemoryBytes() const;
+
 private:
     /** 排序数据
     */
@@ -219,6 +219,35 @@ int32_t ListCtrlHeader::GetColumnWidth(size_t columnIndex) const
     return nColumnWidth;
 }
 
+bool ListCtrlHeader::GetColumnRange(int32_t nLeft, int32_t nRight, size_t& nFirstColumn, size_t& nLastColumn) const
+{
+    nFirstColumn = Box::InvalidIndex;
+    nLastColumn = Box::InvalidIndex;
+    if (nLeft >= nRight) {
+        return false;
+    }
+    int32_t xPos = GetPadding().left;
+    const size_t nColumnCount = GetColumnCount();
+    for (size_t columnIndex = 0; columnIndex < nColumnCount; ++columnIndex) {
+        ListCtrlHeaderItem* pHeaderItem = dynamic_cast<ListCtrlHeaderItem*>(GetItemAt(columnIndex * 2));
+        if ((pHeaderItem == nullptr) || !pHeaderItem->IsColumnVisible()) {
+            continue;
+        }
+        const int32_t nColumnWidth = std::max(pHeaderItem->GetColumnWidth(), 0);
+        if (xPos >= nRight) {
+            break;
+        }
+        if ((xPos + nColumnWidth) > nLeft) {
+            if (nFirstColumn == Box::InvalidIndex) {
+                nFirstColumn = columnIndex;
+            }
+            nLastColumn = columnIndex;
+        }
+        xPos += nColumnWidth;
+    }
+    return (nFirstColumn != Box::InvalidIndex);
+}
+
 bool ListCtrlHeader::SetColumnWidth(size_t columnIndex, int32_t nWidth, bool bNeedDpiScale)
 {
     bool bRet = false;
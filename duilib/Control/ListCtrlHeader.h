@@ -65,6 +65,15 @@ public:
     */
     int32_t GetColumnWidth(size_t columnIndex) const;
 
+    /** 获取与横向区域相交的可见列的索引序号范围（按各列的列宽计算，不依赖于表头控件的布局）
+    * @param [in] nLeft 区域的左侧坐标（相对于表头控件的左侧）
+    * @param [in] nRight 区域的右侧坐标（相对于表头控件的左侧）
+    * @param [out] nFirstColumn 第一个相交的列索引序号
+    * @param [out] nLastColumn 最后一个相交的列索引序号
+    * @return 有相交的可见列时返回true，否则返回false
+    */
+    bool GetColumnRange(int32_t nLeft, int32_t nRight, size_t& nFirstColumn, size_t& nLastColumn) const;
+
     /** 调整列的宽度(根据该列内容的实际宽度自适应)
     * @param [in] columnIndex 列索引序号：[0, GetColumnCount())
     * @param [in] nWidth 列宽值
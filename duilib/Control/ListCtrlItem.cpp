@@ -87,10 +87,23 @@ size_t ListCtrlItem::GetSubItemCount() const
 
 ListCtrlSubItem* ListCtrlItem::GetSubItem(size_t columnIndex) const
 {
-    ASSERT(columnIndex < GetSubItemCount());
-    ListCtrlSubItem* pSubItem = dynamic_cast<ListCtrlSubItem*>(GetItemAt(columnIndex));
-    ASSERT(pSubItem != nullptr);
-    return pSubItem;
+    ASSERT(m_pListCtrl != nullptr);
+    if (m_pListCtrl == nullptr) {
+        return nullptr;
+    }
+    //子控件只为列窗口内的列创建，按关联的列ID查找
+    const size_t nColumnId = m_pListCtrl->GetColumnId(columnIndex);
+    if (nColumnId == Box::InvalidIndex) {
+        return nullptr;
+    }
+    size_t nItemCount = GetItemCount();
+    for (size_t index = 0; index < nItemCount; ++index) {
+        ListCtrlSubItem* pSubItem = dynamic_cast<ListCtrlSubItem*>(GetItemAt(index));
+        if ((pSubItem != nullptr) && (pSubItem->GetDataColumnId() == nColumnId)) {
+            return pSubItem;
+        }
+    }
+    return nullptr;
 }
 
 ListCtrlSubItem* ListCtrlItem::GetSubItem(const UiPoint& ptMouse) const
@@ -121,7 +134,7 @@ size_t ListCtrlItem::GetSubItemIndex(const UiPoint& ptMouse) const
         ListCtrlSubItem* pSubItem = dynamic_cast<ListCtrlSubItem*>(GetItemAt(index));
         if (pSubItem != nullptr) {
             if (pSubItem->GetRect().ContainsPt(pt)) {
-                nSubItemIndex = index;
+                nSubItemIndex = GetSubItemIndex(pSubItem);
                 break;
             }
         }
@@ -132,10 +145,14 @@ size_t ListCtrlItem::GetSubItemIndex(const UiPoint& ptMouse) const
 size_t ListCtrlItem::GetSubItemIndex(ListCtrlSubItem* pSubItem) const
 {
     size_t nSubItemIndex = Box::InvalidIndex;
+    if ((pSubItem == nullptr) || (m_pListCtrl == nullptr)) {
+        return nSubItemIndex;
+    }
     size_t nItemCount = GetItemCount();
     for (size_t index = 0; index < nItemCount; ++index) {
         if (pSubItem == dynamic_cast<ListCtrlSubItem*>(GetItemAt(index))) {
-            nSubItemIndex = index;
+            //子控件只为列窗口内的列创建，按关联的列ID获取列的序号
+            nSubItemIndex = m_pListCtrl->GetColumnIndex(pSubItem->GetDataColumnId());
             break;
         }
     }
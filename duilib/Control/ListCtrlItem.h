@@ -72,12 +72,13 @@ public:
     */
     size_t GetDataItemIndex() const;
 
-    /** 获取子控件的个数
+    /** 获取子控件的个数（只有横向可见区域附近的列创建了子控件）
     */
     size_t GetSubItemCount() const;
 
-    /** 获取第columnIndex个子控件
-    * @param [in] columnIndex 列索引序号：[0, GetSubItemCount())
+    /** 获取第columnIndex列的子控件
+    * @param [in] columnIndex 列索引序号：[0, ListCtrl::GetColumnCount())
+    * @return 如果该列不在横向可见区域附近，未创建子控件，返回nullptr
     */
     ListCtrlSubItem* GetSubItem(size_t columnIndex) const;
 
@@ -88,11 +89,13 @@ public:
 
     /** 获取鼠标所在位置的子控件的列索引序号(哪一列)
     * @param [in] ptMouse 鼠标所在的位置，屏幕坐标点
+    * @return 列索引序号：[0, ListCtrl::GetColumnCount())
     */
     size_t GetSubItemIndex(const UiPoint& ptMouse) const;
 
     /** 获取子控件的列索引序号(哪一列)
     * @param [in] pSubItem 子控件的接口
+    * @return 列索引序号：[0, ListCtrl::GetColumnCount())
     */
     size_t GetSubItemIndex(ListCtrlSubItem* pSubItem) const;
 
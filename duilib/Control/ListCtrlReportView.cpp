@@ -4,6 +4,9 @@
 
 //包含类：ListCtrlReportView / ListCtrlReportLayout
 
+//横向可见区域两侧默认额外创建的列数
+#define DEFAULT_REPORT_VIEW_COLUMN_OVERSCAN 2
+
 namespace ui
 {
 ListCtrlReportView::ListCtrlReportView(Window* pWindow) :
@@ -11,6 +14,9 @@ ListCtrlReportView::ListCtrlReportView(Window* pWindow) :
     m_pListCtrl(nullptr),
     m_pData(nullptr),
     m_nTopElementIndex(0),
+    m_nFirstColumn(Box::InvalidIndex),
+    m_nLastColumn(Box::InvalidIndex),
+    m_nColumnOverscan(DEFAULT_REPORT_VIEW_COLUMN_OVERSCAN),
     m_nRowGridLineWidth(0),
     m_nColumnGridLineWidth(0)
 {
@@ -663,6 +669,37 @@ void ListCtrlReportView::PaintChild(IRender* pRender, const UiRect& rcPaint)
     PaintFrameSelection(pRender);
 }
 
+bool ListCtrlReportView::GetScrollCopyFixedRects(std::vector<UiRect>& fixedRects) const
+{
+    if (!BaseClass::GetScrollCopyFixedRects(fixedRects)) {
+        return false;
+    }
+    //Header和置顶的元素固定显示在视图顶部，不随内容平移
+    std::vector<Control*> topControls;
+    ListCtrlHeader* pHeaderCtrl = dynamic_cast<ListCtrlHeader*>(GetItemAt(0));
+    if ((pHeaderCtrl != nullptr) && pHeaderCtrl->IsVisible()) {
+        topControls.push_back(pHeaderCtrl);
+    }
+    for (size_t index : m_atTopControlList) {
+        Control* pControl = GetItemAt(index);
+        if ((pControl != nullptr) && pControl->IsVisible()) {
+            topControls.push_back(pControl);
+        }
+    }
+    UiRect rcTopControls;
+    for (const Control* pTopControl : topControls) {
+        rcTopControls.Union(pTopControl->GetRect());
+    }
+    if (rcTopControls.Height() > 0) {
+        const UiPoint scrollBoxOffset = GetScrollOffsetInScrollBox();
+        UiRect rcTop = GetPosWithoutPadding();
+        rcTop.Offset(-scrollBoxOffset.x, -scrollBoxOffset.y);
+        rcTop.bottom = std::min(rcTop.top + rcTopControls.Height(), rcTop.bottom);
+        fixedRects.push_back(rcTop);
+    }
+    return true;
+}
+
 void ListCtrlReportView::PaintGridLines(IRender* pRender)
 {
     ASSERT(pRender != nullptr);
@@ -884,20 +921,16 @@ bool ListCtrlReportView::FillDataItem(Control* pControl,
     pItem->SetChecked(bItemChecked, false);
     pItem->SetImageId(nImageId);
 
-    //设置左侧内边距，避免CheckBox显示与文字显示重叠
+    //左侧内边距，避免CheckBox显示与文字显示重叠
     const int32_t nPaddingLeft = pItem->GetItemPaddingLeft();
-    UiPadding rcPadding = pItem->GetPadding();
-    if (nPaddingLeft != rcPadding.left) {
-        rcPadding.left = nPaddingLeft;
-        pItem->SetPadding(rcPadding, false);
-    }
 
     //Header控件的内边距
     const UiPadding rcHeaderPadding = pHeaderCtrl->GetPadding();
 
     // 基本结构: <ListCtrlItem> <ListCtrlSubItem/> ... <ListCtrlSubItem/>  </ListCtrlItem>
     // 附加说明: 1. ListCtrlItem 是 HBox的子类;   
-    //          2. 每一列，放置一个ListCtrlSubItem控件
+    //          2. 列窗口（横向可见区域内的列及两侧额外的几列）中的每一列，放置一个ListCtrlSubItem控件，
+    //             列窗口左侧的列不创建控件，其宽度计入ListCtrlItem的左侧内边距，右侧的列不创建控件
     //          3. ListCtrlSubItem 是LabelBox的子类
 
     // 详细的结构说明，参见：ListCtrlItem.h
@@ -917,6 +950,15 @@ bool ListCtrlReportView::FillDataItem(Control* pControl,
     };
     std::vector<ElementData> elementDataList;
     const size_t nColumnCount = pHeaderCtrl->GetColumnCount();
+    size_t nFirstColumn = 0;
+    size_t nLastColumn = nColumnCount;
+    if (!GetColumnWindow(nFirstColumn, nLastColumn) || (nLastColumn >= nColumnCount)) {
+        //列窗口尚未计算或者已经失效（列发生变化，尚未重新布局）：所有的可见列都创建控件
+        nFirstColumn = 0;
+        nLastColumn = nColumnCount;
+    }
+    //列窗口左侧的可见列的总宽度
+    int32_t nSkippedWidth = 0;
     for (size_t nColumnIndex = 0; nColumnIndex < nColumnCount; ++nColumnIndex) {
         ListCtrlHeaderItem* pHeaderItem = pHeaderCtrl->GetColumn(nColumnIndex);
         if ((pHeaderItem == nullptr) || !pHeaderItem->IsColumnVisible()) {
@@ -926,6 +968,13 @@ bool ListCtrlReportView::FillDataItem(Control* pControl,
         if (nColumnWidth < 0) {
             nColumnWidth = 0;
         }
+        if (nColumnIndex < nFirstColumn) {
+            nSkippedWidth += nColumnWidth;
+            continue;
+        }
+        if (nColumnIndex > nLastColumn) {
+            break;
+        }
         ElementData data;
         data.nColumnIndex = nColumnIndex;
         data.nColumnId = pHeaderCtrl->GetColumnId(nColumnIndex);        
@@ -949,6 +998,14 @@ bool ListCtrlReportView::FillDataItem(Control* pControl,
         return false;
     }
 
+    //设置左侧内边距：列窗口左侧有列时，与表头的列对齐
+    UiPadding rcPadding = pItem->GetPadding();
+    const int32_t nItemPaddingLeft = (nSkippedWidth > 0) ? (rcHeaderPadding.left + nSkippedWidth) : nPaddingLeft;
+    if (nItemPaddingLeft != rcPadding.left) {
+        rcPadding.left = nItemPaddingLeft;
+        pItem->SetPadding(rcPadding, false);
+    }
+
     const size_t showColumnCount = elementDataList.size(); //显示的列数
     while (pItem->GetItemCount() > showColumnCount) {
         //移除多余的列
@@ -1178,7 +1235,14 @@ int32_t ListCtrlReportView::GetMaxDataItemWidth(const std::vector<ListCtrlSubIte
 
 void ListCtrlReportView::AdjustSubItemWidth(const std::map<size_t, int32_t>& subItemWidths)
 {
-    if (subItemWidths.empty()) {
+    if (subItemWidths.empty() || (m_pListCtrl == nullptr)) {
+        return;
+    }
+    size_t nFirstColumn = 0;
+    size_t nLastColumn = 0;
+    if (GetColumnWindow(nFirstColumn, nLastColumn) && (subItemWidths.begin()->first < nFirstColumn)) {
+        //列窗口左侧的列宽发生变化，各行的左侧内边距需要调整，重新填充数据
+        Refresh();
         return;
     }
     size_t itemCount = GetItemCount();
@@ -1187,23 +1251,96 @@ void ListCtrlReportView::AdjustSubItemWidth(const std::map<size_t, int32_t>& sub
         if (pItem == nullptr) {
             continue;
         }
-        size_t columnCount = pItem->GetItemCount();
-        for (size_t nColumn = 0; nColumn < columnCount; ++nColumn) {
-            auto iter = subItemWidths.find(nColumn);
+        size_t subItemCount = pItem->GetSubItemCount();
+        for (size_t nSubItem = 0; nSubItem < subItemCount; ++nSubItem) {
+            ListCtrlSubItem* pSubItem = dynamic_cast<ListCtrlSubItem*>(pItem->GetItemAt(nSubItem));
+            if (pSubItem == nullptr) {
+                continue;
+            }
+            //子控件只为列窗口内的列创建，按关联的列ID查找列的序号
+            auto iter = subItemWidths.find(m_pListCtrl->GetColumnIndex(pSubItem->GetDataColumnId()));
             if (iter != subItemWidths.end()) {
                 int32_t nColumnWidth = iter->second;
                 if (nColumnWidth < 0) {
                     nColumnWidth = 0;
                 }
-                ListCtrlSubItem* pSubItem = dynamic_cast<ListCtrlSubItem*>(pItem->GetItemAt(nColumn));
-                if (pSubItem != nullptr) {
-                    pSubItem->SetFixedWidth(UiFixedInt(nColumnWidth), true, false);
-                }
+                pSubItem->SetFixedWidth(UiFixedInt(nColumnWidth), true, false);
             }
         }
     }
 }
 
+void ListCtrlReportView::SetColumnOverscan(int32_t nColumnOverscan)
+{
+    if (nColumnOverscan < 0) {
+        nColumnOverscan = 0;
+    }
+    if (m_nColumnOverscan != nColumnOverscan) {
+        m_nColumnOverscan = nColumnOverscan;
+        Refresh();
+    }
+}
+
+int32_t ListCtrlReportView::GetColumnOverscan() const
+{
+    return m_nColumnOverscan;
+}
+
+bool ListCtrlReportView::GetColumnWindow(size_t& nFirstColumn, size_t& nLastColumn) const
+{
+    nFirstColumn = m_nFirstColumn;
+    nLastColumn = m_nLastColumn;
+    return (m_nFirstColumn != Box::InvalidIndex) && (m_nLastColumn != Box::InvalidIndex);
+}
+
+bool ListCtrlReportView::GetVisibleColumnRange(size_t& nFirstColumn, size_t& nLastColumn) const
+{
+    nFirstColumn = Box::InvalidIndex;
+    nLastColumn = Box::InvalidIndex;
+    if (m_pListCtrl == nullptr) {
+        return false;
+    }
+    ListCtrlHeader* pHeaderCtrl = m_pListCtrl->GetHeaderCtrl();
+    if (pHeaderCtrl == nullptr) {
+        return false;
+    }
+    const UiRect rc = GetPosWithoutPadding();
+    if (rc.Width() <= 0) {
+        return false;
+    }
+    //表头与各行的左侧坐标相同，都随横向滚动条平移
+    const int32_t nLeft = (int32_t)GetScrollPos().cx;
+    return pHeaderCtrl->GetColumnRange(nLeft, nLeft + rc.Width(), nFirstColumn, nLastColumn);
+}
+
+void ListCtrlReportView::UpdateColumnWindow()
+{
+    size_t nFirstColumn = Box::InvalidIndex;
+    size_t nLastColumn = Box::InvalidIndex;
+    if (GetVisibleColumnRange(nFirstColumn, nLastColumn)) {
+        //可见区域两侧各额外创建几列，小幅度的横向滚动不需要重新填充数据
+        const size_t nColumnOverscan = (size_t)m_nColumnOverscan;
+        const size_t nColumnCount = m_pListCtrl->GetColumnCount();
+        nFirstColumn = (nFirstColumn > nColumnOverscan) ? (nFirstColumn - nColumnOverscan) : 0;
+        nLastColumn = std::min(nLastColumn + nColumnOverscan, nColumnCount - 1);
+    }
+    m_nFirstColumn = nFirstColumn;
+    m_nLastColumn = nLastColumn;
+}
+
+bool ListCtrlReportView::IsColumnWindowChanged() const
+{
+    size_t nFirstColumn = Box::InvalidIndex;
+    size_t nLastColumn = Box::InvalidIndex;
+    if (!GetVisibleColumnRange(nFirstColumn, nLastColumn)) {
+        return false;
+    }
+    if ((m_nFirstColumn == Box::InvalidIndex) || (m_nLastColumn == Box::InvalidIndex)) {
+        return true;
+    }
+    return (nFirstColumn < m_nFirstColumn) || (nLastColumn > m_nLastColumn);
+}
+
 void ListCtrlReportView::OnSubItemColumnChecked(size_t nElementIndex, size_t nColumnId, bool bChecked)
 {
     ListCtrlData* pDataProvider = m_pData;
@@ -1606,6 +1743,9 @@ void ListCtrlReportLayout::LazyArrangeChild(UiRect rc) const
     pDataView->SetDisplayDataItems(std::vector<size_t>());
     pDataView->SetNormalItemTop(-1);
 
+    //按横向滚动条的位置，计算每行需要创建子控件的列
+    pDataView->UpdateColumnWindow();
+
     if (pDataView->IsNormalMode()) {
         //常规模式
         LazyArrangeChildNormal(rc);
@@ -2100,8 +2240,8 @@ bool ListCtrlReportLayout::NeedReArrange() const
 
     int64_t nScrollPosY = pDataView->GetScrollPos().cy;//新滚动条位置
     int64_t nVirtualOffsetY = pDataView->GetScrollVirtualOffset().cy;//原滚动条位置
-    //只要滚动位置发生变化，就需要重新布局
-    return (nScrollPosY != nVirtualOffsetY);
+    //只要纵向滚动位置发生变化，就需要重新布局；横向滚动时，只有可见的列超出列窗口时才需要重新布局
+    return (nScrollPosY != nVirtualOffsetY) || pDataView->IsColumnWindowChanged();
 }
 
 void ListCtrlReportLayout::EnsureVisible(UiRect rc, size_t iIndex, bool bToTop) const
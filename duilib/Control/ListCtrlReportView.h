@@ -189,11 +189,37 @@ public:
     */
     void AdjustSubItemWidth(const std::map<size_t, int32_t>& subItemWidths);
 
+public:
+    /** 设置横向可见区域两侧额外创建的列数（每行只为横向可见区域内的列创建子控件）
+    * @param [in] nColumnOverscan 可见区域左右两侧各额外创建的列数
+    */
+    void SetColumnOverscan(int32_t nColumnOverscan);
+    int32_t GetColumnOverscan() const;
+
+    /** 获取当前创建了子控件的列的索引序号范围（列窗口）
+    * @param [out] nFirstColumn 第一列的索引序号
+    * @param [out] nLastColumn 最后一列的索引序号
+    * @return 如果尚未计算列窗口，返回false（此时每行为所有的可见列创建子控件）
+    */
+    bool GetColumnWindow(size_t& nFirstColumn, size_t& nLastColumn) const;
+
+    /** 按当前横向滚动条的位置重新计算列窗口（在重新布局和填充数据之前调用）
+    */
+    void UpdateColumnWindow();
+
+    /** 横向滚动后，可见的列是否已经超出了列窗口的范围（需要重新填充数据）
+    */
+    bool IsColumnWindowChanged() const;
+
 protected:
     /** 绘制子控件
     */
     virtual void PaintChild(IRender* pRender, const UiRect& rcPaint) override;
 
+    /** 滚动复制时，获取视图中不随滚动内容平移的区域（Header控件和置顶的列表项）
+    */
+    virtual bool GetScrollCopyFixedRects(std::vector<UiRect>& fixedRects) const override;
+
     /** 查找子控件
     */
     virtual Control* FindControl(FINDCONTROLPROC Proc, void* pProcData, uint32_t uFlags,
@@ -289,6 +315,10 @@ private:
     */
     void MoveTopItemsToLast(std::vector<Control*>& items, std::vector<Control*>& atTopItems) const;
 
+    /** 获取横向可见区域内的列的索引序号范围
+    */
+    bool GetVisibleColumnRange(size_t& nFirstColumn, size_t& nLastColumn) const;
+
 private:
     /** ListCtrl 控件接口
     */
@@ -310,6 +340,15 @@ private:
     */
     std::vector<size_t> m_atTopControlList;
 
+    /** 列窗口：当前创建了子控件的列的索引序号范围
+    */
+    size_t m_nFirstColumn;
+    size_t m_nLastColumn;
+
+    /** 横向可见区域两侧额外创建的列数
+    */
+    int32_t m_nColumnOverscan;
+
 private:
     /** 横向网格线的宽度
     */
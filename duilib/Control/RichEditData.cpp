@@ -1,4 +1,5 @@
 #include "RichEditData.h"
+#include "duilib/Core/MemoryStat.h"
 #include "duilib/Utils/PerformanceUtil.h"
 #include <unordered_set>
 
@@ -14,7 +15,9 @@ RichEditData::RichEditData(IRichTextData* pRichTextData):
     m_bCacheDirty(true),
     m_nUndoLimit(64),
     m_bTextRectYOffsetUpdated(false),
-    m_bTextRectXOffsetUpdated(false)
+    m_bTextRectXOffsetUpdated(false),
+    m_nUndoMemoryBytes(0),
+    m_nUndoMemoryCount(0)
 {
     ASSERT(pRichTextData != nullptr);
 
@@ -22,6 +25,7 @@ RichEditData::RichEditData(IRichTextData* pRichTextData):
 
 RichEditData::~RichEditData()
 {
+    MemoryStat::Add(MemoryCategory::kRichEditUndo, -(int64_t)m_nUndoMemoryBytes, -(int64_t)m_nUndoMemoryCount);
 }
 
 void RichEditData::SetRender(IRender* pRender)
@@ -214,7 +218,7 @@ void RichEditData::CalcCacheTextRects(UiRect& rcTextRect)
         ASSERT(pLineInfo != nullptr);
         const size_t nRowCount = pLineInfo->m_rowInfo.size();
         for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-            const UiRectF& rowRect = pLineInfo->m_rowInfo[nRow]->m_rowRect;
+            const UiRectF& rowRect = pLineInfo->m_rowInfo[nRow].m_rowRect;
             if (bFirst) {
                 rowRects = rowRect;
                 bFirst = false;
@@ -239,7 +243,7 @@ void RichEditData::UpdateRowTextOffsetY(RichTextLineInfoList& lineTextInfo, int3
         ASSERT(pLineInfo != nullptr);
         const size_t nRowCount = pLineInfo->m_rowInfo.size();
         for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-            UiRectF& rowRect = pLineInfo->m_rowInfo[nRow]->m_rowRect;
+            UiRectF& rowRect = pLineInfo->m_rowInfo[nRow].m_rowRect;
             if (bFirstRow) {
                 //第一行
                 fRowHeight = rowRect.Height();
@@ -271,7 +275,7 @@ void RichEditData::UpdateRowTextOffsetX(RichTextLineInfoList& lineTextInfo, HorA
         ASSERT(pLineInfo != nullptr);
         const size_t nRowCount = pLineInfo->m_rowInfo.size();
         for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-            RichTextRowInfo& rowInfo = *pLineInfo->m_rowInfo[nRow];
+            RichTextRowInfo& rowInfo = pLineInfo->m_rowInfo[nRow];
             UiRectF& rowRect = rowInfo.m_rowRect;
             if (rowInfo.m_xOffset > 0) {
                 //恢复
@@ -589,7 +593,7 @@ void RichEditData::CalcTextRects(size_t nStartLine,
             const RichTextLineInfo& lineInfo = *m_lineTextInfo[nLineIndex];
             const size_t nRowCount = lineInfo.m_rowInfo.size();
             for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-                rowRectTopList.push_back((int32_t)lineInfo.m_rowInfo[nRow]->m_rowRect.top);
+                rowRectTopList.push_back((int32_t)lineInfo.m_rowInfo[nRow].m_rowRect.top);
             }
         }
         if (!m_pRender->UpdateDrawRichTextCache(m_spDrawRichTextCache, spDrawRichTextCacheUpdated, richTextDataListAll,
@@ -653,11 +657,11 @@ void RichEditData::CalcTextRects(size_t nStartLine,
 
             const size_t nRowCount = infoOld.m_rowInfo.size();
             for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-                const RichTextRowInfo& rowOld = *infoOld.m_rowInfo[nRow];
-                const RichTextRowInfo& rowNew = *infoNew.m_rowInfo[nRow];
+                const RichTextRowInfo& rowOld = infoOld.m_rowInfo[nRow];
+                const RichTextRowInfo& rowNew = infoNew.m_rowInfo[nRow];
                 ASSERT(rowOld.m_rowRect == rowNew.m_rowRect);
-                ASSERT(rowOld.m_charInfo.size() == rowNew.m_charInfo.size());
-                ASSERT(rowOld.m_charInfo == rowNew.m_charInfo);
+                ASSERT(rowOld.GetCharCount() == rowNew.GetCharCount());
+                ASSERT(rowOld.IsCharDataEqual(rowNew));
             }
         }
 
@@ -1201,12 +1205,11 @@ bool RichEditData::GetCharLineRowIndex(int32_t nCharIndex, size_t& nLineNumber,
             size_t nRowTextLen = 0;
             const size_t nRowCount = lineTextInfo.m_rowInfo.size();
             for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-                ASSERT(lineTextInfo.m_rowInfo[nRow] != nullptr);
-                const RichTextRowInfo& rowInfo = *lineTextInfo.m_rowInfo[nRow];
-                nRowTextLen += rowInfo.m_charInfo.size();
+                const RichTextRowInfo& rowInfo = lineTextInfo.m_rowInfo[nRow];
+                nRowTextLen += rowInfo.GetCharCount();
                 if (nStartLineOffset < nRowTextLen) {
                     //定位在本逻辑分行中
-                    const size_t nStartCharBaseLen = nRowTextLen - rowInfo.m_charInfo.size();
+                    const size_t nStartCharBaseLen = nRowTextLen - rowInfo.GetCharCount();
                     bFound = true;
                     nStartCharRowOffset = (size_t)nStartLineOffset - nStartCharBaseLen;
                     nLineNumber = nLineIndex;
@@ -1221,8 +1224,8 @@ bool RichEditData::GetCharLineRowIndex(int32_t nCharIndex, size_t& nLineNumber,
             const size_t nRowCount = lineTextInfo.m_rowInfo.size();
             ASSERT(nRowCount != 0);
             if (nRowCount > 0) {
-                const RichTextRowInfo& rowInfo = *lineTextInfo.m_rowInfo[nRowCount - 1];                
-                nStartCharRowOffset = rowInfo.m_charInfo.size();
+                const RichTextRowInfo& rowInfo = lineTextInfo.m_rowInfo[nRowCount - 1];
+                nStartCharRowOffset = rowInfo.GetCharCount();
                 nLineNumber = nLineIndex;
                 nLineRowIndex = nRowCount - 1;
                 bFound = true;
@@ -1233,66 +1236,66 @@ bool RichEditData::GetCharLineRowIndex(int32_t nCharIndex, size_t& nLineNumber,
     return bFound;
 }
 
-RichTextRowInfoPtr RichEditData::GetRowInfoFromPoint(const UiPoint& pt) const
+const RichTextRowInfo* RichEditData::GetRowInfoFromPoint(const UiPoint& pt) const
 {
     ASSERT(!m_bCacheDirty);
-    RichTextRowInfoPtr spRowInfo;
+    const RichTextRowInfo* pRowInfo = nullptr;
     const RichTextLineInfoList& lineTextInfoList = m_lineTextInfo;
     const size_t nLineCount = lineTextInfoList.size();
     for (size_t nLineIndex = 0; nLineIndex < nLineCount; ++nLineIndex) {
         ASSERT(lineTextInfoList[nLineIndex] != nullptr);
         const RichTextLineInfo& lineTextInfo = *lineTextInfoList[nLineIndex];
-        const size_t nRowCount = lineTextInfo.m_rowInfo.size();
-        for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-            ASSERT(lineTextInfo.m_rowInfo[nRow] != nullptr);
-            const RichTextRowInfo& rowInfo = *lineTextInfo.m_rowInfo[nRow];
-            const UiRectF& rowRect = rowInfo.m_rowRect;
-            if ((pt.y >= rowRect.top) && (pt.y < rowRect.bottom)) {
-                spRowInfo = lineTextInfo.m_rowInfo[nRow];
-                break;
-            }
+        const std::vector<RichTextRowInfo>& rowInfoList = lineTextInfo.m_rowInfo;
+        if (rowInfoList.empty() || (pt.y < rowInfoList.front().m_rowRect.top) || (pt.y >= rowInfoList.back().m_rowRect.bottom)) {
+            continue;
         }
-        if (spRowInfo != nullptr) {
+        //逻辑行按纵坐标排列，按二分查找定位
+        auto iter = std::upper_bound(rowInfoList.begin(), rowInfoList.end(), (float)pt.y,
+                                     [](float y, const RichTextRowInfo& rowInfo) {
+                                         return y < rowInfo.m_rowRect.bottom;
+                                     });
+        if ((iter != rowInfoList.end()) && (pt.y >= iter->m_rowRect.top)) {
+            pRowInfo = &(*iter);
             break;
         }
     }
-    return spRowInfo;
+    return pRowInfo;
 }
 
-RichTextRowInfoPtr RichEditData::GetCharRowInfo(int32_t nCharIndex, size_t& nStartCharRowOffset) const
+const RichTextRowInfo* RichEditData::GetCharRowInfo(int32_t nCharIndex, size_t& nStartCharRowOffset) const
 {
     ASSERT(!m_bCacheDirty);
     size_t nLineNumber = 0;
     size_t nLineRowIndex = 0;
-    RichTextRowInfoPtr spRowInfo;
+    const RichTextRowInfo* pRowInfo = nullptr;
     if (GetCharLineRowIndex(nCharIndex, nLineNumber, nLineRowIndex, nStartCharRowOffset)) {
         if (nLineNumber < m_lineTextInfo.size()) {
             const RichTextLineInfo& lineTextInfo = *m_lineTextInfo[nLineNumber];
-            spRowInfo = lineTextInfo.m_rowInfo[nLineRowIndex];
+            pRowInfo = &lineTextInfo.m_rowInfo[nLineRowIndex];
         }
     }
-    return spRowInfo;
+    return pRowInfo;
 }
 
-RichTextRowInfoPtr RichEditData::GetFirstRowInfo() const
+const RichTextRowInfo* RichEditData::GetFirstRowInfo() const
 {
     ASSERT(!m_bCacheDirty);
-    RichTextRowInfoPtr spRowInfo;
+    const RichTextRowInfo* pRowInfo = nullptr;
     const RichTextLineInfoList& lineTextInfoList = m_lineTextInfo;
     if (!lineTextInfoList.empty()) {
         const RichTextLineInfo& lineTextInfo = *lineTextInfoList[0];
         ASSERT(!lineTextInfo.m_rowInfo.empty());
         if (!lineTextInfo.m_rowInfo.empty()) {
-            spRowInfo = lineTextInfo.m_rowInfo[0];
+            pRowInfo = &lineTextInfo.m_rowInfo[0];
         }
     }
-    return spRowInfo;
+    return pRowInfo;
 }
 
-RichTextRowInfoPtr RichEditData::GetLastRowInfo() const
+const RichTextRowInfo* RichEditData::GetLastRowInfo() const
 {
     ASSERT(!m_bCacheDirty);
-    RichTextRowInfoPtr spRowInfo;
+    const RichTextRowInfo* pRowInfo = nullptr;
     const RichTextLineInfoList& lineTextInfoList = m_lineTextInfo;
     const size_t nLineCount = lineTextInfoList.size();
     if (nLineCount != 0) {
@@ -1300,13 +1303,13 @@ RichTextRowInfoPtr RichEditData::GetLastRowInfo() const
         ASSERT(!lineTextInfo.m_rowInfo.empty());
         const size_t nRowCount = lineTextInfo.m_rowInfo.size();
         if (nRowCount != 0) {
-            spRowInfo = lineTextInfo.m_rowInfo[nRowCount - 1];
+            pRowInfo = &lineTextInfo.m_rowInfo[nRowCount - 1];
         }
     }
-    return spRowInfo;
+    return pRowInfo;
 }
 
-size_t RichEditData::GetRowInfoStartIndex(const RichTextRowInfoPtr& spRowInfo) const
+size_t RichEditData::GetRowInfoStartIndex(const RichTextRowInfo* pRowInfo) const
 {
     ASSERT(!m_bCacheDirty);
     size_t nStartIndex = (size_t)-1;
@@ -1318,23 +1321,18 @@ size_t RichEditData::GetRowInfoStartIndex(const RichTextRowInfoPtr& spRowInfo) c
         const RichTextLineInfo& lineTextInfo = *lineTextInfoList[nLineIndex];
         ASSERT(lineTextInfo.m_nLineTextLen > 0);
 
-        size_t nRowTextLen = 0;
-        const size_t nRowCount = lineTextInfo.m_rowInfo.size();
-        for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-            ASSERT(lineTextInfo.m_rowInfo[nRow] != nullptr);
-            const RichTextRowInfo& rowInfo = *lineTextInfo.m_rowInfo[nRow];            
-            if (lineTextInfo.m_rowInfo[nRow] == spRowInfo) {
-                //找到此行
-                nStartIndex = nTextLen + nRowTextLen;
-                break;
+        const std::vector<RichTextRowInfo>& rowInfoList = lineTextInfo.m_rowInfo;
+        if (!rowInfoList.empty() && (pRowInfo >= rowInfoList.data()) && (pRowInfo < rowInfoList.data() + rowInfoList.size())) {
+            //找到此行（逻辑行连续存储，按地址判断所在的物理行）
+            size_t nRowTextLen = 0;
+            const size_t nRowIndex = (size_t)(pRowInfo - rowInfoList.data());
+            for (size_t nRow = 0; nRow < nRowIndex; ++nRow) {
+                nRowTextLen += rowInfoList[nRow].GetCharCount();
             }
-            nRowTextLen += rowInfo.m_charInfo.size();
-        }
-
-        nTextLen += lineTextInfo.m_nLineTextLen;
-        if (nStartIndex != (size_t)-1) {
+            nStartIndex = nTextLen + nRowTextLen;
             break;
         }
+        nTextLen += lineTextInfo.m_nLineTextLen;
     }
     return nStartIndex;
 }
@@ -1361,11 +1359,7 @@ void RichEditData::UpdateRowInfo(size_t nDrawStartLineIndex)
         const size_t nLineRowCount = lineTextInfoList[nLineIndex]->m_rowInfo.size();
         ASSERT(nLineRowCount > 0);
         for (size_t nLineRowIndex = 0; nLineRowIndex < nLineRowCount; ++nLineRowIndex) {
-            ASSERT(lineTextInfoList[nLineIndex]->m_rowInfo[nLineRowIndex] != nullptr);
-            if (lineTextInfoList[nLineIndex]->m_rowInfo[nLineRowIndex] == nullptr) {
-                continue;
-            }
-            UiRectF& rowRect = lineTextInfoList[nLineIndex]->m_rowInfo[nLineRowIndex]->m_rowRect;
+            UiRectF& rowRect = lineTextInfoList[nLineIndex]->m_rowInfo[nLineRowIndex].m_rowRect;
             if (nLineIndex >= nDrawStartLineIndex) {
                 //更新本行的纵向坐标值
                 fLastRowHeight = rowRect.bottom - rowRect.top;
@@ -1454,30 +1448,20 @@ UiPoint RichEditData::CaretPosFromChar(int32_t nCharIndex)
     }
     else {
         size_t nStartCharRowOffset = 0;
-        RichTextRowInfoPtr spRowInfo = GetCharRowInfo(nCharIndex, nStartCharRowOffset);
-        if (spRowInfo != nullptr) {
-            const RichTextRowInfo& rowInfo = *spRowInfo;
-            const size_t nIndexOffset = nStartCharRowOffset;
-            float xPos = rowInfo.m_rowRect.left;//左上角坐标
+        const RichTextRowInfo* pRowInfo = GetCharRowInfo(nCharIndex, nStartCharRowOffset);
+        if (pRowInfo != nullptr) {
+            const RichTextRowInfo& rowInfo = *pRowInfo;
+            const float xPos = rowInfo.m_rowRect.left + rowInfo.GetCharOffset(nStartCharRowOffset);//左上角坐标
             cursorPos.y = (int32_t)rowInfo.m_rowRect.top;
-            for (size_t i = 0; i < nIndexOffset; ++i) {
-                const RichTextCharInfo& charInfo = rowInfo.m_charInfo[i];
-                xPos += charInfo.CharWidth();
-            }
             cursorPos.x = (int32_t)xPos;
         }        
         else {
             //取最后一个字符的右上角坐标
-            spRowInfo = GetLastRowInfo();
-            if (spRowInfo != nullptr) {
-                const RichTextRowInfo& rowInfo = *spRowInfo;
-                float xPos = rowInfo.m_rowRect.left;
+            pRowInfo = GetLastRowInfo();
+            if (pRowInfo != nullptr) {
+                const RichTextRowInfo& rowInfo = *pRowInfo;
+                const float xPos = rowInfo.m_rowRect.left + rowInfo.GetCharOffset(rowInfo.GetCharCount());//右上角坐标
                 cursorPos.y = (int32_t)rowInfo.m_rowRect.top;
-                const size_t nCharCount = rowInfo.m_charInfo.size();
-                for (size_t i = 0; i < nCharCount; ++i) {
-                    const RichTextCharInfo& charInfo = rowInfo.m_charInfo[i];
-                    xPos += charInfo.CharWidth();//右上角坐标
-                }
                 cursorPos.x = (int32_t)ui::CEILF(xPos);
             }
         }
@@ -1508,9 +1492,9 @@ UiRect RichEditData::GetCharRowRect(int32_t nCharIndex)
     }
     else {
         size_t nStartCharRowOffset = 0;
-        RichTextRowInfoPtr spRowInfo = GetCharRowInfo(nCharIndex, nStartCharRowOffset);
-        if (spRowInfo != nullptr) {
-            const RichTextRowInfo& rowInfo = *spRowInfo;
+        const RichTextRowInfo* pRowInfo = GetCharRowInfo(nCharIndex, nStartCharRowOffset);
+        if (pRowInfo != nullptr) {
+            const RichTextRowInfo& rowInfo = *pRowInfo;
             const UiRectF& rowRectF = rowInfo.m_rowRect;
             UiRect rc = m_pRichText->GetRichTextDrawRect();
             rowRect.left = 0;
@@ -1542,31 +1526,22 @@ UiPoint RichEditData::PosFromChar(int32_t nCharIndex)
     }
     else {     
         size_t nStartCharRowOffset = 0;
-        RichTextRowInfoPtr spRowInfo = GetCharRowInfo(nCharIndex, nStartCharRowOffset);
-        if (spRowInfo != nullptr) {
-            const RichTextRowInfo& rowInfo = *spRowInfo;
-            const size_t nIndexOffset = nStartCharRowOffset;
-            float xPos = rowInfo.m_rowRect.left;//左上角坐标
+        const RichTextRowInfo* pRowInfo = GetCharRowInfo(nCharIndex, nStartCharRowOffset);
+        if (pRowInfo != nullptr) {
+            const RichTextRowInfo& rowInfo = *pRowInfo;
+            const float xPos = rowInfo.m_rowRect.left + rowInfo.GetCharOffset(nStartCharRowOffset);//左上角坐标
             pt.y = (int32_t)rowInfo.m_rowRect.top;
-            for (size_t i = 0; i < nIndexOffset; ++i) {
-                const RichTextCharInfo& charInfo = rowInfo.m_charInfo[i];
-                xPos += charInfo.CharWidth();
-            }
             pt.x = (int32_t)xPos;
         }
         else {
             //取最后一个字符的左上角坐标
-            spRowInfo = GetLastRowInfo();
-            if (spRowInfo != nullptr) {
-                const RichTextRowInfo& rowInfo = *spRowInfo;
+            pRowInfo = GetLastRowInfo();
+            if (pRowInfo != nullptr) {
+                const RichTextRowInfo& rowInfo = *pRowInfo;
                 float xPos = rowInfo.m_rowRect.left;
                 pt.y = (int32_t)rowInfo.m_rowRect.top;
-                if (!rowInfo.m_charInfo.empty()) {
-                    const size_t nIndexOffset = rowInfo.m_charInfo.size() - 1;
-                    for (size_t i = 0; i < nIndexOffset; ++i) {
-                        const RichTextCharInfo& charInfo = rowInfo.m_charInfo[i];
-                        xPos += charInfo.CharWidth();//左上角坐标
-                    }
+                if (!rowInfo.IsEmpty()) {
+                    xPos += rowInfo.GetCharOffset(rowInfo.GetCharCount() - 1);//左上角坐标
                 }
                 pt.x = (int32_t)xPos;
             }
@@ -1598,92 +1573,85 @@ int32_t RichEditData::CharFromPos(UiPoint pt)
 
     //横向按字符边界对齐，纵向按行高对齐
     int32_t nCharPosIndex = -1;
-    RichTextRowInfoPtr spDestRow;
-    RichTextRowInfoPtr spFirstRow = GetFirstRowInfo();
-    if (spFirstRow != nullptr) {
-        const UiRectF& rowRect = spFirstRow->m_rowRect;
+    const RichTextRowInfo* pDestRow = nullptr;
+    const RichTextRowInfo* pFirstRow = GetFirstRowInfo();
+    if (pFirstRow != nullptr) {
+        const UiRectF& rowRect = pFirstRow->m_rowRect;
         if (pt.y < rowRect.top) {
             //该点在区域上方，定位到第一行
-            spDestRow = spFirstRow;
+            pDestRow = pFirstRow;
         }
     }
-    if (spDestRow == nullptr) {
-        RichTextRowInfoPtr spLastRow = GetLastRowInfo();
-        if (spLastRow != nullptr) {
-            const UiRectF& rowRect = spLastRow->m_rowRect;
+    if (pDestRow == nullptr) {
+        const RichTextRowInfo* pLastRow = GetLastRowInfo();
+        if (pLastRow != nullptr) {
+            const UiRectF& rowRect = pLastRow->m_rowRect;
             if (pt.y >= rowRect.bottom) {
                 //该点在区域下方，定位到最后一行
-                spDestRow = spLastRow;
+                pDestRow = pLastRow;
             }
         }        
     }
 
-    if (spDestRow == nullptr) {
-        spDestRow = GetRowInfoFromPoint(pt);        
+    if (pDestRow == nullptr) {
+        pDestRow = GetRowInfoFromPoint(pt);
     }
-    ASSERT(spDestRow != nullptr);
-    if (spDestRow != nullptr) {
-        const RichTextRowInfo& rowInfo = *spDestRow;
-        const size_t nCharCount = rowInfo.m_charInfo.size();
-        ASSERT(!rowInfo.m_charInfo.empty());
+    ASSERT(pDestRow != nullptr);
+    if (pDestRow != nullptr) {
+        const RichTextRowInfo& rowInfo = *pDestRow;
+        const size_t nCharCount = rowInfo.GetCharCount();
+        ASSERT(!rowInfo.IsEmpty());
 
         if (pt.x <= rowInfo.m_rowRect.left) {
             //该点在本行的左侧，指向本行的首字符
-            nCharPosIndex = (int32_t)GetRowInfoStartIndex(spDestRow);
+            nCharPosIndex = (int32_t)GetRowInfoStartIndex(pDestRow);
         }
         else if (pt.x >= rowInfo.m_rowRect.right) {
             //该点在本行的右侧，指向本行的尾字符
-            if ((nCharCount >= 2) && rowInfo.m_charInfo[nCharCount - 1].IsNewLine() && rowInfo.m_charInfo[nCharCount - 2].IsReturn()){
+            if ((nCharCount >= 2) && rowInfo.IsNewLine(nCharCount - 1) && rowInfo.IsReturn(nCharCount - 2)){
                 //该行以回车+换行结尾: 指向回车字符
-                nCharPosIndex = (int32_t)(GetRowInfoStartIndex(spDestRow) + rowInfo.m_charInfo.size() - 2);
+                nCharPosIndex = (int32_t)(GetRowInfoStartIndex(pDestRow) + nCharCount - 2);
             }
-            else if ((nCharCount >= 1) && rowInfo.m_charInfo[nCharCount - 1].IsNewLine()) {
+            else if ((nCharCount >= 1) && rowInfo.IsNewLine(nCharCount - 1)) {
                 //该行以换行结尾: 指向换行字符
-                nCharPosIndex = (int32_t)(GetRowInfoStartIndex(spDestRow) + rowInfo.m_charInfo.size() - 1);
+                nCharPosIndex = (int32_t)(GetRowInfoStartIndex(pDestRow) + nCharCount - 1);
             }
             else {
                 //本行结尾无回车和换行符，指向该字符后面
-                nCharPosIndex = (int32_t)(GetRowInfoStartIndex(spDestRow) + rowInfo.m_charInfo.size());
+                nCharPosIndex = (int32_t)(GetRowInfoStartIndex(pDestRow) + nCharCount);
             }
         }
-        else if ((nCharCount == 2) && rowInfo.m_charInfo[nCharCount - 1].IsNewLine() && rowInfo.m_charInfo[nCharCount - 2].IsReturn()) {
+        else if ((nCharCount == 2) && rowInfo.IsNewLine(nCharCount - 1) && rowInfo.IsReturn(nCharCount - 2)) {
             //本行为空行，只有一个回车+换行: 指向回车字符
-            nCharPosIndex = (int32_t)(GetRowInfoStartIndex(spDestRow) + rowInfo.m_charInfo.size() - 2);
+            nCharPosIndex = (int32_t)(GetRowInfoStartIndex(pDestRow) + nCharCount - 2);
         }
         else if (nCharCount == 1) {
             //该行只有一个字符
-            nCharPosIndex = (int32_t)GetRowInfoStartIndex(spDestRow);
+            nCharPosIndex = (int32_t)GetRowInfoStartIndex(pDestRow);
         }
         else {
-            float xRowPos = rowInfo.m_rowRect.left;
-            const size_t nCount = rowInfo.m_charInfo.size();
-            for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
-                const RichTextCharInfo& charInfo = rowInfo.m_charInfo[nIndex];
-                if (charInfo.IsIgnoredChar()) {
-                    continue;
-                }
-                if ((pt.x >= xRowPos) && (pt.x < (xRowPos + charInfo.CharWidth()))) {
-                    if (pt.x <= (xRowPos + charInfo.CharWidth() / 2)) {
-                        //如果X坐标小于等于中心点，取当前字符
-                        nCharPosIndex = (int32_t)(GetRowInfoStartIndex(spDestRow) + nIndex);
-                    }
-                    else {
-                        //如果X坐标大于中心点，则取下一个字符
-                        for (size_t i = nIndex + 1; i < nCount; ++i) {
-                            const RichTextCharInfo& nextCharInfo = rowInfo.m_charInfo[i];
-                            if (nextCharInfo.IsLowSurrogate()) {
-                                continue;
-                            }
-                            nCharPosIndex = (int32_t)(GetRowInfoStartIndex(spDestRow) + i);
-                            break;
-                        }
-                        if (nCharPosIndex == -1) {
-                            nCharPosIndex = (int32_t)(GetRowInfoStartIndex(spDestRow) + nIndex);
+            //按字符的累计偏移量二分查找X坐标所在的字符（非绘制字符的宽度为0，不会被选中）
+            const float fOffset = (float)pt.x - rowInfo.m_rowRect.left;
+            const size_t nIndex = rowInfo.GetCharIndexFromOffset(fOffset);
+            if (nIndex < nCharCount) {
+                const float fCharLeft = rowInfo.GetCharOffset(nIndex);
+                if (fOffset <= (fCharLeft + rowInfo.GetCharWidth(nIndex) / 2)) {
+                    //如果X坐标小于等于中心点，取当前字符
+                    nCharPosIndex = (int32_t)(GetRowInfoStartIndex(pDestRow) + nIndex);
+                }
+                else {
+                    //如果X坐标大于中心点，则取下一个字符
+                    for (size_t i = nIndex + 1; i < nCharCount; ++i) {
+                        if (rowInfo.IsLowSurrogate(i)) {
+                            continue;
                         }
+                        nCharPosIndex = (int32_t)(GetRowInfoStartIndex(pDestRow) + i);
+                        break;
+                    }
+                    if (nCharPosIndex == -1) {
+                        nCharPosIndex = (int32_t)(GetRowInfoStartIndex(pDestRow) + nIndex);
                     }
-                    break;
                 }
-                xRowPos += charInfo.CharWidth();
             }
         }
     }
@@ -2234,12 +2202,12 @@ int32_t RichEditData::GetCharWidthValue(int32_t nCharIndex)
 
     int32_t nCharWidth = 0;
     size_t nStartCharRowOffset = 0;
-    RichTextRowInfoPtr spRowInfo = GetCharRowInfo(nCharIndex, nStartCharRowOffset);
-    if (spRowInfo != nullptr) {
-        const RichTextRowInfo& rowInfo = *spRowInfo;
-        ASSERT(nStartCharRowOffset <= rowInfo.m_charInfo.size());
-        if (nStartCharRowOffset < rowInfo.m_charInfo.size()) {
-            nCharWidth = (int32_t)ui::CEILF(rowInfo.m_charInfo[nStartCharRowOffset].CharWidth());
+    const RichTextRowInfo* pRowInfo = GetCharRowInfo(nCharIndex, nStartCharRowOffset);
+    if (pRowInfo != nullptr) {
+        const RichTextRowInfo& rowInfo = *pRowInfo;
+        ASSERT(nStartCharRowOffset <= rowInfo.GetCharCount());
+        if (nStartCharRowOffset < rowInfo.GetCharCount()) {
+            nCharWidth = (int32_t)ui::CEILF(rowInfo.GetCharWidth(nStartCharRowOffset));
         }
     }
     return nCharWidth;
@@ -2277,33 +2245,20 @@ void RichEditData::GetCharRangeRects(int32_t nStartChar, int32_t nEndChar, std::
         nRowTextLen = 0;
         const size_t nRowCount = lineTextInfo.m_rowInfo.size();
         for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-            ASSERT(lineTextInfo.m_rowInfo[nRow] != nullptr);
-
             nRowStartCharIndex = nTextLen + nRowTextLen;
-            const RichTextRowInfo& rowInfo = *lineTextInfo.m_rowInfo[nRow];
+            const RichTextRowInfo& rowInfo = lineTextInfo.m_rowInfo[nRow];
 
-            nEndRowIndex = (int32_t)(nRowStartCharIndex + rowInfo.m_charInfo.size());
+            nEndRowIndex = (int32_t)(nRowStartCharIndex + rowInfo.GetCharCount());
             bool bFirstLine = (nStartChar >= (int32_t)nRowStartCharIndex) && (nStartChar < nEndRowIndex);
             bool bLastLine = (nEndChar >= (int32_t)nRowStartCharIndex) && (nEndChar < nEndRowIndex);
 
             if (bFirstLine && bLastLine) {
-                //首行和尾行是同一行
+                //首行和尾行是同一行（非绘制字符和换行符的宽度为0，按累计偏移量计算）
                 UiRectF rowRectF = rowInfo.m_rowRect;
-                rowRectF.right = rowRectF.left;
                 const size_t nStartCharIndex = (size_t)nStartChar - nRowStartCharIndex;
                 const size_t nEndCharIndex = (size_t)nEndChar - nRowStartCharIndex;
-                for (size_t i = 0; i < nEndCharIndex; ++i) {
-                    if (rowInfo.m_charInfo[i].IsIgnoredChar() || rowInfo.m_charInfo[i].IsNewLine()) {
-                        continue;
-                    }
-                    if (i < nStartCharIndex) {
-                        rowRectF.left += rowInfo.m_charInfo[i].CharWidth();
-                        rowRectF.right = rowRectF.left;
-                    }
-                    else {
-                        rowRectF.right += rowInfo.m_charInfo[i].CharWidth();
-                    }
-                }
+                rowRectF.left = rowInfo.m_rowRect.left + rowInfo.GetCharOffset(nStartCharIndex);
+                rowRectF.right = rowInfo.m_rowRect.left + rowInfo.GetCharOffset(nEndCharIndex);
                 UiRectF& destRowRect = rowTextRectFs[nCurrentRowIndex];
                 if (destRowRect.IsZero()) {
                     destRowRect = rowRectF;
@@ -2318,21 +2273,9 @@ void RichEditData::GetCharRangeRects(int32_t nStartChar, int32_t nEndChar, std::
                 //首行: 选择到行尾
                 nStartRowIndex = nCurrentRowIndex;
                 UiRectF rowRectF = rowInfo.m_rowRect;
-                rowRectF.right = rowRectF.left;
                 const size_t nStartCharIndex = (size_t)nStartChar - nRowStartCharIndex;
-                const size_t nEndCharIndex = rowInfo.m_charInfo.size();
-                for (size_t i = 0; i < nEndCharIndex; ++i) {
-                    if (rowInfo.m_charInfo[i].IsIgnoredChar() || rowInfo.m_charInfo[i].IsNewLine()) {
-                        continue;
-                    }
-                    if (i < nStartCharIndex) {
-                        rowRectF.left += rowInfo.m_charInfo[i].CharWidth();
-                        rowRectF.right = rowRectF.left;
-                    }
-                    else {
-                        rowRectF.right += rowInfo.m_charInfo[i].CharWidth();
-                    }
-                }
+                rowRectF.left = rowInfo.m_rowRect.left + rowInfo.GetCharOffset(nStartCharIndex);
+                rowRectF.right = rowInfo.m_rowRect.left + rowInfo.GetCharOffset(rowInfo.GetCharCount());
                 UiRectF& destRowRect = rowTextRectFs[nCurrentRowIndex];
                 if (destRowRect.IsZero()) {
                     destRowRect = rowRectF;
@@ -2344,14 +2287,8 @@ void RichEditData::GetCharRangeRects(int32_t nStartChar, int32_t nEndChar, std::
             else if (bLastLine) {
                 //尾行：选择到行首
                 UiRectF rowRectF = rowInfo.m_rowRect;
-                rowRectF.right = rowRectF.left;
                 const size_t nEndCharIndex = (size_t)nEndChar - nRowStartCharIndex;
-                for (size_t i = 0; i < nEndCharIndex; ++i) {
-                    if (rowInfo.m_charInfo[i].IsIgnoredChar() || rowInfo.m_charInfo[i].IsNewLine()) {
-                        continue;
-                    }
-                    rowRectF.right += rowInfo.m_charInfo[i].CharWidth();
-                }
+                rowRectF.right = rowInfo.m_rowRect.left + rowInfo.GetCharOffset(nEndCharIndex);
                 UiRectF& destRowRect = rowTextRectFs[nCurrentRowIndex];
                 if (destRowRect.IsZero()) {
                     destRowRect = rowRectF;
@@ -2374,7 +2311,7 @@ void RichEditData::GetCharRangeRects(int32_t nStartChar, int32_t nEndChar, std::
                 }
             }            
 
-            nRowTextLen += rowInfo.m_charInfo.size();
+            nRowTextLen += rowInfo.GetCharCount();
             ++nCurrentRowIndex; //逻辑行号递增
         }
         nTextLen += lineTextInfo.m_nLineTextLen;
@@ -2458,6 +2395,7 @@ void RichEditData::SetUndoLimit(uint32_t nUndoLimit)
         while (!m_undoList.empty() && (m_undoList.size() > m_nUndoLimit)) {
             m_undoList.pop_front();
         }
+        UpdateUndoMemoryStat();
     }
 }
 
@@ -2470,6 +2408,7 @@ void RichEditData::ClearUndoList()
 {
     m_undoList.clear();
     m_redoList.clear();
+    UpdateUndoMemoryStat();
 }
 
 void RichEditData::EmptyUndoBuffer()
@@ -2502,6 +2441,36 @@ void RichEditData::AddToUndoList(int32_t nStartChar, const DStringW& newText, co
 
     //每次添加Undo后，清空Redo列表
     m_redoList.clear();
+    UpdateUndoMemoryStat();
+}
+
+void RichEditData::UpdateUndoMemoryStat()
+{
+    size_t nMemoryBytes = 0;
+    for (const std::list<TUndoData>* pUndoList : { &m_undoList, &m_redoList }) {
+        for (const TUndoData& undoData : *pUndoList) {
+            nMemoryBytes += sizeof(TUndoData);
+            nMemoryBytes += (undoData.m_newText.size() + undoData.m_oldText.size()) * sizeof(DStringW::value_type);
+        }
+    }
+    const size_t nMemoryCount = m_undoList.size() + m_redoList.size();
+    MemoryStat::Add(MemoryCategory::kRichEditUndo,
+                    (int64_t)nMemoryBytes - (int64_t)m_nUndoMemoryBytes,
+                    (int64_t)nMemoryCount - (int64_t)m_nUndoMemoryCount);
+    m_nUndoMemoryBytes = nMemoryBytes;
+    m_nUndoMemoryCount = nMemoryCount;
+}
+
+void RichEditData::GetMemoryStat(WindowMemoryStat& stat) const
+{
+    MemoryStatItem& undoItem = stat.m_items[(size_t)MemoryCategory::kRichEditUndo];
+    undoItem.m_nBytes += m_nUndoMemoryBytes;
+    undoItem.m_nCount += m_nUndoMemoryCount;
+    if ((m_spDrawRichTextCache != nullptr) && (m_pRenderFactory != nullptr)) {
+        MemoryStatItem& cacheItem = stat.m_items[(size_t)MemoryCategory::kRichTextCache];
+        cacheItem.m_nBytes += m_pRenderFactory->GetDrawRichTextCacheBytes(*m_spDrawRichTextCache);
+        cacheItem.m_nCount += 1;
+    }
 }
 
 bool RichEditData::CanUndo() const
@@ -2611,15 +2580,15 @@ DStringW RichEditData::GetRowText(int32_t nRowIndex)
         for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
             if (nRows == nRowIndex) {
                 //定位到本行
-                ASSERT(!lineText.m_rowInfo[nRow]->m_charInfo.empty());
+                ASSERT(!lineText.m_rowInfo[nRow].IsEmpty());
                 size_t nStartIndex = 0;
                 for (size_t i = 0; i < nRow; ++i) {
-                    nStartIndex += lineText.m_rowInfo[i]->m_charInfo.size();
+                    nStartIndex += lineText.m_rowInfo[i].GetCharCount();
                 }
-                if (!lineText.m_rowInfo[nRow]->m_charInfo.empty()) {
+                if (!lineText.m_rowInfo[nRow].IsEmpty()) {
                     ASSERT(nStartIndex < lineText.m_nLineTextLen);
                     std::wstring_view lineView(lineText.m_lineText.c_str(), lineText.m_nLineTextLen);
-                    rowText = lineView.substr(nStartIndex, lineText.m_rowInfo[nRow]->m_charInfo.size());
+                    rowText = lineView.substr(nStartIndex, lineText.m_rowInfo[nRow].GetCharCount());
                 }
                 bFound = true;
                 break;
@@ -2655,7 +2624,7 @@ int32_t RichEditData::RowIndex(int32_t nRowIndex)
                 break;
             }
             else {
-                nCharCount += (int32_t)lineText.m_rowInfo[nRow]->m_charInfo.size();
+                nCharCount += (int32_t)lineText.m_rowInfo[nRow].GetCharCount();
             }
             ++nRows;
         }
@@ -2682,7 +2651,7 @@ int32_t RichEditData::RowLength(int32_t nRowIndex)
         for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
             if (nRows == nRowIndex) {
                 //获取到本行的字符长度
-                nRowLength = (int32_t)lineText.m_rowInfo[nRow]->m_charInfo.size();
+                nRowLength = (int32_t)lineText.m_rowInfo[nRow].GetCharCount();
                 bFound = true;
                 break;
             }
@@ -2724,9 +2693,8 @@ int32_t RichEditData::RowFromChar(int32_t nCharIndex)
             size_t nRowTextLen = 0;
             const size_t nRowCount = lineText.m_rowInfo.size();
             for (size_t nRow = 0; nRow < nRowCount; ++nRow) {
-                ASSERT(lineText.m_rowInfo[nRow] != nullptr);
-                const RichTextRowInfo& rowInfo = *lineText.m_rowInfo[nRow];
-                nRowTextLen += rowInfo.m_charInfo.size();
+                const RichTextRowInfo& rowInfo = lineText.m_rowInfo[nRow];
+                nRowTextLen += rowInfo.GetCharCount();
                 if (nStartLineOffset < nRowTextLen) {
                     //定位在本逻辑分行中
                     break;
@@ -10,6 +10,8 @@
 
 namespace ui
 {
+struct WindowMemoryStat;
+
 /** 生成格式化文本的接口，用于绘制文本
 */
 class IRichTextData
@@ -331,6 +333,10 @@ public:
     */
     void ClearDrawRichTextCache();
 
+    /** 统计占用的内存（Undo/Redo数据和绘制缓存），累加到窗口的内存统计数据中
+    */
+    void GetMemoryStat(WindowMemoryStat& stat) const;
+
     /** 对重新计算做标记
     */
     void SetCacheDirty(bool bDirty);
@@ -384,6 +390,10 @@ private:
     */
     void AddToUndoList(int32_t nStartChar, const DStringW& newText, const DStringW& oldText);
 
+    /** Undo/Redo列表修改后，重新计算占用的内存，并更新内存统计的计数器
+    */
+    void UpdateUndoMemoryStat();
+
     /** 从缓存中计算文本所占的矩形区域
     */
     void CalcCacheTextRects(UiRect& rcTextRect);
@@ -438,27 +448,27 @@ private:
                              size_t& nLineRowIndex,
                              size_t& nStartCharRowOffset) const;
 
-    /** 获取指定字符的所在行的数据
+    /** 获取指定字符的所在行的数据（返回的指针在重新计算字符位置前有效）
     * @param [in] nCharIndex 字符索引位置
     * @param [out] nStartCharRowOffset 在逻辑行中的字符偏移量
     */
-    RichTextRowInfoPtr GetCharRowInfo(int32_t nCharIndex, size_t& nStartCharRowOffset) const;
+    const RichTextRowInfo* GetCharRowInfo(int32_t nCharIndex, size_t& nStartCharRowOffset) const;
 
     /** 获取一个点所在的行
     */
-    RichTextRowInfoPtr GetRowInfoFromPoint(const UiPoint& pt) const;
+    const RichTextRowInfo* GetRowInfoFromPoint(const UiPoint& pt) const;
 
     /** 获取首行的数据
     */
-    RichTextRowInfoPtr GetFirstRowInfo() const;
+    const RichTextRowInfo* GetFirstRowInfo() const;
 
     /** 获取尾行的数据
     */
-    RichTextRowInfoPtr GetLastRowInfo() const;
+    const RichTextRowInfo* GetLastRowInfo() const;
 
     /** 获取一行数据的起始字符下标值，如果找不到返回(size_t)-1
     */
-    size_t GetRowInfoStartIndex(const RichTextRowInfoPtr& spRowInfo) const;
+    size_t GetRowInfoStartIndex(const RichTextRowInfo* pRowInfo) const;
 
     /** 更新行高数据（增量绘制后的更新）
     * @param [in] nDrawStartLineIndex 从哪一行数据开始处理
@@ -557,6 +567,14 @@ private:
     /** 重做的最大次数限制
     */
     uint32_t m_nUndoLimit;
+
+    /** Undo/Redo数据占用的内存（字节，按数据大小估算）
+    */
+    size_t m_nUndoMemoryBytes;
+
+    /** Undo/Redo数据的个数（与内存统计的计数器保持一致）
+    */
+    size_t m_nUndoMemoryCount;
 };
 
 } //namespace ui
@@ -3,6 +3,7 @@
 #include "duilib/Core/Window.h"
 #include "duilib/Core/WindowMessage.h"
 #include "duilib/Core/ScrollBar.h"
+#include "duilib/Core/MemoryStat.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/AttributeUtil.h"
@@ -3153,6 +3154,14 @@ bool RichEdit::IsTextPasswordMode() const
     return IsPasswordMode();
 }
 
+void RichEdit::GetMemoryStat(WindowMemoryStat& stat) const
+{
+    BaseClass::GetMemoryStat(stat);
+    if (m_pTextData != nullptr) {
+        m_pTextData->GetMemoryStat(stat);
+    }
+}
+
 UiSize RichEdit::EstimateText(UiSize szAvailable)
 {
     UiSize fixedSize;
@@ -52,6 +52,7 @@ public:
     virtual UiSize EstimateText(UiSize szAvailable) override;
     virtual UiSize64 CalcRequiredSize(const UiRect& rc, bool bEstimateOnly) override;
     virtual void OnScrollOffsetChanged(const UiSize& oldScrollOffset, const UiSize& newScrollOffset) override;
+    virtual void GetMemoryStat(WindowMemoryStat& stat) const override;
 
 public:
     /** 设置控件的文本, 会触发文本变化事件
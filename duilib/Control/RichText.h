@@ -45,6 +45,11 @@ public:
      */
     virtual UiSize EstimateText(UiSize szAvailable) override;
 
+    /** 统计控件自身占用的内存（包括绘制缓存）
+     *  @param [in,out] stat 窗口的内存统计数据
+     */
+    virtual void GetMemoryStat(WindowMemoryStat& stat) const override;
+
 public:
     /** 获取文字内边距
      */
@@ -252,6 +257,13 @@ UiSize RichTextT<T>::EstimateText(UiSize szAvailable)
     return m_impl->EstimateText(szAvailable);
 }
 
+template<typename T>
+void RichTextT<T>::GetMemoryStat(WindowMemoryStat& stat) const
+{
+    BaseClass::GetMemoryStat(stat);
+    m_impl->GetMemoryStat(stat);
+}
+
 template<typename T>
 void RichTextT<T>::PaintText(IRender* pRender)
 {
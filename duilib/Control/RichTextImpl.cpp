@@ -7,6 +7,7 @@
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/AttributeUtil.h"
 #include "duilib/Core/Window.h"
+#include "duilib/Core/MemoryStat.h"
 
 namespace ui 
 {
@@ -163,6 +164,21 @@ void RichTextImpl::Redraw()
     }    
 }
 
+void RichTextImpl::GetMemoryStat(WindowMemoryStat& stat) const
+{
+    if (m_spDrawRichTextCache == nullptr) {
+        return;
+    }
+    IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactory != nullptr);
+    if (pRenderFactory == nullptr) {
+        return;
+    }
+    MemoryStatItem& item = stat.m_items[(size_t)MemoryCategory::kRichTextCache];
+    item.m_nBytes += pRenderFactory->GetDrawRichTextCacheBytes(*m_spDrawRichTextCache);
+    item.m_nCount += 1;
+}
+
 void RichTextImpl::Invalidate()
 {
     if (IsEnableRedraw()) {
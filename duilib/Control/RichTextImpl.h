@@ -197,6 +197,10 @@ public:
     */
     void Redraw();
 
+    /** 统计绘制缓存占用的内存，累加到窗口的内存统计数据中
+    */
+    void GetMemoryStat(WindowMemoryStat& stat) const;
+
     /** 重绘
     */
     void Invalidate();
@@ -443,7 +443,8 @@ bool TreeNode::AddChildNodeAt(TreeNode* pTreeNode, const size_t iIndex)
     //是否显示图标
     pTreeNode->SetEnableIcon(m_pTreeView->IsEnableIcon());
 
-    //添加到ListBox容器中
+    //添加到ListBox容器中（批量修改过程中，先更新延迟的子项索引号）
+    m_pTreeView->UpdateListBoxItemIndex();
     size_t nInsertIndex = GetDescendantNodeMaxListBoxIndex(iIndex);
     if (!Box::IsValidItemIndex(nInsertIndex)) {
         //第一个节点
@@ -981,6 +982,9 @@ bool TreeNode::RemoveSelf()
 
     //从ListBox中移除元素
     bool bRemoved = false;
+    if (m_pTreeView != nullptr) {
+        m_pTreeView->UpdateListBoxItemIndex();
+    }
     size_t nListBoxIndex = GetListBoxIndex();
     if (Box::IsValidItemIndex(nListBoxIndex)) {
         ASSERT(m_pTreeView->ListBox::GetItemAt(nListBoxIndex) == this);
@@ -1528,6 +1532,7 @@ bool TreeView::InsertControlBeforeNode(TreeNode* pTreeNode, Control* pControl)
         //不允许通过该接口添加树节点
         return false;
     }
+    UpdateListBoxItemIndex();
     size_t iIndex = pTreeNode->GetListBoxIndex();
     if (Box::IsValidItemIndex(iIndex)) {
         bAdded = ListBox::AddItemAt(pControl, iIndex);
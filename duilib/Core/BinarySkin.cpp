@@ -0,0 +1,482 @@
+#include "BinarySkin.h"
+#include "duilib/Core/WindowBuilder.h"
+#include "duilib/Utils/FileUtil.h"
+#include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/StringConvert.h"
+
+#include "duilib/third_party/xml/pugixml.hpp"
+#include <unordered_map>
+#include <string_view>
+#include <filesystem>
+
+namespace ui
+{
+/** 二进制皮肤文件的标识（"DUIB"）
+*/
+#define BINARY_SKIN_MAGIC           (0x42495544u)
+
+/** 二进制皮肤文件的版本号（文件格式发生变化时，需要增加版本号，使原有的二进制皮肤文件失效）
+*/
+#define BINARY_SKIN_VERSION         (1u)
+
+/** 二进制皮肤文件的扩展名（附加在XML文件名之后）
+*/
+#define BINARY_SKIN_FILE_EXT        _T(".bin")
+
+/** 二进制皮肤文件的文件头（所有整数均为小端字节序）
+*   文件头之后依次为：
+*   1. 字符串表：m_nStringCount个(偏移, 长度)，之后为m_nStringDataLen字节的字符串数据（UTF8编码）
+*   2. 节点树：按先序遍历保存的m_nNodeCount个节点，每个节点为(类型, 名称或值, 属性个数, 子节点个数)，
+*      之后为属性个数个(属性名称, 属性值)，第一个节点为文档节点
+*   3. 图片资源索引：m_nImageCount个图片属性值，m_nClassCount个class属性值
+*   节点名称、属性名称和属性值，均保存为字符串表中的序号
+*/
+struct TBinarySkinHeader
+{
+    uint32_t m_nMagic;              //文件标识
+    uint32_t m_nVersion;            //版本号
+    uint32_t m_nStringCount;        //字符串个数
+    uint32_t m_nStringDataLen;      //字符串数据的长度（字节）
+    uint32_t m_nNodeCount;          //节点个数
+    uint32_t m_nImageCount;         //图片属性值的个数
+    uint32_t m_nClassCount;         //class属性值的个数
+    uint32_t m_nReserved;           //保留字段
+};
+static_assert(sizeof(TBinarySkinHeader) == 32, "TBinarySkinHeader size error!");
+
+/** 节点类型
+*/
+enum TBinarySkinNodeType : uint32_t
+{
+    kBinarySkinNodeDocument = 0,    //文档节点
+    kBinarySkinNodeElement  = 1,    //元素节点
+    kBinarySkinNodePcdata   = 2,    //文本节点
+    kBinarySkinNodeCdata    = 3     //CDATA节点
+};
+
+/** 二进制皮肤数据的写入器
+*/
+class BinarySkinWriter
+{
+public:
+    /** 添加字符串，返回字符串在字符串表中的序号（相同的字符串只保存一份）
+    */
+    uint32_t AddString(const pugi::char_t* str)
+    {
+#ifdef PUGIXML_WCHAR_MODE
+        std::string utf8 = StringConvert::WStringToUTF8(str);
+#else
+        std::string utf8 = str;
+#endif
+        auto iter = m_stringMap.find(utf8);
+        if (iter != m_stringMap.end()) {
+            return iter->second;
+        }
+        uint32_t nIndex = (uint32_t)m_strings.size();
+        m_stringMap[utf8] = nIndex;
+        m_strings.push_back(std::move(utf8));
+        return nIndex;
+    }
+
+    /** 添加节点（包含子节点）
+    */
+    void AddNode(const pugi::xml_node& xmlNode, BinarySkinImageIndex& imageIndex)
+    {
+        uint32_t nodeType = kBinarySkinNodeElement;
+        uint32_t nNameOrValue = 0;
+        if (xmlNode.type() == pugi::node_document) {
+            nodeType = kBinarySkinNodeDocument;
+        }
+        else if (xmlNode.type() == pugi::node_element) {
+            nNameOrValue = AddString(xmlNode.name());
+        }
+        else {
+            nodeType = (xmlNode.type() == pugi::node_cdata) ? kBinarySkinNodeCdata : kBinarySkinNodePcdata;
+            nNameOrValue = AddString(xmlNode.value());
+        }
+        std::vector<pugi::xml_node> childNodes;
+        for (pugi::xml_node node : xmlNode.children()) {
+            if ((node.type() == pugi::node_element) ||
+                (node.type() == pugi::node_pcdata) ||
+                (node.type() == pugi::node_cdata)) {
+                childNodes.push_back(node);
+            }
+        }
+        std::vector<uint32_t> attributes;
+        for (pugi::xml_attribute attr : xmlNode.attributes()) {
+            attributes.push_back(AddString(attr.name()));
+            attributes.push_back(AddString(attr.value()));
+
+            DString strName = attr.name();
+            DString strValue = attr.value();
+            if (strName == _T("class")) {
+                if (!strValue.empty()) {
+                    imageIndex.m_classList.push_back(strValue);
+                }
+            }
+            else if (WindowBuilder::IsImageAttribute(strName, strValue)) {
+                imageIndex.m_imageStrings.push_back(strValue);
+            }
+        }
+        m_nodes.push_back(nodeType);
+        m_nodes.push_back(nNameOrValue);
+        m_nodes.push_back((uint32_t)attributes.size() / 2);
+        m_nodes.push_back((uint32_t)childNodes.size());
+        m_nodes.insert(m_nodes.end(), attributes.begin(), attributes.end());
+        ++m_nNodeCount;
+        for (const pugi::xml_node& node : childNodes) {
+            AddNode(node, imageIndex);
+        }
+    }
+
+    /** 生成二进制皮肤数据
+    */
+    void Write(const BinarySkinImageIndex& imageIndex, std::vector<uint8_t>& binData)
+    {
+        std::vector<uint32_t> imageStrings;
+        for (const DString& str : imageIndex.m_imageStrings) {
+            imageStrings.push_back(AddString(str.c_str()));
+        }
+        for (const DString& str : imageIndex.m_classList) {
+            imageStrings.push_back(AddString(str.c_str()));
+        }
+        uint32_t nStringDataLen = 0;
+        for (const std::string& str : m_strings) {
+            nStringDataLen += (uint32_t)str.size();
+        }
+
+        binData.clear();
+        WriteUInt32(binData, BINARY_SKIN_MAGIC);
+        WriteUInt32(binData, BINARY_SKIN_VERSION);
+        WriteUInt32(binData, (uint32_t)m_strings.size());
+        WriteUInt32(binData, nStringDataLen);
+        WriteUInt32(binData, m_nNodeCount);
+        WriteUInt32(binData, (uint32_t)imageIndex.m_imageStrings.size());
+        WriteUInt32(binData, (uint32_t)imageIndex.m_classList.size());
+        WriteUInt32(binData, 0);
+
+        uint32_t nOffset = 0;
+        for (const std::string& str : m_strings) {
+            WriteUInt32(binData, nOffset);
+            WriteUInt32(binData, (uint32_t)str.size());
+            nOffset += (uint32_t)str.size();
+        }
+        for (const std::string& str : m_strings) {
+            binData.insert(binData.end(), str.begin(), str.end());
+        }
+        for (uint32_t nValue : m_nodes) {
+            WriteUInt32(binData, nValue);
+        }
+        for (uint32_t nValue : imageStrings) {
+            WriteUInt32(binData, nValue);
+        }
+    }
+
+private:
+    static void WriteUInt32(std::vector<uint8_t>& binData, uint32_t nValue)
+    {
+        binData.push_back((uint8_t)(nValue & 0xFF));
+        binData.push_back((uint8_t)((nValue >> 8) & 0xFF));
+        binData.push_back((uint8_t)((nValue >> 16) & 0xFF));
+        binData.push_back((uint8_t)((nValue >> 24) & 0xFF));
+    }
+
+private:
+    //字符串表
+    std::vector<std::string> m_strings;
+    std::unordered_map<std::string, uint32_t> m_stringMap;
+
+    //节点数据
+    std::vector<uint32_t> m_nodes;
+    uint32_t m_nNodeCount = 0;
+};
+
+/** 二进制皮肤数据的读取器（所有读取操作均检查数据边界）
+*/
+class BinarySkinReader
+{
+public:
+    BinarySkinReader(const uint8_t* data, size_t nDataLen):
+        m_data(data),
+        m_nDataLen(nDataLen),
+        m_nPos(0)
+    {
+    }
+
+    bool ReadUInt32(uint32_t& nValue)
+    {
+        if ((m_data == nullptr) || (m_nPos > m_nDataLen) || (m_nDataLen - m_nPos < 4)) {
+            return false;
+        }
+        const uint8_t* p = m_data + m_nPos;
+        nValue = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+        m_nPos += 4;
+        return true;
+    }
+
+    /** 读取一段数据（返回数据的起始地址）
+    */
+    const uint8_t* ReadData(size_t nLen)
+    {
+        if ((m_data == nullptr) || (m_nPos > m_nDataLen) || (m_nDataLen - m_nPos < nLen)) {
+            return nullptr;
+        }
+        const uint8_t* p = m_data + m_nPos;
+        m_nPos += nLen;
+        return p;
+    }
+
+    bool IsEnd() const
+    {
+        return m_nPos == m_nDataLen;
+    }
+
+private:
+    const uint8_t* m_data;
+    size_t m_nDataLen;
+    size_t m_nPos;
+};
+
+/** 读取文件头
+*/
+static bool ReadBinarySkinHeader(BinarySkinReader& reader, TBinarySkinHeader& header)
+{
+    if (!reader.ReadUInt32(header.m_nMagic) || (header.m_nMagic != BINARY_SKIN_MAGIC)) {
+        return false;
+    }
+    if (!reader.ReadUInt32(header.m_nVersion) || (header.m_nVersion != BINARY_SKIN_VERSION)) {
+        return false;
+    }
+    return reader.ReadUInt32(header.m_nStringCount) &&
+           reader.ReadUInt32(header.m_nStringDataLen) &&
+           reader.ReadUInt32(header.m_nNodeCount) &&
+           reader.ReadUInt32(header.m_nImageCount) &&
+           reader.ReadUInt32(header.m_nClassCount) &&
+           reader.ReadUInt32(header.m_nReserved);
+}
+
+bool BinarySkin::CompileXmlData(const std::vector<uint8_t>& xmlData, std::vector<uint8_t>& binData)
+{
+    binData.clear();
+    if (xmlData.empty()) {
+        return false;
+    }
+    //解析选项与WindowBuilder::ParseXmlData函数保持一致
+    pugi::xml_document xml;
+    pugi::xml_parse_result result = xml.load_buffer(xmlData.data(), xmlData.size(),
+                                                    pugi::parse_default, pugi::xml_encoding::encoding_auto);
+    if (result.status != pugi::status_ok) {
+        return false;
+    }
+    return CompileXmlDocument(xml, binData);
+}
+
+bool BinarySkin::CompileXmlDocument(const pugi::xml_document& xml, std::vector<uint8_t>& binData)
+{
+    binData.clear();
+    if (xml.first_child().empty()) {
+        return false;
+    }
+    BinarySkinWriter writer;
+    BinarySkinImageIndex imageIndex;
+    writer.AddNode(xml, imageIndex);
+    writer.Write(imageIndex, binData);
+    return true;
+}
+
+bool BinarySkin::CompileXmlFile(const FilePath& xmlFilePath, const FilePath& binFilePath)
+{
+    std::vector<uint8_t> xmlData;
+    if (!FileUtil::ReadFileData(xmlFilePath, xmlData)) {
+        return false;
+    }
+    std::vector<uint8_t> binData;
+    if (!CompileXmlData(xmlData, binData)) {
+        return false;
+    }
+    return FileUtil::WriteFileData(binFilePath.IsEmpty() ? GetBinaryFilePath(xmlFilePath) : binFilePath, binData);
+}
+
+uint32_t BinarySkin::CompileDirectory(const FilePath& skinPath)
+{
+    if (skinPath.IsEmpty()) {
+        return 0;
+    }
+#ifdef DUILIB_BUILD_FOR_WIN
+    std::filesystem::path rootPath(skinPath.ToStringW());
+#else
+    std::filesystem::path rootPath(skinPath.ToStringA());
+#endif
+    std::vector<FilePath> xmlFiles;
+    std::error_code ec;
+    std::filesystem::recursive_directory_iterator iter(rootPath, ec);
+    for (; !ec && (iter != std::filesystem::recursive_directory_iterator()); iter.increment(ec)) {
+        std::error_code ecFile;
+        if (!iter->is_regular_file(ecFile)) {
+            continue;
+        }
+        FilePath filePath(iter->path().native());
+        if (StringUtil::IsEqualNoCase(_T(".xml"), filePath.GetFileExtension())) {
+            xmlFiles.push_back(filePath);
+        }
+    }
+    uint32_t nCompiledCount = 0;
+    for (const FilePath& xmlFilePath : xmlFiles) {
+        if (CompileXmlFile(xmlFilePath)) {
+            ++nCompiledCount;
+        }
+    }
+    return nCompiledCount;
+}
+
+FilePath BinarySkin::GetBinaryFilePath(const FilePath& xmlFilePath)
+{
+    if (xmlFilePath.IsEmpty()) {
+        return FilePath();
+    }
+    return FilePath(xmlFilePath.ToString() + BINARY_SKIN_FILE_EXT);
+}
+
+bool BinarySkin::IsBinarySkinData(const uint8_t* data, size_t nDataLen)
+{
+    BinarySkinReader reader(data, nDataLen);
+    TBinarySkinHeader header;
+    return ReadBinarySkinHeader(reader, header);
+}
+
+bool BinarySkin::LoadXmlDocument(const uint8_t* data, size_t nDataLen,
+                                 pugi::xml_document& xml, BinarySkinImageIndex* pImageIndex)
+{
+    xml.reset();
+    BinarySkinReader reader(data, nDataLen);
+    TBinarySkinHeader header;
+    if (!ReadBinarySkinHeader(reader, header) || (header.m_nNodeCount == 0)) {
+        return false;
+    }
+
+    //字符串表：每个字符串只转换一次
+    typedef std::basic_string_view<pugi::char_t> StringView;
+    std::vector<uint32_t> stringOffsets;
+    std::vector<uint32_t> stringLengths;
+    if (header.m_nStringCount > nDataLen / 8) {
+        return false;
+    }
+    stringOffsets.resize(header.m_nStringCount);
+    stringLengths.resize(header.m_nStringCount);
+    for (uint32_t i = 0; i < header.m_nStringCount; ++i) {
+        if (!reader.ReadUInt32(stringOffsets[i]) || !reader.ReadUInt32(stringLengths[i])) {
+            return false;
+        }
+        if ((stringOffsets[i] > header.m_nStringDataLen) ||
+            (stringLengths[i] > header.m_nStringDataLen - stringOffsets[i])) {
+            return false;
+        }
+    }
+    const uint8_t* pStringData = reader.ReadData(header.m_nStringDataLen);
+    if (pStringData == nullptr) {
+        return false;
+    }
+    std::vector<StringView> strings;
+    strings.resize(header.m_nStringCount);
+#ifdef PUGIXML_WCHAR_MODE
+    std::vector<DStringW> stringBuffers;
+    stringBuffers.resize(header.m_nStringCount);
+    for (uint32_t i = 0; i < header.m_nStringCount; ++i) {
+        stringBuffers[i] = StringConvert::UTF8ToWString(std::string((const char*)pStringData + stringOffsets[i],
+                                                                     stringLengths[i]));
+        strings[i] = StringView(stringBuffers[i].c_str(), stringBuffers[i].size());
+    }
+#else
+    for (uint32_t i = 0; i < header.m_nStringCount; ++i) {
+        strings[i] = StringView((const char*)pStringData + stringOffsets[i], stringLengths[i]);
+    }
+#endif
+
+    //节点树：按先序遍历顺序重建
+    struct TParentNode
+    {
+        pugi::xml_node m_node;
+        uint32_t m_nChildCount;
+    };
+    std::vector<TParentNode> parentNodes;
+    for (uint32_t nNode = 0; nNode < header.m_nNodeCount; ++nNode) {
+        uint32_t nodeType = 0;
+        uint32_t nNameOrValue = 0;
+        uint32_t nAttrCount = 0;
+        uint32_t nChildCount = 0;
+        if (!reader.ReadUInt32(nodeType) || !reader.ReadUInt32(nNameOrValue) ||
+            !reader.ReadUInt32(nAttrCount) || !reader.ReadUInt32(nChildCount)) {
+            return false;
+        }
+        pugi::xml_node xmlNode;
+        if (nNode == 0) {
+            if ((nodeType != kBinarySkinNodeDocument) || (nAttrCount != 0)) {
+                return false;
+            }
+            xmlNode = xml;
+        }
+        else {
+            while (!parentNodes.empty() && (parentNodes.back().m_nChildCount == 0)) {
+                parentNodes.pop_back();
+            }
+            if (parentNodes.empty() || (nNameOrValue >= strings.size())) {
+                return false;
+            }
+            --parentNodes.back().m_nChildCount;
+            pugi::xml_node parentNode = parentNodes.back().m_node;
+            const StringView& str = strings[nNameOrValue];
+            if (nodeType == kBinarySkinNodeElement) {
+                xmlNode = parentNode.append_child(pugi::node_element);
+                xmlNode.set_name(str.data(), str.size());
+            }
+            else if ((nodeType == kBinarySkinNodePcdata) || (nodeType == kBinarySkinNodeCdata)) {
+                if ((nAttrCount != 0) || (nChildCount != 0)) {
+                    return false;
+                }
+                xmlNode = parentNode.append_child((nodeType == kBinarySkinNodeCdata) ? pugi::node_cdata : pugi::node_pcdata);
+                xmlNode.set_value(str.data(), str.size());
+            }
+            else {
+                return false;
+            }
+        }
+        for (uint32_t nAttr = 0; nAttr < nAttrCount; ++nAttr) {
+            uint32_t nName = 0;
+            uint32_t nValue = 0;
+            if (!reader.ReadUInt32(nName) || !reader.ReadUInt32(nValue) ||
+                (nName >= strings.size()) || (nValue >= strings.size())) {
+                return false;
+            }
+            pugi::xml_attribute attr = xmlNode.append_attribute(PUGIXML_TEXT(""));
+            attr.set_name(strings[nName].data(), strings[nName].size());
+            attr.set_value(strings[nValue].data(), strings[nValue].size());
+        }
+        if (nChildCount > 0) {
+            parentNodes.push_back({ xmlNode, nChildCount });
+        }
+    }
+
+    //图片资源索引
+    const uint32_t nIndexCount = header.m_nImageCount + header.m_nClassCount;
+    if (nIndexCount < header.m_nImageCount) {
+        return false;
+    }
+    for (uint32_t nIndex = 0; nIndex < nIndexCount; ++nIndex) {
+        uint32_t nString = 0;
+        if (!reader.ReadUInt32(nString) || (nString >= strings.size())) {
+            return false;
+        }
+        if (pImageIndex != nullptr) {
+            DString str(strings[nString].data(), strings[nString].size());
+            if (nIndex < header.m_nImageCount) {
+                pImageIndex->m_imageStrings.push_back(std::move(str));
+            }
+            else {
+                pImageIndex->m_classList.push_back(std::move(str));
+            }
+        }
+    }
+    return reader.IsEnd() && !xml.first_child().empty();
+}
+
+} // namespace ui
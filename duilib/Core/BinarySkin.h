@@ -0,0 +1,84 @@
+#ifndef UI_CORE_BINARY_SKIN_H_
+#define UI_CORE_BINARY_SKIN_H_
+
+#include "duilib/Utils/FilePath.h"
+#include <vector>
+
+namespace pugi
+{
+    //XML 解析器相关定义
+    class xml_document;
+}
+
+namespace ui
+{
+/** 二进制皮肤文件中的图片资源索引（编译时收集，预加载图片时不再需要遍历XML文档）
+*/
+struct UILIB_API BinarySkinImageIndex
+{
+    /** 图片属性的属性值列表（判断规则与WindowBuilder::IsImageAttribute函数相同）
+    */
+    std::vector<DString> m_imageStrings;
+
+    /** class属性的属性值列表
+    */
+    std::vector<DString> m_classList;
+};
+
+/** 二进制皮肤文件：将XML皮肤文件预先编译为二进制格式（文件名为XML文件名加".bin"后缀，比如："main.xml.bin"），
+*   文件中包含字符串表（节点名称、属性名称和属性值去重后只保存一份，以序号引用）、预先解析的节点树和图片资源索引，
+*   加载时直接构建XML文档对象，不再进行XML文本的词法分析、转义字符和编码转换等处理，以加快程序启动速度；
+*   WindowBuilder::ParseXmlFile函数优先加载二进制皮肤文件，二进制皮肤文件不存在、比XML文件旧或者格式无效时，加载XML文件
+*/
+class UILIB_API BinarySkin
+{
+public:
+    /** 将XML文件数据编译为二进制皮肤数据
+    * @param [in] xmlData XML文件数据
+    * @param [out] binData 返回二进制皮肤数据
+    */
+    static bool CompileXmlData(const std::vector<uint8_t>& xmlData, std::vector<uint8_t>& binData);
+
+    /** 将XML文档对象编译为二进制皮肤数据
+    * @param [in] xml XML文档对象
+    * @param [out] binData 返回二进制皮肤数据
+    */
+    static bool CompileXmlDocument(const pugi::xml_document& xml, std::vector<uint8_t>& binData);
+
+    /** 将XML文件编译为二进制皮肤文件
+    * @param [in] xmlFilePath XML文件路径(绝对路径)
+    * @param [in] binFilePath 二进制皮肤文件路径(绝对路径)，为空时使用GetBinaryFilePath函数的返回值
+    */
+    static bool CompileXmlFile(const FilePath& xmlFilePath, const FilePath& binFilePath = FilePath());
+
+    /** 将目录中（包含子目录）的所有XML文件编译为二进制皮肤文件（用于发布程序前的离线编译，生成的文件与XML文件在同一个目录）
+    * @param [in] skinPath 皮肤目录(绝对路径)
+    * @return 返回编译成功的文件个数
+    */
+    static uint32_t CompileDirectory(const FilePath& skinPath);
+
+    /** 获取XML文件对应的二进制皮肤文件路径（XML文件名加".bin"后缀）
+    * @param [in] xmlFilePath XML文件路径
+    */
+    static FilePath GetBinaryFilePath(const FilePath& xmlFilePath);
+
+    /** 判断数据是否为二进制皮肤数据（只检查文件头）
+    * @param [in] data 数据
+    * @param [in] nDataLen 数据长度
+    */
+    static bool IsBinarySkinData(const uint8_t* data, size_t nDataLen);
+
+    /** 加载二进制皮肤数据，构建XML文档对象
+    * @param [in] data 二进制皮肤数据
+    * @param [in] nDataLen 数据长度
+    * @param [out] xml 返回XML文档对象
+    * @param [out] pImageIndex 如果不为nullptr，返回图片资源索引
+    * @return 数据格式无效时返回false
+    */
+    static bool LoadXmlDocument(const uint8_t* data, size_t nDataLen,
+                                pugi::xml_document& xml, BinarySkinImageIndex* pImageIndex);
+};
+
+} // namespace ui
+
+#endif // UI_CORE_BINARY_SKIN_H_
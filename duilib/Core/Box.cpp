@@ -10,8 +10,11 @@ Box::Box(Window* pWindow, Layout* pLayout) :
     m_bAutoDestroyChild(true),
     m_bMouseChildEnabled(true),
     m_items(),
+    m_bLayoutBoundary(false),
     m_nDropInId(0),
-    m_nDragOutId(0)
+    m_nDragOutId(0),
+    m_nUpdateCount(0),
+    m_bUpdateArrangePending(false)
 {
     ASSERT(m_pLayout != nullptr);
     if (m_pLayout) {
@@ -45,6 +48,9 @@ void Box::SetAttribute(const DString& strName, const DString& strValue)
     else if ((strName == _T("mouse_child")) || (strName == _T("mousechild"))) {
         SetMouseChildEnabled(strValue == _T("true"));
     }
+    else if (strName == _T("layout_boundary")) {
+        SetLayoutBoundary(strValue == _T("true"));
+    }
     else if (strName == _T("drag_out_id")) {
         uint8_t nValue = ui::TruncateToUInt8(StringUtil::StringToInt32(strValue));
         SetDragOutId(nValue);
@@ -428,7 +434,7 @@ bool Box::SetItemIndex(Control* pControl, size_t iIndex)
     }
     for (auto it = m_items.begin(); it != m_items.end(); ++it) {
         if( *it == pControl ) {
-            Arrange();            
+            ArrangeItems();
             m_items.erase(it);
             m_items.insert(m_items.begin() + iIndex, pControl);
             return true;
@@ -476,7 +482,7 @@ bool Box::DoAddItemAt(Control* pControl, size_t iIndex)
     //在添加到父容器以后，调用初始化函数
     pControl->Init();
     if (IsVisible()) {
-        Arrange();
+        ArrangeItems();
     }    
     return true;
 }
@@ -512,7 +518,7 @@ bool Box::DoRemoveItem(Control* pControl)
                     delete pControl;
                 }                
             }
-            Arrange();
+            ArrangeItems();
             return true;
         }
     }
@@ -529,10 +535,91 @@ void Box::RemoveAllItems()
         }
     }
     if (!items.empty()) {
-        Arrange();
+        ArrangeItems();
     }    
 }
 
+bool Box::AddItems(const std::vector<Control*>& items, size_t iIndex)
+{
+    ASSERT(iIndex <= GetItemCount());
+    if (iIndex > GetItemCount()) {
+        return false;
+    }
+    bool bRet = true;
+    BoxUpdateGuard updateGuard(this);
+    for (Control* pControl : items) {
+        //调用虚函数，子类的添加逻辑保持不变，布局重排等操作在批量修改结束时执行
+        if (AddItemAt(pControl, iIndex)) {
+            ++iIndex;
+        }
+        else {
+            bRet = false;
+        }
+    }
+    return bRet;
+}
+
+size_t Box::RemoveItems(size_t iIndex, size_t nCount)
+{
+    const size_t nItemCount = GetItemCount();
+    if ((iIndex >= nItemCount) || (nCount == 0)) {
+        return 0;
+    }
+    nCount = std::min(nCount, nItemCount - iIndex);
+    size_t nRemoved = 0;
+    BoxUpdateGuard updateGuard(this);
+    //从后向前移除，减少子控件列表中元素的移动
+    for (size_t i = iIndex + nCount; i > iIndex; --i) {
+        if (RemoveItemAt(i - 1)) {
+            ++nRemoved;
+        }
+    }
+    return nRemoved;
+}
+
+void Box::BeginUpdate()
+{
+    ASSERT(m_nUpdateCount < UINT16_MAX);
+    if (m_nUpdateCount < UINT16_MAX) {
+        ++m_nUpdateCount;
+    }
+}
+
+void Box::EndUpdate()
+{
+    ASSERT(m_nUpdateCount > 0);
+    if (m_nUpdateCount == 0) {
+        return;
+    }
+    --m_nUpdateCount;
+    if (m_nUpdateCount == 0) {
+        OnEndUpdate();
+    }
+}
+
+bool Box::IsUpdating() const
+{
+    return m_nUpdateCount > 0;
+}
+
+void Box::OnEndUpdate()
+{
+    if (m_bUpdateArrangePending) {
+        m_bUpdateArrangePending = false;
+        Arrange();
+    }
+}
+
+void Box::ArrangeItems()
+{
+    if (IsUpdating()) {
+        m_bUpdateArrangePending = true;
+    }
+    else {
+        Arrange();
+    }
+}
+
 Layout* Box::ResetLayout(Layout* pNewLayout)
 {
     ASSERT(pNewLayout != nullptr);
@@ -554,6 +641,16 @@ void Box::FreeLayout(Layout* pLayout)
     }
 }
 
+void Box::SetLayoutBoundary(bool bLayoutBoundary)
+{
+    m_bLayoutBoundary = bLayoutBoundary;
+}
+
+bool Box::IsLayoutBoundary() const
+{
+    return m_bLayoutBoundary;
+}
+
 void Box::ClearImageCache()
 {
     BaseClass::ClearImageCache();
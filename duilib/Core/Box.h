@@ -127,8 +127,37 @@ public:
      */
     virtual void RemoveAllItems();
 
+    /** 向指定位置批量添加控件（在一个批量修改过程中完成，布局重排等操作只执行一次）
+     * @param[in] items 控件指针列表
+     * @param[in] iIndex 插入的位置，有效范围：[0, GetItemCount()]
+     * @return 返回 true 为全部添加成功，false 为有添加失败的控件
+     */
+    virtual bool AddItems(const std::vector<Control*>& items, size_t iIndex);
+
+    /** 从指定位置开始批量移除控件（在一个批量修改过程中完成，布局重排等操作只执行一次）
+     * @param[in] iIndex 开始移除的控件索引
+     * @param[in] nCount 移除的控件个数（超出子控件总数的部分忽略）
+     * @return 返回实际移除的控件个数
+     */
+    virtual size_t RemoveItems(size_t iIndex, size_t nCount);
+
     /** @} */
 
+public:
+    /** 开始批量修改子控件（可嵌套调用，必须与EndUpdate配对调用，可使用BoxUpdateGuard辅助类）
+    *   在批量修改过程中，添加和移除子控件时不再每次都重排布局，子类中的索引号更新、选择事件等也延迟执行，
+    *   在最外层的EndUpdate调用时统一执行一次
+    */
+    void BeginUpdate();
+
+    /** 结束批量修改子控件（最外层的调用执行延迟的操作）
+    */
+    void EndUpdate();
+
+    /** 当前是否处于批量修改子控件的过程中
+    */
+    bool IsUpdating() const;
+
 public:
     /** 查找下一个可选控件的索引（面向 list、combo）
      * @param[in] iIndex 指定要起始查找的索引
@@ -186,6 +215,15 @@ public:
     */
     void FreeLayout(Layout* pLayout);
 
+    /** 设置是否为布局边界容器：子控件大小变化时，仅对该容器内部重新布局，不再向上级容器传递
+    *   (该容器自身的大小不随子控件的大小变化，一般用于固定大小的容器)
+    */
+    void SetLayoutBoundary(bool bLayoutBoundary);
+
+    /** 判断是否为布局边界容器
+    */
+    bool IsLayoutBoundary() const;
+
 public:
     /** 设置是否支持拖拽投放进入该容器: 如果不等于0，支持拖入，否则不支持拖入(从DragOutId==DropInId的容器拖入到该容器)
     */
@@ -224,6 +262,14 @@ protected:
     */
     virtual void OnSetEnabled(bool bChanged) override;
 
+    /** 批量修改子控件结束时（最外层的EndUpdate调用时）执行延迟的操作，子类可重写该函数
+    */
+    virtual void OnEndUpdate();
+
+    /** 子控件列表变化后，重排布局（批量修改过程中，延迟到批量修改结束时执行）
+    */
+    void ArrangeItems();
+
 private:
     /**@brief 向指定位置添加一个控件
      * @param[in] pControl 控件指针
@@ -251,11 +297,44 @@ private:
     //是否允许响应子控件的鼠标消息
     bool m_bMouseChildEnabled;
 
+    //是否为布局边界容器（子控件大小变化时，不再向上级容器传递布局重排）
+    bool m_bLayoutBoundary;
+
     //是否支持拖拽投放进入该容器: 如果不等于0，支持拖入，否则不支持拖入(从DragOutId==DropInId的容器拖入到该容器)
     uint8_t m_nDropInId;
 
     //是否支持拖拽拖出该容器：如果不等于0，支持拖出，否则不支持拖出（拖出到DropInId==DragOutId的容器）
     uint8_t m_nDragOutId;
+
+    //批量修改子控件的嵌套层数
+    uint16_t m_nUpdateCount;
+
+    //批量修改过程中，是否有延迟的布局重排
+    bool m_bUpdateArrangePending;
+};
+
+/** 批量修改容器子控件的辅助类：构造时调用BeginUpdate，析构时调用EndUpdate
+*/
+class BoxUpdateGuard
+{
+public:
+    explicit BoxUpdateGuard(Box* pBox):
+        m_pBox(pBox)
+    {
+        if (m_pBox != nullptr) {
+            m_pBox->BeginUpdate();
+        }
+    }
+    ~BoxUpdateGuard()
+    {
+        if (m_pBox != nullptr) {
+            m_pBox->EndUpdate();
+        }
+    }
+    BoxUpdateGuard(const BoxUpdateGuard&) = delete;
+    BoxUpdateGuard& operator = (const BoxUpdateGuard&) = delete;
+private:
+    Box* m_pBox;
 };
 
 } // namespace ui
@@ -6,6 +6,8 @@
 #include "duilib/Core/ColorManager.h"
 #include "duilib/Core/StateColorMap.h"
 #include "duilib/Core/StateColorMap2.h"
+#include "duilib/Core/MemoryStat.h"
+#include "duilib/Core/RenderSurfacePool.h"
 #include "duilib/Image/Image.h"
 #include "duilib/Render/IRender.h"
 #include "duilib/Render/AutoClip.h"
@@ -26,6 +28,16 @@
 
 namespace ui 
 {
+/** 获取离屏绘制缓存占用的内存（字节，每个像素4字节）
+*/
+static int64_t GetTempRenderBytes(const IRender* pRender)
+{
+    if (pRender == nullptr) {
+        return 0;
+    }
+    return (int64_t)pRender->GetWidth() * (int64_t)pRender->GetHeight() * 4;
+}
+
 Control::Control(Window* pWindow) :
     PlaceHolder(pWindow),
     m_bContextMenuUsed(false),
@@ -41,7 +53,8 @@ Control::Control(Window* pWindow) :
     m_bShowFocusRect(false),
     m_nPaintOrder(0),
     m_bBordersOnTop(true),
-    m_bMouseEnter(false)
+    m_bMouseEnter(false),
+    m_bKeepTempRender(false)
 {
 }
 
@@ -73,6 +86,7 @@ Control::~Control()
     m_pColorMap.reset();
     m_pColorData.reset();
     m_pBorderData.reset();
+    ReleaseTempRender();
 }
 
 DString Control::GetType() const { return DUI_CTR_CONTROL; }
@@ -477,6 +491,9 @@ void Control::SetAttribute(const DString& strName, const DString& strValue)
     else if (strName == _T("alpha")) {
         SetAlpha(ui::TruncateToUInt8(StringUtil::StringToInt32(strValue)));
     }
+    else if (strName == _T("keep_temp_render")) {
+        SetKeepTempRender(strValue == _T("true"));
+    }
     else if ((strName == _T("normal_image")) || (strName == _T("normalimage"))) {
         SetStateImage(kControlStateNormal, strValue);
     }
@@ -873,6 +890,9 @@ void Control::SetFadeHot(bool bFadeHot)
         pAnimationPlayer->SetAnimationType(AnimationType::kAnimationHot);
         pAnimationPlayer->SetStartValue(0);
         pAnimationPlayer->SetEndValue(255);
+        if (GetWindow() != nullptr) {
+            pAnimationPlayer->SetAnimationClock(GetWindow()->GetAnimationClock());
+        }
         ControlPtr pControl(this);
 
         AnimationPlayCallback playCallback = [pControl](int32_t nNewValue) {
@@ -1032,7 +1052,7 @@ void Control::SetBkColor(const DString& strColor)
     if (m_pColorData->m_strBkColor == strColor) {
         return;
     }
-    m_pColorData->m_strBkColor = strColor;
+    m_pColorData->m_strBkColor = UiString::Intern(strColor);
     Invalidate();
 }
 
@@ -1055,7 +1075,7 @@ void Control::SetBkColor2(const DString& strColor)
     if (m_pColorData->m_strBkColor2 == strColor) {
         return;
     }
-    m_pColorData->m_strBkColor2 = strColor;
+    m_pColorData->m_strBkColor2 = UiString::Intern(strColor);
     Invalidate();
 }
 
@@ -1133,7 +1153,7 @@ void Control::SetForeColor(const DString& strColor)
     if (m_pColorData->m_strForeColor == strColor) {
         return;
     }
-    m_pColorData->m_strForeColor = strColor;
+    m_pColorData->m_strForeColor = UiString::Intern(strColor);
     Invalidate();
 }
 
@@ -1608,7 +1628,7 @@ void Control::SetFocusBorderColor(const DString& strBorderColor)
         m_pBorderData = std::make_unique<TBorderData>();
     }
     if (m_pBorderData->m_focusBorderColor != strBorderColor) {
-        m_pBorderData->m_focusBorderColor = strBorderColor;
+        m_pBorderData->m_focusBorderColor = UiString::Intern(strBorderColor);
         Invalidate();
     }
 }
@@ -2091,7 +2111,7 @@ void Control::SetFocusRectColor(const DString& focusRectColor)
     if (m_pColorData->m_focusRectColor == focusRectColor) {
         return;
     }
-    m_pColorData->m_focusRectColor = focusRectColor;
+    m_pColorData->m_focusRectColor = UiString::Intern(focusRectColor);
     Invalidate();
 }
 
@@ -2307,6 +2327,15 @@ UiSize Control::EstimateText(UiSize /*szAvailable*/)
     return UiSize(0, 0);
 }
 
+bool Control::PrepareMeasureText(UiSize /*szAvailable*/, TextMeasureTask& /*task*/)
+{
+    return false;
+}
+
+void Control::SetMeasureTextResult(const TextMeasureTask& /*task*/)
+{
+}
+
 UiSize Control::EstimateImage(UiSize szAvailable, EstimateImageType estImageType)
 {
     UiSize imageSize;
@@ -3343,8 +3372,14 @@ bool Control::PaintImage(IRender* pRender,
         else if (newImageAttribute.m_bWindowShadowMode) {
             //阴影模式：不拉伸，避免四个角变形
             bImageStretch = false;
-        }        
-        pBitmap = duiImage.GetCurrentBitmap(bImageStretch, rcImageDect, rcSource, rcSourceCorners, &bDecodeError);
+        }
+        if ((pMatrix == nullptr) && !newImageAttribute.IsTiledDraw() && !newImageAttribute.m_bWindowShadowMode) {
+            //小图标按原大小绘制时，从共享的图集位图中绘制（同一图集的多个图标可合并绘制）
+            pBitmap = duiImage.GetAtlasBitmap(rcImageDect, rcSource, rcSourceCorners);
+        }
+        if (pBitmap == nullptr) {
+            pBitmap = duiImage.GetCurrentBitmap(bImageStretch, rcImageDect, rcSource, rcSourceCorners, &bDecodeError);
+        }
         if (pBitmap == nullptr) {
             if (!bDecodeError && duiImage.GetImageAttribute().m_bAsyncLoad) {
                 bDataPending = true;
@@ -3433,6 +3468,16 @@ void Control::SetPaintRect(const UiRect& rect)
     m_rcPaint = rect;
 }
 
+void Control::GetMemoryStat(WindowMemoryStat& stat) const
+{
+    stat.m_nControlCount += 1;
+    if (m_pTempRender != nullptr) {
+        MemoryStatItem& item = stat.m_items[(size_t)MemoryCategory::kTempRender];
+        item.m_nBytes += (uint64_t)GetTempRenderBytes(m_pTempRender.get());
+        item.m_nCount += 1;
+    }
+}
+
 std::unique_ptr<IRender> Control::CreateTempRender() const
 {
     std::unique_ptr<IRender> spTempRender;
@@ -3449,6 +3494,14 @@ std::unique_ptr<IRender> Control::CreateTempRender() const
     return spTempRender;
 }
 
+void Control::ReleaseTempRender()
+{
+    if (m_pTempRender != nullptr) {
+        MemoryStat::Add(MemoryCategory::kTempRender, -GetTempRenderBytes(m_pTempRender.get()), -1);
+        m_pTempRender.reset();
+    }
+}
+
 void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
 {
     ASSERT(pRender != nullptr);
@@ -3488,16 +3541,33 @@ void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
         //当设置了透明度时，该控件（若为容器则包含子控件）需要完整绘制
         UiRect rcPaintRect = GetRect();
         SetPaintRect(rcPaintRect);
-        if (m_pTempRender == nullptr) {
+
+        //未设置保留离屏绘制缓存时，从窗口的缓存池中获取（大小不小于控件的大小），绘制完成后立即归还
+        RenderSurfacePool* pRenderSurfacePool = nullptr;
+        std::unique_ptr<IRender> spPoolRender;
+        if (!IsKeepTempRender() && (GetWindow() != nullptr)) {
+            pRenderSurfacePool = GetWindow()->GetRenderSurfacePool();
+        }
+        if (pRenderSurfacePool != nullptr) {
+            spPoolRender = pRenderSurfacePool->AcquireRender(GetRect().Width(), GetRect().Height());
+        }
+        else if (m_pTempRender == nullptr) {
             m_pTempRender = CreateTempRender();
+            if (m_pTempRender != nullptr) {
+                MemoryStat::Add(MemoryCategory::kTempRender, GetTempRenderBytes(m_pTempRender.get()), 1);
+            }
         }
-        IRender* pTempRender = m_pTempRender.get();
+        IRender* pTempRender = (spPoolRender != nullptr) ? spPoolRender.get() : m_pTempRender.get();
         ASSERT(pTempRender != nullptr);
         if (pTempRender == nullptr) {
             return;
         }
-        if ((pTempRender->GetWidth() != GetRect().Width()) || (pTempRender->GetHeight() != GetRect().Height())) {
-            if (!pTempRender->Resize(GetRect().Width(), GetRect().Height())) {
+        if ((spPoolRender == nullptr) &&
+            ((pTempRender->GetWidth() != GetRect().Width()) || (pTempRender->GetHeight() != GetRect().Height()))) {
+            const int64_t nOldBytes = GetTempRenderBytes(pTempRender);
+            const bool bResized = pTempRender->Resize(GetRect().Width(), GetRect().Height());
+            MemoryStat::Add(MemoryCategory::kTempRender, GetTempRenderBytes(pTempRender) - nOldBytes, 0);
+            if (!bResized) {
                 //存在错误，绘制失败
                 ASSERT(!"pTempRender->Resize failed!");
                 return;
@@ -3557,6 +3627,9 @@ void Control::AlphaPaint(IRender* pRender, const UiRect& rcPaint)
         }
         pRender->SetWindowOrg(ptOldOrg);//恢复视图原点
         UiRect::Intersect(m_rcPaint, rcPaint, GetRect()); //设置m_rcPaint的值
+        if (pRenderSurfacePool != nullptr) {
+            pRenderSurfacePool->ReleaseRender(spPoolRender);
+        }
     }
     else {
         //本控件未设置透明度，不使用缓存绘制，直接在目标render上绘制本控件（若为容器，则也包含子控件）        
@@ -4146,6 +4219,14 @@ void Control::SetHotAlpha(uint8_t nHotAlpha)
     }
 }
 
+void Control::SetKeepTempRender(bool bKeepTempRender)
+{
+    m_bKeepTempRender = bKeepTempRender;
+    if (!m_bKeepTempRender) {
+        ReleaseTempRender();
+    }
+}
+
 void Control::SetTabStop(bool enable)
 {
     m_bAllowTabstop = enable;
@@ -21,6 +21,8 @@ namespace ui
     class IRender;
     class IPath;
     class IFont;
+    struct TextMeasureTask;
+    struct WindowMemoryStat;
     class AutoClip;
     class ControlDropTarget_Windows;
     class ControlDropTarget_SDL;
@@ -544,6 +546,18 @@ public:
      */
     virtual UiSize EstimateText(UiSize szAvailable);
 
+    /** 准备文本评估任务（在UI线程中调用），用于在多个线程中并行评估大量控件的文本大小
+     *  @param [in] szAvailable 可用大小，与EstimateSize函数的参数相同
+     *  @param [out] task 返回文本评估任务，评估任务只使用task中的数据，可以在其他线程中执行
+     *  @return 如果控件需要重新估算大小，并且文本可以在其他线程中评估，返回true
+     */
+    virtual bool PrepareMeasureText(UiSize szAvailable, TextMeasureTask& task);
+
+    /** 设置文本评估任务的结果（在UI线程中调用），结果缓存在控件中，下次调用EstimateText函数时使用
+     *  @param [in] task 已完成的文本评估任务
+     */
+    virtual void SetMeasureTextResult(const TextMeasureTask& task);
+
     /** 计算图片区域大小（宽和高）
      *  @param [in] szAvailable 可用大小，不包含内边距，不包含外边距
      *  @param [in] estImageType 估算图片的类型
@@ -551,6 +565,11 @@ public:
      */
     virtual UiSize EstimateImage(UiSize szAvailable, EstimateImageType estImageType);
 
+    /** 统计控件自身占用的内存（不含子控件，由GlobalManager::GetMemorySnapshot函数调用），子类可重写，添加子类的数据占用的内存
+     *  @param [in,out] stat 窗口的内存统计数据，将本控件占用的内存累加到对应的分类中
+     */
+    virtual void GetMemoryStat(WindowMemoryStat& stat) const;
+
     /**
      * @brief 检查指定坐标是否在滚动条当前滚动位置的范围内
      * @param[in] point 具体坐标
@@ -682,6 +701,16 @@ public:
      */
     uint8_t GetHotAlpha() const { return m_nHotAlpha; }
 
+    /** 设置是否保留透明度绘制使用的离屏绘制缓存
+     * @param [in] bKeepTempRender true表示控件自己持有离屏绘制缓存（适用于长期设置透明度且频繁绘制的控件）；
+     *             false表示每次绘制时从窗口的离屏绘制缓存池中获取，绘制完成后立即归还（默认）
+     */
+    void SetKeepTempRender(bool bKeepTempRender);
+
+    /** 获取是否保留透明度绘制使用的离屏绘制缓存
+     */
+    bool IsKeepTempRender() const { return m_bKeepTempRender; }
+
     /**
      * @brief 设置是否接受TAB键切换焦点
      * @param[in] enable
@@ -1601,6 +1630,10 @@ private:
     */
     std::unique_ptr<IRender> CreateTempRender() const;
 
+    /** 释放控件持有的离屏绘制缓存
+    */
+    void ReleaseTempRender();
+
     /** 校验事件类型是否有效、是否匹配
     * @return 返回true表示校验通过，返回false表示校验未通过
     */
@@ -1801,7 +1834,7 @@ private:
     */
     std::unique_ptr<StateImageMap> m_pImageMap;
 
-    /** 绘制渲染引擎接口(控件自身，仅当设置透明度时使用)
+    /** 绘制渲染引擎接口(控件自身，仅当设置透明度并且保留离屏绘制缓存时使用)
     */
     std::unique_ptr<IRender> m_pTempRender;
 
@@ -1878,6 +1911,9 @@ private:
 
     //是否处于MouseEnter状态（用于触发事件的标志）
     bool m_bMouseEnter;
+
+    //是否保留透明度绘制使用的离屏绘制缓存
+    bool m_bKeepTempRender;
 };
 
 } // namespace ui
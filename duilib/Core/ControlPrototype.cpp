@@ -0,0 +1,24 @@
+#include "ControlPrototype.h"
+
+namespace ui 
+{
+
+ControlPrototype::ControlPrototype()
+{
+}
+
+ControlPrototype::~ControlPrototype()
+{
+}
+
+bool ControlPrototype::IsEmpty() const
+{
+    return m_nodes.empty();
+}
+
+uint32_t ControlPrototype::GetClassVersion() const
+{
+    return m_nClassVersion;
+}
+
+} // namespace ui
@@ -0,0 +1,111 @@
+#ifndef UI_CORE_CONTROL_PROTOTYPE_H_
+#define UI_CORE_CONTROL_PROTOTYPE_H_
+
+#include "duilib/Core/UiFixedInt.h"
+#include "duilib/Core/UiMargin.h"
+#include "duilib/Core/UiPadding.h"
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace ui 
+{
+/** 控件原型：由XML模板预先编译生成的节点树（由WindowBuilder::CreatePrototype函数创建）
+*   节点的控件类型、属性列表（class属性已展开为属性列表）、XML事件、Include包含的XML文件均已预先解析，
+*   常用属性（宽高、外边距、内边距、对齐方式等）的值也已预先解析为类型化的值，
+*   创建实例时不再遍历XML文档，也不再查找和解析Class的属性列表，适用于同一个模板需要重复创建大量实例的场景（比如列表项）
+*   注意：Include包含的XML文件按窗口的资源路径解析，原型只能用于资源路径相同的窗口
+*/
+class UILIB_API ControlPrototype
+{
+public:
+    ControlPrototype();
+    ~ControlPrototype();
+    ControlPrototype(const ControlPrototype&) = delete;
+    ControlPrototype& operator = (const ControlPrototype&) = delete;
+
+public:
+    /** 原型中是否没有控件节点
+    */
+    bool IsEmpty() const;
+
+    /** 获取编译原型时全局Class的版本号（见GlobalManager::GetClassVersion），版本号不同时原型需要重新编译
+    */
+    uint32_t GetClassVersion() const;
+
+private:
+    friend class WindowBuilder;
+
+    /** XML事件（XML节点为<Event>或者<BubbledEvent>）
+    */
+    struct TEventNode
+    {
+        bool m_bBubbled = false;    //是否为<BubbledEvent>
+        DString m_type;             //事件类型列表
+        DString m_receiver;         //事件接收者列表
+        DString m_applyAttribute;   //事件触发时，应用的属性列表
+    };
+
+    /** 预编译的属性类型
+    */
+    enum class TAttributeType : uint8_t
+    {
+        kString,        //未预编译的属性，创建控件时调用SetAttribute函数设置
+        kWidth,         //width
+        kHeight,        //height
+        kMargin,        //margin
+        kPadding,       //padding
+        kHorAlign,      //halign
+        kVerAlign,      //valign
+        kName,          //name
+        kVisible,       //visible
+        kEnabled,       //enabled
+        kMouseEnabled,  //mouse_enabled或者mouse
+        kFloat          //float
+    };
+
+    /** 控件的属性（常用属性的值已预先解析，创建控件时直接调用对应的设置函数，不再解析字符串）
+    */
+    struct TAttribute
+    {
+        TAttributeType m_type = TAttributeType::kString;
+        DString m_name;                     //属性名称
+        DString m_value;                    //属性值
+        UiFixedInt m_fixedInt;              //kWidth/kHeight: 宽度或者高度
+        bool m_bNeedDpiScale = true;        //kWidth/kHeight: 是否需要DPI缩放（百分比时不需要）
+        UiMargin m_rcMargin;                //kMargin: 外边距
+        UiPadding m_rcPadding;              //kPadding: 内边距
+        int8_t m_nAlignType = 0;            //kHorAlign/kVerAlign: HorAlignType或者VerAlignType的值
+        bool m_bValue = false;              //kVisible/kEnabled/kMouseEnabled/kFloat: 属性值
+    };
+
+    /** 控件节点
+    */
+    struct TControlNode
+    {
+        DString m_className;                                    //控件的类型名称
+        std::vector<TAttribute> m_attributes;                   //控件的属性列表（class属性已展开）
+        std::vector<TEventNode> m_events;                       //控件关联的XML事件
+        std::vector<TControlNode> m_children;                   //子控件节点
+    };
+
+    /** 根节点下的控件节点
+    */
+    std::vector<TControlNode> m_nodes;
+
+    /** XML中定义的窗口Class（名称，属性列表）
+    */
+    std::vector<std::pair<DString, DString>> m_windowClasses;
+
+    /** XML中定义的窗口TextColor（名称，颜色值）
+    */
+    std::vector<std::pair<DString, DString>> m_windowTextColors;
+
+    /** 编译原型时全局Class的版本号
+    */
+    uint32_t m_nClassVersion = 0;
+};
+
+} // namespace ui
+
+#endif // UI_CORE_CONTROL_PROTOTYPE_H_
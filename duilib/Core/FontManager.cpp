@@ -1,6 +1,7 @@
 #include "FontManager.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/DpiManager.h"
+#include "duilib/Core/MemoryStat.h"
 #include "duilib/Render/IRender.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/FilePathUtil.h"
@@ -193,6 +194,7 @@ IFont* FontManager::GetIFont(const DString& fontId, uint32_t nZoomPercent)
         return nullptr;
     }
     m_fontMap.insert(std::make_pair(dpiFontId, pFont));
+    MemoryStat::Add(MemoryCategory::kFont, 0, 1);
     return pFont;
 }
 
@@ -220,6 +222,7 @@ bool FontManager::RemoveFontId(const DString& fontId)
             }
             bDeleted = true;
             iter = m_fontMap.erase(iter);
+            MemoryStat::Add(MemoryCategory::kFont, 0, -1);
         }
         else {
             ++iter;
@@ -246,6 +249,7 @@ bool FontManager::RemoveIFont(const DString& fontId, uint32_t nZoomPercent)
             }
             bDeleted = true;
             m_fontMap.erase(iter);
+            MemoryStat::Add(MemoryCategory::kFont, 0, -1);
         }
     }
     return bDeleted;
@@ -259,6 +263,7 @@ void FontManager::RemoveAllFonts()
             delete pFont;
         }
     }
+    MemoryStat::Add(MemoryCategory::kFont, 0, -(int64_t)m_fontMap.size());
     m_fontMap.clear();
     m_defaultFontId.clear();
     m_fontIdMap.clear();
@@ -1,9 +1,11 @@
 #include "GlobalManager.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Utils/ParallelUtil.h"
 #include "duilib/Core/Window.h"
 #include "duilib/Core/Control.h"
 #include "duilib/Core/Box.h"
+#include "duilib/Core/RenderSurfacePool.h"
 
 //渲染引擎
 #include "duilib/RenderSkia/RenderFactory_Skia.h"
@@ -69,6 +71,7 @@ private:
 
 GlobalManager::GlobalManager():
     m_platformData(nullptr),
+    m_nClassVersion(0),
     m_bAnimationEnabled(true)
 {
 }
@@ -201,6 +204,9 @@ void GlobalManager::Shutdown()
     }
     m_threadList.clear();
 
+    //终止并行任务的工作线程
+    ParallelUtil::Shutdown();
+
     m_threadManager.Clear();
     m_timerManager.Clear();
     m_colorManager.Clear();    
@@ -220,6 +226,8 @@ void GlobalManager::Shutdown()
     m_languagePath.Clear();
     m_fontFilePath.Clear();
     m_builderMap.clear();
+    m_prototypeMap.clear();
+    WindowBuilder::ClearXmlDocumentCache();
     m_platformData = nullptr;
 
     //执行退出时清理资源的函数
@@ -755,6 +763,7 @@ void GlobalManager::AddClass(const DString& strClassName, const DString& strCont
     ASSERT(!strClassName.empty() && !strControlAttrList.empty());
     if (!strClassName.empty() && !strControlAttrList.empty()) {
         m_globalClass[strClassName] = strControlAttrList;
+        ++m_nClassVersion;
     }    
 }
 
@@ -772,6 +781,12 @@ void GlobalManager::RemoveAllClasss()
 {
     AssertUIThread();
     m_globalClass.clear();
+    ++m_nClassVersion;
+}
+
+uint32_t GlobalManager::GetClassVersion() const
+{
+    return m_nClassVersion;
 }
 
 ColorManager& GlobalManager::Color()
@@ -881,6 +896,8 @@ Box* GlobalManager::CreateBoxWithCache(Window* pWindow, const FilePath& strXmlPa
         }        
         if (pBox != nullptr) {
             m_builderMap[strXmlPath].reset(builder);
+            //编译为控件原型，后续直接使用原型创建
+            GetControlPrototype(pWindow, strXmlPath, *builder);
         }
         else {
             delete builder;
@@ -888,7 +905,14 @@ Box* GlobalManager::CreateBoxWithCache(Window* pWindow, const FilePath& strXmlPa
         }
     }
     else {
-        Control* pControl = it->second->CreateControls(pWindow, callback);
+        Control* pControl = nullptr;
+        std::shared_ptr<ControlPrototype> spPrototype = GetControlPrototype(pWindow, strXmlPath, *it->second);
+        if (spPrototype != nullptr) {
+            pControl = WindowBuilder::CreateControls(*spPrototype, pWindow, callback);
+        }
+        else {
+            pControl = it->second->CreateControls(pWindow, callback);
+        }
         ASSERT(pControl != nullptr);
         if (pControl != nullptr) {
             pBox = it->second->ToBox(pControl);
@@ -951,6 +975,8 @@ bool GlobalManager::FillBoxWithCache(Box* pUserDefinedBox, const FilePath& strXm
         }        
         if (pBox != nullptr) {
             m_builderMap[strXmlPath].reset(winBuilder);
+            //编译为控件原型，后续直接使用原型创建
+            GetControlPrototype(pWindow, strXmlPath, *winBuilder);
         }
         else {
             delete winBuilder;
@@ -958,7 +984,14 @@ bool GlobalManager::FillBoxWithCache(Box* pUserDefinedBox, const FilePath& strXm
         }
     }
     else {
-        Control* pControl = it->second->CreateControls(pWindow, callback, nullptr, pUserDefinedBox);
+        Control* pControl = nullptr;
+        std::shared_ptr<ControlPrototype> spPrototype = GetControlPrototype(pWindow, strXmlPath, *it->second);
+        if (spPrototype != nullptr) {
+            pControl = WindowBuilder::CreateControls(*spPrototype, pWindow, callback, nullptr, pUserDefinedBox);
+        }
+        else {
+            pControl = it->second->CreateControls(pWindow, callback, nullptr, pUserDefinedBox);
+        }
         ASSERT(pControl != nullptr);
         if (pControl != nullptr) {
             pBox = it->second->ToBox(pControl);
@@ -973,6 +1006,26 @@ bool GlobalManager::FillBoxWithCache(Box* pUserDefinedBox, const FilePath& strXm
     return (pBox != nullptr);
 }
 
+std::shared_ptr<ControlPrototype> GlobalManager::GetControlPrototype(Window* pWindow, const FilePath& strXmlPath,
+                                                                     const WindowBuilder& builder)
+{
+    ASSERT(pWindow != nullptr);
+    if (pWindow == nullptr) {
+        return nullptr;
+    }
+    std::pair<FilePath, FilePath> prototypeKey(strXmlPath, pWindow->GetResourcePath());
+    auto iter = m_prototypeMap.find(prototypeKey);
+    if (iter != m_prototypeMap.end()) {
+        if ((iter->second == nullptr) || (iter->second->GetClassVersion() == m_nClassVersion)) {
+            return iter->second;
+        }
+        //全局 Class 已变化，原型中展开的 Class 属性已过期，需要重新编译
+    }
+    std::shared_ptr<ControlPrototype> spPrototype = builder.CreatePrototype(pWindow);
+    m_prototypeMap[prototypeKey] = spPrototype;
+    return spPrototype;
+}
+
 Control* GlobalManager::CreateControl(const DString& strControlName)
 {
     Control* pControl = nullptr;
@@ -1072,4 +1125,50 @@ bool GlobalManager::IsAnimationEnabled() const
     return m_bAnimationEnabled;
 }
 
+/** 遍历控件树，统计控件占用的内存
+*/
+static void GetControlMemoryStat(const Control* pControl, WindowMemoryStat& stat)
+{
+    if (pControl == nullptr) {
+        return;
+    }
+    pControl->GetMemoryStat(stat);
+    const Box* pBox = dynamic_cast<const Box*>(pControl);
+    if (pBox != nullptr) {
+        const size_t nItemCount = pBox->GetItemCount();
+        for (size_t nItem = 0; nItem < nItemCount; ++nItem) {
+            GetControlMemoryStat(pBox->GetItemAt(nItem), stat);
+        }
+    }
+}
+
+void GlobalManager::GetMemorySnapshot(bool bWindowDetails, MemorySnapshot& snapshot)
+{
+    AssertUIThread();
+    snapshot.m_windows.clear();
+    //ListCtrl的数据存储不在增删数据时更新计数器，在此时按所有窗口的统计结果更新
+    MemoryStatItem listCtrlItem;
+    std::vector<WindowPtr> windowList = Windows().GetAllWindowList();
+    for (const WindowPtr& pWindow : windowList) {
+        if ((pWindow == nullptr) || pWindow->IsClosingWnd()) {
+            continue;
+        }
+        WindowMemoryStat windowStat;
+        windowStat.m_windowId = pWindow->GetWindowId();
+        windowStat.m_windowClassName = pWindow->GetWindowClassName();
+        GetControlMemoryStat(pWindow->GetRoot(), windowStat);
+        pWindow->GetRenderSurfacePool()->GetMemoryStat(windowStat);
+        const MemoryStatItem& item = windowStat.m_items[(size_t)MemoryCategory::kListCtrlData];
+        listCtrlItem.m_nBytes += item.m_nBytes;
+        listCtrlItem.m_nCount += item.m_nCount;
+        if (bWindowDetails) {
+            snapshot.m_windows.push_back(std::move(windowStat));
+        }
+    }
+    MemoryStat::Set(MemoryCategory::kListCtrlData, listCtrlItem.m_nBytes, listCtrlItem.m_nCount);
+    for (size_t index = 0; index < (size_t)MemoryCategory::kCount; ++index) {
+        snapshot.m_items[index] = MemoryStat::GetItem((MemoryCategory)index);
+    }
+}
+
 } // namespace ui
@@ -14,6 +14,7 @@
 #include "duilib/Core/CursorManager.h"
 #include "duilib/Core/IconManager.h"
 #include "duilib/Core/WindowManager.h"
+#include "duilib/Core/MemoryStat.h"
 #include "duilib/Image/ImageDecoderFactory.h"
 
 #include <string>
@@ -156,6 +157,10 @@ public:
      */
     void RemoveAllClasss();
 
+    /** 获取全局 Class 的版本号（每次添加或者删除全局 Class 时递增），用于判断控件原型是否需要重新编译
+    */
+    uint32_t GetClassVersion() const;
+
 public:
     /** 停止一个内部线程(内部默认启动kThreadWorker/kThreadImage1/kThreadImage2这3个线程，如果不需要可停止掉)
     */
@@ -278,6 +283,7 @@ public:
      *           如果是Window：可以包含与Window相似的窗口内公共资源定义（比如Class等），这些资源是窗口内有效，Window标签的属性不解析
      *           如果是其他名称，则无特殊逻辑
      *  2. CreateBoxWithCache和FillBoxWithCache：解析后XML文件解析结果会被缓存，适合XML文件被重复调用的场景，可以提高性能（节省XML解析的时间）
+     *     首次创建后，XML被编译为控件原型（见ControlPrototype），后续创建时不再遍历XML文档，也不再查找和解析Class的属性列表
      *  3. XML文件的第二级节点（上述XML文件中的Window节点下的节点）：需要是容器，不能是Control
      *  3. CreateBox/CreateBoxWithCache: 解析XML，创建并返回相应的二级容器节点（即XML中Window下的VBox节点）：
      *                                   上述XML文件中，是会创建VBox节点，函数返回的是VBox指针，包含了XML中VBox的属性
@@ -372,6 +378,13 @@ public:
     */
     bool IsAnimationEnabled() const;
 
+public:
+    /** 获取内存统计的快照（各个分类的内存占用、对象个数，以及每个窗口的内存占用），需要在UI线程中调用
+    * @param [in] bWindowDetails 是否在快照中保存每个窗口的内存占用（无论是否保存，都会遍历所有窗口的控件树）
+    * @param [out] snapshot 返回内存统计的快照，可通过 MemorySnapshot::ToJsonString 函数转换为JSON格式
+    */
+    void GetMemorySnapshot(bool bWindowDetails, MemorySnapshot& snapshot);
+
 private:
     /** 从缓存中删除所有图片
      */
@@ -388,6 +401,15 @@ private:
     FilePath FindExistsResFullPath(const FilePath& windowResPath, const FilePath& windowXmlPath,
                                    const FilePath& resPath, bool& bLocalPath, bool& bResPath);
 
+    /** 获取XML文件对应的控件原型，如果不存在或者已经过期（全局 Class 已变化），则使用XML解析结果编译生成
+    * @param [in] pWindow 关联的窗口，Include包含的XML文件按窗口的资源路径解析
+    * @param [in] strXmlPath XML 文件路径
+    * @param [in] builder XML文件的解析结果
+    * @return 返回控件原型，如果该XML不支持编译为原型，返回nullptr
+    */
+    std::shared_ptr<ControlPrototype> GetControlPrototype(Window* pWindow, const FilePath& strXmlPath,
+                                                          const WindowBuilder& builder);
+
 private:
     /** 资源加载失败的回调函数相关数据
     */
@@ -427,6 +449,11 @@ private:
     */
     std::map<FilePath, std::unique_ptr<WindowBuilder>> m_builderMap;
 
+    /** 控件原型，KEY是（XML文件路径，窗口的资源路径），VALUE是由XML编译生成的控件原型（创建控件时不再遍历XML文档，也不再解析Class）
+    *   由于Include包含的XML文件按窗口的资源路径解析，资源路径不同的窗口使用各自的原型；VALUE为nullptr表示该XML不支持编译为原型
+    */
+    std::map<std::pair<FilePath, FilePath>, std::shared_ptr<ControlPrototype>> m_prototypeMap;
+
     /** 控件创建函数，用于用户自定义控件的创建
     */
     std::vector<CreateControlCallback> m_pfnCreateControlCallbackList;
@@ -435,6 +462,10 @@ private:
     */
     std::map<DString, DString> m_globalClass;
 
+    /** 全局 Class 的版本号
+    */
+    uint32_t m_nClassVersion;
+
     /** 主线程ID
     */
     std::thread::id m_dwUiThreadId;
@@ -1,26 +1,63 @@
 #include "ImageManager.h"
 #include "duilib/Image/Image.h"
 #include "duilib/Image/ImageLoadParam.h"
+#include "duilib/Image/ImageDiskCache.h"
+#include "duilib/Image/ImageAtlas.h"
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/DpiManager.h"
+#include "duilib/Core/MemoryStat.h"
 #include "duilib/Core/Window.h"
 #include "duilib/Core/Control.h"
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/FileUtil.h"
 #include "duilib/Utils/FilePathUtil.h"
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
 
 #ifdef DUILIB_BUILD_FOR_WIN
     //#define OUTPUT_IMAGE_LOG 1
 #endif
 
+/** 等待预取图片完成解码的最长时间（毫秒），超时后不再等待，未完成的图片由控件按正常流程加载
+*/
+#define PREFETCH_IMAGE_WAIT_TIMEOUT_MS  3000
+
 namespace ui 
 {
+/** 预取图片的解码状态
+*/
+struct ImageManager::TPrefetchState
+{
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    size_t m_nPendingCount = 0; //子线程中尚未完成解码的图片个数
+};
+
+/** 一个预取的图片
+*/
+struct ImageManager::TPrefetchImage
+{
+    std::shared_ptr<IImage> m_pImageData;   //原图数据
+    DString m_imageKey;                     //原图数据的KEY
+    bool m_bDecodeExecuted = false;         //是否已经在子线程中执行解码
+    bool m_bTaskFinished = false;           //子线程中的解码任务是否已经结束（执行完成或者被丢弃，由TPrefetchState::m_mutex保护）
+    bool m_bMerged = false;                 //是否已经合并解码数据（仅在UI线程中访问）
+};
+
 ImageManager::ImageManager():
     m_bAutoMatchScaleImage(true),
     m_bImageAsyncLoad(true),
+    m_nRetainedBytes(0),
+    m_nRetainedBytesLimit(64 * 1024 * 1024),
+    m_nResidentBytes(0),
+    m_nCacheHitCount(0),
+    m_nCacheMissCount(0),
+    m_nCacheEvictCount(0),
     m_releaseImageCallback(nullptr)
 {
+    m_spImageAtlas = std::make_unique<ImageAtlas>();
 }
 
 ImageManager::~ImageManager()
@@ -38,6 +75,7 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const ImageLoadParam& loadPara
         if (spImageInfo != nullptr) {
             //从缓存中，找到有效图片资源，直接返回
             bImageDataFromCache = true;
+            ++m_nCacheHitCount;
             return spImageInfo;
         }
     }
@@ -90,70 +128,23 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const ImageLoadParam& loadPara
             if (!ImageUtil::IsSameImageScale(iterImageData->second.m_fImageSizeScale, fImageSizeScale)) {
                 //在动态切换DPI后，比例会发生变化，需要重新加载，不可共享原来加载的图片
                 m_imageDataMap.erase(iterImageData);
+                CancelReleaseImage(spImageData);
                 spImageData.reset();
             }
         }
     }
     bImageDataFromCache = spImageData != nullptr ? true : false; //标记是否从缓存中获取的ImageData共享图片资源
+    if (bImageDataFromCache) {
+        ++m_nCacheHitCount;
+    }
+    else {
+        ++m_nCacheMissCount;
+    }
     if (spImageData == nullptr) {
         //从内存数据加载图片
         ImageDecoderFactory& ImageDecoders = GlobalManager::Instance().ImageDecoders();
-        std::vector<uint8_t> fileData;
-        std::vector<uint8_t> fileHeaderData;
-        if (imageLoadPath.m_pathType != ImageLoadPathType::kVirtualPath) {
-            //实体图片文件，必须有图片数据用于解码图片
-            FilePath imageFilePath(imageFullPath);
-            if (isUseZip && !imageFilePath.IsAbsolutePath()) {
-                GlobalManager::Instance().Zip().GetZipData(imageFilePath, fileData);
-                ASSERT(!fileData.empty());
-                if (fileData.empty()) {
-                    //加载失败
-                    return nullptr;
-                }
-            }
-            else {
-                bool bReadFileData = true;//是否读取完整文件内容到内存（默认将图片文件的数据全部读取到内存，然后再加载并解码图片数据）
-                if (imageLoadPath.m_pathType == ImageLoadPathType::kLocalPath) {
-                    //本地文件（非程序的resources目录，可能存在较大的文件，比如几MB或者更大的文件）
-                    uint64_t nFileSize = imageFilePath.GetFileSize();
-                    if (nFileSize > 128 * 1024) {//128KB
-                        //大文件
-                        bReadFileData = false;
-                    }
-                }
-                if (bReadFileData) {
-                    //小文件/程序的resources目录文件等，读取文件全部数据
-                    FileUtil::ReadFileData(imageFilePath, fileData);
-                    if (loadParam.IsAssertEnabled()) {
-                        ASSERT(!fileData.empty());
-                    }                    
-                    if (fileData.empty()) {
-                        //加载失败
-                        return nullptr;
-                    }
-                }
-                else {
-                    //大文件，只读取文件头的部分数据，用作签名校验(读取4KB数据)
-                    FileUtil::ReadFileHeaderData(imageFilePath, 4 * 1024, fileHeaderData);
-                    if (loadParam.IsAssertEnabled()) {
-                        ASSERT(!fileHeaderData.empty());
-                    }
-                    if (fileHeaderData.empty()) {
-                        //加载失败
-                        return nullptr;
-                    }
-                }
-            }           
-        }
         ImageDecodeParam decodeParam;
         decodeParam.m_imageFilePath = imageFullPath;//前面的流程，当是本地文件时，已经确保文件存在
-        if (!fileData.empty()) {
-            decodeParam.m_pFileData = std::make_shared<std::vector<uint8_t>>();
-            decodeParam.m_pFileData->swap(fileData);
-        }
-        else if (!fileHeaderData.empty()) {
-            decodeParam.m_fileHeaderData.swap(fileHeaderData);
-        }
         if (nImageFileDpiScale == 100) {//针对DPI自适应的原图，不开启该项优化，避免计算原图大小时出现异常
             decodeParam.m_rcMaxDestRectSize = loadParam.GetMaxDestRectSize();
         }
@@ -167,8 +158,94 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const ImageLoadParam& loadPara
         decodeParam.m_bLoadAllFrames = true; //所有多帧图片相关参数
         decodeParam.m_bAssertEnabled = loadParam.IsAssertEnabled();       //加载图片失败时是否允许断言（一般只影响图片数据错误导致的问题）
 
-        //加载图片     
-        std::unique_ptr<IImage> pImageData = ImageDecoders.LoadImageData(decodeParam);
+        //皮肤资源图片，优先从磁盘缓存加载：按文件大小和修改时间（压缩包内为CRC32）查询，命中时无需读取和解码图片文件
+        const bool bSkinImage = (imageLoadPath.m_pathType == ImageLoadPathType::kLocalResPath) ||
+                                (imageLoadPath.m_pathType == ImageLoadPathType::kZipResPath);
+        std::unique_ptr<IImage> pImageData;
+        TPendingDiskCacheData diskCacheData;
+        if ((m_spImageDiskCache != nullptr) && bSkinImage) {
+            FilePath imageFilePath(imageFullPath);
+            uint64_t nFileSize = 0;
+            uint64_t nFileVersion = 0;
+            if (isUseZip && !imageFilePath.IsAbsolutePath()) {
+                uint32_t nCrc32 = 0;
+                if (GlobalManager::Instance().Zip().GetZipFileInfo(imageFilePath, nCrc32, nFileSize)) {
+                    nFileVersion = nCrc32;
+                }
+            }
+            else {
+                nFileSize = imageFilePath.GetFileSize();
+                nFileVersion = (uint64_t)imageFilePath.GetLastWriteTime();
+            }
+            if ((nFileSize > 0) && (nFileVersion != 0)) {
+                diskCacheData.m_cacheKey = ImageDiskCache::MakeCacheKey(imageFullPath, decodeParam);
+                diskCacheData.m_nSourceStamp = ImageDiskCache::MakeSourceStamp(nFileSize, nFileVersion);
+                pImageData = m_spImageDiskCache->LoadImageData(diskCacheData.m_cacheKey, diskCacheData.m_nSourceStamp, fImageSizeScale);
+                if (pImageData != nullptr) {
+                    //已经从缓存加载，不需要再写入缓存
+                    diskCacheData.m_cacheKey.clear();
+                }
+            }
+        }
+
+        //读取图片数据并解码
+        if (pImageData == nullptr) {
+            std::vector<uint8_t> fileData;
+            std::vector<uint8_t> fileHeaderData;
+            if (imageLoadPath.m_pathType != ImageLoadPathType::kVirtualPath) {
+                //实体图片文件，必须有图片数据用于解码图片
+                FilePath imageFilePath(imageFullPath);
+                if (isUseZip && !imageFilePath.IsAbsolutePath()) {
+                    GlobalManager::Instance().Zip().GetZipData(imageFilePath, fileData);
+                    ASSERT(!fileData.empty());
+                    if (fileData.empty()) {
+                        //加载失败
+                        return nullptr;
+                    }
+                }
+                else {
+                    bool bReadFileData = true;//是否读取完整文件内容到内存（默认将图片文件的数据全部读取到内存，然后再加载并解码图片数据）
+                    if (imageLoadPath.m_pathType == ImageLoadPathType::kLocalPath) {
+                        //本地文件（非程序的resources目录，可能存在较大的文件，比如几MB或者更大的文件）
+                        uint64_t nFileSize = imageFilePath.GetFileSize();
+                        if (nFileSize > 128 * 1024) {//128KB
+                            //大文件
+                            bReadFileData = false;
+                        }
+                    }
+                    if (bReadFileData) {
+                        //小文件/程序的resources目录文件等，读取文件全部数据
+                        FileUtil::ReadFileData(imageFilePath, fileData);
+                        if (loadParam.IsAssertEnabled()) {
+                            ASSERT(!fileData.empty());
+                        }                    
+                        if (fileData.empty()) {
+                            //加载失败
+                            return nullptr;
+                        }
+                    }
+                    else {
+                        //大文件，只读取文件头的部分数据，用作签名校验(读取4KB数据)
+                        FileUtil::ReadFileHeaderData(imageFilePath, 4 * 1024, fileHeaderData);
+                        if (loadParam.IsAssertEnabled()) {
+                            ASSERT(!fileHeaderData.empty());
+                        }
+                        if (fileHeaderData.empty()) {
+                            //加载失败
+                            return nullptr;
+                        }
+                    }
+                }           
+            }
+            if (!fileData.empty()) {
+                decodeParam.m_pFileData = std::make_shared<std::vector<uint8_t>>();
+                decodeParam.m_pFileData->swap(fileData);
+            }
+            else if (!fileHeaderData.empty()) {
+                decodeParam.m_fileHeaderData.swap(fileHeaderData);
+            }
+            pImageData = ImageDecoders.LoadImageData(decodeParam);
+        }
         bool bEnableAssert = true;
 #ifndef DUILIB_IMAGE_SUPPORT_LIB_PAG        
         if (pImageData == nullptr) {
@@ -196,7 +273,15 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const ImageLoadParam& loadPara
         //赋值, 添加到容器(替换删除函数)
         ASSERT(imageKey == imageFullPath);
         spImageData.reset(pImageData.release(), ImageManager::CallImageDataDestroy);//TODO：待验证，或许有平台兼容性问题
-        OnImageDataCreate(imageKey, spImageData, fImageSizeScale);        
+        OnImageDataCreate(imageKey, spImageData, fImageSizeScale, bSkinImage);
+
+        //写入磁盘缓存（如果图片在子线程中解码，则等解码完成后再写入）
+        if (!diskCacheData.m_cacheKey.empty()) {
+            if (!m_spImageDiskCache->StoreImageData(diskCacheData.m_cacheKey, diskCacheData.m_nSourceStamp, spImageData) &&
+                spImageData->IsAsyncDecodeEnabled() && !spImageData->IsAsyncDecodeFinished()) {
+                m_pendingDiskCacheMap[imageKey] = diskCacheData;
+            }
+        }
     }
     if (spImageData != nullptr) {
         std::shared_ptr<ImageInfo> imageInfo(new ImageInfo, &ImageManager::CallImageInfoDestroy);
@@ -208,7 +293,7 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const ImageLoadParam& loadPara
             OnImageInfoCreate(imageInfo);
 
             if (bImageDataFromCache) {
-                //如果是重用缓存中的ImageData数据，需要移除待删除队列的数据
+                //如果是重用缓存中的ImageData数据，需要移除保留队列中的数据
                 CancelReleaseImage(spImageData);
             }
             return imageInfo;
@@ -217,6 +302,156 @@ std::shared_ptr<ImageInfo> ImageManager::GetImage(const ImageLoadParam& loadPara
     return nullptr;
 }
 
+size_t ImageManager::PrefetchImages(const std::vector<ImageLoadParam>& loadParams)
+{
+    GlobalManager::Instance().AssertUIThread();
+    if (m_spPrefetchState == nullptr) {
+        m_spPrefetchState = std::make_shared<TPrefetchState>();
+    }
+    //可用的图片解码线程，按顺序轮流分配解码任务
+    ThreadManager& threadManager = GlobalManager::Instance().Thread();
+    std::vector<int32_t> threadIdentifiers;
+    if (threadManager.HasThread(ui::kThreadImage1)) {
+        threadIdentifiers.push_back(ui::kThreadImage1);
+    }
+    if (threadManager.HasThread(ui::kThreadImage2)) {
+        threadIdentifiers.push_back(ui::kThreadImage2);
+    }
+    if (threadIdentifiers.empty() && threadManager.HasThread(ui::kThreadWorker)) {
+        threadIdentifiers.push_back(ui::kThreadWorker);
+    }
+
+    size_t nPrefetchCount = 0;
+    size_t nNextThread = 0;
+    for (const ImageLoadParam& loadParam : loadParams) {
+        //读取图片文件，并添加到缓存中（ImageInfo对象释放后，原图数据放入保留队列）
+        bool bImageDataFromCache = false;
+        std::shared_ptr<ImageInfo> spImageInfo = GetImage(loadParam, bImageDataFromCache);
+        if ((spImageInfo == nullptr) || bImageDataFromCache) {
+            continue;
+        }
+        ++nPrefetchCount;
+        std::shared_ptr<IImage> pImageData = spImageInfo->GetImageData();
+        if ((pImageData == nullptr) ||
+            (pImageData->GetImageType() == ImageType::kImageAnimation) ||
+            !pImageData->IsAsyncDecodeEnabled() ||
+            pImageData->IsAsyncDecodeFinished() ||
+            (pImageData->GetAsyncDecodeTaskId() != 0)) {
+            //多帧图片只加载第一帧（其他帧在播放动画时解码），其他图片已经完成解码
+            continue;
+        }
+
+        std::shared_ptr<TPrefetchImage> spPrefetchImage = std::make_shared<TPrefetchImage>();
+        spPrefetchImage->m_pImageData = pImageData;
+        spPrefetchImage->m_imageKey = spImageInfo->GetImageKey();
+        pImageData.reset();
+
+        size_t nTaskId = 0;
+        if (!threadIdentifiers.empty()) {
+            std::shared_ptr<TPrefetchState> spPrefetchState = m_spPrefetchState;
+            {
+                std::lock_guard<std::mutex> threadGuard(spPrefetchState->m_mutex);
+                spPrefetchState->m_nPendingCount++;
+            }
+            //任务凭据：解码任务执行完成，或者任务被丢弃（比如线程退出，任务未执行）时释放，
+            //保证未完成的任务计数一定会减少（否则WaitPrefetchImages会一直等待），并通知UI线程合并数据
+            std::shared_ptr<void> spTaskTicket(nullptr, [spPrefetchImage, spPrefetchState](void*) {
+                    {
+                        std::lock_guard<std::mutex> threadGuard(spPrefetchState->m_mutex);
+                        ASSERT(spPrefetchState->m_nPendingCount > 0);
+                        spPrefetchState->m_nPendingCount--;
+                        spPrefetchImage->m_bTaskFinished = true;
+                    }
+                    spPrefetchState->m_cv.notify_all();
+                    //通知UI线程合并数据（确保原图数据在UI线程中释放）
+                    GlobalManager::Instance().Thread().PostTask(ui::kThreadUI, [spPrefetchImage]() {
+                            GlobalManager::Instance().Image().MergePrefetchImage(*spPrefetchImage);
+                        });
+                });
+            //解码函数，在子线程中执行
+            auto PrefetchImageFunction = [spPrefetchImage, spTaskTicket]() mutable {
+                    std::shared_ptr<IImage>& pDecodeImageData = spPrefetchImage->m_pImageData;
+                    auto IsAborted = [spPrefetchImage]() {
+                            //没有控件使用，并且已经从保留队列中淘汰
+                            return spPrefetchImage->m_pImageData.use_count() == 1;
+                        };
+                    if (!IsAborted() && !pDecodeImageData->IsAsyncDecodeFinished()) {
+                        spPrefetchImage->m_bDecodeExecuted = true;
+                        pDecodeImageData->AsyncDecode(0, IsAborted, nullptr);
+                    }
+                    spTaskTicket.reset();
+                };
+            spTaskTicket.reset();
+            const int32_t nThreadIdentifier = threadIdentifiers[nNextThread % threadIdentifiers.size()];
+            ++nNextThread;
+            nTaskId = threadManager.PostTask(nThreadIdentifier, std::move(PrefetchImageFunction));
+        }
+        if (nTaskId != 0) {
+            //控件加载该图片时，不再重复启动解码任务，解码完成后通过DelayPaintImage通知控件重绘
+            spPrefetchImage->m_pImageData->SetAsyncDecodeTaskId(nTaskId);
+            m_prefetchImages.push_back(spPrefetchImage);
+        }
+        else {
+            //没有可用的图片解码线程，在UI线程中解码
+            spPrefetchImage->m_bDecodeExecuted = true;
+            spPrefetchImage->m_pImageData->AsyncDecode(0, []() { return false; }, nullptr);
+            MergePrefetchImage(*spPrefetchImage);
+        }
+    }
+    return nPrefetchCount;
+}
+
+void ImageManager::WaitPrefetchImages()
+{
+    GlobalManager::Instance().AssertUIThread();
+    if (m_spPrefetchState == nullptr) {
+        return;
+    }
+    //等待子线程完成解码（限定最长等待时间，避免解码线程繁忙时界面长时间无响应）
+    std::vector<std::shared_ptr<TPrefetchImage>> prefetchImages;
+    {
+        std::unique_lock<std::mutex> threadGuard(m_spPrefetchState->m_mutex);
+        TPrefetchState* pPrefetchState = m_spPrefetchState.get();
+        pPrefetchState->m_cv.wait_for(threadGuard, std::chrono::milliseconds(PREFETCH_IMAGE_WAIT_TIMEOUT_MS), [pPrefetchState]() {
+                return pPrefetchState->m_nPendingCount == 0;
+            });
+        for (const std::shared_ptr<TPrefetchImage>& spPrefetchImage : m_prefetchImages) {
+            if (spPrefetchImage->m_bTaskFinished) {
+                prefetchImages.push_back(spPrefetchImage);
+            }
+        }
+    }
+    //已经完成解码的图片，直接合并数据（后续到达的通知不再重复处理）；未完成的图片，在其解码完成的通知中合并
+    for (const std::shared_ptr<TPrefetchImage>& spPrefetchImage : prefetchImages) {
+        MergePrefetchImage(*spPrefetchImage);
+    }
+}
+
+void ImageManager::MergePrefetchImage(TPrefetchImage& prefetchImage)
+{
+    GlobalManager::Instance().AssertUIThread();
+    if (prefetchImage.m_bMerged || (prefetchImage.m_pImageData == nullptr)) {
+        return;
+    }
+    prefetchImage.m_bMerged = true;
+    if (prefetchImage.m_bDecodeExecuted) {
+        prefetchImage.m_pImageData->MergeAsyncDecodeData();
+    }
+    prefetchImage.m_pImageData->SetAsyncDecodeTaskId(0);
+
+    //通知已经加载该图片的控件，重绘界面
+    DelayPaintImage(prefetchImage.m_imageKey);
+
+    //从正在解码的列表中移除（调用方持有该对象的引用）
+    auto iter = std::find_if(m_prefetchImages.begin(), m_prefetchImages.end(),
+                             [&prefetchImage](const std::shared_ptr<TPrefetchImage>& spPrefetchImage) {
+                                 return spPrefetchImage.get() == &prefetchImage;
+                             });
+    if (iter != m_prefetchImages.end()) {
+        m_prefetchImages.erase(iter);
+    }
+}
+
 void ImageManager::CallImageInfoDestroy(ImageInfo* pImageInfo)
 {
     ImageManager& imageManager = GlobalManager::Instance().Image();
@@ -266,11 +501,17 @@ void ImageManager::OnImageInfoDestroy(ImageInfo* pImageInfo)
     }
 }
 
-void ImageManager::OnImageDataCreate(const DString& imageKey, std::shared_ptr<IImage>& pImage, float fImageSizeScale)
+void ImageManager::OnImageDataCreate(const DString& imageKey, std::shared_ptr<IImage>& pImage, float fImageSizeScale, bool bSkinImage)
 {
     ASSERT(!imageKey.empty() && (pImage != nullptr));
     if (!imageKey.empty() && (pImage != nullptr)) {
         m_imageDataMap[imageKey] = TImageData(pImage, fImageSizeScale);
+
+        TImageDataInfo& imageDataInfo = m_imageDataInfoMap[pImage.get()];
+        imageDataInfo.m_nImageBytes = GetImageDataBytes(pImage.get());
+        imageDataInfo.m_bSkinImage = bSkinImage;
+        m_nResidentBytes += imageDataInfo.m_nImageBytes;
+        MemoryStat::Add(MemoryCategory::kImage, (int64_t)imageDataInfo.m_nImageBytes, 1);
 #ifdef OUTPUT_IMAGE_LOG
         DString log = _T("Created ImageData: ") + imageKey + _T("\n");
         ::OutputDebugString(log.c_str());
@@ -290,12 +531,22 @@ void ImageManager::OnImageDataDestroy(IImage* pImage)
                 DString log = _T("Removed ImageData: ") + iter->first + _T("\n");
                 ::OutputDebugString(log.c_str());
 #endif
+                if (!m_pendingDiskCacheMap.empty()) {
+                    m_pendingDiskCacheMap.erase(iter->first);
+                }
                 iter = m_imageDataMap.erase(iter);
             }
             else {
                 ++iter;
             }
         }
+        auto iterInfo = m_imageDataInfoMap.find(pImage);
+        if (iterInfo != m_imageDataInfoMap.end()) {
+            ASSERT(m_nResidentBytes >= iterInfo->second.m_nImageBytes);
+            m_nResidentBytes -= std::min(m_nResidentBytes, iterInfo->second.m_nImageBytes);
+            MemoryStat::Add(MemoryCategory::kImage, -(int64_t)iterInfo->second.m_nImageBytes, -1);
+            m_imageDataInfoMap.erase(iterInfo);
+        }
         delete pImage;
     }
 }
@@ -303,7 +554,14 @@ void ImageManager::OnImageDataDestroy(IImage* pImage)
 void ImageManager::RemoveAllImages()
 {
     m_imageDataMap.clear();
-    m_delayReleaseImageList.clear();
+    m_pendingDiskCacheMap.clear();
+    m_retainedImageIndex.clear();
+    m_nRetainedBytes = 0;
+    for (RetainedImageList& retainedImageList : m_retainedImageList) {
+        RetainedImageList imageList;
+        imageList.swap(retainedImageList);
+        imageList.clear();//可能触发OnImageDataDestroy回调，需要在成员变量更新完成后释放
+    }
     m_imageInfoMap.clear();
 }
 
@@ -312,56 +570,191 @@ void ImageManager::ReleaseImage(const std::shared_ptr<IImage>& pImageData, const
     //先移除队列中的元素，从而确保只有一个元素在队列中
     CancelReleaseImage(pImageData);
 
-    //通过回调函数，可以避免放入延迟释放队列
+    //通过回调函数，可以避免放入保留队列
     if (m_releaseImageCallback != nullptr) {
         bool bAllowRelease = m_releaseImageCallback(pImageData, imageFullPath);
         if (!bAllowRelease) {
             return;
         }
     }
+    if (pImageData == nullptr) {
+        return;
+    }
 
-    if (pImageData != nullptr) {
-        TReleaseImageData imageData;
-        imageData.m_pImage = pImageData;
-        imageData.m_releaseTime = std::chrono::steady_clock::now();
-        m_delayReleaseImageList.push_back(imageData);
+    size_t nImageBytes = 0;
+    bool bSkinImage = false;
+    auto iterInfo = m_imageDataInfoMap.find(pImageData.get());
+    if (iterInfo != m_imageDataInfoMap.end()) {
+        nImageBytes = iterInfo->second.m_nImageBytes;
+        bSkinImage = iterInfo->second.m_bSkinImage;
+    }
+    else {
+        nImageBytes = GetImageDataBytes(pImageData.get());
+    }
+    if (nImageBytes > m_nRetainedBytesLimit) {
+        //超出内存预算的大图，不保留
+        return;
     }
 
-    const int32_t nDelaySeconds = 35;
-    auto delayReleaseImage = []() {
-        ImageManager& imageManager = GlobalManager::Instance().Image();
-        auto nowTime = std::chrono::steady_clock::now();
-        auto iter = imageManager.m_delayReleaseImageList.begin();
-        while (iter != imageManager.m_delayReleaseImageList.end()) {
-            const TReleaseImageData& imageData = *iter;
-            //检查并释放图片资源(间隔：30秒，释放原图，以避免影响图片共享)
-            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(nowTime - imageData.m_releaseTime);
-            if (seconds.count() > (nDelaySeconds - 5)) {
-                iter = imageManager.m_delayReleaseImageList.erase(iter);
-            }
-            else {
-                ++iter;
-            }
-        }
-    };
-    GlobalManager::Instance().Thread().PostDelayedTask(ui::kThreadUI, delayReleaseImage, nDelaySeconds * 1000);
+    //放入保留队列的表头（最近使用）
+    const size_t nListIndex = bSkinImage ? 1 : 0;
+    RetainedImageList& retainedImageList = m_retainedImageList[nListIndex];
+    TRetainedImageData imageData;
+    imageData.m_pImage = pImageData;
+    imageData.m_nImageBytes = nImageBytes;
+    retainedImageList.push_front(imageData);
+    m_retainedImageIndex[pImageData.get()] = std::make_pair(nListIndex, retainedImageList.begin());
+    m_nRetainedBytes += nImageBytes;
+
+    //超出预算时，淘汰最久未使用的原图
+    EvictRetainedImages(m_nRetainedBytesLimit);
 }
 
 void ImageManager::CancelReleaseImage(const std::shared_ptr<IImage>& pImageData)
 {
-    if ((pImageData != nullptr) && !m_delayReleaseImageList.empty()) {
-        auto iter = m_delayReleaseImageList.begin();
-        while (iter != m_delayReleaseImageList.end()) {
-            const TReleaseImageData& imageData = *iter;
-            if (imageData.m_pImage == pImageData) {
-                iter = m_delayReleaseImageList.erase(iter);
-                break;
-            }
-            else {
-                ++iter;
-            }
+    if ((pImageData == nullptr) || m_retainedImageIndex.empty()) {
+        return;
+    }
+    auto iter = m_retainedImageIndex.find(pImageData.get());
+    if (iter != m_retainedImageIndex.end()) {
+        const size_t nListIndex = iter->second.first;
+        RetainedImageList::iterator iterImage = iter->second.second;
+        m_retainedImageIndex.erase(iter);
+        ASSERT(m_nRetainedBytes >= iterImage->m_nImageBytes);
+        m_nRetainedBytes -= std::min(m_nRetainedBytes, iterImage->m_nImageBytes);
+        //调用方持有pImageData，此处不会触发原图数据的销毁
+        m_retainedImageList[nListIndex].erase(iterImage);
+    }
+}
+
+void ImageManager::EvictRetainedImages(size_t nMaxBytes)
+{
+    //先淘汰用户内容图片，再淘汰皮肤资源图片，同一队列中从表尾（最久未使用）开始淘汰
+    for (RetainedImageList& retainedImageList : m_retainedImageList) {
+        while ((m_nRetainedBytes > nMaxBytes) && !retainedImageList.empty()) {
+            std::shared_ptr<IImage> spImageData = retainedImageList.back().m_pImage;
+            const size_t nImageBytes = retainedImageList.back().m_nImageBytes;
+            retainedImageList.pop_back();
+            m_retainedImageIndex.erase(spImageData.get());
+            ASSERT(m_nRetainedBytes >= nImageBytes);
+            m_nRetainedBytes -= std::min(m_nRetainedBytes, nImageBytes);
+            ++m_nCacheEvictCount;
+            //如无其他引用，在此处释放原图数据（触发OnImageDataDestroy回调）
+            spImageData.reset();
+        }
+    }
+}
+
+void ImageManager::TrimRetainedImages(size_t nMaxBytes)
+{
+    GlobalManager::Instance().AssertUIThread();
+    EvictRetainedImages(nMaxBytes);
+}
+
+void ImageManager::SetRetainedImageBytesLimit(size_t nMaxBytes)
+{
+    m_nRetainedBytesLimit = nMaxBytes;
+    EvictRetainedImages(m_nRetainedBytesLimit);
+}
+
+size_t ImageManager::GetRetainedImageBytesLimit() const
+{
+    return m_nRetainedBytesLimit;
+}
+
+ImageCacheStat ImageManager::GetImageCacheStat() const
+{
+    ImageCacheStat stat;
+    stat.m_nHitCount = m_nCacheHitCount;
+    stat.m_nMissCount = m_nCacheMissCount;
+    stat.m_nEvictCount = m_nCacheEvictCount;
+    stat.m_nResidentBytes = m_nResidentBytes;
+    stat.m_nRetainedBytes = m_nRetainedBytes;
+    stat.m_nRetainedCount = (uint32_t)m_retainedImageIndex.size();
+    return stat;
+}
+
+void ImageManager::ResetImageCacheStat()
+{
+    m_nCacheHitCount = 0;
+    m_nCacheMissCount = 0;
+    m_nCacheEvictCount = 0;
+}
+
+bool ImageManager::SetImageDiskCacheDir(const FilePath& cacheDir, uint64_t nMaxCacheBytes)
+{
+    GlobalManager::Instance().AssertUIThread();
+    m_pendingDiskCacheMap.clear();
+    if (cacheDir.IsEmpty()) {
+        m_spImageDiskCache.reset();
+        return true;
+    }
+    std::unique_ptr<ImageDiskCache> spImageDiskCache = std::make_unique<ImageDiskCache>();
+    if (!spImageDiskCache->SetCacheDirectory(cacheDir, nMaxCacheBytes)) {
+        return false;
+    }
+    m_spImageDiskCache.swap(spImageDiskCache);
+    return true;
+}
+
+FilePath ImageManager::GetImageDiskCacheDir() const
+{
+    if (m_spImageDiskCache != nullptr) {
+        return m_spImageDiskCache->GetCacheDirectory();
+    }
+    return FilePath();
+}
+
+void ImageManager::SetImageAtlasMaxSize(uint32_t nMaxImageSize)
+{
+    GlobalManager::Instance().AssertUIThread();
+    if (nMaxImageSize == 0) {
+        //关闭图集：已放入图集的图片，在绘制时自动改用独立的位图
+        m_spImageAtlas.reset();
+        return;
+    }
+    if (m_spImageAtlas == nullptr) {
+        m_spImageAtlas = std::make_unique<ImageAtlas>();
+    }
+    if (m_spImageAtlas->GetMaxImageSize() != nMaxImageSize) {
+        m_spImageAtlas->Clear();
+        m_spImageAtlas->SetMaxImageSize(nMaxImageSize);
+    }
+}
+
+uint32_t ImageManager::GetImageAtlasMaxSize() const
+{
+    if (m_spImageAtlas != nullptr) {
+        return m_spImageAtlas->GetMaxImageSize();
+    }
+    return 0;
+}
+
+ImageAtlas* ImageManager::GetImageAtlas() const
+{
+    return m_spImageAtlas.get();
+}
+
+size_t ImageManager::GetImageDataBytes(const IImage* pImage)
+{
+    if (pImage == nullptr) {
+        return 0;
+    }
+    const int32_t nWidth = pImage->GetWidth();
+    const int32_t nHeight = pImage->GetHeight();
+    if ((nWidth <= 0) || (nHeight <= 0)) {
+        return 0;
+    }
+    //按32位位图（每个像素4字节）计算
+    size_t nFrameBytes = (size_t)nWidth * (size_t)nHeight * sizeof(uint32_t);
+    size_t nFrameCount = 1;
+    if (pImage->GetImageType() == ImageType::kImageAnimation) {
+        std::shared_ptr<IAnimationImage> pAnimationImage = pImage->GetImageAnimation();
+        if ((pAnimationImage != nullptr) && (pAnimationImage->GetFrameCount() > 1)) {
+            nFrameCount = (size_t)pAnimationImage->GetFrameCount();
         }
     }
+    return nFrameBytes * nFrameCount;
 }
 
 void ImageManager::SetReleaseImageCallback(ReleaseImageCallback callback)
@@ -571,6 +964,24 @@ void ImageManager::DelayPaintImage(const DString& imageKey)
     if (imageKey.empty()) {
         return;
     }
+    if (!m_pendingDiskCacheMap.empty()) {
+        //子线程解码完成，写入磁盘缓存
+        auto iterPending = m_pendingDiskCacheMap.find(imageKey);
+        if (iterPending != m_pendingDiskCacheMap.end()) {
+            std::shared_ptr<IImage> spImageData;
+            auto iterImageData = m_imageDataMap.find(imageKey);
+            if (iterImageData != m_imageDataMap.end()) {
+                spImageData = iterImageData->second.m_pImage.lock();
+            }
+            if ((spImageData == nullptr) || (m_spImageDiskCache == nullptr)) {
+                m_pendingDiskCacheMap.erase(iterPending);
+            }
+            else if (m_spImageDiskCache->StoreImageData(iterPending->second.m_cacheKey, iterPending->second.m_nSourceStamp, spImageData) ||
+                     !spImageData->IsAsyncDecodeEnabled() || spImageData->IsAsyncDecodeFinished()) {
+                m_pendingDiskCacheMap.erase(iterPending);
+            }
+        }
+    }
     auto iter = m_delayPaintImageList.begin();
     while (iter != m_delayPaintImageList.end()) {
         if ((iter->m_pControl == nullptr) || (iter->m_pImage == nullptr) || (iter->m_imageKey == imageKey)) {
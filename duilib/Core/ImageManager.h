@@ -9,7 +9,6 @@
 #include <list>
 #include <unordered_map>
 #include <memory>
-#include <chrono>
 
 namespace ui 
 {
@@ -19,16 +18,50 @@ class DpiManager;
 class Window;
 class Control;
 class Image;
+class ImageDiskCache;
+class ImageAtlas;
 
 /** 延迟释放图片的回调函数类型
  * @param [in] pImageData 原图的图像数据接口
  * @param [in] imageFullPath 该图片的完整路径
- * @return 返回true表示允许放入延迟释放队列，返回false表示组织放入延迟释放队列
+ * @return 返回true表示允许放入保留队列，返回false表示阻止放入保留队列（立即释放）
  */
 using ReleaseImageCallback = std::function<bool (const std::shared_ptr<ui::IImage>& pImageData,
                                                  const DString& imageFullPath)>;
 
-/** 图片管理器（对于图片资源的释放：延迟释放，内部有个原图图片队列，如果需要立即释放图片，则需要ReleaseImageCallback回调函数阻止放入延迟释放队列）
+/** 图片缓存的统计信息
+*/
+struct UILIB_API ImageCacheStat
+{
+    //命中次数（从缓存中获取到图片数据，无需重新解码）
+    uint64_t m_nHitCount = 0;
+
+    //未命中次数（需要重新加载并解码图片）
+    uint64_t m_nMissCount = 0;
+
+    //因超出内存预算或者内存不足，从保留队列中淘汰的原图个数
+    uint64_t m_nEvictCount = 0;
+
+    //当前所有原图数据占用的内存（字节，按像素数据估算）
+    uint64_t m_nResidentBytes = 0;
+
+    //保留队列中（已无控件使用）原图数据占用的内存（字节）
+    uint64_t m_nRetainedBytes = 0;
+
+    //保留队列中的原图个数
+    uint32_t m_nRetainedCount = 0;
+
+    /** 获取命中率，取值范围：[0, 1]
+    */
+    double GetHitRate() const
+    {
+        const uint64_t nTotal = m_nHitCount + m_nMissCount;
+        return (nTotal > 0) ? ((double)m_nHitCount / (double)nTotal) : 0.0;
+    }
+};
+
+/** 图片管理器（对于图片资源的释放：无控件使用的原图放入按LRU规则管理的保留队列，队列占用的内存不超过预算值，
+*   超出预算时优先淘汰用户内容图片，再淘汰皮肤资源图片；如果需要立即释放图片，则需要ReleaseImageCallback回调函数阻止放入保留队列）
  */
 class UILIB_API ImageManager
 {
@@ -50,22 +83,82 @@ public:
      */
     void RemoveAllImages();
 
-    /** 从缓存中释放一个原图图片（延迟释放）
+    /** 从缓存中释放一个原图图片（放入保留队列，延迟释放）
     * @param [in] pImageData 原图的图像数据接口
     * @param [in] imageFullPath 该图片的完整路径
     */
     void ReleaseImage(const std::shared_ptr<IImage>& pImageData, const DString& imageFullPath);
 
-    /** 取消释放原图图片
+    /** 取消释放原图图片（从保留队列中移除）
     */
     void CancelReleaseImage(const std::shared_ptr<IImage>& pImageData);
 
-    /** 设置延迟释放图片的回调函数，可以用来阻止图片资源放入延迟释放队列，立即释放图片资源
+    /** 设置延迟释放图片的回调函数，可以用来阻止图片资源放入保留队列，立即释放图片资源
      *   备注：如果图片资源是在虚表的子项中使用，立即释放原图资源会导致性能降低，因为虚表的元素是每次刷新都重新填充
      * @param [in] callback 延迟释放图片的回调函数
      */
     void SetReleaseImageCallback(ReleaseImageCallback callback);
 
+    /** 预取图片（在窗口首次显示前预热图片缓存）：在UI线程中读取图片文件，并将原图数据添加到缓存中（放入保留队列，直到有控件使用），
+    *   然后由图片解码线程并行解码单帧图片的数据；控件加载这些图片时，可直接从缓存中获取原图数据
+    * @param [in] loadParams 图片的加载属性列表（需要设置图片的加载路径和加载的DPI缩放百分比）
+    * @return 返回新加载的图片个数（不含缓存中已有的图片）
+    */
+    size_t PrefetchImages(const std::vector<ImageLoadParam>& loadParams);
+
+    /** 等待预取的图片在子线程中解码完成，并合并解码数据
+    */
+    void WaitPrefetchImages();
+
+public:
+    /** 设置保留队列的内存预算（字节），超出预算时，按LRU规则淘汰原图（默认值为64MB）
+    * @param [in] nMaxBytes 内存预算，为0时表示不保留原图（无控件使用时立即释放）
+    */
+    void SetRetainedImageBytesLimit(size_t nMaxBytes);
+
+    /** 获取保留队列的内存预算（字节）
+    */
+    size_t GetRetainedImageBytesLimit() const;
+
+    /** 缩减保留队列，直到占用的内存不超过指定值（内存不足时调用）
+    * @param [in] nMaxBytes 保留队列可以占用的最大内存（字节），为0时表示释放保留队列中的所有原图
+    */
+    void TrimRetainedImages(size_t nMaxBytes);
+
+    /** 获取图片缓存的统计信息
+    */
+    ImageCacheStat GetImageCacheStat() const;
+
+    /** 重置图片缓存的统计信息（命中次数、未命中次数、淘汰次数清零）
+    */
+    void ResetImageCacheStat();
+
+    /** 设置已解码图片的磁盘缓存目录（仅缓存皮肤资源中的单帧位图，用于加快程序冷启动的速度）
+    * @param [in] cacheDir 缓存目录，为空表示关闭磁盘缓存（默认关闭）
+    * @param [in] nMaxCacheBytes 缓存文件的总大小上限（字节）
+    * @return 成功返回true，失败返回false
+    */
+    bool SetImageDiskCacheDir(const FilePath& cacheDir, uint64_t nMaxCacheBytes = 128 * 1024 * 1024);
+
+    /** 获取已解码图片的磁盘缓存目录
+    */
+    FilePath GetImageDiskCacheDir() const;
+
+    /** 设置小图标共享图集的图片大小上限（默认值为64）
+    *   未经DPI缩放的宽度和高度均不超过该值的单帧位图和SVG图片，按原大小绘制时，从按DPI划分的共享图集位图中绘制
+    * @param [in] nMaxImageSize 图片大小上限，为0表示不使用图集
+    */
+    void SetImageAtlasMaxSize(uint32_t nMaxImageSize);
+
+    /** 获取小图标共享图集的图片大小上限
+    */
+    uint32_t GetImageAtlasMaxSize() const;
+
+    /** 获取小图标共享图集接口
+    * @return 未启用图集时返回nullptr
+    */
+    ImageAtlas* GetImageAtlas() const;
+
 public:
     /** 设置是否智能匹配临近的缩放百分比图片
     *   比如当dpiScale为120的时候，如果无图片匹配，但存在缩放百分比为125的图片，会自动匹配到
@@ -131,8 +224,9 @@ private:
      * @param[in] imageKey 图片的KEY
      * @param[in] pImage 图片数据接口
      * @param[in] fImageSizeScale 该图片的缩放比
+     * @param[in] bSkinImage 是否为皮肤资源图片（资源目录或者压缩包内的图片），皮肤资源图片在保留队列中优先保留
      */
-    void OnImageDataCreate(const DString& imageKey, std::shared_ptr<IImage>& pImage, float fImageSizeScale);
+    void OnImageDataCreate(const DString& imageKey, std::shared_ptr<IImage>& pImage, float fImageSizeScale, bool bSkinImage);
 
     /** 图片数据被销毁的回调函数，用于释放图片资源的数据
      * @param[in] pImage 图片数据接口
@@ -174,6 +268,19 @@ private:
     */
     DString GetDpiScaledPath(uint32_t dpiScale, const DString& imageFullPath) const;
 
+    /** 估算原图数据占用的内存（字节），按解码后的像素数据计算
+    */
+    static size_t GetImageDataBytes(const IImage* pImage);
+
+    /** 按LRU规则淘汰保留队列中的原图，直到占用的内存不超过指定值（先淘汰用户内容图片，再淘汰皮肤资源图片）
+    */
+    void EvictRetainedImages(size_t nMaxBytes);
+
+    /** 预取的图片在子线程中解码完成后，在UI线程中合并解码数据
+    */
+    struct TPrefetchImage;
+    void MergePrefetchImage(TPrefetchImage& prefetchImage);
+
 private:
     /** 是否智能匹配临近的缩放百分比图片
     */
@@ -215,17 +322,55 @@ private:
     */
     std::unordered_map<DString, TImageData> m_imageDataMap;
 
-    /** 等待释放的原图数据
+    /** 原图数据的内存占用及优先级（KEY为原图数据接口指针，原图数据销毁时移除）
     */
-    struct TReleaseImageData
+    struct TImageDataInfo
     {
-        //释放的图片接口
+        //原图数据占用的内存（字节）
+        size_t m_nImageBytes = 0;
+
+        //是否为皮肤资源图片
+        bool m_bSkinImage = false;
+    };
+    std::unordered_map<const IImage*, TImageDataInfo> m_imageDataInfoMap;
+
+    /** 保留队列中的原图数据（已无控件使用，等待释放的原图）
+    */
+    struct TRetainedImageData
+    {
+        //保留的图片接口
         std::shared_ptr<IImage> m_pImage;
 
-        //数据释放的时间
-        std::chrono::steady_clock::time_point m_releaseTime;
+        //原图数据占用的内存（字节）
+        size_t m_nImageBytes = 0;
     };
-    std::vector<TReleaseImageData> m_delayReleaseImageList;
+    typedef std::list<TRetainedImageData> RetainedImageList;
+
+    /** 保留队列（按LRU排序，表头为最近放入的原图）：[0]为用户内容图片，[1]为皮肤资源图片
+    */
+    RetainedImageList m_retainedImageList[2];
+
+    /** 保留队列的索引：原图数据接口指针 -> (所在队列的下标, 队列中的位置)
+    */
+    std::unordered_map<const IImage*, std::pair<size_t, RetainedImageList::iterator>> m_retainedImageIndex;
+
+    /** 保留队列占用的内存（字节）
+    */
+    size_t m_nRetainedBytes;
+
+    /** 保留队列的内存预算（字节）
+    */
+    size_t m_nRetainedBytesLimit;
+
+    /** 所有原图数据占用的内存（字节）
+    */
+    size_t m_nResidentBytes;
+
+    /** 统计信息：命中次数、未命中次数、淘汰个数
+    */
+    uint64_t m_nCacheHitCount;
+    uint64_t m_nCacheMissCount;
+    uint64_t m_nCacheEvictCount;
 
     /** 延迟释放图片的回调函数
     */
@@ -241,6 +386,37 @@ private:
         DString m_imageKey;             //图片资源的KEY
     };
     std::list<TImageDelayPaintData> m_delayPaintImageList;
+
+private:
+    /** 已解码图片的磁盘缓存
+    */
+    std::unique_ptr<ImageDiskCache> m_spImageDiskCache;
+
+    /** 等待写入磁盘缓存的图片（图片在子线程中解码，解码完成后写入）
+    */
+    struct TPendingDiskCacheData
+    {
+        DString m_cacheKey;         //缓存文件的KEY
+        uint64_t m_nSourceStamp = 0;//图片文件的标识
+    };
+    /** KEY：原图数据Key（与m_imageDataMap的KEY相同）
+    */
+    std::unordered_map<DString, TPendingDiskCacheData> m_pendingDiskCacheMap;
+
+private:
+    /** 小图标的共享图集
+    */
+    std::unique_ptr<ImageAtlas> m_spImageAtlas;
+
+private:
+    /** 预取图片的解码状态（子线程中尚未完成解码的图片个数）
+    */
+    struct TPrefetchState;
+    std::shared_ptr<TPrefetchState> m_spPrefetchState;
+
+    /** 正在子线程中解码的预取图片
+    */
+    std::vector<std::shared_ptr<TPrefetchImage>> m_prefetchImages;
 };
 
 }
@@ -0,0 +1,212 @@
+#include "MemoryStat.h"
+#include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/StringConvert.h"
+#include "duilib/Utils/FileUtil.h"
+#include <atomic>
+#include <algorithm>
+
+namespace ui
+{
+
+/** 一个分类的计数器
+*/
+struct TMemoryStatCounter
+{
+    std::atomic<int64_t> m_nBytes{ 0 };
+    std::atomic<int64_t> m_nCount{ 0 };
+    std::atomic<int64_t> m_nPeakBytes{ 0 };
+    std::atomic<int64_t> m_nPeakCount{ 0 };
+};
+
+/** 所有分类的计数器
+*/
+struct TMemoryStatData
+{
+    TMemoryStatCounter m_counters[(size_t)MemoryCategory::kCount];
+    std::atomic<bool> m_bPeakEnabled{ false };
+};
+
+static TMemoryStatData& GetMemoryStatData()
+{
+    static TMemoryStatData s_memoryStatData;
+    return s_memoryStatData;
+}
+
+/** 更新峰值（仅当新值大于峰值时）
+*/
+static void UpdatePeakValue(std::atomic<int64_t>& nPeakValue, int64_t nValue)
+{
+    int64_t nOldValue = nPeakValue.load(std::memory_order_relaxed);
+    while ((nValue > nOldValue) &&
+           !nPeakValue.compare_exchange_weak(nOldValue, nValue, std::memory_order_relaxed)) {
+    }
+}
+
+void MemoryStat::Add(MemoryCategory category, int64_t nBytes, int64_t nCount)
+{
+    ASSERT(category < MemoryCategory::kCount);
+    if (category >= MemoryCategory::kCount) {
+        return;
+    }
+    TMemoryStatData& statData = GetMemoryStatData();
+    TMemoryStatCounter& counter = statData.m_counters[(size_t)category];
+    const int64_t nNewBytes = counter.m_nBytes.fetch_add(nBytes, std::memory_order_relaxed) + nBytes;
+    const int64_t nNewCount = counter.m_nCount.fetch_add(nCount, std::memory_order_relaxed) + nCount;
+    if (statData.m_bPeakEnabled.load(std::memory_order_relaxed)) {
+        UpdatePeakValue(counter.m_nPeakBytes, nNewBytes);
+        UpdatePeakValue(counter.m_nPeakCount, nNewCount);
+    }
+}
+
+void MemoryStat::Set(MemoryCategory category, uint64_t nBytes, uint64_t nCount)
+{
+    ASSERT(category < MemoryCategory::kCount);
+    if (category >= MemoryCategory::kCount) {
+        return;
+    }
+    TMemoryStatData& statData = GetMemoryStatData();
+    TMemoryStatCounter& counter = statData.m_counters[(size_t)category];
+    counter.m_nBytes.store((int64_t)nBytes, std::memory_order_relaxed);
+    counter.m_nCount.store((int64_t)nCount, std::memory_order_relaxed);
+    if (statData.m_bPeakEnabled.load(std::memory_order_relaxed)) {
+        UpdatePeakValue(counter.m_nPeakBytes, (int64_t)nBytes);
+        UpdatePeakValue(counter.m_nPeakCount, (int64_t)nCount);
+    }
+}
+
+MemoryStatItem MemoryStat::GetItem(MemoryCategory category)
+{
+    MemoryStatItem item;
+    ASSERT(category < MemoryCategory::kCount);
+    if (category >= MemoryCategory::kCount) {
+        return item;
+    }
+    const TMemoryStatCounter& counter = GetMemoryStatData().m_counters[(size_t)category];
+    //计数器的更新不是同步的，可能短暂出现负值
+    item.m_nBytes = (uint64_t)std::max(counter.m_nBytes.load(std::memory_order_relaxed), (int64_t)0);
+    item.m_nCount = (uint64_t)std::max(counter.m_nCount.load(std::memory_order_relaxed), (int64_t)0);
+    item.m_nPeakBytes = (uint64_t)std::max(counter.m_nPeakBytes.load(std::memory_order_relaxed), (int64_t)0);
+    item.m_nPeakCount = (uint64_t)std::max(counter.m_nPeakCount.load(std::memory_order_relaxed), (int64_t)0);
+    return item;
+}
+
+void MemoryStat::SetPeakEnabled(bool bEnabled)
+{
+    TMemoryStatData& statData = GetMemoryStatData();
+    if (bEnabled && !statData.m_bPeakEnabled.load(std::memory_order_relaxed)) {
+        //开启时，峰值从当前值开始统计
+        statData.m_bPeakEnabled.store(true, std::memory_order_relaxed);
+        ResetPeak();
+    }
+    else if (!bEnabled) {
+        statData.m_bPeakEnabled.store(false, std::memory_order_relaxed);
+    }
+}
+
+bool MemoryStat::IsPeakEnabled()
+{
+    return GetMemoryStatData().m_bPeakEnabled.load(std::memory_order_relaxed);
+}
+
+void MemoryStat::ResetPeak()
+{
+    for (TMemoryStatCounter& counter : GetMemoryStatData().m_counters) {
+        counter.m_nPeakBytes.store(counter.m_nBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        counter.m_nPeakCount.store(counter.m_nCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+const DString::value_type* MemoryStat::GetCategoryName(MemoryCategory category)
+{
+    switch (category) {
+    case MemoryCategory::kImage:
+        return _T("image");
+    case MemoryCategory::kFont:
+        return _T("font");
+    case MemoryCategory::kTempRender:
+        return _T("temp_render");
+    case MemoryCategory::kRichTextCache:
+        return _T("rich_text_cache");
+    case MemoryCategory::kRichEditUndo:
+        return _T("rich_edit_undo");
+    case MemoryCategory::kListCtrlData:
+        return _T("list_ctrl_data");
+    default:
+        break;
+    }
+    return _T("");
+}
+
+/** JSON格式字符串中的特殊字符需要转义
+*/
+static DString EscapeJsonString(const DString& str)
+{
+    DString result;
+    for (DString::value_type ch : str) {
+        if ((ch == _T('"')) || (ch == _T('\\'))) {
+            result.push_back(_T('\\'));
+        }
+        result.push_back(ch);
+    }
+    return result;
+}
+
+/** 将各个分类的统计数据转换为JSON格式的字符串
+*/
+static DString MemoryStatItemsToJson(const MemoryStatItem* items, bool bPeak)
+{
+    DString json = _T("{");
+    for (size_t index = 0; index < (size_t)MemoryCategory::kCount; ++index) {
+        const MemoryStatItem& item = items[index];
+        json += (index == 0) ? _T("\"") : _T(", \"");
+        json += MemoryStat::GetCategoryName((MemoryCategory)index);
+        json += _T("\": {\"bytes\": ") + StringUtil::UInt64ToString(item.m_nBytes);
+        json += _T(", \"count\": ") + StringUtil::UInt64ToString(item.m_nCount);
+        if (bPeak) {
+            json += _T(", \"peak_bytes\": ") + StringUtil::UInt64ToString(item.m_nPeakBytes);
+            json += _T(", \"peak_count\": ") + StringUtil::UInt64ToString(item.m_nPeakCount);
+        }
+        json += _T("}");
+    }
+    json += _T("}");
+    return json;
+}
+
+uint64_t MemorySnapshot::GetTotalBytes() const
+{
+    uint64_t nTotalBytes = 0;
+    for (const MemoryStatItem& item : m_items) {
+        nTotalBytes += item.m_nBytes;
+    }
+    return nTotalBytes;
+}
+
+DString MemorySnapshot::ToJsonString() const
+{
+    DString json = _T("{\n  \"total_bytes\": ") + StringUtil::UInt64ToString(GetTotalBytes());
+    json += _T(",\n  \"categories\": ") + MemoryStatItemsToJson(m_items, MemoryStat::IsPeakEnabled());
+    json += _T(",\n  \"windows\": [");
+    for (size_t index = 0; index < m_windows.size(); ++index) {
+        const WindowMemoryStat& windowStat = m_windows[index];
+        json += (index == 0) ? _T("\n") : _T(",\n");
+        json += _T("    {\"id\": \"") + EscapeJsonString(windowStat.m_windowId) + _T("\"");
+        json += _T(", \"class_name\": \"") + EscapeJsonString(windowStat.m_windowClassName) + _T("\"");
+        json += _T(", \"control_count\": ") + StringUtil::UInt64ToString(windowStat.m_nControlCount);
+        json += _T(", \"categories\": ") + MemoryStatItemsToJson(windowStat.m_items, false);
+        json += _T("}");
+    }
+    json += _T("\n  ]\n}\n");
+    return json;
+}
+
+bool MemorySnapshot::SaveJsonFile(const FilePath& filePath) const
+{
+    ASSERT(!filePath.IsEmpty());
+    if (filePath.IsEmpty()) {
+        return false;
+    }
+    DStringA jsonData = StringConvert::TToUTF8(ToJsonString());
+    return FileUtil::WriteFileData(filePath, jsonData);
+}
+
+} // namespace ui
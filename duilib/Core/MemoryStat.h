@@ -0,0 +1,125 @@
+#ifndef UI_CORE_MEMORY_STAT_H_
+#define UI_CORE_MEMORY_STAT_H_
+
+#include "duilib/Utils/FilePath.h"
+#include <vector>
+
+namespace ui
+{
+/** 内存统计的分类
+*/
+enum class MemoryCategory : uint8_t
+{
+    kImage = 0,         //解码后的原图数据（ImageManager）
+    kFont,              //字体对象（FontManager），只统计个数
+    kTempRender,        //控件设置透明度时使用的离屏绘制缓存（Control和RenderSurfacePool）
+    kRichTextCache,     //RichText/RichEdit的绘制缓存
+    kRichEditUndo,      //RichEdit的Undo/Redo数据
+    kListCtrlData,      //ListCtrl的数据存储（在获取内存快照时统计）
+    kCount              //分类个数（非有效分类）
+};
+
+/** 一个分类的内存统计数据
+*/
+struct UILIB_API MemoryStatItem
+{
+    //占用的内存（字节，按数据大小估算）
+    uint64_t m_nBytes = 0;
+
+    //对象个数
+    uint64_t m_nCount = 0;
+
+    //占用内存的峰值（字节，开启峰值统计后有效）
+    uint64_t m_nPeakBytes = 0;
+
+    //对象个数的峰值（开启峰值统计后有效）
+    uint64_t m_nPeakCount = 0;
+};
+
+/** 一个窗口的内存统计数据
+*/
+struct UILIB_API WindowMemoryStat
+{
+    //窗口ID
+    DString m_windowId;
+
+    //窗口类名
+    DString m_windowClassName;
+
+    //控件个数
+    uint64_t m_nControlCount = 0;
+
+    //各个分类的内存统计数据（只统计窗口中的控件占用的内存，不含峰值），按MemoryCategory的值索引
+    MemoryStatItem m_items[(size_t)MemoryCategory::kCount];
+};
+
+/** 内存统计的快照（由GlobalManager::GetMemorySnapshot函数生成）
+*/
+struct UILIB_API MemorySnapshot
+{
+    //各个分类的内存统计数据（全局），按MemoryCategory的值索引
+    MemoryStatItem m_items[(size_t)MemoryCategory::kCount];
+
+    //每个窗口的内存统计数据
+    std::vector<WindowMemoryStat> m_windows;
+
+    /** 获取所有分类占用的内存之和（字节）
+    */
+    uint64_t GetTotalBytes() const;
+
+    /** 转换为JSON格式的字符串（机器可读的格式，便于定期采集和比较）
+    */
+    DString ToJsonString() const;
+
+    /** 以JSON格式保存到文件
+    * @param [in] filePath 本地文件路径(绝对路径)
+    */
+    bool SaveJsonFile(const FilePath& filePath) const;
+};
+
+/** 内存统计的计数器：各个子系统在创建和释放对象时更新计数器（原子操作，线程安全），
+*   用于在长时间运行的程序中定期采集内存占用情况，发现内存泄漏和内存膨胀问题，不需要借助堆内存分析工具
+*/
+class UILIB_API MemoryStat
+{
+public:
+    /** 更新一个分类的计数器
+    * @param [in] category 分类
+    * @param [in] nBytes 增加的内存字节数（释放时为负数）
+    * @param [in] nCount 增加的对象个数（释放时为负数）
+    */
+    static void Add(MemoryCategory category, int64_t nBytes, int64_t nCount);
+
+    /** 设置一个分类的当前值（用于在获取快照时统计的分类）
+    * @param [in] category 分类
+    * @param [in] nBytes 占用的内存字节数
+    * @param [in] nCount 对象个数
+    */
+    static void Set(MemoryCategory category, uint64_t nBytes, uint64_t nCount);
+
+    /** 获取一个分类的统计数据
+    * @param [in] category 分类
+    */
+    static MemoryStatItem GetItem(MemoryCategory category);
+
+    /** 设置是否统计峰值（默认不统计，开启后每次更新计数器时增加一次比较操作）
+    */
+    static void SetPeakEnabled(bool bEnabled);
+
+    /** 是否统计峰值
+    */
+    static bool IsPeakEnabled();
+
+    /** 将所有分类的峰值重置为当前值
+    */
+    static void ResetPeak();
+
+    /** 获取分类的名称（用于JSON格式的输出）
+    * @param [in] category 分类
+    */
+    static const DString::value_type* GetCategoryName(MemoryCategory category);
+};
+
+} // namespace ui
+
+#endif // UI_CORE_MEMORY_STAT_H_
@@ -4,11 +4,35 @@
 #if defined(DUILIB_BUILD_FOR_SDL)
 
 #include "NativeWindow_SDL.h"
+#include "duilib/Core/GlobalManager.h"
 #include <SDL3/SDL.h>
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+//一次从SDL队列中取出的事件个数上限
+#define MAX_FETCH_EVENT_COUNT   1024
 
 namespace ui
 {
 std::unordered_map<uint32_t, SDLUserMessageCallback> MessageLoop_SDL::s_userMsgCallbacks;
+MessageLoopEventStat MessageLoop_SDL::s_eventStat;
+
+/** 已经从SDL队列取出、但尚未派发的事件（嵌套的消息循环也从该队列中优先获取事件）
+*/
+static std::deque<SDL_Event> s_pendingEvents;
+
+/** 取出SDL事件时，按优先级分组的事件列表：输入及其他事件、定时器事件、绘制事件
+*/
+static std::vector<SDL_Event> s_fetchedEvents[3];
+
+/** 判断是否为输入事件（键盘、鼠标、触摸事件）
+*/
+static bool IsInputEvent(uint32_t eventType)
+{
+    return ((eventType >= SDL_EVENT_KEY_DOWN) && (eventType < SDL_EVENT_JOYSTICK_AXIS_MOTION)) ||
+           ((eventType >= SDL_EVENT_FINGER_DOWN) && (eventType <= SDL_EVENT_FINGER_MOTION));
+}
 
 MessageLoop_SDL::MessageLoop_SDL()
 {
@@ -85,7 +109,7 @@ int32_t MessageLoop_SDL::Run(MessageLoopIdleCallback idleCallback)
     if (idleCallback == nullptr) {
         //普通消息循环，不支持Idle函数
         while (bKeepGoing) {
-            while (bKeepGoing && SDL_WaitEvent(&sdlEvent)) {
+            while (bKeepGoing && GetNextEvent(sdlEvent, true)) {
                 ProcessSDLEvent(sdlEvent, bKeepGoing);
             }
         }
@@ -93,14 +117,14 @@ int32_t MessageLoop_SDL::Run(MessageLoopIdleCallback idleCallback)
     else {
         //需要支持Idle函数
         while (bKeepGoing) {
-            while (bKeepGoing && SDL_PollEvent(&sdlEvent)) {
+            while (bKeepGoing && GetNextEvent(sdlEvent, false)) {
                 ProcessSDLEvent(sdlEvent, bKeepGoing);
             }
             if (bKeepGoing) {
                 idleCallback();
 
                 //等待队列中放入消息，避免一直循环导致CPU占有率很高
-                if (SDL_WaitEvent(&sdlEvent)) {
+                if (GetNextEvent(sdlEvent, true)) {
                     ProcessSDLEvent(sdlEvent, bKeepGoing);
                 }
             }
@@ -108,16 +132,149 @@ int32_t MessageLoop_SDL::Run(MessageLoopIdleCallback idleCallback)
     }
 
     //退出SDL
+    s_pendingEvents.clear();
     SDL_Quit();
     return 0;
 }
 
+bool MessageLoop_SDL::GetNextEvent(SDL_Event& sdlEvent, bool bWait)
+{
+    if (s_pendingEvents.empty() && !FetchSDLEvents(bWait)) {
+        return false;
+    }
+    ASSERT(!s_pendingEvents.empty());
+    if (s_pendingEvents.empty()) {
+        return false;
+    }
+    sdlEvent = s_pendingEvents.front();
+    s_pendingEvents.pop_front();
+
+    //统计输入事件从产生到派发的延迟
+    s_eventStat.m_nDispatchCount++;
+    if (IsInputEvent(sdlEvent.type) && (sdlEvent.common.timestamp != 0)) {
+        const Uint64 nNowNS = SDL_GetTicksNS();
+        if (nNowNS >= sdlEvent.common.timestamp) {
+            const uint64_t nLatencyNS = nNowNS - sdlEvent.common.timestamp;
+            s_eventStat.m_nInputEventCount++;
+            s_eventStat.m_nTotalLatencyNS += nLatencyNS;
+            s_eventStat.m_nMaxLatencyNS = std::max(s_eventStat.m_nMaxLatencyNS, nLatencyNS);
+        }
+    }
+    return true;
+}
+
+bool MessageLoop_SDL::FetchSDLEvents(bool bWait)
+{
+    SDL_Event sdlEvent;
+    bool bRet = bWait ? SDL_WaitEvent(&sdlEvent) : SDL_PollEvent(&sdlEvent);
+    if (!bRet) {
+        return false;
+    }
+    AddFetchedEvent(sdlEvent);
+
+    //一次取出队列中已有的所有事件（SDL_WaitEvent/SDL_PollEvent已经从系统收集了事件）
+    const int32_t nBatchCount = 64;
+    SDL_Event sdlEvents[nBatchCount];
+    size_t nFetchCount = 1;
+    while (nFetchCount < MAX_FETCH_EVENT_COUNT) {
+        int nCount = SDL_PeepEvents(sdlEvents, nBatchCount, SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+        if (nCount <= 0) {
+            break;
+        }
+        for (int i = 0; i < nCount; ++i) {
+            AddFetchedEvent(sdlEvents[i]);
+        }
+        nFetchCount += (size_t)nCount;
+        if (nCount < nBatchCount) {
+            break;
+        }
+    }
+
+    //按优先级放入待派发的事件队列：先处理输入事件，然后是定时器事件，最后是绘制事件
+    for (std::vector<SDL_Event>& fetchedEvents : s_fetchedEvents) {
+        s_pendingEvents.insert(s_pendingEvents.end(), fetchedEvents.begin(), fetchedEvents.end());
+        fetchedEvents.clear();
+    }
+    return !s_pendingEvents.empty();
+}
+
+void MessageLoop_SDL::AddFetchedEvent(const SDL_Event& sdlEvent)
+{
+    if (sdlEvent.type == WM_USER_DEFINED_TIMER) {
+        s_fetchedEvents[1].push_back(sdlEvent);
+        return;
+    }
+    if (sdlEvent.type == WM_USER_PAINT_MSG) {
+        s_fetchedEvents[2].push_back(sdlEvent);
+        return;
+    }
+    std::vector<SDL_Event>& fetchedEvents = s_fetchedEvents[0];
+    if (!fetchedEvents.empty()) {
+        SDL_Event& lastEvent = fetchedEvents.back();
+        if ((sdlEvent.type == SDL_EVENT_MOUSE_MOTION) && (lastEvent.type == SDL_EVENT_MOUSE_MOTION) &&
+            (sdlEvent.motion.windowID == lastEvent.motion.windowID) &&
+            (sdlEvent.motion.which == lastEvent.motion.which) &&
+            (sdlEvent.motion.state == lastEvent.motion.state)) {
+            //连续的鼠标移动事件：保留最新的位置，累加相对移动距离（时间戳保留最早的，用于统计延迟）
+            const Uint64 nTimestamp = lastEvent.common.timestamp;
+            const float xrel = lastEvent.motion.xrel + sdlEvent.motion.xrel;
+            const float yrel = lastEvent.motion.yrel + sdlEvent.motion.yrel;
+            lastEvent = sdlEvent;
+            lastEvent.motion.xrel = xrel;
+            lastEvent.motion.yrel = yrel;
+            lastEvent.common.timestamp = nTimestamp;
+            s_eventStat.m_nCoalescedCount++;
+            return;
+        }
+        if ((sdlEvent.type == SDL_EVENT_MOUSE_WHEEL) && (lastEvent.type == SDL_EVENT_MOUSE_WHEEL) &&
+            (sdlEvent.wheel.windowID == lastEvent.wheel.windowID) &&
+            (sdlEvent.wheel.which == lastEvent.wheel.which) &&
+            (sdlEvent.wheel.direction == lastEvent.wheel.direction)) {
+            //连续的鼠标滚轮事件：保留最新的鼠标位置，累加滚动距离（含整数格式的滚动距离）
+            const Uint64 nTimestamp = lastEvent.common.timestamp;
+            const float x = lastEvent.wheel.x + sdlEvent.wheel.x;
+            const float y = lastEvent.wheel.y + sdlEvent.wheel.y;
+            const Sint32 nIntegerX = lastEvent.wheel.integer_x + sdlEvent.wheel.integer_x;
+            const Sint32 nIntegerY = lastEvent.wheel.integer_y + sdlEvent.wheel.integer_y;
+            lastEvent = sdlEvent;
+            lastEvent.wheel.x = x;
+            lastEvent.wheel.y = y;
+            lastEvent.wheel.integer_x = nIntegerX;
+            lastEvent.wheel.integer_y = nIntegerY;
+            lastEvent.common.timestamp = nTimestamp;
+            s_eventStat.m_nCoalescedCount++;
+            return;
+        }
+    }
+    if ((sdlEvent.type == SDL_EVENT_WINDOW_RESIZED) || (sdlEvent.type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED)) {
+        //窗口大小变化事件：如果与同一窗口的前一个同类事件之间只有该窗口的其他窗口事件，只保留最新的大小
+        for (auto iter = fetchedEvents.rbegin(); iter != fetchedEvents.rend(); ++iter) {
+            if ((iter->type < SDL_EVENT_WINDOW_FIRST) || (iter->type > SDL_EVENT_WINDOW_LAST) ||
+                (iter->window.windowID != sdlEvent.window.windowID)) {
+                break;
+            }
+            if (iter->type == sdlEvent.type) {
+                iter->window.data1 = sdlEvent.window.data1;
+                iter->window.data2 = sdlEvent.window.data2;
+                s_eventStat.m_nCoalescedCount++;
+                return;
+            }
+        }
+    }
+    fetchedEvents.push_back(sdlEvent);
+}
+
 void MessageLoop_SDL::ProcessSDLEvent(const SDL_Event& sdlEvent, bool& bKeepGoing)
 {
     switch (sdlEvent.type) {
     case SDL_EVENT_QUIT:  /* triggers on last window close and other things. End the program. */
         bKeepGoing = false;
         break;
+    case SDL_EVENT_LOW_MEMORY:
+        //系统内存不足：释放图片保留队列中的所有原图
+        GlobalManager::Instance().Image().TrimRetainedImages(0);
+        DispatchSDLEvent(sdlEvent);
+        break;
     default:
         //将事件派发到窗口
         DispatchSDLEvent(sdlEvent);
@@ -144,7 +301,7 @@ void MessageLoop_SDL::RunDoModal(NativeWindow_SDL& nativeWindow, bool bCloseByEs
     while (bKeepGoing) {
 
         /* run through all pending events until we run out. */
-        while (bKeepGoing && SDL_WaitEvent(&sdlEvent)) {
+        while (bKeepGoing && GetNextEvent(sdlEvent, true)) {
             switch (sdlEvent.type) {
             case SDL_EVENT_QUIT:  /* triggers on last window close and other things. End the program. */
                 bKeepGoing = false;
@@ -194,7 +351,7 @@ void MessageLoop_SDL::RunUserLoop(bool& bTerminate)
     while (bKeepGoing) {
 
         /* run through all pending events until we run out. */
-        while (bKeepGoing && SDL_WaitEvent(&sdlEvent)) {
+        while (bKeepGoing && GetNextEvent(sdlEvent, true)) {
             switch (sdlEvent.type) {
             case SDL_EVENT_QUIT:  /* triggers on last window close and other things. End the program. */
                 bKeepGoing = false;
@@ -223,6 +380,31 @@ void MessageLoop_SDL::RunUserLoop(bool& bTerminate)
 void MessageLoop_SDL::RemoveDuplicateMsg(uint32_t msgId)
 {
     SDL_FlushEvent(msgId);
+    s_pendingEvents.erase(std::remove_if(s_pendingEvents.begin(), s_pendingEvents.end(),
+                                         [msgId](const SDL_Event& sdlEvent) {
+                                             return sdlEvent.type == msgId;
+                                         }),
+                          s_pendingEvents.end());
+}
+
+bool MessageLoop_SDL::HasPendingWindowEvent(uint32_t eventType, uint32_t windowID)
+{
+    for (const SDL_Event& sdlEvent : s_pendingEvents) {
+        if ((sdlEvent.type == eventType) && (NativeWindow_SDL::GetWindowIdFromEvent(sdlEvent) == windowID)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const MessageLoopEventStat& MessageLoop_SDL::GetEventStat()
+{
+    return s_eventStat;
+}
+
+void MessageLoop_SDL::ResetEventStat()
+{
+    s_eventStat = MessageLoopEventStat();
 }
 
 bool MessageLoop_SDL::PostUserEvent(uint32_t msgId, WPARAM wParam, LPARAM lParam)
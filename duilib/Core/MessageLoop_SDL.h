@@ -9,6 +9,11 @@
 
 union SDL_Event;
 
+/** duilib内部占用的SDL自定义事件ID（使用处需要包含<SDL3/SDL.h>，ID的分配情况见MessageLoop_SDL::CheckInitSDL）
+*/
+#define WM_USER_DEFINED_TIMER   (SDL_EVENT_USER + 2)    //定时器事件（TimerManager）
+#define WM_USER_PAINT_MSG       (SDL_EVENT_USER + 3)    //主动绘制事件（NativeWindow_SDL）
+
 namespace ui {
 
 class NativeWindow_SDL;
@@ -17,6 +22,17 @@ class NativeWindow_SDL;
 */
 typedef std::function<void(uint32_t msgID, WPARAM wParam, LPARAM lParam)> SDLUserMessageCallback;
 
+/** 消息循环的事件派发统计
+*/
+struct MessageLoopEventStat
+{
+    uint64_t m_nDispatchCount = 0;      //派发的事件个数
+    uint64_t m_nCoalescedCount = 0;     //被合并的事件个数（鼠标移动、滚轮、窗口大小变化事件）
+    uint64_t m_nInputEventCount = 0;    //派发的输入事件个数（键盘、鼠标、触摸事件）
+    uint64_t m_nTotalLatencyNS = 0;     //输入事件从产生到派发的延迟之和（纳秒）
+    uint64_t m_nMaxLatencyNS = 0;       //输入事件从产生到派发的最大延迟（纳秒）
+};
+
 /** 主线程的消息循环
 */
 class MessageLoop_SDL
@@ -58,6 +74,20 @@ public:
     */
     static void RemoveDuplicateMsg(uint32_t msgId);
 
+    /** 判断已经从SDL队列取出、但尚未派发的事件中，是否含有指定窗口的指定事件
+    * @param [in] eventType 事件类型
+    * @param [in] windowID 窗口ID
+    */
+    static bool HasPendingWindowEvent(uint32_t eventType, uint32_t windowID);
+
+    /** 获取事件派发的统计数据
+    */
+    static const MessageLoopEventStat& GetEventStat();
+
+    /** 清零事件派发的统计数据
+    */
+    static void ResetEventStat();
+
     /** 向消息队列中发送一个消息
     * @param [in] msgId 消息ID, 该ID必须位于SDL_EVENT_USER与SDL_EVENT_LAST之间
     * @param [in] wParam 消息的第1个参数
@@ -84,6 +114,7 @@ public:
     * @param [in] videoDriverName 显示驱动的名称, 有效值是：
       Windows平台："windows"
       Linux平台："X11" 或者 "wayland" 或者 "wayland,X11" 或者 "X11,wayland"
+      无显示设备时（如性能测试环境）："offscreen" 或者 "dummy"
     */
     static bool CheckInitSDL(const DString& videoDriverName = _T(""));
 
@@ -96,6 +127,22 @@ public:
     static float GetPrimaryDisplayContentScale();
 
 private:
+    /** 获取下一个需要派发的事件：待派发的事件为空时，一次取出SDL队列中的所有事件，
+    *   合并连续的鼠标移动、滚轮和窗口大小变化事件，并按照输入事件、定时器事件、绘制事件的优先级排序
+    * @param [out] sdlEvent 返回需要派发的事件
+    * @param [in] bWait SDL队列为空时，是否等待事件
+    * @return 有需要派发的事件时返回true，否则返回false
+    */
+    static bool GetNextEvent(SDL_Event& sdlEvent, bool bWait);
+
+    /** 从SDL队列中取出所有事件，放入待派发的事件队列
+    */
+    static bool FetchSDLEvents(bool bWait);
+
+    /** 将一个事件添加到按优先级分组的事件列表中，可合并时与前一个事件合并
+    */
+    static void AddFetchedEvent(const SDL_Event& sdlEvent);
+
     /** 处理一条队列中的SDL事件(消息循环中的一个子功能)
     */
     static void ProcessSDLEvent(const SDL_Event& sdlEvent, bool& bKeepGoing);
@@ -112,6 +159,10 @@ private:
     /** 自定义消息映射
     */
     static std::unordered_map<uint32_t, SDLUserMessageCallback> s_userMsgCallbacks;
+
+    /** 事件派发的统计数据
+    */
+    static MessageLoopEventStat s_eventStat;
 };
 
 } // namespace ui
@@ -17,10 +17,6 @@
     #include "SDL_Linux.h"
 #endif
 
-/** 主动绘制
-*/
-#define WM_USER_PAINT_MSG (SDL_EVENT_USER + 3)
-
 /** 主动触发窗口的Hover消息
 */
 #define WM_USER_HOVER_MSG (SDL_EVENT_USER + 4)
@@ -2627,6 +2623,10 @@ void NativeWindow_SDL::Invalidate(const UiRect& rcItem)
         data.m_bFoundExposedEvent = false;
         data.m_sdlWindow = m_sdlWindow;
         SDL_FilterEvents(FilterNativeWindowExposedEvent, &data);
+        if (!data.m_bFoundExposedEvent) {
+            //已经从SDL队列中取出、但尚未派发的事件中，也可能含有该窗口的绘制消息
+            data.m_bFoundExposedEvent = MessageLoop_SDL::HasPendingWindowEvent(WM_USER_PAINT_MSG, SDL_GetWindowID(m_sdlWindow));
+        }
         if (!data.m_bFoundExposedEvent) {
             //如果队列中没有该窗口的绘制消息，则添加一个；但如果有的话，就不重复添加，避免重复绘制而影响性能
             SDL_Event sdlEvent;
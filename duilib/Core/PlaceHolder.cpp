@@ -77,7 +77,7 @@ DString PlaceHolder::GetName() const
 
 bool PlaceHolder::IsNameEquals(const DString& name) const
 {
-    return StringUtil::StringCompare(m_sName.c_str(), name.c_str()) == 0;
+    return m_sName == name;
 }
 
 bool PlaceHolder::HasName() const
@@ -87,7 +87,8 @@ bool PlaceHolder::HasName() const
 
 void PlaceHolder::SetName(const DString& strName)
 {
-    m_sName = strName;
+    //控件名称使用驻留字符串，相同名称的控件共享字符串数据
+    m_sName = UiString::Intern(strName);
 }
 
 void PlaceHolder::SetUTF8Name(const std::string& strName)
@@ -104,6 +105,10 @@ void PlaceHolder::SetParent(Box* pParent)
 void PlaceHolder::SetWindow(Window* pWindow)
 {
     m_pWindow = pWindow;
+    if (m_bIsArranged && (m_pWindow != nullptr)) {
+        //需要布局重排，加入窗口的布局队列
+        m_pWindow->AddArrangeControl(this);
+    }
 }
 
 void PlaceHolder::Init()
@@ -558,8 +563,9 @@ void PlaceHolder::ArrangeAncestor()
         }
     }
     else {
-        Control* parent = GetParent();
-        while (parent && (parent->GetFixedWidth().IsAuto() || parent->GetFixedHeight().IsAuto())) {
+        Box* parent = GetParent();
+        while (parent && !parent->IsLayoutBoundary() &&
+               (parent->GetFixedWidth().IsAuto() || parent->GetFixedHeight().IsAuto())) {
             parent->SetReEstimateSize(true);
             parent = parent->GetParent();
         }
@@ -593,8 +599,13 @@ void PlaceHolder::SetPos(UiRect rc)
 }
 
 void PlaceHolder::SetArranged(bool bArranged)
-{ 
-    m_bIsArranged = bArranged; 
+{
+    bool bOldArranged = m_bIsArranged;
+    m_bIsArranged = bArranged;
+    if (bArranged && !bOldArranged && (m_pWindow != nullptr)) {
+        //加入窗口的布局队列，布局时不需要再遍历整个控件树查找需要重排的控件
+        m_pWindow->AddArrangeControl(this);
+    }
 }
 
 void PlaceHolder::SetRect(const UiRect& rc)
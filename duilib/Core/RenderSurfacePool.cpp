@@ -0,0 +1,216 @@
+#include "RenderSurfacePool.h"
+#include "duilib/Core/Window.h"
+#include "duilib/Core/GlobalManager.h"
+#include "duilib/Core/MemoryStat.h"
+#include <algorithm>
+
+//空闲缓存默认的内存上限（字节）
+#define DEFAULT_RENDER_SURFACE_POOL_MAX_IDLE_BYTES (32 * 1024 * 1024)
+
+//缓存默认的最长空闲时间（毫秒）
+#define DEFAULT_RENDER_SURFACE_POOL_IDLE_TIME 5000
+
+//最小的大小级别（像素）
+#define RENDER_SURFACE_MIN_SIZE_CLASS 16
+
+namespace ui
+{
+/** 获取大小所在的级别：不超过64时按16对齐，否则按所在2的幂区间的1/4对齐（每个维度的浪费不超过25%）
+*/
+static int32_t GetSurfaceSizeClass(int32_t nSize)
+{
+    if (nSize <= RENDER_SURFACE_MIN_SIZE_CLASS * 4) {
+        nSize = std::max(nSize, 1);
+        return (nSize + RENDER_SURFACE_MIN_SIZE_CLASS - 1) / RENDER_SURFACE_MIN_SIZE_CLASS * RENDER_SURFACE_MIN_SIZE_CLASS;
+    }
+    int32_t nPowerOfTwo = RENDER_SURFACE_MIN_SIZE_CLASS * 4;
+    while ((nPowerOfTwo <= nSize / 2) && (nPowerOfTwo < INT32_MAX / 4)) {
+        nPowerOfTwo *= 2;
+    }
+    const int32_t nStep = nPowerOfTwo / 4;
+    if (nSize > INT32_MAX - nStep) {
+        return nSize;
+    }
+    return (nSize + nStep - 1) / nStep * nStep;
+}
+
+/** 获取离屏绘制缓存占用的内存（字节，每个像素4字节）
+*/
+static size_t GetSurfaceBytes(const IRender* pRender)
+{
+    if (pRender == nullptr) {
+        return 0;
+    }
+    return (size_t)pRender->GetWidth() * (size_t)pRender->GetHeight() * 4;
+}
+
+RenderSurfacePool::RenderSurfacePool(Window* pWindow):
+    m_pWindow(pWindow),
+    m_nIdleBytes(0),
+    m_nMaxIdleBytes(DEFAULT_RENDER_SURFACE_POOL_MAX_IDLE_BYTES),
+    m_nIdleTime(DEFAULT_RENDER_SURFACE_POOL_IDLE_TIME)
+{
+    ASSERT(m_pWindow != nullptr);
+}
+
+RenderSurfacePool::~RenderSurfacePool()
+{
+    Clear();
+}
+
+std::unique_ptr<IRender> RenderSurfacePool::AcquireRender(int32_t nWidth, int32_t nHeight)
+{
+    ASSERT((nWidth > 0) && (nHeight > 0));
+    if ((nWidth <= 0) || (nHeight <= 0)) {
+        return nullptr;
+    }
+    const int32_t nClassWidth = GetSurfaceSizeClass(nWidth);
+    const int32_t nClassHeight = GetSurfaceSizeClass(nHeight);
+
+    //优先使用最近归还的同一级别的缓存
+    for (size_t nIndex = m_idleRenders.size(); nIndex > 0; --nIndex) {
+        TIdleRender& idleRender = m_idleRenders[nIndex - 1];
+        if ((idleRender.m_spRender->GetWidth() == nClassWidth) &&
+            (idleRender.m_spRender->GetHeight() == nClassHeight)) {
+            std::unique_ptr<IRender> spRender = std::move(idleRender.m_spRender);
+            m_idleRenders.erase(m_idleRenders.begin() + (nIndex - 1));
+            m_nIdleBytes -= GetSurfaceBytes(spRender.get());
+            return spRender;
+        }
+    }
+    return CreateRender(nClassWidth, nClassHeight);
+}
+
+void RenderSurfacePool::ReleaseRender(std::unique_ptr<IRender>& spRender)
+{
+    if (spRender == nullptr) {
+        return;
+    }
+    const size_t nBytes = GetSurfaceBytes(spRender.get());
+    if ((nBytes == 0) || (nBytes > m_nMaxIdleBytes) || (m_nIdleTime == 0)) {
+        DestroyRender(spRender);
+        return;
+    }
+    TIdleRender idleRender;
+    idleRender.m_spRender = std::move(spRender);
+    idleRender.m_idleTime = std::chrono::steady_clock::now();
+    m_idleRenders.push_back(std::move(idleRender));
+    m_nIdleBytes += nBytes;
+    TrimIdleBytes();
+
+    if (!m_idleRenders.empty() && !m_trimTimerFlag.HasUsed()) {
+        //定时释放空闲时间过长的缓存
+        uint32_t nElapseMs = std::max(m_nIdleTime / 2, (uint32_t)500);
+        GlobalManager::Instance().Timer().AddTimer(m_trimTimerFlag.GetWeakFlag(),
+                                                   [this]() { TrimIdleRenders(); },
+                                                   nElapseMs);
+    }
+}
+
+void RenderSurfacePool::SetMaxIdleBytes(size_t nMaxIdleBytes)
+{
+    m_nMaxIdleBytes = nMaxIdleBytes;
+    TrimIdleBytes();
+}
+
+size_t RenderSurfacePool::GetMaxIdleBytes() const
+{
+    return m_nMaxIdleBytes;
+}
+
+void RenderSurfacePool::SetIdleTime(uint32_t nIdleTimeMs)
+{
+    if (m_nIdleTime != nIdleTimeMs) {
+        m_nIdleTime = nIdleTimeMs;
+        //定时器的间隔与空闲时间相关，重新设置定时器
+        m_trimTimerFlag.Cancel();
+        if (m_nIdleTime == 0) {
+            Clear();
+        }
+    }
+}
+
+uint32_t RenderSurfacePool::GetIdleTime() const
+{
+    return m_nIdleTime;
+}
+
+void RenderSurfacePool::Clear()
+{
+    m_trimTimerFlag.Cancel();
+    for (TIdleRender& idleRender : m_idleRenders) {
+        DestroyRender(idleRender.m_spRender);
+    }
+    m_idleRenders.clear();
+    m_nIdleBytes = 0;
+}
+
+void RenderSurfacePool::GetMemoryStat(WindowMemoryStat& stat) const
+{
+    MemoryStatItem& item = stat.m_items[(size_t)MemoryCategory::kTempRender];
+    item.m_nBytes += m_nIdleBytes;
+    item.m_nCount += m_idleRenders.size();
+}
+
+std::unique_ptr<IRender> RenderSurfacePool::CreateRender(int32_t nWidth, int32_t nHeight) const
+{
+    std::unique_ptr<IRender> spRender;
+    IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactory != nullptr);
+    if ((pRenderFactory == nullptr) || (m_pWindow == nullptr)) {
+        return spRender;
+    }
+    spRender.reset(pRenderFactory->CreateRender(m_pWindow->GetRenderDpi()));
+    if ((spRender != nullptr) && !spRender->Resize(nWidth, nHeight)) {
+        ASSERT(!"RenderSurfacePool: Resize failed!");
+        spRender.reset();
+    }
+    if (spRender != nullptr) {
+        MemoryStat::Add(MemoryCategory::kTempRender, (int64_t)GetSurfaceBytes(spRender.get()), 1);
+    }
+    return spRender;
+}
+
+void RenderSurfacePool::DestroyRender(std::unique_ptr<IRender>& spRender) const
+{
+    if (spRender != nullptr) {
+        MemoryStat::Add(MemoryCategory::kTempRender, -(int64_t)GetSurfaceBytes(spRender.get()), -1);
+        spRender.reset();
+    }
+}
+
+void RenderSurfacePool::TrimIdleRenders()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto idleTime = std::chrono::milliseconds(m_nIdleTime);
+    //空闲列表按归还时间排序，只需要释放开头的部分
+    size_t nTrimCount = 0;
+    while ((nTrimCount < m_idleRenders.size()) && ((now - m_idleRenders[nTrimCount].m_idleTime) >= idleTime)) {
+        TIdleRender& idleRender = m_idleRenders[nTrimCount];
+        m_nIdleBytes -= GetSurfaceBytes(idleRender.m_spRender.get());
+        DestroyRender(idleRender.m_spRender);
+        ++nTrimCount;
+    }
+    if (nTrimCount > 0) {
+        m_idleRenders.erase(m_idleRenders.begin(), m_idleRenders.begin() + nTrimCount);
+    }
+    if (m_idleRenders.empty()) {
+        m_trimTimerFlag.Cancel();
+    }
+}
+
+void RenderSurfacePool::TrimIdleBytes()
+{
+    size_t nTrimCount = 0;
+    while ((nTrimCount < m_idleRenders.size()) && (m_nIdleBytes > m_nMaxIdleBytes)) {
+        TIdleRender& idleRender = m_idleRenders[nTrimCount];
+        m_nIdleBytes -= GetSurfaceBytes(idleRender.m_spRender.get());
+        DestroyRender(idleRender.m_spRender);
+        ++nTrimCount;
+    }
+    if (nTrimCount > 0) {
+        m_idleRenders.erase(m_idleRenders.begin(), m_idleRenders.begin() + nTrimCount);
+    }
+}
+
+} //namespace ui
@@ -0,0 +1,112 @@
+#ifndef UI_CORE_RENDER_SURFACE_POOL_H_
+#define UI_CORE_RENDER_SURFACE_POOL_H_
+
+#include "duilib/Core/Callback.h"
+#include "duilib/Render/IRender.h"
+#include <chrono>
+#include <vector>
+
+namespace ui
+{
+class Window;
+struct WindowMemoryStat;
+
+/** 窗口级别的离屏绘制缓存池：控件设置透明度时，从缓存池中获取临时的离屏绘制缓存，绘制合成完成后立即归还，
+*   缓存按大小分级（宽和高分别向上取整到所在的级别），空闲的缓存超过内存上限时释放最久未使用的，空闲时间过长时定时释放
+*/
+class UILIB_API RenderSurfacePool
+{
+public:
+    explicit RenderSurfacePool(Window* pWindow);
+    ~RenderSurfacePool();
+    RenderSurfacePool(const RenderSurfacePool&) = delete;
+    RenderSurfacePool& operator = (const RenderSurfacePool&) = delete;
+
+public:
+    /** 获取一个离屏绘制缓存（宽和高不小于所需的大小，内容未清除），使用完成后需要调用ReleaseRender归还
+    * @param [in] nWidth 所需的宽度
+    * @param [in] nHeight 所需的高度
+    * @return 失败时返回nullptr
+    */
+    std::unique_ptr<IRender> AcquireRender(int32_t nWidth, int32_t nHeight);
+
+    /** 归还一个离屏绘制缓存（必须是由AcquireRender获取的）
+    * @param [in] spRender 离屏绘制缓存，函数返回后为nullptr
+    */
+    void ReleaseRender(std::unique_ptr<IRender>& spRender);
+
+    /** 设置空闲缓存的内存上限（字节），超过上限时释放最久未使用的缓存
+    */
+    void SetMaxIdleBytes(size_t nMaxIdleBytes);
+
+    /** 获取空闲缓存的内存上限（字节）
+    */
+    size_t GetMaxIdleBytes() const;
+
+    /** 设置缓存的最长空闲时间（毫秒），超过该时间未使用的缓存将被释放
+    */
+    void SetIdleTime(uint32_t nIdleTimeMs);
+
+    /** 获取缓存的最长空闲时间（毫秒）
+    */
+    uint32_t GetIdleTime() const;
+
+    /** 释放所有空闲的缓存
+    */
+    void Clear();
+
+    /** 统计空闲缓存占用的内存，累加到窗口的内存统计数据中
+    */
+    void GetMemoryStat(WindowMemoryStat& stat) const;
+
+private:
+    /** 创建一个离屏绘制缓存
+    */
+    std::unique_ptr<IRender> CreateRender(int32_t nWidth, int32_t nHeight) const;
+
+    /** 释放一个离屏绘制缓存
+    */
+    void DestroyRender(std::unique_ptr<IRender>& spRender) const;
+
+    /** 释放空闲时间超过限制的缓存
+    */
+    void TrimIdleRenders();
+
+    /** 释放最久未使用的缓存，直到空闲缓存占用的内存不超过上限
+    */
+    void TrimIdleBytes();
+
+private:
+    /** 关联的窗口
+    */
+    Window* m_pWindow;
+
+    /** 空闲的缓存（按归还的时间排序，最后归还的在最后）
+    */
+    struct TIdleRender
+    {
+        std::unique_ptr<IRender> m_spRender;
+        std::chrono::steady_clock::time_point m_idleTime;
+    };
+    std::vector<TIdleRender> m_idleRenders;
+
+    /** 空闲缓存占用的内存（字节）
+    */
+    size_t m_nIdleBytes;
+
+    /** 空闲缓存的内存上限（字节）
+    */
+    size_t m_nMaxIdleBytes;
+
+    /** 缓存的最长空闲时间（毫秒）
+    */
+    uint32_t m_nIdleTime;
+
+    /** 空闲检查定时器的取消机制
+    */
+    WeakCallbackFlag m_trimTimerFlag;
+};
+
+} //namespace ui
+
+#endif //UI_CORE_RENDER_SURFACE_POOL_H_
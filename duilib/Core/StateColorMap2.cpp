@@ -17,7 +17,7 @@ void StateColorMap2::SetStateColor(ControlStateType stateType, const DString& co
     size_t nIndex = (size_t)stateType;
     ASSERT(nIndex < m_stateColors.size());
     if (nIndex < m_stateColors.size()) {
-        m_stateColors[nIndex].m_colorStr = color;
+        m_stateColors[nIndex].m_colorStr = UiString::Intern(color);
     }
 }
 
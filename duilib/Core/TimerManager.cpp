@@ -5,14 +5,13 @@
 #include "duilib/Core/WindowMessage.h"
 
 #if defined (DUILIB_BUILD_FOR_SDL)
+    #include "duilib/Core/MessageLoop_SDL.h"
     #include <SDL3/SDL.h>
 #endif
 
-/** 自定义消息
+/** 自定义消息（SDL版本的定义见MessageLoop_SDL.h）
 */
-#if defined (DUILIB_BUILD_FOR_SDL)
-    #define WM_USER_DEFINED_TIMER   (SDL_EVENT_USER + 2)
-#else
+#if !defined (DUILIB_BUILD_FOR_SDL)
     #define WM_USER_DEFINED_TIMER   (kWM_USER + 567)
 #endif
 
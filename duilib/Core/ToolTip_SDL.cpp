@@ -117,9 +117,12 @@ public:
     //定时器的有效性保证
     std::weak_ptr<WeakFlag> m_hoverFlag;
 
-    //Tooltip自身的窗口
+    //Tooltip自身的窗口（每个父窗口创建一次，隐藏后再次显示时复用）
     ControlPtrT<ToolTipWindow> m_pTooltipWnd;
 
+    //Tooltip窗口的阴影大小（创建窗口时从XML中解析，复用窗口时无需再次解析）
+    UiPadding m_rcShadowCorner;
+
     //鼠标跟踪状态
     bool m_bMouseTracking;
 
@@ -200,21 +203,25 @@ void ToolTip::TImpl::ShowToolTip(WindowBase* pParentWnd,
     UiPoint windowPos = trackPos;
     if ((m_pTooltipWnd == nullptr) || m_pTooltipWnd->IsClosingWnd()) {
         m_pTooltipWnd = new ToolTipWindow;
-    }    
-    DString skinFolder = m_pTooltipWnd->GetSkinFolder();
-    DString skinFile = m_pTooltipWnd->GetSkinFile();
-    FilePath xmlPath(skinFolder);
-    xmlPath.NormalizeDirectoryPath();
-    xmlPath += skinFile;
-
-    UiPadding rcShadowCorner;
-    WindowBuilder windowBuilder;
-    if (windowBuilder.ParseXmlFile(xmlPath)) {
-        WindowCreateAttributes createAttributes;
-        if (windowBuilder.ParseWindowCreateAttributes(createAttributes)) {
-            rcShadowCorner = createAttributes.m_rcShadowCorner;
+    }
+    if (!m_pTooltipWnd->IsWindow()) {
+        //创建窗口前，解析窗口的阴影大小
+        DString skinFolder = m_pTooltipWnd->GetSkinFolder();
+        DString skinFile = m_pTooltipWnd->GetSkinFile();
+        FilePath xmlPath(skinFolder);
+        xmlPath.NormalizeDirectoryPath();
+        xmlPath += skinFile;
+
+        m_rcShadowCorner.Clear();
+        WindowBuilder windowBuilder;
+        if (windowBuilder.ParseXmlFile(xmlPath)) {
+            WindowCreateAttributes createAttributes;
+            if (windowBuilder.ParseWindowCreateAttributes(createAttributes)) {
+                m_rcShadowCorner = createAttributes.m_rcShadowCorner;
+            }
         }
     }
+    UiPadding rcShadowCorner = m_rcShadowCorner;
 
     WindowCreateParam createParam;
     createParam.m_nX = windowPos.x + pParentWnd->Dpi().GetScaleInt(10); //在鼠标点，向右的偏移
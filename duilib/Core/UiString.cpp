@@ -0,0 +1,112 @@
+#include "UiString.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace ui
+{
+
+/** 驻留表的数据：以字符串内容为索引（索引引用数据块中的字符串数据）
+*/
+template<typename T>
+struct TInternTableData
+{
+    std::mutex m_mutex;
+    std::unordered_map<std::basic_string_view<T>, UiStringBufferT<T>*> m_buffers;
+};
+
+/** 获取驻留表的数据：不释放，因为静态对象析构时，可能还有驻留字符串未释放
+*/
+template<typename T>
+static TInternTableData<T>& GetInternTableData()
+{
+    static TInternTableData<T>* s_pTableData = new TInternTableData<T>;
+    return *s_pTableData;
+}
+
+template<typename T>
+static UiStringBufferT<T>* InternString(const T* str, size_t nLength)
+{
+    ASSERT((str != nullptr) && (nLength > 0) && (nLength < UINT32_MAX));
+    if ((str == nullptr) || (nLength == 0) || (nLength >= UINT32_MAX)) {
+        return nullptr;
+    }
+    TInternTableData<T>& tableData = GetInternTableData<T>();
+    std::lock_guard<std::mutex> threadGuard(tableData.m_mutex);
+    auto iter = tableData.m_buffers.find(std::basic_string_view<T>(str, nLength));
+    if (iter != tableData.m_buffers.end()) {
+        iter->second->m_nRefCount.fetch_add(1, std::memory_order_relaxed);
+        return iter->second;
+    }
+    void* pMemory = ::operator new(sizeof(UiStringBufferT<T>) + (nLength + 1) * sizeof(T));
+    UiStringBufferT<T>* pBuffer = new (pMemory) UiStringBufferT<T>;
+    pBuffer->m_nRefCount.store(1, std::memory_order_relaxed);
+    pBuffer->m_nLength = static_cast<uint32_t>(nLength);
+    pBuffer->m_bInterned = true;
+    std::char_traits<T>::copy(pBuffer->Chars(), str, nLength);
+    pBuffer->Chars()[nLength] = '\0';
+    tableData.m_buffers[std::basic_string_view<T>(pBuffer->Chars(), nLength)] = pBuffer;
+    return pBuffer;
+}
+
+template<typename T>
+static void ReleaseInternString(UiStringBufferT<T>* pBuffer)
+{
+    ASSERT((pBuffer != nullptr) && pBuffer->m_bInterned);
+    if (pBuffer == nullptr) {
+        return;
+    }
+    //不是最后一个引用时，不需要加锁
+    int32_t nRefCount = pBuffer->m_nRefCount.load(std::memory_order_relaxed);
+    while (nRefCount > 1) {
+        if (pBuffer->m_nRefCount.compare_exchange_weak(nRefCount, nRefCount - 1, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+    //最后一个引用：加锁后再减少引用计数，避免与查找操作冲突（查找操作在锁内增加引用计数）
+    TInternTableData<T>& tableData = GetInternTableData<T>();
+    std::lock_guard<std::mutex> threadGuard(tableData.m_mutex);
+    if (pBuffer->m_nRefCount.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    tableData.m_buffers.erase(std::basic_string_view<T>(pBuffer->Chars(), pBuffer->m_nLength));
+    pBuffer->~UiStringBufferT<T>();
+    ::operator delete(pBuffer);
+}
+
+UiStringBufferT<char>* UiStringInternTable::Intern(const char* str, size_t nLength)
+{
+    return InternString(str, nLength);
+}
+
+UiStringBufferT<wchar_t>* UiStringInternTable::Intern(const wchar_t* str, size_t nLength)
+{
+    return InternString(str, nLength);
+}
+
+void UiStringInternTable::Release(UiStringBufferT<char>* pBuffer)
+{
+    ReleaseInternString(pBuffer);
+}
+
+void UiStringInternTable::Release(UiStringBufferT<wchar_t>* pBuffer)
+{
+    ReleaseInternString(pBuffer);
+}
+
+size_t UiStringInternTable::GetCount()
+{
+    size_t nCount = 0;
+    {
+        TInternTableData<char>& tableData = GetInternTableData<char>();
+        std::lock_guard<std::mutex> threadGuard(tableData.m_mutex);
+        nCount += tableData.m_buffers.size();
+    }
+    {
+        TInternTableData<wchar_t>& tableData = GetInternTableData<wchar_t>();
+        std::lock_guard<std::mutex> threadGuard(tableData.m_mutex);
+        nCount += tableData.m_buffers.size();
+    }
+    return nCount;
+}
+
+}//namespace ui
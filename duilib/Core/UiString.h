@@ -2,73 +2,162 @@
 #define UI_CORE_UISTRING_H_
 
 #include "duilib/Utils/StringUtil.h"
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <new>
 
 namespace ui
 {
 
+/** UiStringT使用的堆上字符串数据块（数据块创建后不再修改，多个UiStringT对象共享同一个数据块，使用引用计数管理生命周期）
+*   数据块的头部之后，紧跟着字符串数据（以'\0'结尾）
+*/
+template<typename T>
+struct UiStringBufferT
+{
+    /** 引用计数
+    */
+    std::atomic<int32_t> m_nRefCount;
+
+    /** 字符串的长度（不含结尾的'\0'）
+    */
+    uint32_t m_nLength;
+
+    /** 是否为字符串驻留表中的数据块
+    */
+    bool m_bInterned;
+
+    /** 获取字符串数据
+    */
+    T* Chars() { return reinterpret_cast<T*>(this + 1); }
+    const T* Chars() const { return reinterpret_cast<const T*>(this + 1); }
+};
+
+/** 字符串驻留表：相同内容的标识类字符串（控件名称、颜色名称、类名等）共享一个数据块
+*   数据块的引用计数为0时，从驻留表中移除，驻留表是线程安全的
+*/
+class UILIB_API UiStringInternTable
+{
+public:
+    /** 获取字符串对应的驻留数据块（不存在时创建），返回的数据块引用计数已增加
+    * @param [in] str 字符串数据，不能为空串
+    * @param [in] nLength 字符串的长度
+    */
+    static UiStringBufferT<char>* Intern(const char* str, size_t nLength);
+    static UiStringBufferT<wchar_t>* Intern(const wchar_t* str, size_t nLength);
+
+    /** 释放驻留数据块的一个引用（引用计数为0时，从驻留表中移除并释放）
+    */
+    static void Release(UiStringBufferT<char>* pBuffer);
+    static void Release(UiStringBufferT<wchar_t>* pBuffer);
+
+    /** 获取驻留表中的字符串个数
+    */
+    static size_t GetCount();
+};
+
 /** 控件使用的字符串，用于替代DString，以减少控件的内存占用
-*   该类适合用于较低的内存空间来存储字符串，性能方面由于字符串复制偏多，性能偏弱
+*   对象大小与一个指针相同：短字符串直接存储在对象内部，不分配内存；
+*   长字符串存储在堆上的数据块中，数据块不可修改，对象复制时共享数据块（只增加引用计数）；
+*   通过Intern函数创建的字符串使用驻留表中的数据块，两个驻留字符串内容相同时，数据块也相同，可直接按指针比较
 */
 template<typename T>
 class UILIB_API UiStringT
 {
     using string_type = std::basic_string<T, std::char_traits<T>, std::allocator<T>>;
     using value_type = typename string_type::value_type;
+    using view_type = std::basic_string_view<value_type>;
+    using buffer_type = UiStringBufferT<value_type>;
 public:
-    UiStringT(): m_pData(nullptr) {}
-    UiStringT(const UiStringT& str) : m_pData(nullptr)
+    UiStringT() { ::memset(m_szData, 0, sizeof(m_szData)); }
+    UiStringT(const UiStringT& str)
     {
-        if (!str.empty()) {
-            size_t strSize = StringUtil::StringLen(str.c_str());
-            m_pData = new value_type[strSize + 1];
-            StringUtil::StringCopy(m_pData, strSize + 1, str.c_str());
+        ::memcpy(m_szData, str.m_szData, sizeof(m_szData));
+        buffer_type* pBuffer = GetBuffer();
+        if (pBuffer != nullptr) {
+            pBuffer->m_nRefCount.fetch_add(1, std::memory_order_relaxed);
         }
     }
-    UiStringT(const string_type& str) : m_pData(nullptr)
+    UiStringT(UiStringT&& str) noexcept
     {
-        if (!str.empty()) {
-            size_t strSize = StringUtil::StringLen(str.c_str());
-            m_pData = new value_type[strSize + 1];
-            StringUtil::StringCopy(m_pData, strSize + 1, str.c_str());
-        }
+        ::memcpy(m_szData, str.m_szData, sizeof(m_szData));
+        ::memset(str.m_szData, 0, sizeof(str.m_szData));
     }
-    UiStringT(const std::basic_string_view<value_type>& str) : m_pData(nullptr)
+    UiStringT(const string_type& str)
     {
-        if (!str.empty()) {
-            size_t strSize = str.size();
-            m_pData = new value_type[strSize + 1];
-            StringUtil::StringCopy(m_pData, strSize + 1, str.data());
-        }
+        Assign(str.c_str(), str.size());
     }
-    UiStringT(const value_type* pstr) : m_pData(nullptr)
+    UiStringT(const view_type& str)
+    {
+        Assign(str.data(), str.size());
+    }
+    UiStringT(const value_type* pstr)
     {
         if (pstr != nullptr) {
-            std::basic_string_view<value_type> str(pstr);
-            if (!str.empty()) {
-                size_t strSize = str.size();
-                m_pData = new value_type[strSize + 1];
-                StringUtil::StringCopy(m_pData, strSize + 1, str.data());
-            }
+            Assign(pstr, std::char_traits<value_type>::length(pstr));
+        }
+        else {
+            Assign(nullptr, 0);
         }
     }
     ~UiStringT()
-    { 
-        if (m_pData != nullptr) {
-            delete[] m_pData;
-            m_pData = nullptr;
-        }
+    {
+        Release();
     }
+
 public:
+    /** 创建一个驻留字符串（适用于控件名称、颜色名称、类名等标识类字符串，相同内容的字符串共享一个数据块）
+    * @param [in] str 字符串内容
+    */
+    static UiStringT Intern(const view_type& str)
+    {
+        UiStringT result;
+        if (str.empty() || (str.size() <= kInlineCapacity)) {
+            //短字符串直接存储在对象内部，内容相同时对象数据也相同
+            result.Assign(str.data(), str.size());
+        }
+        else {
+            result.SetBuffer(UiStringInternTable::Intern(str.data(), str.size()));
+        }
+        return result;
+    }
 
-    bool empty() const { return (m_pData == nullptr) || (m_pData[0] == '\0'); }
+    /** 是否为驻留字符串（使用驻留表中的数据块，短字符串不使用数据块，返回false）
+    */
+    bool IsInterned() const
+    {
+        const buffer_type* pBuffer = GetBuffer();
+        return (pBuffer != nullptr) && pBuffer->m_bInterned;
+    }
+
+public:
+    bool empty() const { return size() == 0; }
     const value_type* data() const { return c_str(); }
-    const value_type* c_str() const;
-    void clear() 
+    const value_type* c_str() const
+    {
+        if (IsInline()) {
+            return m_szData + 1;
+        }
+        const buffer_type* pBuffer = GetBuffer();
+        if (pBuffer != nullptr) {
+            return pBuffer->Chars();
+        }
+        return EmptyString();
+    }
+    size_t size() const
     {
-        if (m_pData != nullptr) {
-            delete[] m_pData;
-            m_pData = nullptr;
+        if (IsInline()) {
+            return static_cast<size_t>(static_cast<std::make_unsigned_t<value_type>>(m_szData[0]) >> 1);
         }
+        const buffer_type* pBuffer = GetBuffer();
+        return (pBuffer != nullptr) ? pBuffer->m_nLength : 0;
+    }
+    size_t length() const { return size(); }
+    void clear()
+    {
+        Release();
+        ::memset(m_szData, 0, sizeof(m_szData));
     }
 
     UiStringT& operator=(const UiStringT& str)
@@ -76,76 +165,49 @@ public:
         if (&str == this) {
             return *this;
         }
-        if (m_pData != nullptr) {
-            delete[] m_pData;
-            m_pData = nullptr;
-        }
-        if (!str.empty()) {
-            size_t strSize = StringUtil::StringLen(str.c_str());
-            m_pData = new value_type[strSize + 1];
-            StringUtil::StringCopy(m_pData, strSize + 1, str.c_str());
-        }
+        UiStringT temp(str);
+        Swap(temp);
         return *this;
     }
 
-    UiStringT& operator=(const string_type& str)
+    UiStringT& operator=(UiStringT&& str) noexcept
     {
-        if (m_pData != nullptr) {
-            delete[] m_pData;
-            m_pData = nullptr;
-        }
-        if (!str.empty()) {
-            size_t strSize = str.size();
-            m_pData = new value_type[strSize + 1];
-            StringUtil::StringCopy(m_pData, strSize + 1, str.c_str());
+        if (&str != this) {
+            Release();
+            ::memcpy(m_szData, str.m_szData, sizeof(m_szData));
+            ::memset(str.m_szData, 0, sizeof(str.m_szData));
         }
         return *this;
     }
 
-    UiStringT& operator=(const std::basic_string_view<value_type>& str)
+    UiStringT& operator=(const string_type& str)
     {
-        if (m_pData != nullptr) {
-            delete[] m_pData;;
-            m_pData = nullptr;
-        }
-        if (!str.empty()) {
-            size_t strSize = str.size();
-            m_pData = new value_type[strSize + 1];
-            StringUtil::StringNCopy(m_pData, strSize + 1, str.data(), str.size());
+        return operator=(view_type(str));
+    }
+
+    UiStringT& operator=(const view_type& str)
+    {
+        if (view_type(c_str(), size()) == str) {
+            return *this;
         }
+        //先创建新数据，再释放旧数据（str可能引用本对象的数据）
+        UiStringT temp(str);
+        Swap(temp);
         return *this;
     }
 
     UiStringT& operator=(const value_type* pstr)
     {
-        if (m_pData != nullptr) {
-            delete[] m_pData;;
-            m_pData = nullptr;
-        }
-        if (pstr != nullptr) {
-            std::basic_string_view<value_type> str(pstr);
-            if (!str.empty()) {
-                size_t strSize = str.size();
-                m_pData = new value_type[strSize + 1];
-                StringUtil::StringNCopy(m_pData, strSize + 1, str.data(), str.size());
-            }
+        if (pstr == nullptr) {
+            clear();
+            return *this;
         }
-        return *this;
+        return operator=(view_type(pstr));
     }
 
     bool equals(const string_type& str) const
     {
-        if (str.empty()) {
-            return empty();
-        }
-        else {
-            if (m_pData == nullptr) {
-                return false;
-            }
-            else {
-                return StringUtil::StringCompare(m_pData, str.c_str()) == 0;
-            }
-        }
+        return view_type(c_str(), size()) == view_type(str);
     }
 
     bool equals(const value_type* str) const
@@ -153,29 +215,20 @@ public:
         if ((str == nullptr) || (str[0] == '\0')) {
             return empty();
         }
-        else {
-            if (m_pData == nullptr) {
-                return false;
-            }
-            else {
-                return StringUtil::StringCompare(m_pData, str) == 0;
-            }
-        }
+        return view_type(c_str(), size()) == view_type(str);
     }
 
     bool equals(const UiStringT& str) const
     {
-        if (str.empty()) {
-            return empty();
+        if (::memcmp(m_szData, str.m_szData, sizeof(m_szData)) == 0) {
+            //同一个数据块，或者内部存储的内容相同
+            return true;
         }
-        else {
-            if (m_pData == nullptr) {
-                return false;
-            }
-            else {
-                return StringUtil::StringCompare(m_pData, str.c_str()) == 0;
-            }
+        if (IsInterned() && str.IsInterned()) {
+            //驻留字符串：内容相同则数据块相同
+            return false;
         }
+        return view_type(c_str(), size()) == view_type(str.c_str(), str.size());
     }
 
     friend bool operator==(const UiStringT& a, const UiStringT& b) {
@@ -208,21 +261,113 @@ public:
     friend bool operator!=(const value_type* a, const UiStringT& b) {
         return !b.equals(a);
     }
+
+private:
+    /** 对象内部存储的字符个数（与一个指针的大小相同）
+    */
+    static constexpr size_t kDataCount = sizeof(void*) / sizeof(value_type);
+
+    /** 对象内部可存储的字符串最大长度：第1个字符存储标志位和长度，最后一个字符存储'\0'
+    *   标志位位于指针的最低位（堆上数据块的地址是对齐的，最低位为0），仅小端字节序的平台支持内部存储
+    */
+    static constexpr size_t kInlineCapacity = ((std::endian::native == std::endian::little) && (kDataCount > 2)) ? (kDataCount - 2) : 0;
+
+    /** 空字符串
+    */
+    static const value_type* EmptyString();
+
+    /** 字符串是否存储在对象内部
+    */
+    bool IsInline() const
+    {
+        return (kInlineCapacity > 0) && ((m_szData[0] & 1) != 0);
+    }
+
+    /** 获取堆上的数据块（字符串存储在对象内部或者为空时，返回nullptr）
+    */
+    buffer_type* GetBuffer() const
+    {
+        if (IsInline()) {
+            return nullptr;
+        }
+        buffer_type* pBuffer = nullptr;
+        ::memcpy(&pBuffer, m_szData, sizeof(pBuffer));
+        return pBuffer;
+    }
+
+    /** 设置堆上的数据块（引用计数由调用方增加）
+    */
+    void SetBuffer(buffer_type* pBuffer)
+    {
+        ::memcpy(m_szData, &pBuffer, sizeof(pBuffer));
+    }
+
+    /** 设置字符串数据（不释放原来的数据）
+    */
+    void Assign(const value_type* str, size_t nLength)
+    {
+        ::memset(m_szData, 0, sizeof(m_szData));
+        if ((str == nullptr) || (nLength == 0)) {
+            return;
+        }
+        if (nLength <= kInlineCapacity) {
+            m_szData[0] = static_cast<value_type>((nLength << 1) | 1);
+            std::char_traits<value_type>::copy(m_szData + 1, str, nLength);
+            return;
+        }
+        ASSERT(nLength < UINT32_MAX);
+        void* pMemory = ::operator new(sizeof(buffer_type) + (nLength + 1) * sizeof(value_type));
+        buffer_type* pBuffer = new (pMemory) buffer_type;
+        pBuffer->m_nRefCount.store(1, std::memory_order_relaxed);
+        pBuffer->m_nLength = static_cast<uint32_t>(nLength);
+        pBuffer->m_bInterned = false;
+        std::char_traits<value_type>::copy(pBuffer->Chars(), str, nLength);
+        pBuffer->Chars()[nLength] = '\0';
+        SetBuffer(pBuffer);
+    }
+
+    /** 释放堆上数据块的引用（不清除对象数据）
+    */
+    void Release()
+    {
+        buffer_type* pBuffer = GetBuffer();
+        if (pBuffer == nullptr) {
+            return;
+        }
+        if (pBuffer->m_bInterned) {
+            UiStringInternTable::Release(pBuffer);
+        }
+        else if (pBuffer->m_nRefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            pBuffer->~buffer_type();
+            ::operator delete(pBuffer);
+        }
+    }
+
+    /** 交换两个对象的数据
+    */
+    void Swap(UiStringT& str)
+    {
+        value_type szTemp[kDataCount];
+        ::memcpy(szTemp, m_szData, sizeof(m_szData));
+        ::memcpy(m_szData, str.m_szData, sizeof(m_szData));
+        ::memcpy(str.m_szData, szTemp, sizeof(m_szData));
+    }
+
 private:
-    //字符串数据
-    value_type* m_pData;
+    //字符串数据：内部存储的短字符串，或者堆上数据块的地址
+    alignas(void*) value_type m_szData[kDataCount];
 };
 
 template <>
-inline const DStringW::value_type* UiStringT<DStringW::value_type>::c_str() const
+inline const DStringW::value_type* UiStringT<DStringW::value_type>::EmptyString()
 {
-    return (m_pData != nullptr) ? m_pData : L"";
+    return L"";
 }
 
 template <>
-inline const DStringA::value_type* UiStringT<DStringA::value_type>::c_str() const
+inline const DStringA::value_type* UiStringT<DStringA::value_type>::EmptyString()
 {
-    return (m_pData != nullptr) ? m_pData : "";
+    return "";
 }
 
 /** 模板类型定义
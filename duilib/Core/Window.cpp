@@ -7,11 +7,16 @@
 #include "duilib/Core/ToolTip.h"
 #include "duilib/Core/Keyboard.h"
 #include "duilib/Core/WindowMessage.h"
+#include "duilib/Core/RenderSurfacePool.h"
+#include "duilib/Animation/AnimationClock.h"
 #include "duilib/Render/IRender.h"
 #include "duilib/Render/AutoClip.h"
 #include "duilib/Utils/PerformanceUtil.h"
 #include "duilib/Utils/FilePathUtil.h"
 #include "duilib/Utils/AttributeUtil.h"
+#include "duilib/Image/Image.h"
+#include "duilib/Image/ImageLoadParam.h"
+#include <set>
 
 namespace ui
 {
@@ -30,7 +35,10 @@ Window::Window() :
     m_renderBackendType(RenderBackendType::kRaster_BackendType),
     m_bWindowAttributesApplied(false),
     m_bCheckSetWindowFocus(false),
-    m_bControlFullscreen(false)
+    m_bControlFullscreen(false),
+    m_bScrollCopied(false),
+    m_bEnableParallelPaint(false),
+    m_bEnablePrefetchImages(false)
 {
     m_toolTip = std::make_unique<ToolTip>();
 }
@@ -66,6 +74,14 @@ void Window::SetAttribute(const DString& strName, const DString& strValue)
         //分层窗口的透明度
         SetLayeredWindowAlpha(StringUtil::StringToInt32(strValue));
     }
+    else if (strName == _T("parallel_paint")) {
+        //是否开启并行绘制
+        SetEnableParallelPaint(strValue == _T("true"));
+    }
+    else if (strName == _T("prefetch_images")) {
+        //是否在创建窗口时预取图片
+        SetEnablePrefetchImages(strValue == _T("true"));
+    }
 }
 
 void Window::SetEnableDragDrop(bool bEnable)
@@ -235,6 +251,7 @@ void Window::GetCreateWindowAttributes(WindowCreateAttributes& createAttributes)
 
 void Window::ParseWindowXml()
 {
+    PerformanceStat statPerformance(_T("BuildWindow, Window::ParseWindowXml"));
     FilePath skinFolder(GetSkinFolder());
     DString xmlFile = GetSkinFile();
     if (skinFolder.IsEmpty() && xmlFile.empty()) {
@@ -318,6 +335,25 @@ void Window::PreInitWindow()
         ParseWindowXml();
     }
 
+    //预取XML中引用的图片（在子线程中解码，与创建控件并行执行）
+    bool bPrefetchImages = false;
+    if (m_windowBuilder != nullptr) {
+        bPrefetchImages = IsEnablePrefetchImages();
+        if (!bPrefetchImages) {
+            //窗口的属性在创建控件时才设置，所以需要从XML中读取该属性
+            std::map<DString, DString> windowAttributes;
+            if (m_windowBuilder->ParseWindowAttributes(windowAttributes)) {
+                auto iter = windowAttributes.find(_T("prefetch_images"));
+                bPrefetchImages = (iter != windowAttributes.end()) && (iter->second == _T("true"));
+            }
+        }
+        if (bPrefetchImages) {
+            std::vector<DString> imageStrings;
+            m_windowBuilder->GetImageStrings(imageStrings);
+            PrefetchImages(imageStrings, false);
+        }
+    }
+
     Box* pRoot = nullptr;
     if (m_windowBuilder != nullptr) {
         auto callback = UiBind(&Window::CreateControl, this, std::placeholders::_1);
@@ -341,6 +377,11 @@ void Window::PreInitWindow()
         //更新自绘制标题栏状态
         OnUseSystemCaptionBarChanged();
     }
+
+    if (bPrefetchImages) {
+        //窗口显示前，等待预取的图片解码完成
+        GlobalManager::Instance().Image().WaitPrefetchImages();
+    }
 }
 
 void Window::PostInitWindow()
@@ -415,8 +456,11 @@ void Window::ClearWindow()
     ReapObjects(GetRoot());
 
     m_controlFinder.Clear();
+    m_arrangeControls.clear();
     m_toolTip.reset();
     m_shadow.reset();
+    m_renderSurfacePool.reset();
+    m_animationClock.reset();
     m_render.reset();
 
     Box* pRoot = m_pRoot.get();
@@ -1212,6 +1256,191 @@ bool Window::OnPreparePaint()
     return true;
 }
 
+//记录的重绘区域个数上限，超过时合并为一个区域
+#define MAX_INVALIDATE_RECT_COUNT 32
+
+void Window::OnInvalidate(const UiRect& rcItem)
+{
+    if (rcItem.IsEmpty()) {
+        return;
+    }
+    for (const UiRect& rc : m_invalidateRects) {
+        if (rc.ContainsRect(rcItem)) {
+            return;
+        }
+    }
+    if (m_invalidateRects.size() >= MAX_INVALIDATE_RECT_COUNT) {
+        UiRect rcUnion = rcItem;
+        for (const UiRect& rc : m_invalidateRects) {
+            rcUnion.Union(rc);
+        }
+        m_invalidateRects.clear();
+        m_invalidateRects.push_back(rcUnion);
+    }
+    else {
+        m_invalidateRects.push_back(rcItem);
+    }
+}
+
+bool Window::ScrollWindowRect(const UiRect& rcScroll, int32_t dx, int32_t dy)
+{
+    GlobalManager::Instance().AssertUIThread();
+    if (!IsWindow() || (m_render == nullptr) || !IsWindowFirstShown()) {
+        return false;
+    }
+    if (IsLayeredWindow()) {
+        //层窗口每次绘制时需要处理透明通道，不支持
+        return false;
+    }
+    if ((m_renderOffset.x != 0) || (m_renderOffset.y != 0)) {
+        //窗口动画过程中，不支持
+        return false;
+    }
+    UiRect rcClient;
+    GetClientRect(rcClient);
+    if ((m_render->GetWidth() != rcClient.Width()) || (m_render->GetHeight() != rcClient.Height())) {
+        return false;
+    }
+    UiRect rcScrollRect = rcScroll;
+    if (!rcScrollRect.Intersect(rcClient)) {
+        return false;
+    }
+    if (!m_render->ScrollRect(rcScrollRect, dx, dy)) {
+        return false;
+    }
+
+    //已标记为需要重绘、但尚未绘制的区域：其中的内容已经随之平移，平移后的位置也需要重绘
+    const std::vector<UiRect> invalidateRects = m_invalidateRects;
+    for (const UiRect& rc : invalidateRects) {
+        UiRect rcMoved;
+        if (UiRect::Intersect(rcMoved, rc, rcScrollRect)) {
+            rcMoved.Offset(dx, dy);
+            if (rcMoved.Intersect(rcScrollRect)) {
+                Invalidate(rcMoved);
+            }
+        }
+    }
+
+    //新露出的区域需要重绘
+    if (dy > 0) {
+        Invalidate(UiRect(rcScrollRect.left, rcScrollRect.top, rcScrollRect.right, rcScrollRect.top + dy));
+    }
+    else if (dy < 0) {
+        Invalidate(UiRect(rcScrollRect.left, rcScrollRect.bottom + dy, rcScrollRect.right, rcScrollRect.bottom));
+    }
+    if (dx > 0) {
+        Invalidate(UiRect(rcScrollRect.left, rcScrollRect.top, rcScrollRect.left + dx, rcScrollRect.bottom));
+    }
+    else if (dx < 0) {
+        Invalidate(UiRect(rcScrollRect.right + dx, rcScrollRect.top, rcScrollRect.right, rcScrollRect.bottom));
+    }
+
+    //整个区域需要重新显示到窗口，但只需重绘上面标记的区域
+    InvalidateNoPaint(rcScrollRect);
+    m_bScrollCopied = true;
+    m_szScrollCopyRender = UiSize(m_render->GetWidth(), m_render->GetHeight());
+    return true;
+}
+
+void Window::SetEnableParallelPaint(bool bEnable)
+{
+    m_bEnableParallelPaint = bEnable;
+}
+
+bool Window::IsEnableParallelPaint() const
+{
+    return m_bEnableParallelPaint;
+}
+
+void Window::SetEnablePrefetchImages(bool bEnable)
+{
+    m_bEnablePrefetchImages = bEnable;
+}
+
+bool Window::IsEnablePrefetchImages() const
+{
+    return m_bEnablePrefetchImages;
+}
+
+size_t Window::PrefetchImages(const std::vector<DString>& imageStrings, bool bWaitDecode)
+{
+    GlobalManager::Instance().AssertUIThread();
+    const uint32_t nLoadDpiScale = Dpi().GetDisplayScaleFactor();
+    const FilePath windowResPath = GetResourcePath();
+    const FilePath windowXmlPath = GetXmlPath();
+    IconManager& iconManager = GlobalManager::Instance().Icon();
+    std::vector<ImageLoadParam> loadParams;
+    std::set<DString> loadKeys;
+    for (const DString& imageString : imageStrings) {
+        Image image;
+        image.SetImageString(imageString, Dpi());
+        const DString sImagePath = image.GetImagePath();
+        if (sImagePath.empty() || iconManager.IsIconString(sImagePath)) {
+            //图标数据不需要预取
+            continue;
+        }
+        bool bLocalPath = true;
+        bool bResPath = true;
+        FilePath imageFullPath = GlobalManager::Instance().GetExistsResFullPath(windowResPath, windowXmlPath, FilePath(sImagePath),
+                                                                                nullptr, bLocalPath, bResPath);
+        if (imageFullPath.IsEmpty()) {
+            continue;
+        }
+        ImageLoadPath imageLoadPath;
+        imageLoadPath.m_imageFullPath = imageFullPath.NativePath();
+        if (bLocalPath) {
+            imageLoadPath.m_pathType = bResPath ? ImageLoadPathType::kLocalResPath : ImageLoadPathType::kLocalPath;
+        }
+        else {
+            imageLoadPath.m_pathType = ImageLoadPathType::kZipResPath;
+        }
+
+        ImageLoadParam loadParam = image.GetImageLoadParam();
+        loadParam.SetLoadDpiScale(nLoadDpiScale);
+        loadParam.SetImageLoadPath(imageLoadPath);
+        uint32_t nImageSetWidth = 0;
+        uint32_t nImageSetHeight = 0;
+        if (loadParam.GetImageFixedSize(nImageSetWidth, nImageSetHeight)) {
+            //与控件加载图片时的参数保持一致
+            loadParam.SetMaxDestRectSize(UiSize((int32_t)nImageSetWidth, (int32_t)nImageSetHeight));
+        }
+        if (loadKeys.insert(loadParam.GetLoadKey(nLoadDpiScale)).second) {
+            loadParams.push_back(loadParam);
+        }
+    }
+    if (loadParams.empty()) {
+        return 0;
+    }
+    ImageManager& imageManager = GlobalManager::Instance().Image();
+    size_t nPrefetchCount = imageManager.PrefetchImages(loadParams);
+    if (bWaitDecode) {
+        imageManager.WaitPrefetchImages();
+    }
+    return nPrefetchCount;
+}
+
+size_t Window::PrefetchXmlImages(const FilePath& xmlPath, bool bWaitDecode)
+{
+    ASSERT(!xmlPath.IsEmpty());
+    if (xmlPath.IsEmpty()) {
+        return 0;
+    }
+    WindowBuilder builder;
+    if (!builder.ParseXmlFile(xmlPath, GetResourcePath())) {
+        return 0;
+    }
+    std::vector<DString> imageStrings;
+    builder.GetImageStrings(imageStrings);
+    return PrefetchImages(imageStrings, bWaitDecode);
+}
+
+size_t Window::PrefetchClassImages(const DString& strClassList, bool bWaitDecode)
+{
+    std::vector<DString> imageStrings;
+    WindowBuilder::GetClassImageStrings(this, strClassList, imageStrings);
+    return PrefetchImages(imageStrings, bWaitDecode);
+}
+
 LRESULT Window::OnPaintMsg(const UiRect& rcPaint, const NativeMsg& /*nativeMsg*/, bool& bHandled)
 {
     PerformanceStat statPerformance(_T("PaintWindow, Window::OnPaintMsg"));
@@ -1229,6 +1458,9 @@ LRESULT Window::OnPaintMsg(const UiRect& rcPaint, const NativeMsg& /*nativeMsg*/
     return 0;
 }
 
+//开启并行绘制时，重绘区域的面积（像素）达到该值才使用并行绘制
+#define PARALLEL_PAINT_MIN_AREA (512 * 512)
+
 bool Window::Paint(const UiRect& rcPaint)
 {
     GlobalManager::Instance().AssertUIThread();
@@ -1238,12 +1470,34 @@ bool Window::Paint(const UiRect& rcPaint)
         return false;
     }
 
+    //需要重绘的区域：如果执行过滚动复制，只重绘标记为需要重绘的区域，其他区域直接显示已绘制的内容
+    std::vector<UiRect> paintRects;
+    if (m_bScrollCopied && IsWindowFirstShown() &&
+        (m_szScrollCopyRender.cx == pRender->GetWidth()) && (m_szScrollCopyRender.cy == pRender->GetHeight())) {
+        for (const UiRect& rc : m_invalidateRects) {
+            UiRect rcDirty;
+            if (UiRect::Intersect(rcDirty, rc, rcPaint)) {
+                paintRects.push_back(rcDirty);
+            }
+        }
+    }
+    else {
+        paintRects.push_back(rcPaint);
+    }
+    m_invalidateRects.clear();
+    m_bScrollCopied = false;
+
     //开始绘制前，去掉alpha通道
     if (IsLayeredWindow()) {
         PerformanceStat statPerformance(_T("PaintWindow, Window::Paint ClearAlpha"));
         pRender->ClearAlpha(rcPaint);
     }
 
+#if defined (DUILIB_BUILD_FOR_WIN) && !defined(DUILIB_RICH_EDIT_DRAW_OPT)
+    //记录本次绘制中是否有控件通过DC绘制（只有通过DC绘制时，才需要进行alpha通道修复）
+    pRender->ClearRenderDCUsed();
+#endif
+
     // 绘制
     Box* pRoot = GetRoot();
     if (pRoot == nullptr) {
@@ -1251,10 +1505,33 @@ bool Window::Paint(const UiRect& rcPaint)
     }
     if (pRoot->IsVisible()) {
         PerformanceStat statPerformance(_T("PaintWindow, Window::Paint Paint/PaintChild"));
-        AutoClip rectClip(pRender, rcPaint, true);
-        UiPoint ptOldWindOrg = pRender->OffsetWindowOrg(m_renderOffset);
-        pRoot->AlphaPaint(pRender, rcPaint);
-        pRender->SetWindowOrg(ptOldWindOrg);
+        auto paintRoot = [this, pRender, pRoot, &paintRects]() {
+            if (paintRects.empty()) {
+                return;
+            }
+            //多个脏区域合并为一个剪辑区域，控件树只绘制一次（绘制范围为所有脏区域的外接矩形）
+            UiRect rcPaintBounds = paintRects.front();
+            for (const UiRect& rcDirty : paintRects) {
+                rcPaintBounds.Union(rcDirty);
+            }
+            AutoClip regionClip(pRender, paintRects, true);
+            UiPoint ptOldWindOrg = pRender->OffsetWindowOrg(m_renderOffset);
+            pRender->BeginDrawImageBatch();
+            pRoot->AlphaPaint(pRender, rcPaintBounds);
+            pRender->EndDrawImageBatch();
+            pRender->SetWindowOrg(ptOldWindOrg);
+        };
+        //重绘区域较大时，记录绘制命令后分块并行绘制
+        bool bParallelPaint = false;
+        if (IsEnableParallelPaint() && ((int64_t)rcPaint.Width() * rcPaint.Height() >= PARALLEL_PAINT_MIN_AREA)) {
+            bParallelPaint = pRender->BeginRecordPaint(rcPaint);
+        }
+        paintRoot();
+        if (bParallelPaint && !pRender->EndRecordPaint()) {
+            //有控件直接访问了位图数据，记录的绘制命令无效：重新直接绘制，并关闭该窗口的并行绘制
+            SetEnableParallelPaint(false);
+            paintRoot();
+        }
     }
     else {
         UiColor bkColor = UiColor(UiColors::LightGray);
@@ -1265,8 +1542,8 @@ bool Window::Paint(const UiRect& rcPaint)
     }
 
 #if defined (DUILIB_BUILD_FOR_WIN) && !defined(DUILIB_RICH_EDIT_DRAW_OPT)
-    //开始绘制前，进行alpha通道修复
-    if (IsLayeredWindow()) {
+    //绘制完成后，进行alpha通道修复（仅当本次绘制中有控件通过DC绘制时需要修复）
+    if (IsLayeredWindow() && pRender->IsRenderDCUsed()) {
         PerformanceStat statPerformance(_T("PaintWindow, Window::Paint RestoreAlpha"));
         Shadow* pShadow = GetShadow();
         if ((pShadow != nullptr) && pShadow->IsShadowAttached() &&
@@ -2273,6 +2550,13 @@ void Window::SetArrange(bool bArrange)
     m_bIsArranged = bArrange;
 }
 
+void Window::AddArrangeControl(PlaceHolder* pControl)
+{
+    if (pControl != nullptr) {
+        m_arrangeControls.push_back(ControlPtrT<PlaceHolder>(pControl));
+    }
+}
+
 void Window::PostQuitMsgWhenClosed(bool bPostQuitMsg)
 {
     m_bPostQuitMsgWhenClosed = bPostQuitMsg;
@@ -2326,6 +2610,22 @@ std::shared_ptr<IRenderDpi> Window::GetRenderDpi()
     return spRenderDpi;
 }
 
+RenderSurfacePool* Window::GetRenderSurfacePool()
+{
+    if (m_renderSurfacePool == nullptr) {
+        m_renderSurfacePool = std::make_unique<RenderSurfacePool>(this);
+    }
+    return m_renderSurfacePool.get();
+}
+
+const std::shared_ptr<AnimationClock>& Window::GetAnimationClock()
+{
+    if (m_animationClock == nullptr) {
+        m_animationClock = std::make_shared<AnimationClock>();
+    }
+    return m_animationClock;
+}
+
 void Window::SetWindowAttributesApplied(bool bApplied)
 {
     m_bWindowAttributesApplied = bApplied;
@@ -2430,19 +2730,16 @@ void Window::ArrangeRoot()
         return;
     }
     if (m_bIsArranged) {
+        PerformanceStat statPerformance(_T("LayoutWindow, Window::ArrangeRoot"));
         m_bIsArranged = false;
         if (pRoot->IsArranged() || (pRoot->GetPos() != rcClient)) {
             //所有控件的布局全部重排
+            m_arrangeControls.clear();
             pRoot->SetPos(rcClient);
         }
         else {
             //仅对有更新的控件的布局全部重排
-            Control* pControl = pRoot->FindControl(ControlFinder::FindControlFromUpdate, nullptr, UIFIND_VISIBLE | UIFIND_ME_FIRST);
-            while (pControl != nullptr) {
-                pControl->SetPos(pControl->GetPos());
-                //ASSERT(!pControl->IsArranged());
-                pControl = pRoot->FindControl(ControlFinder::FindControlFromUpdate, nullptr, UIFIND_VISIBLE | UIFIND_ME_FIRST);
-            }
+            ArrangeQueuedControls(pRoot);
         }
         if (!m_bFirstLayout) {
             m_bFirstLayout = true;
@@ -2451,10 +2748,64 @@ void Window::ArrangeRoot()
     }
     else if (pRoot->GetPos() != rcClient) {
         //所有控件的布局全部重排
+        m_arrangeControls.clear();
         pRoot->SetPos(rcClient);
     }
 }
 
+void Window::ArrangeQueuedControls(Box* pRoot)
+{
+    ASSERT(pRoot != nullptr);
+    if (pRoot == nullptr) {
+        return;
+    }
+    typedef std::pair<int32_t, ControlPtrT<PlaceHolder>> ArrangeItem;
+    std::vector<ArrangeItem> arrangeItems;
+    while (!m_arrangeControls.empty()) {
+        //布局过程中，可能会有新的控件加入队列，所以每次取出当前队列中的全部控件处理
+        std::vector<ControlPtrT<PlaceHolder>> arrangeControls;
+        arrangeControls.swap(m_arrangeControls);
+
+        arrangeItems.clear();
+        arrangeItems.reserve(arrangeControls.size());
+        for (const ControlPtrT<PlaceHolder>& spControl : arrangeControls) {
+            PlaceHolder* pControl = spControl.get();
+            if ((pControl == nullptr) || !pControl->IsArranged() ||
+                (pControl->GetWindow() != this) || !pControl->IsVisible()) {
+                continue;
+            }
+            //计算控件在控件树中的深度，并过滤掉不在本窗口控件树中的控件以及祖先控件不可见的控件
+            int32_t nDepth = 0;
+            bool bAncestorVisible = true;
+            const PlaceHolder* pAncestor = pControl;
+            while (pAncestor->GetParent() != nullptr) {
+                pAncestor = pAncestor->GetParent();
+                if (!pAncestor->IsVisible()) {
+                    bAncestorVisible = false;
+                    break;
+                }
+                ++nDepth;
+            }
+            if (bAncestorVisible && (pAncestor == pRoot)) {
+                arrangeItems.emplace_back(nDepth, spControl);
+            }
+        }
+
+        //按深度排序：先重排祖先控件，祖先控件重排时会同时重排其子孙控件
+        std::stable_sort(arrangeItems.begin(), arrangeItems.end(),
+                         [](const ArrangeItem& a, const ArrangeItem& b) {
+                             return a.first < b.first;
+                         });
+        for (const ArrangeItem& item : arrangeItems) {
+            PlaceHolder* pControl = item.second.get();
+            if ((pControl != nullptr) && pControl->IsArranged() && pControl->IsVisible()) {
+                //重复项，或者已经随祖先控件完成重排的控件，IsArranged()为false，不需要再处理
+                pControl->SetPos(pControl->GetPos());
+            }
+        }
+    }
+}
+
 void Window::SetRenderOffset(UiPoint renderOffset)
 {
     m_renderOffset = renderOffset;
@@ -14,8 +14,11 @@ namespace ui
 
 class Box;
 class Control;
+class PlaceHolder;
 class ToolTip;
 class WindowBuilder;
+class RenderSurfacePool;
+class AnimationClock;
 
 /** 窗口类
 *  //外部调用需要初始化的基本流程:
@@ -233,6 +236,11 @@ public:
     */
     void SetArrange(bool bArrange);
 
+    /** 将需要布局重排的控件加入布局队列（在控件调用SetArranged(true)时自动加入）
+    * @param [in] pControl 需要布局重排的控件
+    */
+    void AddArrangeControl(PlaceHolder* pControl);
+
     /** 清理图片缓存
     */
     void ClearImageCache();
@@ -241,6 +249,44 @@ public:
     */
     void InvalidateAll();
 
+    /** 设置是否开启并行绘制：重绘的区域较大时，先记录绘制命令，然后将重绘区域分块，由多个线程并行绘制到位图中
+    *   仅CPU绘制方式支持；如果绘制过程中有直接访问位图数据的控件（比如Windows平台通过DC绘制的RichEdit控件），
+    *   该窗口自动关闭并行绘制
+    */
+    void SetEnableParallelPaint(bool bEnable);
+
+    /** 获取是否开启并行绘制
+    */
+    bool IsEnableParallelPaint() const;
+
+    /** 设置是否在创建窗口时预取XML中引用的图片（需要在创建窗口前设置）：
+    *   在创建控件前，由图片解码线程并行解码XML（含Class定义）中引用的图片，在窗口显示前等待解码完成
+    */
+    void SetEnablePrefetchImages(bool bEnable);
+
+    /** 获取是否在创建窗口时预取XML中引用的图片
+    */
+    bool IsEnablePrefetchImages() const;
+
+    /** 预取图片：按窗口当前的DPI缩放百分比加载图片，并由图片解码线程并行解码，解码完成后添加到图片缓存中
+    * @param [in] imageStrings 图片属性值列表（与控件的图片属性格式相同，比如："file='icon.png'"）
+    * @param [in] bWaitDecode 是否等待图片解码完成后再返回
+    * @return 返回新加载的图片个数（不含缓存中已有的图片）
+    */
+    size_t PrefetchImages(const std::vector<DString>& imageStrings, bool bWaitDecode);
+
+    /** 预取XML文件中引用的图片（比如列表项模板的XML文件，在填充列表前调用）
+    * @param [in] xmlPath XML文件的路径
+    * @param [in] bWaitDecode 是否等待图片解码完成后再返回
+    */
+    size_t PrefetchXmlImages(const FilePath& xmlPath, bool bWaitDecode);
+
+    /** 预取Class中引用的图片（比如列表项使用的Class，在填充列表前调用）
+    * @param [in] strClassList Class名称列表，多个名称以空格分隔
+    * @param [in] bWaitDecode 是否等待图片解码完成后再返回
+    */
+    size_t PrefetchClassImages(const DString& strClassList, bool bWaitDecode);
+
     /** @} */
 
 public:
@@ -401,6 +447,15 @@ public:
     */
     virtual IRender* GetRender() const override;
 
+    /** 滚动复制：将窗口中某个区域已绘制的内容平移，平移后只需要重绘新露出的区域（用于容器滚动时减少重绘）
+    *   仅CPU绘制方式、非层窗口、未处于窗口动画过程中时支持，不支持时返回false，由调用方重绘整个区域
+    * @param [in] rcScroll 需要平移的区域，为客户区坐标
+    * @param [in] dx 横向平移的距离，正数表示向右平移
+    * @param [in] dy 纵向平移的距离，正数表示向下平移
+    * @return 返回true表示平移成功，新露出的区域已经标记为需要重绘
+    */
+    bool ScrollWindowRect(const UiRect& rcScroll, int32_t dx, int32_t dy);
+
     /** 获取指定坐标点的控件接口
     * @param [in] pt 客户区坐标点
     */
@@ -410,6 +465,14 @@ public:
     */
     std::shared_ptr<IRenderDpi> GetRenderDpi();
 
+    /** 获取离屏绘制缓存池（控件设置透明度时，从缓存池中获取临时的离屏绘制缓存）
+    */
+    RenderSurfacePool* GetRenderSurfacePool();
+
+    /** 获取窗口的动画时钟（窗口内的控件动画共用一个定时器，按实际经过的时间播放）
+    */
+    const std::shared_ptr<AnimationClock>& GetAnimationClock();
+
     /** 设置窗口的属性是否已经设置完成(避免重复设置窗口属性)
     */
     void SetWindowAttributesApplied(bool bApplied);
@@ -531,6 +594,11 @@ protected:
     */
     virtual bool OnPreparePaint() override;
 
+    /** 窗口的某个区域被标记为需要重绘（由Invalidate函数触发）
+    * @param [in] rcItem 重绘范围，为客户区坐标
+    */
+    virtual void OnInvalidate(const UiRect& rcItem) override;
+
     /** 窗口的层窗口属性发生变化
     */
     virtual void OnLayeredWindowChanged() override;
@@ -984,6 +1052,11 @@ private:
     */
     void ArrangeRoot();
 
+    /** 对布局队列中的控件进行布局调整（按控件树的深度排序，先处理祖先控件，子孙控件如果已经随祖先完成布局则跳过）
+    * @param [in] pRoot 根容器
+    */
+    void ArrangeQueuedControls(Box* pRoot);
+
     /** 清理窗口资源
     */
     void ClearWindow();
@@ -1096,6 +1169,9 @@ private:
     //布局是否变化，如果变化(true)则需要重新计算布局
     bool m_bIsArranged;
 
+    //需要布局重排的控件队列(可能存在重复项，布局时去重)
+    std::vector<ControlPtrT<PlaceHolder>> m_arrangeControls;
+
     //布局是否已经初始化
     bool m_bFirstLayout;
 
@@ -1108,12 +1184,33 @@ private:
     //绘制时的偏移量（动画用）
     UiPoint m_renderOffset;
 
+    //自上次绘制以来标记为需要重绘的区域（数量过多时合并为一个区域）
+    std::vector<UiRect> m_invalidateRects;
+
+    //自上次绘制以来是否执行过滚动复制（如果执行过，绘制时只重绘m_invalidateRects中的区域）
+    bool m_bScrollCopied;
+
+    //执行滚动复制时，绘制引擎的大小（绘制引擎的大小变化后，已绘制的内容失效）
+    UiSize m_szScrollCopyRender;
+
+    //是否开启并行绘制
+    bool m_bEnableParallelPaint;
+
+    //是否在创建窗口时预取XML中引用的图片
+    bool m_bEnablePrefetchImages;
+
     //窗口最大化状态下的外边距（Windows平台，窗口最大化时，窗口的区域是溢出屏幕区域的，所以需要增加外边距，避免窗口的内容也溢出屏幕）
     UiMargin m_rcWindowMaximizedMargin;
 
     //绘制引擎
     std::unique_ptr<IRender> m_render;
 
+    //离屏绘制缓存池（首次使用时创建）
+    std::unique_ptr<RenderSurfacePool> m_renderSurfacePool;
+
+    //动画时钟（首次使用时创建，动画播放器持有弱引用）
+    std::shared_ptr<AnimationClock> m_animationClock;
+
 private:
     /** 每个窗口的资源路径(相对于资源根目录的路径)
     */
@@ -705,6 +705,13 @@ void WindowBase::ClearWindowRgn(bool bRedraw)
 }
 
 void WindowBase::Invalidate(const UiRect& rcItem)
+{
+    GlobalManager::Instance().AssertUIThread();
+    OnInvalidate(rcItem);
+    m_pNativeWindow->Invalidate(rcItem);
+}
+
+void WindowBase::InvalidateNoPaint(const UiRect& rcItem)
 {
     GlobalManager::Instance().AssertUIThread();
     m_pNativeWindow->Invalidate(rcItem);
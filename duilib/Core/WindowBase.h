@@ -866,6 +866,16 @@ protected:
     */
     virtual bool OnPreparePaint() = 0;
 
+    /** 窗口的某个区域被标记为需要重绘（由Invalidate函数触发）
+    * @param [in] rcItem 重绘范围，为客户区坐标
+    */
+    virtual void OnInvalidate(const UiRect& /*rcItem*/) {}
+
+    /** 发出重绘消息，但不触发OnInvalidate回调（仅需要将已绘制的内容重新显示到窗口时使用）
+    * @param [in] rcItem 重绘范围，为客户区坐标
+    */
+    void InvalidateNoPaint(const UiRect& rcItem);
+
     /** 窗口的层窗口属性发生变化
     */
     virtual void OnLayeredWindowChanged() = 0;
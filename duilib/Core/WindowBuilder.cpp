@@ -8,6 +8,7 @@
 #include "duilib/Core/ControlResizable.h"
 #include "duilib/Core/ScrollBar.h"
 #include "duilib/Core/WindowCreateAttributes.h"
+#include "duilib/Core/BinarySkin.h"
 
 #include "duilib/Control/TreeView.h"
 #include "duilib/Control/DirectoryTree.h"
@@ -57,16 +58,113 @@
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/AttributeUtil.h"
 #include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Utils/MappedFile.h"
 
 #include "duilib/third_party/xml/pugixml.hpp"
 #include <set>
+#include <map>
+#include <mutex>
+#include <algorithm>
+
+//XML文档缓存的最大个数
+#define MAX_XML_DOCUMENT_CACHE_COUNT 32
 
 namespace ui 
 {
 
+/** XML文档缓存中的一个文档
+*/
+struct TXmlDocumentCacheItem
+{
+    //解析后的XML文档对象（只读）
+    std::shared_ptr<pugi::xml_document> m_xml;
+    //图片资源索引（从二进制皮肤文件加载时有效）
+    std::shared_ptr<BinarySkinImageIndex> m_imageIndex;
+    //文件大小（用于检测磁盘上的文件是否有修改，资源在压缩包中时为0）
+    uint64_t m_nFileSize = 0;
+    //文件的最后修改时间（用于检测磁盘上的文件是否有修改，资源在压缩包中时为0）
+    int64_t m_nLastWriteTime = 0;
+    //最后使用的序号（用于淘汰最久未使用的文档）
+    uint64_t m_nLastUsed = 0;
+};
+
+/** XML文档缓存（以XML文件的完整路径为索引）
+*/
+struct TXmlDocumentCache
+{
+    std::mutex m_mutex;
+    std::map<FilePath, TXmlDocumentCacheItem> m_items;
+    uint64_t m_nUseCount = 0;
+};
+
+static TXmlDocumentCache& GetXmlDocumentCache()
+{
+    static TXmlDocumentCache s_xmlDocumentCache;
+    return s_xmlDocumentCache;
+}
+
+/** 从缓存中查找XML文档（文件大小或修改时间不一致时，认为文件已经修改，不使用缓存）
+*/
+static std::shared_ptr<pugi::xml_document> FindXmlDocument(const FilePath& xmlFileFullPath,
+                                                           uint64_t nFileSize, int64_t nLastWriteTime,
+                                                           std::shared_ptr<BinarySkinImageIndex>& spImageIndex)
+{
+    TXmlDocumentCache& cache = GetXmlDocumentCache();
+    std::lock_guard<std::mutex> threadGuard(cache.m_mutex);
+    auto iter = cache.m_items.find(xmlFileFullPath);
+    if (iter == cache.m_items.end()) {
+        return nullptr;
+    }
+    if ((iter->second.m_nFileSize != nFileSize) || (iter->second.m_nLastWriteTime != nLastWriteTime)) {
+        cache.m_items.erase(iter);
+        return nullptr;
+    }
+    iter->second.m_nLastUsed = ++cache.m_nUseCount;
+    spImageIndex = iter->second.m_imageIndex;
+    return iter->second.m_xml;
+}
+
+/** 将XML文档添加到缓存中（缓存已满时，淘汰最久未使用的文档）
+*/
+static void AddXmlDocument(const FilePath& xmlFileFullPath, const std::shared_ptr<pugi::xml_document>& xml,
+                           uint64_t nFileSize, int64_t nLastWriteTime,
+                           const std::shared_ptr<BinarySkinImageIndex>& spImageIndex)
+{
+    TXmlDocumentCache& cache = GetXmlDocumentCache();
+    std::lock_guard<std::mutex> threadGuard(cache.m_mutex);
+    if ((cache.m_items.size() >= MAX_XML_DOCUMENT_CACHE_COUNT) &&
+        (cache.m_items.find(xmlFileFullPath) == cache.m_items.end())) {
+        auto iterOldest = std::min_element(cache.m_items.begin(), cache.m_items.end(),
+                                           [](const auto& a, const auto& b) {
+                                               return a.second.m_nLastUsed < b.second.m_nLastUsed;
+                                           });
+        cache.m_items.erase(iterOldest);
+    }
+    TXmlDocumentCacheItem& item = cache.m_items[xmlFileFullPath];
+    item.m_xml = xml;
+    item.m_imageIndex = spImageIndex;
+    item.m_nFileSize = nFileSize;
+    item.m_nLastWriteTime = nLastWriteTime;
+    item.m_nLastUsed = ++cache.m_nUseCount;
+}
+
+/** 加载二进制皮肤数据（数据格式无效时返回nullptr）
+*/
+static std::shared_ptr<pugi::xml_document> LoadBinarySkinData(const uint8_t* data, size_t nDataLen,
+                                                              std::shared_ptr<BinarySkinImageIndex>& spImageIndex)
+{
+    std::shared_ptr<pugi::xml_document> xml = std::make_shared<pugi::xml_document>();
+    std::shared_ptr<BinarySkinImageIndex> imageIndex = std::make_shared<BinarySkinImageIndex>();
+    if (!BinarySkin::LoadXmlDocument(data, nDataLen, *xml, imageIndex.get())) {
+        return nullptr;
+    }
+    spImageIndex = imageIndex;
+    return xml;
+}
+
 WindowBuilder::WindowBuilder()
 {
-    m_xml = std::make_unique<pugi::xml_document>();
+    m_xml = std::make_shared<pugi::xml_document>();
 }
 
 WindowBuilder::~WindowBuilder()
@@ -199,16 +297,15 @@ bool WindowBuilder::IsXmlFileExists(const FilePath& xmlFilePath) const
     bool bExists = false;
     if (GlobalManager::Instance().Zip().IsUseZip()) {
         FilePath sFile = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
-        bExists = GlobalManager::Instance().Zip().IsZipResExist(sFile);
+        bExists = GlobalManager::Instance().Zip().IsZipResExist(sFile) ||
+                  GlobalManager::Instance().Zip().IsZipResExist(BinarySkin::GetBinaryFilePath(sFile));
     }
     else {
-        if (xmlFilePath.IsAbsolutePath()) {
-            bExists = xmlFilePath.IsExistsFile();
-        }
-        else {
-            FilePath xmlFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
-            bExists = xmlFullPath.IsExistsFile();
+        FilePath xmlFullPath = xmlFilePath;
+        if (!xmlFilePath.IsAbsolutePath()) {
+            xmlFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
         }
+        bExists = xmlFullPath.IsExistsFile() || BinarySkin::GetBinaryFilePath(xmlFullPath).IsExistsFile();
     }
     return bExists;
 }
@@ -228,6 +325,9 @@ bool WindowBuilder::ParseXmlData(const DString& xmlFileData, const FilePath& xml
 #else
         pugi::xml_encoding encoding = pugi::xml_encoding::encoding_utf8;
 #endif
+        //不修改已有的文档对象（可能是XML文档缓存中的共享对象）
+        m_xml = std::make_shared<pugi::xml_document>();
+        m_spImageIndex.reset();
         pugi::xml_parse_result result = m_xml->load_buffer(xmlFileData.c_str(),
                                                            xmlFileData.size() * sizeof(DString::value_type),
                                                            pugi::parse_default, encoding);
@@ -247,7 +347,23 @@ bool WindowBuilder::ParseXmlData(const std::vector<unsigned char>& xmlFileData,
     if (xmlFileData.empty()) {
         return false;
     }
+    if (BinarySkin::IsBinarySkinData(xmlFileData.data(), xmlFileData.size())) {
+        //二进制皮肤数据
+        std::shared_ptr<BinarySkinImageIndex> spImageIndex;
+        std::shared_ptr<pugi::xml_document> xml = LoadBinarySkinData(xmlFileData.data(), xmlFileData.size(), spImageIndex);
+        if (xml == nullptr) {
+            ASSERT(!_T("WindowBuilder::ParseXmlData load binary skin data failed!"));
+            return false;
+        }
+        m_xml = xml;
+        m_spImageIndex = spImageIndex;
+        m_xmlFilePath = xmlFilePath;
+        return true;
+    }
     pugi::xml_encoding encoding = pugi::xml_encoding::encoding_auto;
+    //不修改已有的文档对象（可能是XML文档缓存中的共享对象）
+    m_xml = std::make_shared<pugi::xml_document>();
+    m_spImageIndex.reset();
     pugi::xml_parse_result result = m_xml->load_buffer(xmlFileData.data(),
                                                        xmlFileData.size(),
                                                        pugi::parse_default, encoding);
@@ -267,20 +383,42 @@ bool WindowBuilder::ParseXmlFile(const FilePath& xmlFilePath, const FilePath& wi
         return false;
     }
     bool isLoaded = false;
+    std::shared_ptr<BinarySkinImageIndex> spImageIndex;
     if (GlobalManager::Instance().Zip().IsUseZip()) {
+        ZipManager& zipManager = GlobalManager::Instance().Zip();
         FilePath sFile = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
-        if (!windowResPath.IsEmpty() && !GlobalManager::Instance().Zip().IsZipResExist(sFile)) {
+        if (!windowResPath.IsEmpty() && !zipManager.IsZipResExist(sFile) &&
+            !zipManager.IsZipResExist(BinarySkin::GetBinaryFilePath(sFile))) {
             //在窗口目录查找
             sFile = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), windowResPath);
             sFile = FilePathUtil::JoinFilePath(sFile, xmlFilePath);
         }
+        std::shared_ptr<pugi::xml_document> xml = FindXmlDocument(sFile, 0, 0, spImageIndex);
+        if (xml != nullptr) {
+            m_xml = xml;
+            isLoaded = true;
+        }
         std::vector<unsigned char> file_data;
-        if (GlobalManager::Instance().Zip().GetZipData(sFile, file_data)) {
-            pugi::xml_parse_result result = m_xml->load_buffer(file_data.data(), file_data.size());
+        const FilePath binFile = BinarySkin::GetBinaryFilePath(sFile);
+        if (!isLoaded && zipManager.IsZipResExist(binFile) && zipManager.GetZipData(binFile, file_data)) {
+            //优先使用二进制皮肤文件，格式无效时使用XML文件
+            xml = LoadBinarySkinData(file_data.data(), file_data.size(), spImageIndex);
+            if (xml != nullptr) {
+                m_xml = xml;
+                AddXmlDocument(sFile, xml, 0, 0, spImageIndex);
+                isLoaded = true;
+            }
+        }
+        if (!isLoaded && zipManager.GetZipData(sFile, file_data)) {
+            xml = std::make_shared<pugi::xml_document>();
+            pugi::xml_parse_result result = xml->load_buffer(file_data.data(), file_data.size());
             if (result.status != pugi::status_ok) {
                 ASSERT(!_T("WindowBuilder::ParseXmlFile load xml from zip data failed!"));
                 return false;
             }
+            m_xml = xml;
+            spImageIndex.reset();
+            AddXmlDocument(sFile, xml, 0, 0, spImageIndex);
             isLoaded = true;
         }
     }
@@ -288,7 +426,8 @@ bool WindowBuilder::ParseXmlFile(const FilePath& xmlFilePath, const FilePath& wi
         FilePath xmlFileFullPath;
         if (xmlFilePath.IsRelativePath()) {
             xmlFileFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), xmlFilePath);
-            if (!windowResPath.IsEmpty() && !xmlFileFullPath.IsExistsFile()) {
+            if (!windowResPath.IsEmpty() && !xmlFileFullPath.IsExistsFile() &&
+                !BinarySkin::GetBinaryFilePath(xmlFileFullPath).IsExistsFile()) {
                 //在窗口目录查找
                 xmlFileFullPath = FilePathUtil::JoinFilePath(GlobalManager::Instance().GetResourcePath(), windowResPath);
                 xmlFileFullPath = FilePathUtil::JoinFilePath(xmlFileFullPath, xmlFilePath);
@@ -297,21 +436,62 @@ bool WindowBuilder::ParseXmlFile(const FilePath& xmlFilePath, const FilePath& wi
         else {
             xmlFileFullPath = xmlFilePath;
         }
-        pugi::xml_parse_result result = m_xml->load_file(xmlFileFullPath.NativePathA().c_str());
-        if (result.status != pugi::status_ok) {
-            ASSERT(!_T("WindowBuilder::ParseXmlFile load xml file failed!"));
-            return false;
+        uint64_t nFileSize = xmlFileFullPath.GetFileSize();
+        int64_t nLastWriteTime = xmlFileFullPath.GetLastWriteTime();
+
+        //二进制皮肤文件存在，并且不比XML文件旧时，优先使用二进制皮肤文件（缓存以该文件的大小和修改时间检测文件是否有修改）
+        const FilePath binFileFullPath = BinarySkin::GetBinaryFilePath(xmlFileFullPath);
+        const int64_t nBinLastWriteTime = binFileFullPath.GetLastWriteTime();
+        const bool bUseBinary = (nBinLastWriteTime != 0) && (nBinLastWriteTime >= nLastWriteTime);
+        if (bUseBinary) {
+            nFileSize = binFileFullPath.GetFileSize();
+            nLastWriteTime = nBinLastWriteTime;
+        }
+        std::shared_ptr<pugi::xml_document> xml = FindXmlDocument(xmlFileFullPath, nFileSize, nLastWriteTime, spImageIndex);
+        if ((xml == nullptr) && bUseBinary) {
+            //以内存映射的方式读取，不复制文件数据
+            MappedFile mappedFile;
+            if (mappedFile.Open(binFileFullPath)) {
+                xml = LoadBinarySkinData(mappedFile.GetData(), mappedFile.GetSize(), spImageIndex);
+            }
+            if (xml == nullptr) {
+                //二进制皮肤文件的格式无效，使用XML文件
+                nFileSize = xmlFileFullPath.GetFileSize();
+                nLastWriteTime = xmlFileFullPath.GetLastWriteTime();
+            }
+            else {
+                AddXmlDocument(xmlFileFullPath, xml, nFileSize, nLastWriteTime, spImageIndex);
+            }
         }
+        if (xml == nullptr) {
+            xml = std::make_shared<pugi::xml_document>();
+            pugi::xml_parse_result result = xml->load_file(xmlFileFullPath.NativePathA().c_str());
+            if (result.status != pugi::status_ok) {
+                ASSERT(!_T("WindowBuilder::ParseXmlFile load xml file failed!"));
+                return false;
+            }
+            spImageIndex.reset();
+            AddXmlDocument(xmlFileFullPath, xml, nFileSize, nLastWriteTime, spImageIndex);
+        }
+        m_xml = xml;
         isLoaded = true;
     }
     if (!isLoaded) {
         ASSERT(!_T("WindowBuilder::ParseXmlFile load xmlFilePath failed!"));
         return false;
     }
+    m_spImageIndex = spImageIndex;
     m_xmlFilePath = xmlFilePath;
     return true;
 }
 
+void WindowBuilder::ClearXmlDocumentCache()
+{
+    TXmlDocumentCache& cache = GetXmlDocumentCache();
+    std::lock_guard<std::mutex> threadGuard(cache.m_mutex);
+    cache.m_items.clear();
+}
+
 Control* WindowBuilder::CreateControls(Window* pWindow, CreateControlCallback pCallback, Box* pParent, Box* pUserDefinedBox)
 {
     //校验窗口：必须存在，否则DPI自适应功能等功能会失效，导致界面布局不正确
@@ -768,6 +948,16 @@ void WindowBuilder::ParseWindowAttributes(Window* pWindow, const pugi::xml_node&
             knownNames.insert(strName);
             pWindow->SetEnableDragDrop(strValue == _T("true"));
         }
+        else if (strName == _T("parallel_paint")) {
+            knownNames.insert(strName);
+            //设置是否开启并行绘制
+            pWindow->SetEnableParallelPaint(strValue == _T("true"));
+        }
+        else if (strName == _T("prefetch_images")) {
+            knownNames.insert(strName);
+            //设置是否在创建窗口时预取图片（在创建控件前已经处理）
+            pWindow->SetEnablePrefetchImages(strValue == _T("true"));
+        }
     }
 
     if (bHasShadowAttached) {
@@ -1084,29 +1274,7 @@ Control* WindowBuilder::ParseXmlNodeChildren(const pugi::xml_node& xmlNode, Cont
                 //默认值设置为1，count这个属性参数为可选
                 nCount = 1;
             }
-            pugi::xml_attribute sourceAttr = node.attribute(_T("src"));
-            DString sourceValue = sourceAttr.as_string();
-            if (sourceValue.empty()) {
-                sourceAttr = node.attribute(_T("source"));
-                sourceValue = sourceAttr.as_string();                
-            }
-            FilePath sourceXmlFilePath(sourceValue);
-            if (!sourceValue.empty()) {
-                StringUtil::ReplaceAll(_T("/"), m_xmlFilePath.GetPathSeparatorStr(), sourceValue);
-                StringUtil::ReplaceAll(_T("\\"), m_xmlFilePath.GetPathSeparatorStr(), sourceValue);
-                if (!m_xmlFilePath.IsEmpty()) {
-                    //优先尝试在原XML文件相同目录加载
-                    DString xmlFilePath = m_xmlFilePath.NativePath();
-                    size_t pos = xmlFilePath.find_last_of(_T("\\/"));
-                    if (pos != DString::npos) {
-                        FilePath srcFilePath(xmlFilePath.substr(0, pos));
-                        srcFilePath.JoinFilePath(FilePath(sourceValue));
-                        if (IsXmlFileExists(srcFilePath)) {
-                            sourceXmlFilePath = srcFilePath;
-                        }
-                    }
-                }
-            }
+            FilePath sourceXmlFilePath = GetIncludeXmlFilePath(node);
             ASSERT(!sourceXmlFilePath.IsEmpty());
             if (sourceXmlFilePath.IsEmpty()) {
                 continue;
@@ -1383,6 +1551,34 @@ bool WindowBuilder::ParseRichTextXmlNode(const pugi::xml_node& xmlNode, RichText
     return true;
 }
 
+FilePath WindowBuilder::GetIncludeXmlFilePath(const pugi::xml_node& node) const
+{
+    pugi::xml_attribute sourceAttr = node.attribute(_T("src"));
+    DString sourceValue = sourceAttr.as_string();
+    if (sourceValue.empty()) {
+        sourceAttr = node.attribute(_T("source"));
+        sourceValue = sourceAttr.as_string();                
+    }
+    FilePath sourceXmlFilePath(sourceValue);
+    if (!sourceValue.empty()) {
+        StringUtil::ReplaceAll(_T("/"), m_xmlFilePath.GetPathSeparatorStr(), sourceValue);
+        StringUtil::ReplaceAll(_T("\\"), m_xmlFilePath.GetPathSeparatorStr(), sourceValue);
+        if (!m_xmlFilePath.IsEmpty()) {
+            //优先尝试在原XML文件相同目录加载
+            DString xmlFilePath = m_xmlFilePath.NativePath();
+            size_t pos = xmlFilePath.find_last_of(_T("\\/"));
+            if (pos != DString::npos) {
+                FilePath srcFilePath(xmlFilePath.substr(0, pos));
+                srcFilePath.JoinFilePath(FilePath(sourceValue));
+                if (IsXmlFileExists(srcFilePath)) {
+                    sourceXmlFilePath = srcFilePath;
+                }
+            }
+        }
+    }
+    return sourceXmlFilePath;
+}
+
 void WindowBuilder::AttachXmlEvent(bool bBubbled, const pugi::xml_node& node, Control* pParent)
 {
     ASSERT(pParent != nullptr);
@@ -1392,6 +1588,12 @@ void WindowBuilder::AttachXmlEvent(bool bBubbled, const pugi::xml_node& node, Co
     DString strType;
     DString strReceiver;
     DString strApplyAttribute;
+    ParseXmlEventNode(node, strType, strReceiver, strApplyAttribute);
+    AttachXmlEvent(bBubbled, strType, strReceiver, strApplyAttribute, pParent);
+}
+
+void WindowBuilder::ParseXmlEventNode(const pugi::xml_node& node, DString& strType, DString& strReceiver, DString& strApplyAttribute)
+{
     DString strName;
     DString strValue;
     int i = 0;
@@ -1412,7 +1614,15 @@ void WindowBuilder::AttachXmlEvent(bool bBubbled, const pugi::xml_node& node, Co
             strApplyAttribute = strValue;
         }
     }
+}
 
+void WindowBuilder::AttachXmlEvent(bool bBubbled, const DString& strType, const DString& strReceiver,
+                                   const DString& strApplyAttribute, Control* pParent)
+{
+    ASSERT(pParent != nullptr);
+    if (pParent == nullptr) {
+        return;
+    }
     auto typeList = StringUtil::Split(strType, _T(" "));
     auto receiverList = StringUtil::Split(strReceiver, _T(" "));
     for (auto itType = typeList.begin(); itType != typeList.end(); itType++) {
@@ -1482,4 +1692,522 @@ const std::vector<DString>& WindowBuilder::GetGlobalFontIdList() const
     return m_globalFontIdList;
 }
 
+void WindowBuilder::GetImageStrings(std::vector<DString>& imageStrings) const
+{
+    if (m_xml == nullptr) {
+        return;
+    }
+    std::vector<DString> classList;
+    if (m_spImageIndex != nullptr) {
+        //二进制皮肤文件中的图片资源索引，不需要遍历XML文档
+        imageStrings.insert(imageStrings.end(), m_spImageIndex->m_imageStrings.begin(), m_spImageIndex->m_imageStrings.end());
+        classList = m_spImageIndex->m_classList;
+    }
+    else {
+        pugi::xml_node root = m_xml->root().first_child();
+        if (root.empty()) {
+            return;
+        }
+        GetNodeImageStrings(root, imageStrings, classList);
+    }
+
+    //窗口中定义的Class已经在XML中解析，只需要查找全局的Class
+    std::sort(classList.begin(), classList.end());
+    classList.erase(std::unique(classList.begin(), classList.end()), classList.end());
+    for (const DString& strClassList : classList) {
+        GetClassImageStrings(nullptr, strClassList, imageStrings);
+    }
+}
+
+void WindowBuilder::GetNodeImageStrings(const pugi::xml_node& xmlNode,
+                                        std::vector<DString>& imageStrings,
+                                        std::vector<DString>& classList) const
+{
+    DString strName;
+    DString strValue;
+    for (pugi::xml_attribute attr : xmlNode.attributes()) {
+        strName = attr.name();
+        strValue = attr.value();
+        if (strName == _T("class")) {
+            if (!strValue.empty()) {
+                classList.push_back(strValue);
+            }
+        }
+        else if (IsImageAttribute(strName, strValue)) {
+            imageStrings.push_back(strValue);
+        }
+    }
+    for (pugi::xml_node node : xmlNode.children()) {
+        if (node.type() == pugi::node_element) {
+            GetNodeImageStrings(node, imageStrings, classList);
+        }
+    }
+}
+
+void WindowBuilder::GetClassImageStrings(const Window* pWindow, const DString& strClassList,
+                                         std::vector<DString>& imageStrings)
+{
+    std::list<DString> splitList = StringUtil::Split(strClassList, _T(" "));
+    for (const DString& strClassName : splitList) {
+        if (strClassName.empty()) {
+            continue;
+        }
+        DString strAttributeList = GlobalManager::Instance().GetClassAttributes(strClassName);
+        if (strAttributeList.empty() && (pWindow != nullptr)) {
+            strAttributeList = pWindow->GetClassAttributes(strClassName);
+        }
+        if (strAttributeList.empty()) {
+            continue;
+        }
+        std::vector<std::pair<DString, DString>> attributeList;
+        if (strAttributeList.find(_T('\"')) != DString::npos) {
+            AttributeUtil::ParseAttributeList(strAttributeList, _T('\"'), attributeList);
+        }
+        else if (strAttributeList.find(_T('\'')) != DString::npos) {
+            AttributeUtil::ParseAttributeList(strAttributeList, _T('\''), attributeList);
+        }
+        for (const auto& attribute : attributeList) {
+            if (IsImageAttribute(attribute.first, attribute.second)) {
+                imageStrings.push_back(attribute.second);
+            }
+        }
+    }
+}
+
+bool WindowBuilder::IsImageAttribute(const DString& strName, const DString& strValue)
+{
+    const DString imageSuffix = _T("image");
+    if ((strName.size() < imageSuffix.size()) ||
+        (strName.compare(strName.size() - imageSuffix.size(), imageSuffix.size(), imageSuffix) != 0)) {
+        return false;
+    }
+    //排除取值为bool类型的属性（比如："stretch_fore_image"）
+    if (strValue.empty() || (strValue == _T("true")) || (strValue == _T("false"))) {
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<ControlPrototype> WindowBuilder::CreatePrototype(const Window* pWindow) const
+{
+    if (m_xml == nullptr) {
+        return nullptr;
+    }
+    pugi::xml_node root = m_xml->root().first_child();
+    if (root.empty() || (StringUtil::StringCompare(root.name(), _T("Global")) == 0)) {
+        //全局资源的定义，每次创建时需要重新解析
+        return nullptr;
+    }
+    std::shared_ptr<ControlPrototype> spPrototype = std::make_shared<ControlPrototype>();
+    spPrototype->m_nClassVersion = GlobalManager::Instance().GetClassVersion();
+    if (!CompilePrototypeRoot(pWindow, *spPrototype, spPrototype->m_nodes) || spPrototype->IsEmpty()) {
+        return nullptr;
+    }
+    return spPrototype;
+}
+
+bool WindowBuilder::CompilePrototypeRoot(const Window* pWindow, ControlPrototype& prototype,
+                                         std::vector<ControlPrototype::TControlNode>& nodes) const
+{
+    if (m_xml == nullptr) {
+        return false;
+    }
+    pugi::xml_node root = m_xml->root().first_child();
+    if (root.empty()) {
+        return false;
+    }
+    if (StringUtil::StringCompare(root.name(), _T("Window")) == 0) {
+        //窗口下的共享资源（字体是全局有效的，已经在首次创建时解析）
+        DString strName;
+        DString strValue;
+        DString strClass;
+        for (pugi::xml_node node : root.children()) {
+            strClass = node.name();
+            if (strClass == _T("Class")) {
+                DString strClassName;
+                DString strAttribute;
+                for (pugi::xml_attribute attr : node.attributes()) {
+                    strName = attr.name();
+                    strValue = attr.value();
+                    if (strName == _T("name")) {
+                        strClassName = strValue;
+                    }
+                    else {
+                        strAttribute.append(StringUtil::Printf(_T(" %s=\"%s\""), strName.c_str(), strValue.c_str()));
+                    }
+                }
+                if (!strClassName.empty()) {
+                    StringUtil::TrimLeft(strAttribute);
+                    prototype.m_windowClasses.push_back(std::make_pair(strClassName, strAttribute));
+                }
+            }
+            else if (strClass == _T("TextColor")) {
+                DString strColorName = node.attribute(_T("name")).as_string();
+                DString strColor = node.attribute(_T("value")).as_string();
+                if (!strColorName.empty()) {
+                    prototype.m_windowTextColors.push_back(std::make_pair(strColorName, strColor));
+                }
+            }
+        }
+    }
+    return CompilePrototypeChildren(pWindow, root, prototype, nullptr, nodes);
+}
+
+bool WindowBuilder::CompilePrototypeChildren(const Window* pWindow, const pugi::xml_node& xmlNode,
+                                             ControlPrototype& prototype,
+                                             ControlPrototype::TControlNode* pParentNode,
+                                             std::vector<ControlPrototype::TControlNode>& nodes) const
+{
+    for (pugi::xml_node node : xmlNode.children()) {
+        if (node.type() != pugi::node_element) {
+            continue;
+        }
+        DString strClass = node.name();
+        if ((strClass == _T("DefaultFontFamilyNames")) ||
+            (strClass == _T("Font")) ||
+            (strClass == _T("FontFile")) ||
+            (strClass == _T("Class")) ||
+            (strClass == _T("TextColor"))) {
+            continue;
+        }
+        if ((strClass == DUI_CTR_RICHTEXT) || (strClass == DUI_CTR_TREENODE)) {
+            //这两种节点需要特殊处理，不支持原型
+            return false;
+        }
+        if (strClass == _T("Include")) {
+            if (node.attributes().empty()) {
+                continue;
+            }
+            int nCount = node.attribute(_T("count")).as_int();
+            if (nCount <= 0) {
+                nCount = 1;
+            }
+            FilePath sourceXmlFilePath = GetIncludeXmlFilePath(node);
+            if (sourceXmlFilePath.IsEmpty()) {
+                continue;
+            }
+            WindowBuilder builder;
+            FilePath windowResPath = (pWindow != nullptr) ? pWindow->GetResourcePath() : FilePath();
+            if (!builder.ParseXmlFile(sourceXmlFilePath, windowResPath)) {
+                return false;
+            }
+            std::vector<ControlPrototype::TControlNode> includeNodes;
+            if (!builder.CompilePrototypeRoot(pWindow, prototype, includeNodes)) {
+                return false;
+            }
+            for (int i = 0; i < nCount; ++i) {
+                nodes.insert(nodes.end(), includeNodes.begin(), includeNodes.end());
+            }
+            continue;
+        }
+        if ((strClass == _T("Event")) || (strClass == _T("BubbledEvent"))) {
+            if (pParentNode != nullptr) {
+                ControlPrototype::TEventNode eventNode;
+                eventNode.m_bBubbled = (strClass == _T("BubbledEvent"));
+                ParseXmlEventNode(node, eventNode.m_type, eventNode.m_receiver, eventNode.m_applyAttribute);
+                pParentNode->m_events.push_back(eventNode);
+            }
+            continue;
+        }
+
+        ControlPrototype::TControlNode controlNode;
+        controlNode.m_className = strClass;
+        std::vector<std::pair<DString, DString>> attributes;
+        for (pugi::xml_attribute attr : node.attributes()) {
+            if (StringUtil::StringCompare(attr.name(), _T("class")) == 0) {
+                ExpandPrototypeClass(prototype, attr.value(), attributes);
+            }
+            else {
+                attributes.push_back(std::make_pair(DString(attr.name()), DString(attr.value())));
+            }
+        }
+        controlNode.m_attributes.resize(attributes.size());
+        for (size_t nIndex = 0; nIndex < attributes.size(); ++nIndex) {
+            CompilePrototypeAttribute(strClass, attributes[nIndex].first, attributes[nIndex].second,
+                                      controlNode.m_attributes[nIndex]);
+        }
+        if (!CompilePrototypeChildren(pWindow, node, prototype, &controlNode, controlNode.m_children)) {
+            return false;
+        }
+        nodes.push_back(std::move(controlNode));
+    }
+    return true;
+}
+
+void WindowBuilder::ExpandPrototypeClass(const ControlPrototype& prototype, const DString& strClassList,
+                                         std::vector<std::pair<DString, DString>>& attributes)
+{
+    std::list<DString> splitList = StringUtil::Split(strClassList, _T(" "));
+    for (const DString& strClassName : splitList) {
+        if (strClassName.empty()) {
+            continue;
+        }
+        //查找顺序与Control::SetClass函数相同：先查找全局的Class，再查找窗口的Class
+        DString strAttributeList = GlobalManager::Instance().GetClassAttributes(strClassName);
+        if (strAttributeList.empty()) {
+            for (const auto& windowClass : prototype.m_windowClasses) {
+                if (windowClass.first == strClassName) {
+                    strAttributeList = windowClass.second;
+                    break;
+                }
+            }
+        }
+        if (strAttributeList.empty()) {
+            //在其他XML文件中定义的窗口Class，创建控件时再查找
+            attributes.push_back(std::make_pair(DString(_T("class")), strClassName));
+            continue;
+        }
+        if (strAttributeList.find(_T('\"')) != DString::npos) {
+            AttributeUtil::ParseAttributeList(strAttributeList, _T('\"'), attributes);
+        }
+        else if (strAttributeList.find(_T('\'')) != DString::npos) {
+            AttributeUtil::ParseAttributeList(strAttributeList, _T('\''), attributes);
+        }
+    }
+}
+
+void WindowBuilder::CompilePrototypeAttribute(const DString& strClassName, const DString& strName, const DString& strValue,
+                                              ControlPrototype::TAttribute& attribute)
+{
+    using TAttributeType = ControlPrototype::TAttributeType;
+    attribute.m_type = TAttributeType::kString;
+    attribute.m_name = strName;
+    attribute.m_value = strValue;
+    if ((strName == _T("width")) || (strName == _T("height"))) {
+        if ((strName == _T("height")) && (strClassName == DUI_CTR_CHECK_COMBO)) {
+            //CheckCombo控件重写了height属性的处理逻辑
+            return;
+        }
+        if (strValue == _T("stretch")) {
+            attribute.m_fixedInt = UiFixedInt::MakeStretch();
+        }
+        else if (strValue == _T("auto")) {
+            attribute.m_fixedInt = UiFixedInt::MakeAuto();
+        }
+        else if (!strValue.empty()) {
+            if (strValue.back() == _T('%')) {
+                int32_t iValue = StringUtil::StringToInt32(strValue);
+                if ((iValue <= 0) || (iValue > 100)) {
+                    iValue = 100;
+                }
+                attribute.m_fixedInt = UiFixedInt::MakeStretch(iValue);
+                attribute.m_bNeedDpiScale = false;
+            }
+            else {
+                attribute.m_fixedInt = UiFixedInt(StringUtil::StringToInt32(strValue));
+            }
+        }
+        else {
+            attribute.m_fixedInt = UiFixedInt(0);
+        }
+        attribute.m_type = (strName == _T("width")) ? TAttributeType::kWidth : TAttributeType::kHeight;
+    }
+    else if (strName == _T("margin")) {
+        AttributeUtil::ParseMarginValue(strValue.c_str(), attribute.m_rcMargin);
+        attribute.m_type = TAttributeType::kMargin;
+    }
+    else if (strName == _T("padding")) {
+        AttributeUtil::ParsePaddingValue(strValue.c_str(), attribute.m_rcPadding);
+        attribute.m_type = TAttributeType::kPadding;
+    }
+    else if (strName == _T("halign")) {
+        //无效的值不预编译，由SetAttribute函数处理
+        if (strValue == _T("left")) {
+            attribute.m_nAlignType = (int8_t)HorAlignType::kAlignLeft;
+            attribute.m_type = TAttributeType::kHorAlign;
+        }
+        else if (strValue == _T("center")) {
+            attribute.m_nAlignType = (int8_t)HorAlignType::kAlignCenter;
+            attribute.m_type = TAttributeType::kHorAlign;
+        }
+        else if (strValue == _T("right")) {
+            attribute.m_nAlignType = (int8_t)HorAlignType::kAlignRight;
+            attribute.m_type = TAttributeType::kHorAlign;
+        }
+    }
+    else if (strName == _T("valign")) {
+        if (strValue == _T("top")) {
+            attribute.m_nAlignType = (int8_t)VerAlignType::kAlignTop;
+            attribute.m_type = TAttributeType::kVerAlign;
+        }
+        else if (strValue == _T("center")) {
+            attribute.m_nAlignType = (int8_t)VerAlignType::kAlignCenter;
+            attribute.m_type = TAttributeType::kVerAlign;
+        }
+        else if (strValue == _T("bottom")) {
+            attribute.m_nAlignType = (int8_t)VerAlignType::kAlignBottom;
+            attribute.m_type = TAttributeType::kVerAlign;
+        }
+    }
+    else if (strName == _T("name")) {
+        attribute.m_type = TAttributeType::kName;
+    }
+    else if (strName == _T("visible")) {
+        attribute.m_bValue = (strValue == _T("true"));
+        attribute.m_type = TAttributeType::kVisible;
+    }
+    else if (strName == _T("enabled")) {
+        attribute.m_bValue = (strValue == _T("true"));
+        attribute.m_type = TAttributeType::kEnabled;
+    }
+    else if ((strName == _T("mouse_enabled")) || (strName == _T("mouse"))) {
+        attribute.m_bValue = (strValue == _T("true"));
+        attribute.m_type = TAttributeType::kMouseEnabled;
+    }
+    else if (strName == _T("float")) {
+        attribute.m_bValue = (strValue == _T("true"));
+        attribute.m_type = TAttributeType::kFloat;
+    }
+}
+
+void WindowBuilder::ApplyPrototypeAttribute(Control* pControl, const ControlPrototype::TAttribute& attribute)
+{
+    using TAttributeType = ControlPrototype::TAttributeType;
+    ASSERT(pControl != nullptr);
+    if (pControl == nullptr) {
+        return;
+    }
+    switch (attribute.m_type) {
+    case TAttributeType::kWidth:
+        pControl->SetFixedWidth(attribute.m_fixedInt, true, attribute.m_bNeedDpiScale);
+        break;
+    case TAttributeType::kHeight:
+        pControl->SetFixedHeight(attribute.m_fixedInt, true, attribute.m_bNeedDpiScale);
+        break;
+    case TAttributeType::kMargin:
+        pControl->SetMargin(attribute.m_rcMargin, true);
+        break;
+    case TAttributeType::kPadding:
+        pControl->SetPadding(attribute.m_rcPadding, true);
+        break;
+    case TAttributeType::kHorAlign:
+        pControl->SetHorAlignType((HorAlignType)attribute.m_nAlignType);
+        break;
+    case TAttributeType::kVerAlign:
+        pControl->SetVerAlignType((VerAlignType)attribute.m_nAlignType);
+        break;
+    case TAttributeType::kName:
+        pControl->SetName(attribute.m_value);
+        break;
+    case TAttributeType::kVisible:
+        pControl->SetVisible(attribute.m_bValue);
+        break;
+    case TAttributeType::kEnabled:
+        pControl->SetEnabled(attribute.m_bValue);
+        break;
+    case TAttributeType::kMouseEnabled:
+        pControl->SetMouseEnabled(attribute.m_bValue);
+        break;
+    case TAttributeType::kFloat:
+        pControl->SetFloat(attribute.m_bValue);
+        break;
+    default:
+        pControl->SetAttribute(attribute.m_name, attribute.m_value);
+        break;
+    }
+}
+
+Control* WindowBuilder::CreateControls(const ControlPrototype& prototype,
+                                       Window* pWindow,
+                                       CreateControlCallback pCallback,
+                                       Box* pParent,
+                                       Box* pUserDefinedBox)
+{
+    ASSERT(pWindow != nullptr);
+    if (pWindow == nullptr) {
+        return nullptr;
+    }
+    if ((pParent != nullptr) && (pParent->GetWindow() == nullptr)) {
+        pParent->SetWindow(pWindow);
+    }
+    if ((pUserDefinedBox != nullptr) && (pUserDefinedBox->GetWindow() == nullptr)) {
+        pUserDefinedBox->SetWindow(pWindow);
+    }
+
+    //窗口下的共享资源，只添加一次
+    for (const auto& windowClass : prototype.m_windowClasses) {
+        if (pWindow->GetClassAttributes(windowClass.first).empty()) {
+            pWindow->AddClass(windowClass.first, windowClass.second);
+        }
+    }
+    for (const auto& textColor : prototype.m_windowTextColors) {
+        if (pWindow->GetTextColor(textColor.first).IsEmpty()) {
+            pWindow->AddTextColor(textColor.first, textColor.second);
+        }
+    }
+
+    if (prototype.m_nodes.empty()) {
+        return nullptr;
+    }
+    if (pUserDefinedBox == nullptr) {
+        return CreatePrototypeControls(prototype.m_nodes, pParent, pWindow, pCallback);
+    }
+    const ControlPrototype::TControlNode& controlNode = prototype.m_nodes.front();
+    CreatePrototypeControls(controlNode.m_children, pUserDefinedBox, pWindow, pCallback);
+    for (const ControlPrototype::TEventNode& eventNode : controlNode.m_events) {
+        AttachXmlEvent(eventNode.m_bBubbled, eventNode.m_type, eventNode.m_receiver, eventNode.m_applyAttribute, pUserDefinedBox);
+    }
+    //用户自定义的容器可能重写了SetAttribute函数，按字符串形式设置属性
+    for (const ControlPrototype::TAttribute& attribute : controlNode.m_attributes) {
+        pUserDefinedBox->SetAttribute(attribute.m_name, attribute.m_value);
+    }
+    return pUserDefinedBox;
+}
+
+Control* WindowBuilder::CreatePrototypeControls(const std::vector<ControlPrototype::TControlNode>& nodes,
+                                                Control* pParent, Window* pWindow,
+                                                const CreateControlCallback& pCallback)
+{
+    Control* pReturn = nullptr;
+    for (const ControlPrototype::TControlNode& controlNode : nodes) {
+        Control* pControl = CreateControlByClass(controlNode.m_className, pWindow);
+        //内置控件可使用预编译的属性，其他控件可能重写了SetAttribute函数，按字符串形式设置属性
+        const bool bBuiltinControl = (pControl != nullptr);
+        if (pControl == nullptr) {
+            pControl = GlobalManager::Instance().CreateControl(controlNode.m_className);
+        }
+        if ((pControl == nullptr) && pCallback) {
+            pControl = pCallback(controlNode.m_className);
+        }
+        if (pControl == nullptr) {
+            ASSERT(!"Found unknown node name, can't create control!");
+            continue;
+        }
+        pControl->SetWindow(pWindow);
+        for (const ControlPrototype::TAttribute& attribute : controlNode.m_attributes) {
+            if (bBuiltinControl) {
+                ApplyPrototypeAttribute(pControl, attribute);
+            }
+            else {
+                pControl->SetAttribute(attribute.m_name, attribute.m_value);
+            }
+        }
+        for (const ControlPrototype::TEventNode& eventNode : controlNode.m_events) {
+            AttachXmlEvent(eventNode.m_bBubbled, eventNode.m_type, eventNode.m_receiver, eventNode.m_applyAttribute, pControl);
+        }
+        if (!controlNode.m_children.empty()) {
+            CreatePrototypeControls(controlNode.m_children, pControl, pWindow, pCallback);
+        }
+
+        //某些属性和父窗口相关，比如selected，必须先Add到父窗口
+        if (pParent != nullptr) {
+            Box* pContainer = dynamic_cast<Box*>(pParent);
+            ASSERT(pContainer != nullptr);
+            if (pContainer == nullptr) {
+                delete pControl;
+                return nullptr;
+            }
+            if (!pContainer->AddItem(pControl)) {
+                ASSERT(0);
+                delete pControl;
+                continue;
+            }
+        }
+        if (pReturn == nullptr) {
+            pReturn = pControl;
+        }
+    }
+    return pReturn;
+}
+
 } // namespace ui
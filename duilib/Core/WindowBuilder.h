@@ -3,6 +3,8 @@
 
 #include "duilib/Core/UiTypes.h"
 #include "duilib/Utils/FilePath.h"
+#include "duilib/Core/ControlPrototype.h"
+#include <memory>
 
 namespace pugi
 {
@@ -20,6 +22,7 @@ class Control;
 class RichTextSlice;
 class RichTextImpl;
 class WindowCreateAttributes;
+struct BinarySkinImageIndex;
 
 /** 创建控件的回调函数
 */
@@ -73,6 +76,10 @@ public:
     */
     bool ParseXmlFile(const FilePath& xmlFilePath, const FilePath& windowResPath = FilePath());
 
+    /** 清除XML文档缓存（ParseXmlFile解析过的XML文件，文档对象会被缓存，再次解析同一个文件时直接使用，比如菜单、下拉框等频繁创建的窗口）
+    */
+    static void ClearXmlDocumentCache();
+
     /** 使用缓存中已经解析过的XML文件或者数据创建窗口布局等（即CreateFromXmlData和CreateFromXmlFile解析后的结果）
     * @param [in] pWindow 关联的窗口, 不允许为nullptr, 因DPI自适应需要对控件的大小等进行DPI缩放
     * @param [in] pCallback 根据Class名称创建控件（或容器）的函数，适用于自定义控件
@@ -94,6 +101,26 @@ public:
     */
     bool ParseWindowCreateAttributes(WindowCreateAttributes& createAttributes);
 
+public:
+    /** 根据当前解析的XML创建控件原型（需要先解析XML），用于重复创建同一个模板的大量实例
+    * @param [in] pWindow 关联的窗口，用于查找Include包含的XML文件
+    * @return 如果XML的根节点为Global，或者XML中含有不支持原型的节点（RichText、TreeNode），返回nullptr
+    */
+    std::shared_ptr<ControlPrototype> CreatePrototype(const Window* pWindow) const;
+
+    /** 使用控件原型创建控件，参数和返回值与CreateControls函数相同（不解析Window标签的属性）
+    * @param [in] prototype 控件原型
+    * @param [in] pWindow 关联的窗口, 不允许为nullptr, 因DPI自适应需要对控件的大小等进行DPI缩放
+    * @param [in] pCallback 根据Class名称创建控件（或容器）的函数，适用于自定义控件
+    * @param [in] pParent 父容器，将原型中的节点，作为pParent容器的子节点
+    * @param [in] pUserDefinedBox 用户自定义的父容器，将原型中的节点，作为pUserDefinedBox容器的子节点
+    */
+    static Control* CreateControls(const ControlPrototype& prototype,
+                                   Window* pWindow,
+                                   CreateControlCallback pCallback = CreateControlCallback(),
+                                   Box* pParent = nullptr,
+                                   Box* pUserDefinedBox = nullptr);
+
 public:
     /** 解析出窗口的属性(属性名称保存在Map的Key中，属性的值保存在属性的Value中)
     */
@@ -111,6 +138,27 @@ public:
     */
     const std::vector<DString>& GetGlobalFontIdList() const;
 
+public:
+    /** 获取XML中引用的图片属性值（包括Class定义中的图片属性，以及节点的class属性引用的全局Class中的图片属性），用于预取图片
+    *   注意：不解析Include标签包含的XML文件
+    * @param [out] imageStrings 返回图片属性值列表
+    */
+    void GetImageStrings(std::vector<DString>& imageStrings) const;
+
+    /** 获取Class中的图片属性值（比如列表项使用的Class，用于预取列表项模板中的图片）
+    * @param [in] pWindow 关联的窗口，用于查找窗口中定义的Class，可以为nullptr
+    * @param [in] strClassList Class名称列表，多个名称以空格分隔
+    * @param [out] imageStrings 返回图片属性值列表
+    */
+    static void GetClassImageStrings(const Window* pWindow, const DString& strClassList,
+                                     std::vector<DString>& imageStrings);
+
+    /** 判断一个属性是否为图片属性（属性名称以"image"结尾，比如："bkimage"，"normal_image"，"forehotimage"等）
+    * @param [in] strName 属性名称
+    * @param [in] strValue 属性值
+    */
+    static bool IsImageAttribute(const DString& strName, const DString& strValue);
+
 public:
     /** 解析带格式的文本内容，并设置到RichText Control对象
     * @param [in] xmlText 带格式的文本内容
@@ -155,7 +203,7 @@ private:
 
     /** 根据控件的Class名称，创建控件（或容器）
     */
-    Control* CreateControlByClass(const DString& strControlClass, Window* pWindow);
+    static Control* CreateControlByClass(const DString& strControlClass, Window* pWindow);
 
     /** 创建XML事件（XML节点为<Event>或者<BubbledEvent>）
     *   举例子：
@@ -164,6 +212,53 @@ private:
     *   </Option>
     */
     void AttachXmlEvent(bool bBubbled, const pugi::xml_node& node, Control* pParent);
+    static void AttachXmlEvent(bool bBubbled, const DString& strType, const DString& strReceiver,
+                               const DString& strApplyAttribute, Control* pParent);
+
+    /** 解析XML事件节点的属性（XML节点为<Event>或者<BubbledEvent>）
+    */
+    static void ParseXmlEventNode(const pugi::xml_node& node, DString& strType, DString& strReceiver, DString& strApplyAttribute);
+
+    /** 获取Include节点包含的XML文件路径
+    */
+    FilePath GetIncludeXmlFilePath(const pugi::xml_node& node) const;
+
+    /** 编译XML根节点，生成控件原型的节点（含窗口Class和TextColor的定义）
+    */
+    bool CompilePrototypeRoot(const Window* pWindow, ControlPrototype& prototype,
+                              std::vector<ControlPrototype::TControlNode>& nodes) const;
+
+    /** 编译XML节点的子节点，生成控件原型的节点
+    * @param [in] pParentNode 父控件节点，用于关联XML事件
+    */
+    bool CompilePrototypeChildren(const Window* pWindow, const pugi::xml_node& xmlNode,
+                                  ControlPrototype& prototype,
+                                  ControlPrototype::TControlNode* pParentNode,
+                                  std::vector<ControlPrototype::TControlNode>& nodes) const;
+
+    /** 展开控件的class属性（只展开全局Class和XML中定义的Class，其他Class在创建控件时再查找）
+    */
+    static void ExpandPrototypeClass(const ControlPrototype& prototype, const DString& strClassList,
+                                     std::vector<std::pair<DString, DString>>& attributes);
+
+    /** 预编译控件的属性：常用属性的值解析为类型化的值，其他属性保留字符串形式
+    * @param [in] strClassName 控件的类型名称
+    * @param [in] strName 属性名称
+    * @param [in] strValue 属性值
+    * @param [out] attribute 返回预编译的属性
+    */
+    static void CompilePrototypeAttribute(const DString& strClassName, const DString& strName, const DString& strValue,
+                                          ControlPrototype::TAttribute& attribute);
+
+    /** 设置预编译的属性（与Control::SetAttribute函数的处理逻辑相同，但不再解析字符串）
+    */
+    static void ApplyPrototypeAttribute(Control* pControl, const ControlPrototype::TAttribute& attribute);
+
+    /** 使用控件原型的节点创建控件
+    */
+    static Control* CreatePrototypeControls(const std::vector<ControlPrototype::TControlNode>& nodes,
+                                            Control* pParent, Window* pWindow,
+                                            const CreateControlCallback& pCallback);
 
     /** 判断XML文件是否存在
     */
@@ -173,11 +268,24 @@ private:
     */
     void ParseFontXmlNode(const pugi::xml_node& xmlNode);
 
+    /** 获取XML节点及其子节点中的图片属性值
+    * @param [in] xmlNode xml节点
+    * @param [out] imageStrings 返回图片属性值列表
+    * @param [out] classList 返回节点的class属性值列表
+    */
+    void GetNodeImageStrings(const pugi::xml_node& xmlNode,
+                             std::vector<DString>& imageStrings,
+                             std::vector<DString>& classList) const;
+
 private:
     
-    /** 当前解析的XML文档对象
+    /** 当前解析的XML文档对象（解析XML文件时，可能与其他WindowBuilder对象共享缓存中的文档对象，解析后只读）
+    */
+    std::shared_ptr<pugi::xml_document> m_xml;
+
+    /** 当前文档的图片资源索引（从二进制皮肤文件加载时有效，用于获取图片属性值时不再遍历XML文档）
     */
-    std::unique_ptr<pugi::xml_document> m_xml;
+    std::shared_ptr<BinarySkinImageIndex> m_spImageIndex;
 
     /** 创建Control的回调接口
     */
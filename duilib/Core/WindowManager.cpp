@@ -2,10 +2,19 @@
 #include "duilib/Core/Window.h"
 #include "duilib/Core/GlobalManager.h"
 #include <set>
+#include <algorithm>
+
+//弹出窗口缓存池默认的大小
+#define DEFAULT_POPUP_WINDOW_POOL_SIZE 4
+
+//弹出窗口缓存池中窗口默认的最长空闲时间（毫秒）
+#define DEFAULT_POPUP_WINDOW_IDLE_TIME 30000
 
 namespace ui 
 {
-WindowManager::WindowManager()
+WindowManager::WindowManager():
+    m_nPopupWindowPoolSize(DEFAULT_POPUP_WINDOW_POOL_SIZE),
+    m_nPopupWindowIdleTime(DEFAULT_POPUP_WINDOW_IDLE_TIME)
 {
 }
 
@@ -124,7 +133,140 @@ WindowPtr WindowManager::GetWindowById(const DString& windowId) const
 
 void WindowManager::Clear()
 {
+    ClearPopupWindows();
     m_windowList.clear();
 }
 
+void WindowManager::SetPopupWindowPoolSize(size_t nMaxCount)
+{
+    m_nPopupWindowPoolSize = nMaxCount;
+    while (m_popupWindows.size() > m_nPopupWindowPoolSize) {
+        //关闭最早放入的窗口
+        WindowPtr pWindow = m_popupWindows.front().m_pWindow;
+        m_popupWindows.erase(m_popupWindows.begin());
+        if ((pWindow != nullptr) && pWindow->IsWindow()) {
+            pWindow->CloseWnd();
+        }
+    }
+}
+
+size_t WindowManager::GetPopupWindowPoolSize() const
+{
+    return m_nPopupWindowPoolSize;
+}
+
+void WindowManager::SetPopupWindowIdleTime(uint32_t nIdleTimeMs)
+{
+    m_nPopupWindowIdleTime = nIdleTimeMs;
+}
+
+uint32_t WindowManager::GetPopupWindowIdleTime() const
+{
+    return m_nPopupWindowIdleTime;
+}
+
+bool WindowManager::AddPopupWindow(const DString& poolKey, Window* pWindow)
+{
+    GlobalManager::Instance().AssertUIThread();
+    ASSERT((pWindow != nullptr) && !poolKey.empty());
+    if ((pWindow == nullptr) || poolKey.empty() || (m_nPopupWindowPoolSize == 0)) {
+        return false;
+    }
+    if (!pWindow->IsWindow() || pWindow->IsClosingWnd() || (pWindow->GetParentWindow() == nullptr)) {
+        return false;
+    }
+    //移除已经关闭的窗口
+    auto iterRemove = std::remove_if(m_popupWindows.begin(), m_popupWindows.end(),
+                                     [pWindow](const TPopupWindow& popupWindow) {
+                                         return (popupWindow.m_pWindow == nullptr) ||
+                                                (popupWindow.m_pParentWindow == nullptr) ||
+                                                (popupWindow.m_pWindow.get() == pWindow);
+                                     });
+    m_popupWindows.erase(iterRemove, m_popupWindows.end());
+    while (m_popupWindows.size() >= m_nPopupWindowPoolSize) {
+        //缓存池已满，关闭最早放入的窗口
+        WindowPtr pOldWindow = m_popupWindows.front().m_pWindow;
+        m_popupWindows.erase(m_popupWindows.begin());
+        if ((pOldWindow != nullptr) && pOldWindow->IsWindow()) {
+            pOldWindow->CloseWnd();
+        }
+    }
+
+    TPopupWindow popupWindow;
+    popupWindow.m_poolKey = poolKey;
+    popupWindow.m_pWindow = pWindow;
+    popupWindow.m_pParentWindow = pWindow->GetParentWindow();
+    popupWindow.m_idleTime = std::chrono::steady_clock::now();
+    m_popupWindows.push_back(popupWindow);
+
+    if (!m_popupTimerFlag.HasUsed()) {
+        //定时关闭空闲时间过长的窗口
+        uint32_t nElapseMs = std::max(m_nPopupWindowIdleTime / 2, (uint32_t)1000);
+        GlobalManager::Instance().Timer().AddTimer(m_popupTimerFlag.GetWeakFlag(),
+                                                   [this]() { TrimPopupWindows(); },
+                                                   nElapseMs);
+    }
+    return true;
+}
+
+Window* WindowManager::TakePopupWindow(const DString& poolKey, const Window* pParentWindow)
+{
+    GlobalManager::Instance().AssertUIThread();
+    if (poolKey.empty() || (pParentWindow == nullptr)) {
+        return nullptr;
+    }
+    //优先复用最近放入的窗口
+    for (auto iter = m_popupWindows.rbegin(); iter != m_popupWindows.rend(); ++iter) {
+        if ((iter->m_poolKey != poolKey) || (iter->m_pParentWindow.get() != pParentWindow)) {
+            continue;
+        }
+        WindowPtr pWindow = iter->m_pWindow;
+        m_popupWindows.erase(std::next(iter).base());
+        if ((pWindow != nullptr) && pWindow->IsWindow() && !pWindow->IsClosingWnd()) {
+            return pWindow.get();
+        }
+        break;
+    }
+    return nullptr;
+}
+
+void WindowManager::ClearPopupWindows()
+{
+    m_popupTimerFlag.Cancel();
+    std::vector<TPopupWindow> popupWindows;
+    popupWindows.swap(m_popupWindows);
+    for (const TPopupWindow& popupWindow : popupWindows) {
+        WindowPtr pWindow = popupWindow.m_pWindow;
+        if ((pWindow != nullptr) && pWindow->IsWindow() && !pWindow->IsClosingWnd()) {
+            pWindow->CloseWnd();
+        }
+    }
+}
+
+void WindowManager::TrimPopupWindows()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto idleTime = std::chrono::milliseconds(m_nPopupWindowIdleTime);
+    std::vector<WindowPtr> closeWindows;
+    auto iter = m_popupWindows.begin();
+    while (iter != m_popupWindows.end()) {
+        if ((iter->m_pWindow == nullptr) || (iter->m_pParentWindow == nullptr) ||
+            ((now - iter->m_idleTime) >= idleTime)) {
+            closeWindows.push_back(iter->m_pWindow);
+            iter = m_popupWindows.erase(iter);
+        }
+        else {
+            ++iter;
+        }
+    }
+    if (m_popupWindows.empty()) {
+        m_popupTimerFlag.Cancel();
+    }
+    for (WindowPtr pWindow : closeWindows) {
+        if ((pWindow != nullptr) && pWindow->IsWindow() && !pWindow->IsClosingWnd()) {
+            pWindow->CloseWnd();
+        }
+    }
+}
+
 } //namespace ui
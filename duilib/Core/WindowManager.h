@@ -3,6 +3,8 @@
 
 #include "duilib/Core/UiTypes.h"
 #include "duilib/Core/ControlPtrT.h"
+#include "duilib/Core/Callback.h"
+#include <chrono>
 
 namespace ui 
 {
@@ -55,10 +57,78 @@ public:
     */
     void Clear();
 
+public:
+    /** 设置弹出窗口缓存池的大小（缓存池中保留隐藏的弹出窗口，再次弹出时复用，避免重新创建窗口）
+    * @param [in] nMaxCount 缓存池中最多保留的窗口个数，为0表示不缓存
+    */
+    void SetPopupWindowPoolSize(size_t nMaxCount);
+
+    /** 获取弹出窗口缓存池的大小
+    */
+    size_t GetPopupWindowPoolSize() const;
+
+    /** 设置弹出窗口在缓存池中的最长空闲时间，超过该时间未被复用的窗口将被关闭
+    * @param [in] nIdleTimeMs 空闲时间，单位为毫秒
+    */
+    void SetPopupWindowIdleTime(uint32_t nIdleTimeMs);
+
+    /** 获取弹出窗口在缓存池中的最长空闲时间，单位为毫秒
+    */
+    uint32_t GetPopupWindowIdleTime() const;
+
+    /** 将一个已经隐藏的弹出窗口放入缓存池
+    *   目前由Combo的下拉列表窗口使用：
+    *   Menu对象由调用方创建并在窗口关闭后自行销毁，子菜单窗口随父菜单窗口一起销毁，其窗口无法放入缓存池（菜单的XML解析结果由WindowBuilder缓存）；
+    *   ToolTip窗口每个父窗口只创建一次，隐藏后再次显示时直接复用，且弹出窗口无法更换父窗口，因此也不放入缓存池
+    * @param [in] poolKey 窗口的类型标识，复用时只取出相同类型标识的窗口
+    * @param [in] pWindow 弹出窗口，必须已经隐藏
+    * @return 返回true表示已放入缓存池；返回false表示未放入（缓存池已满或者已禁用），调用方需要关闭窗口
+    */
+    bool AddPopupWindow(const DString& poolKey, Window* pWindow);
+
+    /** 从缓存池中取出一个可复用的弹出窗口
+    * @param [in] poolKey 窗口的类型标识
+    * @param [in] pParentWindow 弹出窗口的父窗口，只取出父窗口相同的窗口
+    * @return 返回可复用的窗口，如果没有返回nullptr
+    */
+    Window* TakePopupWindow(const DString& poolKey, const Window* pParentWindow);
+
+    /** 关闭缓存池中的所有弹出窗口
+    */
+    void ClearPopupWindows();
+
+private:
+    /** 关闭缓存池中空闲时间超过限制的弹出窗口
+    */
+    void TrimPopupWindows();
+
 private:
     /** 窗口列表
     */
     std::vector<WindowPtr> m_windowList;
+
+    /** 缓存池中的弹出窗口
+    */
+    struct TPopupWindow
+    {
+        DString m_poolKey;
+        WindowPtr m_pWindow;
+        WindowPtr m_pParentWindow;
+        std::chrono::steady_clock::time_point m_idleTime;
+    };
+    std::vector<TPopupWindow> m_popupWindows;
+
+    /** 缓存池中最多保留的窗口个数
+    */
+    size_t m_nPopupWindowPoolSize;
+
+    /** 缓存池中窗口的最长空闲时间（毫秒）
+    */
+    uint32_t m_nPopupWindowIdleTime;
+
+    /** 空闲检查定时器的取消机制
+    */
+    WeakCallbackFlag m_popupTimerFlag;
 };
 
 } //namespace ui 
@@ -134,6 +134,30 @@ bool ZipManager::GetZipData(const FilePath& path, std::vector<unsigned char>& fi
     return true;
 }
 
+bool ZipManager::GetZipFileInfo(const FilePath& path, uint32_t& nCrc32, uint64_t& nFileSize) const
+{
+    nCrc32 = 0;
+    nFileSize = 0;
+    GlobalManager::Instance().AssertUIThread();
+    ASSERT(m_hzip != nullptr);
+    if (m_hzip == nullptr) {
+        return false;
+    }
+    const FilePath normalizePath = FilePathUtil::NormalizeFilePath(path);
+    std::string filePathA;
+    if (!LocateFile(normalizePath, filePathA)) {
+        return false;
+    }
+    unz_file_info file_info = {0, };
+    int nRet = ::unzGetCurrentFileInfo(m_hzip, &file_info, nullptr, 0, nullptr, 0, nullptr, 0);
+    if ((nRet != UNZ_OK) || (file_info.uncompressed_size == 0)) {
+        return false;
+    }
+    nCrc32 = (uint32_t)file_info.crc;
+    nFileSize = (uint64_t)file_info.uncompressed_size;
+    return true;
+}
+
 bool ZipManager::IsZipResExist(const FilePath& path) const
 {
     GlobalManager::Instance().AssertUIThread();
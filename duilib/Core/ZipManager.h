@@ -53,6 +53,13 @@ public:
      */
     bool GetZipData(const FilePath& path, std::vector<unsigned char>& fileData) const;
 
+    /** 获取压缩包中文件的基本信息（不解压文件内容）
+     * @param [in] path 文件的路径(压缩包内路径)
+     * @param [out] nCrc32 返回文件内容的CRC32校验值
+     * @param [out] nFileSize 返回文件的原始大小（字节）
+     */
+    bool GetZipFileInfo(const FilePath& path, uint32_t& nCrc32, uint64_t& nFileSize) const;
+
     /** 判断资源是否存在zip当中
      * @param[in] path 要判断的资源路径(压缩包内路径)
      */
@@ -326,6 +326,38 @@ std::shared_ptr<IBitmap> Image::GetCurrentBitmap(bool bImageStretch,
     }    
 }
 
+std::shared_ptr<IBitmap> Image::GetAtlasBitmap(const UiRect& rcDest,
+                                               UiRect& rcSource,
+                                               const UiRect& rcSourceCorners) const
+{
+    if (!m_imageInfo || m_imageInfo->IsMultiFrameImage()) {
+        return nullptr;
+    }
+    if (!rcSourceCorners.IsZero()) {
+        //九宫格绘制，不使用图集
+        return nullptr;
+    }
+    if ((rcDest.Width() != rcSource.Width()) || (rcDest.Height() != rcSource.Height())) {
+        //图集仅用于原大小绘制，拉伸绘制时使用独立的位图（避免采样到相邻图标的像素，SVG图片还需要矢量缩放）
+        return nullptr;
+    }
+    if ((rcSource.left < 0) || (rcSource.top < 0) ||
+        (rcSource.right > m_imageInfo->GetWidth()) || (rcSource.bottom > m_imageInfo->GetHeight())) {
+        return nullptr;
+    }
+    ImageAtlasEntry atlasEntry;
+    if (!m_imageInfo->GetAtlasBitmap(atlasEntry) || (atlasEntry.m_pAtlasBitmap == nullptr)) {
+        return nullptr;
+    }
+    if ((atlasEntry.m_rcSource.Width() != m_imageInfo->GetWidth()) ||
+        (atlasEntry.m_rcSource.Height() != m_imageInfo->GetHeight())) {
+        //图集中的图片大小与图片信息中的大小不一致，源区域无法直接映射到图集中（会采样到相邻图标的像素），使用独立的位图
+        return nullptr;
+    }
+    rcSource.Offset(atlasEntry.m_rcSource.left, atlasEntry.m_rcSource.top);
+    return atlasEntry.m_pAtlasBitmap;
+}
+
 void Image::SetControl(Control* pControl)
 {
     if (m_pControl != pControl) {
@@ -155,6 +155,16 @@ public:
                                               UiRect& rcSourceCorners,
                                               bool* bDecodeError) const;
 
+    /** 获取图片在共享图集中的位图（单帧小图标，按原大小绘制时可用）
+    * @param [in] rcDest 绘制目标区域
+    * @param [in,out] rcSource 图片源区域，成功时修改为在图集位图中的区域
+    * @param [in] rcSourceCorners 图片的九宫格圆角属性
+    * @return 返回图集位图，如果不能从图集中绘制，返回nullptr
+    */
+    std::shared_ptr<IBitmap> GetAtlasBitmap(const UiRect& rcDest,
+                                            UiRect& rcSource,
+                                            const UiRect& rcSourceCorners) const;
+
     /** @} */
 
 public:
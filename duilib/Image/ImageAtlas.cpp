@@ -0,0 +1,432 @@
+#include "ImageAtlas.h"
+#include "duilib/Render/IRender.h"
+#include "duilib/Core/GlobalManager.h"
+#include "duilib/Utils/PerformanceUtil.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ui
+{
+/** 图集页的宽度和高度（像素）
+*/
+#define IMAGE_ATLAS_PAGE_SIZE       512
+
+/** 图集中图标之间的间隔（像素）
+*/
+#define IMAGE_ATLAS_PADDING         1
+
+ImageAtlas::ImageAtlas():
+    m_nMaxImageSize(64)
+{
+}
+
+ImageAtlas::~ImageAtlas()
+{
+    Clear();
+}
+
+void ImageAtlas::SetMaxImageSize(uint32_t nMaxImageSize)
+{
+    m_nMaxImageSize = nMaxImageSize;
+}
+
+uint32_t ImageAtlas::GetMaxImageSize() const
+{
+    return m_nMaxImageSize;
+}
+
+bool ImageAtlas::IsAtlasImageSize(uint32_t nWidth, uint32_t nHeight, uint32_t nDpiScale) const
+{
+    if ((nWidth == 0) || (nHeight == 0) || (m_nMaxImageSize == 0)) {
+        return false;
+    }
+    if (nDpiScale == 0) {
+        nDpiScale = 100;
+    }
+    uint32_t nMaxSize = m_nMaxImageSize * nDpiScale / 100;
+    //单个图标最多占用图集页的1/4宽度，避免图集页的空间浪费
+    nMaxSize = std::min(nMaxSize, (uint32_t)IMAGE_ATLAS_PAGE_SIZE / 4);
+    return (nWidth <= nMaxSize) && (nHeight <= nMaxSize);
+}
+
+bool ImageAtlas::FindImage(const DString& imageKey, uint32_t nDpiScale, const UiSize& szImage, ImageAtlasEntry& entry) const
+{
+    auto iter = m_atlasImages.find(imageKey);
+    if (iter == m_atlasImages.end()) {
+        return false;
+    }
+    for (const TAtlasImage& atlasImage : iter->second) {
+        if ((atlasImage.m_nDpiScale == nDpiScale) && (atlasImage.m_szImage == szImage)) {
+            ASSERT(atlasImage.m_pPage != nullptr);
+            entry.m_pAtlasBitmap = atlasImage.m_pPage->m_pBitmap;
+            entry.m_rcSource = atlasImage.m_rcSource;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ImageAtlas::AddBitmap(const DString& imageKey, uint32_t nDpiScale, IBitmap* pBitmap, ImageAtlasEntry& entry)
+{
+    GlobalManager::Instance().AssertUIThread();
+    ASSERT(pBitmap != nullptr);
+    if (pBitmap == nullptr) {
+        return false;
+    }
+    const UiSize szImage((int32_t)pBitmap->GetWidth(), (int32_t)pBitmap->GetHeight());
+    if (!IsAtlasImageSize((uint32_t)szImage.cx, (uint32_t)szImage.cy, nDpiScale)) {
+        return false;
+    }
+    if (AddImageRef(imageKey, nDpiScale, szImage, entry)) {
+        return true;
+    }
+    PerformanceStat statPerformance(_T("ImageAtlas::AddBitmap"));
+    std::shared_ptr<TAtlasPage> pPage;
+    UiRect rcSource;
+    UiRect rcSlot;
+    if (!AllocRect(nDpiScale, szImage, pPage, rcSource, rcSlot)) {
+        return false;
+    }
+    const uint8_t* pSrcBits = (const uint8_t*)pBitmap->LockPixelBits();
+    uint8_t* pDestBits = (uint8_t*)pPage->m_pBitmap->LockPixelBits();
+    ASSERT((pSrcBits != nullptr) && (pDestBits != nullptr));
+    if ((pSrcBits != nullptr) && (pDestBits != nullptr)) {
+        const size_t nSrcRowBytes = (size_t)szImage.cx * sizeof(uint32_t);
+        const size_t nDestRowBytes = (size_t)pPage->m_pBitmap->GetWidth() * sizeof(uint32_t);
+        pDestBits += (size_t)rcSource.top * nDestRowBytes + (size_t)rcSource.left * sizeof(uint32_t);
+        for (int32_t nRow = 0; nRow < szImage.cy; ++nRow) {
+            ::memcpy(pDestBits, pSrcBits, nSrcRowBytes);
+            pSrcBits += nSrcRowBytes;
+            pDestBits += nDestRowBytes;
+        }
+    }
+    pBitmap->UnLockPixelBits();
+    pPage->m_pBitmap->UnLockPixelBits();
+    if ((pSrcBits == nullptr) || (pDestBits == nullptr)) {
+        ReleasePageImage(pPage, rcSlot);
+        return false;
+    }
+    AddAtlasImage(imageKey, nDpiScale, szImage, pPage, rcSource, rcSlot, entry);
+    return true;
+}
+
+bool ImageAtlas::AddSvgImage(const DString& imageKey, uint32_t nDpiScale, ISvgImage* pSvgImage,
+                             const UiSize& szImage, ImageAtlasEntry& entry)
+{
+    GlobalManager::Instance().AssertUIThread();
+    ASSERT(pSvgImage != nullptr);
+    if (pSvgImage == nullptr) {
+        return false;
+    }
+    if (!IsAtlasImageSize((uint32_t)szImage.cx, (uint32_t)szImage.cy, nDpiScale)) {
+        return false;
+    }
+    if (AddImageRef(imageKey, nDpiScale, szImage, entry)) {
+        return true;
+    }
+    PerformanceStat statPerformance(_T("ImageAtlas::AddSvgImage"));
+    std::shared_ptr<TAtlasPage> pPage;
+    UiRect rcSource;
+    UiRect rcSlot;
+    if (!AllocRect(nDpiScale, szImage, pPage, rcSource, rcSlot)) {
+        return false;
+    }
+    bool bRet = false;
+    uint8_t* pDestBits = (uint8_t*)pPage->m_pBitmap->LockPixelBits();
+    ASSERT(pDestBits != nullptr);
+    if (pDestBits != nullptr) {
+        //直接光栅化到图集页中分配的区域（未使用的区域均已清零，为全透明）
+        const size_t nDestRowBytes = (size_t)pPage->m_pBitmap->GetWidth() * sizeof(uint32_t);
+        pDestBits += (size_t)rcSource.top * nDestRowBytes + (size_t)rcSource.left * sizeof(uint32_t);
+        bRet = pSvgImage->RenderToPixels(pDestBits, nDestRowBytes, szImage);
+    }
+    pPage->m_pBitmap->UnLockPixelBits();
+    if (!bRet) {
+        ReleasePageImage(pPage, rcSlot);
+        return false;
+    }
+    AddAtlasImage(imageKey, nDpiScale, szImage, pPage, rcSource, rcSlot, entry);
+    return true;
+}
+
+void ImageAtlas::RemoveImage(const DString& imageKey, const ImageAtlasEntry& entry)
+{
+    GlobalManager::Instance().AssertUIThread();
+    auto iter = m_atlasImages.find(imageKey);
+    if (iter == m_atlasImages.end()) {
+        return;
+    }
+    std::vector<TAtlasImage>& atlasImages = iter->second;
+    for (auto iterImage = atlasImages.begin(); iterImage != atlasImages.end(); ++iterImage) {
+        //图集清除后重新加入的图片，位于新的图集页中，与旧的图集位图不匹配
+        if ((iterImage->m_pPage == nullptr) || (iterImage->m_pPage->m_pBitmap != entry.m_pAtlasBitmap) ||
+            !(iterImage->m_rcSource == entry.m_rcSource)) {
+            continue;
+        }
+        ASSERT(iterImage->m_nRefCount > 0);
+        if (iterImage->m_nRefCount > 1) {
+            --iterImage->m_nRefCount;
+            return;
+        }
+        std::shared_ptr<TAtlasPage> pPage = iterImage->m_pPage;
+        const UiRect rcSlot = iterImage->m_rcSlot;
+        atlasImages.erase(iterImage);
+        if (atlasImages.empty()) {
+            m_atlasImages.erase(iter);
+        }
+        ReleasePageImage(pPage, rcSlot);
+        return;
+    }
+}
+
+std::shared_ptr<IBitmap> ImageAtlas::CopyBitmap(const ImageAtlasEntry& entry)
+{
+    IBitmap* pAtlasBitmap = entry.m_pAtlasBitmap.get();
+    if ((pAtlasBitmap == nullptr) || entry.m_rcSource.IsEmpty()) {
+        return nullptr;
+    }
+    const UiRect& rcSource = entry.m_rcSource;
+    ASSERT((rcSource.left >= 0) && (rcSource.top >= 0) &&
+           (rcSource.right <= (int32_t)pAtlasBitmap->GetWidth()) && (rcSource.bottom <= (int32_t)pAtlasBitmap->GetHeight()));
+    if ((rcSource.left < 0) || (rcSource.top < 0) ||
+        (rcSource.right > (int32_t)pAtlasBitmap->GetWidth()) || (rcSource.bottom > (int32_t)pAtlasBitmap->GetHeight())) {
+        return nullptr;
+    }
+    IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactory != nullptr);
+    if (pRenderFactory == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<IBitmap> pBitmap(pRenderFactory->CreateBitmap());
+    ASSERT(pBitmap != nullptr);
+    if ((pBitmap == nullptr) || !pBitmap->Init((uint32_t)rcSource.Width(), (uint32_t)rcSource.Height(), nullptr)) {
+        return nullptr;
+    }
+    const uint8_t* pSrcBits = (const uint8_t*)pAtlasBitmap->LockPixelBits();
+    uint8_t* pDestBits = (uint8_t*)pBitmap->LockPixelBits();
+    const bool bRet = (pSrcBits != nullptr) && (pDestBits != nullptr);
+    if (bRet) {
+        const size_t nSrcRowBytes = (size_t)pAtlasBitmap->GetWidth() * sizeof(uint32_t);
+        const size_t nDestRowBytes = (size_t)rcSource.Width() * sizeof(uint32_t);
+        pSrcBits += (size_t)rcSource.top * nSrcRowBytes + (size_t)rcSource.left * sizeof(uint32_t);
+        for (int32_t nRow = 0; nRow < rcSource.Height(); ++nRow) {
+            ::memcpy(pDestBits, pSrcBits, nDestRowBytes);
+            pSrcBits += nSrcRowBytes;
+            pDestBits += nDestRowBytes;
+        }
+    }
+    pAtlasBitmap->UnLockPixelBits();
+    pBitmap->UnLockPixelBits();
+    return bRet ? pBitmap : nullptr;
+}
+
+void ImageAtlas::Clear()
+{
+    m_atlasImages.clear();
+    m_pages.clear();
+}
+
+size_t ImageAtlas::GetPageCount() const
+{
+    return m_pages.size();
+}
+
+size_t ImageAtlas::GetPageBytes() const
+{
+    size_t nBytes = 0;
+    for (const std::shared_ptr<TAtlasPage>& pPage : m_pages) {
+        if ((pPage != nullptr) && (pPage->m_pBitmap != nullptr)) {
+            nBytes += (size_t)pPage->m_pBitmap->GetWidth() * pPage->m_pBitmap->GetHeight() * sizeof(uint32_t);
+        }
+    }
+    return nBytes;
+}
+
+bool ImageAtlas::AllocRect(uint32_t nDpiScale, const UiSize& szImage,
+                           std::shared_ptr<TAtlasPage>& pPage, UiRect& rcSource, UiRect& rcSlot)
+{
+    ASSERT((szImage.cx > 0) && (szImage.cy > 0));
+    if ((szImage.cx <= 0) || (szImage.cy <= 0)) {
+        return false;
+    }
+    //优先在已有的同DPI图集页中分配
+    for (const std::shared_ptr<TAtlasPage>& pExistPage : m_pages) {
+        if ((pExistPage->m_nDpiScale == nDpiScale) && AllocRectInPage(*pExistPage, szImage, rcSource, rcSlot)) {
+            pPage = pExistPage;
+            ++pPage->m_nImageCount;
+            return true;
+        }
+    }
+
+    //新建图集页
+    IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactory != nullptr);
+    if (pRenderFactory == nullptr) {
+        return false;
+    }
+    std::shared_ptr<IBitmap> pBitmap(pRenderFactory->CreateBitmap());
+    ASSERT(pBitmap != nullptr);
+    if ((pBitmap == nullptr) || !pBitmap->Init(IMAGE_ATLAS_PAGE_SIZE, IMAGE_ATLAS_PAGE_SIZE, nullptr)) {
+        return false;
+    }
+    //标记为图集位图，绘制时可以合并为一次绘制调用
+    pBitmap->SetAtlasBitmap(true);
+    void* pPixelBits = pBitmap->LockPixelBits();
+    if (pPixelBits != nullptr) {
+        ::memset(pPixelBits, 0, (size_t)IMAGE_ATLAS_PAGE_SIZE * IMAGE_ATLAS_PAGE_SIZE * sizeof(uint32_t));
+    }
+    pBitmap->UnLockPixelBits();
+    if (pPixelBits == nullptr) {
+        return false;
+    }
+
+    std::shared_ptr<TAtlasPage> pNewPage = std::make_shared<TAtlasPage>();
+    pNewPage->m_nDpiScale = nDpiScale;
+    pNewPage->m_pBitmap = pBitmap;
+    if (!AllocRectInPage(*pNewPage, szImage, rcSource, rcSlot)) {
+        return false;
+    }
+    m_pages.push_back(pNewPage);
+    pPage = pNewPage;
+    ++pPage->m_nImageCount;
+    return true;
+}
+
+bool ImageAtlas::AllocRectInPage(TAtlasPage& page, const UiSize& szImage, UiRect& rcSource, UiRect& rcSlot)
+{
+    const int32_t nItemWidth = szImage.cx + IMAGE_ATLAS_PADDING;
+    const int32_t nItemHeight = szImage.cy + IMAGE_ATLAS_PADDING;
+
+    //优先复用已释放的位置：选择面积最小、且高度不超出太多的位置
+    auto iterBestSlot = page.m_freeSlots.end();
+    for (auto iter = page.m_freeSlots.begin(); iter != page.m_freeSlots.end(); ++iter) {
+        if ((iter->Width() < nItemWidth) || (iter->Height() < nItemHeight) || (iter->Height() > nItemHeight * 2)) {
+            continue;
+        }
+        if ((iterBestSlot == page.m_freeSlots.end()) ||
+            ((int64_t)iter->Width() * iter->Height() < (int64_t)iterBestSlot->Width() * iterBestSlot->Height())) {
+            iterBestSlot = iter;
+        }
+    }
+    if (iterBestSlot != page.m_freeSlots.end()) {
+        rcSlot = *iterBestSlot;
+        page.m_freeSlots.erase(iterBestSlot);
+        rcSource.left = rcSlot.left;
+        rcSource.top = rcSlot.top;
+        rcSource.right = rcSource.left + szImage.cx;
+        rcSource.bottom = rcSource.top + szImage.cy;
+        return true;
+    }
+
+    //选择剩余空间足够、且行高最接近的行
+    TAtlasShelf* pBestShelf = nullptr;
+    for (TAtlasShelf& shelf : page.m_shelves) {
+        if ((shelf.m_nHeight < nItemHeight) || (shelf.m_nNextLeft + nItemWidth > IMAGE_ATLAS_PAGE_SIZE)) {
+            continue;
+        }
+        if ((pBestShelf == nullptr) || (shelf.m_nHeight < pBestShelf->m_nHeight)) {
+            pBestShelf = &shelf;
+        }
+    }
+    //行高超出太多时（图标高度不足行高的一半），新建一行，避免空间浪费
+    if ((pBestShelf != nullptr) && (pBestShelf->m_nHeight > nItemHeight * 2) &&
+        (page.m_nNextShelfTop + nItemHeight <= IMAGE_ATLAS_PAGE_SIZE)) {
+        pBestShelf = nullptr;
+    }
+    if (pBestShelf == nullptr) {
+        if (page.m_nNextShelfTop + nItemHeight > IMAGE_ATLAS_PAGE_SIZE) {
+            return false;
+        }
+        TAtlasShelf shelf;
+        shelf.m_nTop = page.m_nNextShelfTop;
+        shelf.m_nHeight = nItemHeight;
+        shelf.m_nNextLeft = 0;
+        page.m_nNextShelfTop += nItemHeight;
+        page.m_shelves.push_back(shelf);
+        pBestShelf = &page.m_shelves.back();
+    }
+    rcSource.left = pBestShelf->m_nNextLeft;
+    rcSource.top = pBestShelf->m_nTop;
+    rcSource.right = rcSource.left + szImage.cx;
+    rcSource.bottom = rcSource.top + szImage.cy;
+    rcSlot.left = rcSource.left;
+    rcSlot.top = rcSource.top;
+    rcSlot.right = rcSlot.left + nItemWidth;
+    rcSlot.bottom = rcSlot.top + pBestShelf->m_nHeight;
+    pBestShelf->m_nNextLeft += nItemWidth;
+    return true;
+}
+
+bool ImageAtlas::AddImageRef(const DString& imageKey, uint32_t nDpiScale, const UiSize& szImage, ImageAtlasEntry& entry)
+{
+    auto iter = m_atlasImages.find(imageKey);
+    if (iter == m_atlasImages.end()) {
+        return false;
+    }
+    for (TAtlasImage& atlasImage : iter->second) {
+        if ((atlasImage.m_nDpiScale == nDpiScale) && (atlasImage.m_szImage == szImage)) {
+            ASSERT(atlasImage.m_pPage != nullptr);
+            ++atlasImage.m_nRefCount;
+            entry.m_pAtlasBitmap = atlasImage.m_pPage->m_pBitmap;
+            entry.m_rcSource = atlasImage.m_rcSource;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ImageAtlas::AddAtlasImage(const DString& imageKey, uint32_t nDpiScale, const UiSize& szImage,
+                               const std::shared_ptr<TAtlasPage>& pPage, const UiRect& rcSource, const UiRect& rcSlot,
+                               ImageAtlasEntry& entry)
+{
+    TAtlasImage atlasImage;
+    atlasImage.m_nDpiScale = nDpiScale;
+    atlasImage.m_szImage = szImage;
+    atlasImage.m_pPage = pPage;
+    atlasImage.m_rcSource = rcSource;
+    atlasImage.m_rcSlot = rcSlot;
+    atlasImage.m_nRefCount = 1;
+    m_atlasImages[imageKey].push_back(atlasImage);
+
+    entry.m_pAtlasBitmap = pPage->m_pBitmap;
+    entry.m_rcSource = rcSource;
+}
+
+void ImageAtlas::ReleasePageImage(const std::shared_ptr<TAtlasPage>& pPage, const UiRect& rcSlot)
+{
+    if (pPage == nullptr) {
+        return;
+    }
+    ASSERT(pPage->m_nImageCount > 0);
+    if (pPage->m_nImageCount > 0) {
+        --pPage->m_nImageCount;
+    }
+    if (pPage->m_nImageCount == 0) {
+        //图集页中已无图标，释放该图集页（正在绘制中的位图由绘制方持有引用）
+        auto iter = std::find(m_pages.begin(), m_pages.end(), pPage);
+        if (iter != m_pages.end()) {
+            m_pages.erase(iter);
+        }
+        return;
+    }
+    if (pPage->m_pBitmap == nullptr) {
+        return;
+    }
+    //清空该位置（保持未使用的区域全透明），然后放入空闲列表供后续复用
+    uint8_t* pDestBits = (uint8_t*)pPage->m_pBitmap->LockPixelBits();
+    if (pDestBits != nullptr) {
+        const size_t nDestRowBytes = (size_t)pPage->m_pBitmap->GetWidth() * sizeof(uint32_t);
+        pDestBits += (size_t)rcSlot.top * nDestRowBytes + (size_t)rcSlot.left * sizeof(uint32_t);
+        for (int32_t nRow = 0; nRow < rcSlot.Height(); ++nRow) {
+            ::memset(pDestBits, 0, (size_t)rcSlot.Width() * sizeof(uint32_t));
+            pDestBits += nDestRowBytes;
+        }
+    }
+    pPage->m_pBitmap->UnLockPixelBits();
+    if (pDestBits != nullptr) {
+        pPage->m_freeSlots.push_back(rcSlot);
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,183 @@
+#ifndef UI_IMAGE_IMAGE_ATLAS_H_
+#define UI_IMAGE_IMAGE_ATLAS_H_
+
+#include "duilib/Image/ImageDecoder.h"
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+namespace ui
+{
+/** 图集中的一个图片
+*/
+struct UILIB_API ImageAtlasEntry
+{
+    /** 图片所在的图集位图
+    */
+    std::shared_ptr<IBitmap> m_pAtlasBitmap;
+
+    /** 图片在图集位图中的区域
+    */
+    UiRect m_rcSource;
+};
+
+/** 小图标的共享图集：将小尺寸的单帧位图和SVG图片（按DPI缩放后的大小）打包到共享的图集位图中，
+*   每个DPI缩放比使用独立的图集页，SVG图片直接光栅化到图集页中，无需生成独立的位图，
+*   同一个图集页中的多个图标可以合并为一次绘制调用（见IRender::BeginDrawImageBatch）
+*   图集页采用按行（Shelf）分配的方式，图标之间保留1像素的透明间隔；
+*   同一个图片可以被多个调用方共享（引用计数），引用全部移除后其占用的位置清空并放入空闲列表，供后续的图标复用，
+*   图集页中的图标全部移除后释放该图集页
+*/
+class UILIB_API ImageAtlas
+{
+public:
+    ImageAtlas();
+    ~ImageAtlas();
+    ImageAtlas(const ImageAtlas&) = delete;
+    ImageAtlas& operator = (const ImageAtlas&) = delete;
+
+public:
+    /** 设置可放入图集的图片大小上限（未经DPI缩放的宽度和高度）
+    */
+    void SetMaxImageSize(uint32_t nMaxImageSize);
+
+    /** 获取可放入图集的图片大小上限（未经DPI缩放的宽度和高度）
+    */
+    uint32_t GetMaxImageSize() const;
+
+    /** 判断该大小的图片是否可以放入图集
+    * @param [in] nWidth 图片宽度（DPI缩放后的大小）
+    * @param [in] nHeight 图片高度（DPI缩放后的大小）
+    * @param [in] nDpiScale 图片的DPI缩放比
+    */
+    bool IsAtlasImageSize(uint32_t nWidth, uint32_t nHeight, uint32_t nDpiScale) const;
+
+    /** 查找图集中的图片
+    * @param [in] imageKey 图片的KEY
+    * @param [in] nDpiScale 图片的DPI缩放比
+    * @param [in] szImage 图片的大小
+    * @param [out] entry 返回图片所在的图集位图和区域
+    */
+    bool FindImage(const DString& imageKey, uint32_t nDpiScale, const UiSize& szImage, ImageAtlasEntry& entry) const;
+
+    /** 将位图复制到图集中（图片已经在图集中时，增加其引用计数）
+    * @param [in] imageKey 图片的KEY
+    * @param [in] nDpiScale 图片的DPI缩放比
+    * @param [in] pBitmap 位图接口（预乘Alpha格式）
+    * @param [out] entry 返回图片所在的图集位图和区域
+    */
+    bool AddBitmap(const DString& imageKey, uint32_t nDpiScale, IBitmap* pBitmap, ImageAtlasEntry& entry);
+
+    /** 将SVG图片直接光栅化到图集中（图片已经在图集中时，增加其引用计数）
+    * @param [in] imageKey 图片的KEY
+    * @param [in] nDpiScale 图片的DPI缩放比
+    * @param [in] pSvgImage SVG图片接口
+    * @param [in] szImage 光栅化的图片大小
+    * @param [out] entry 返回图片所在的图集位图和区域
+    */
+    bool AddSvgImage(const DString& imageKey, uint32_t nDpiScale, ISvgImage* pSvgImage,
+                     const UiSize& szImage, ImageAtlasEntry& entry);
+
+    /** 减少图集中图片的引用计数，引用计数为0时从图集中移除
+    * @param [in] imageKey 图片的KEY
+    * @param [in] entry 图片所在的图集位图和区域（由AddBitmap或者AddSvgImage返回）
+    */
+    void RemoveImage(const DString& imageKey, const ImageAtlasEntry& entry);
+
+    /** 从图集中复制出图片的独立位图（用于不能使用图集绘制的场景，比如拉伸绘制）
+    * @param [in] entry 图片所在的图集位图和区域
+    */
+    static std::shared_ptr<IBitmap> CopyBitmap(const ImageAtlasEntry& entry);
+
+    /** 清除所有图集页
+    */
+    void Clear();
+
+    /** 获取图集页的个数
+    */
+    size_t GetPageCount() const;
+
+    /** 获取图集页占用的内存（字节）
+    */
+    size_t GetPageBytes() const;
+
+private:
+    /** 图集页中的一行
+    */
+    struct TAtlasShelf
+    {
+        int32_t m_nTop = 0;         //行的顶部位置
+        int32_t m_nHeight = 0;      //行高
+        int32_t m_nNextLeft = 0;    //下一个图标的左侧位置
+    };
+
+    /** 图集页
+    */
+    struct TAtlasPage
+    {
+        uint32_t m_nDpiScale = 100;             //DPI缩放比
+        std::shared_ptr<IBitmap> m_pBitmap;     //图集位图
+        std::vector<TAtlasShelf> m_shelves;     //已分配的行
+        int32_t m_nNextShelfTop = 0;            //下一行的顶部位置
+        uint32_t m_nImageCount = 0;             //图集页中的图标个数
+        std::vector<UiRect> m_freeSlots;        //已释放、可复用的位置（含间隔）
+    };
+
+    /** 图集中的图片
+    */
+    struct TAtlasImage
+    {
+        uint32_t m_nDpiScale = 100;             //DPI缩放比
+        UiSize m_szImage;                       //图片大小
+        std::shared_ptr<TAtlasPage> m_pPage;    //所在的图集页
+        UiRect m_rcSource;                      //在图集页中的区域
+        UiRect m_rcSlot;                        //在图集页中占用的位置（含间隔）
+        uint32_t m_nRefCount = 1;               //引用计数
+    };
+
+private:
+    /** 在图集页中分配一块区域（没有足够空间时，新建图集页）
+    * @param [in] nDpiScale DPI缩放比
+    * @param [in] szImage 图片的大小
+    * @param [out] pPage 返回分配的图集页
+    * @param [out] rcSource 返回分配的区域
+    * @param [out] rcSlot 返回占用的位置（含间隔）
+    */
+    bool AllocRect(uint32_t nDpiScale, const UiSize& szImage,
+                   std::shared_ptr<TAtlasPage>& pPage, UiRect& rcSource, UiRect& rcSlot);
+
+    /** 在指定的图集页中分配一块区域（优先复用已释放的位置）
+    */
+    static bool AllocRectInPage(TAtlasPage& page, const UiSize& szImage, UiRect& rcSource, UiRect& rcSlot);
+
+    /** 查找图集中的图片，找到时增加其引用计数
+    */
+    bool AddImageRef(const DString& imageKey, uint32_t nDpiScale, const UiSize& szImage, ImageAtlasEntry& entry);
+
+    /** 记录图集中的图片
+    */
+    void AddAtlasImage(const DString& imageKey, uint32_t nDpiScale, const UiSize& szImage,
+                       const std::shared_ptr<TAtlasPage>& pPage, const UiRect& rcSource, const UiRect& rcSlot,
+                       ImageAtlasEntry& entry);
+
+    /** 从图集页中移除一个图标：清空其占用的位置并放入空闲列表，图集页为空时释放该图集页
+    */
+    void ReleasePageImage(const std::shared_ptr<TAtlasPage>& pPage, const UiRect& rcSlot);
+
+private:
+    /** 可放入图集的图片大小上限（未经DPI缩放的宽度和高度）
+    */
+    uint32_t m_nMaxImageSize;
+
+    /** 所有的图集页
+    */
+    std::vector<std::shared_ptr<TAtlasPage>> m_pages;
+
+    /** 图集中的图片，KEY为图片的KEY
+    */
+    std::unordered_map<DString, std::vector<TAtlasImage>> m_atlasImages;
+};
+
+} // namespace ui
+
+#endif // UI_IMAGE_IMAGE_ATLAS_H_
@@ -115,6 +115,13 @@ public:
     * @param [in] szImageSize 代表获取图片的宽度(cx)和高度(cy)
     */
     virtual std::shared_ptr<IBitmap> GetBitmap(const UiSize& szImageSize) = 0;
+
+    /** 将图片直接光栅化到外部的位图数据中（矢量缩放），比如图集位图中的一块区域
+    * @param [in] pPixelBits 目标区域左上角的位图数据地址，数据格式与IBitmap的位图数据相同（预乘Alpha）
+    * @param [in] nRowBytes 位图数据每行的字节数
+    * @param [in] szImageSize 光栅化的图片宽度(cx)和高度(cy)
+    */
+    virtual bool RenderToPixels(void* pPixelBits, size_t nRowBytes, const UiSize& szImageSize) = 0;
 };
 
 /** 单帧位图图片接口
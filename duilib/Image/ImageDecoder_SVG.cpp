@@ -133,28 +133,43 @@ public:
             return nullptr;
         }
 
-        SkBitmap skBitmap;
+        std::vector<uint32_t> pixelBits((size_t)nImageWidth * nImageHeight, 0);
+        if (!RenderToPixels(pixelBits.data(), (size_t)nImageWidth * sizeof(uint32_t), UiSize((int32_t)nImageWidth, (int32_t)nImageHeight)) ||
+            !pBitmap->Init(nImageWidth, nImageHeight, pixelBits.data())) {
+            pBitmap.reset();
+        }
+        //记录缓存位图，避免每次都重新生成位图
+        m_pBitmap = pBitmap;
+        return pBitmap;
+    }
+
+    /** 将图片直接光栅化到外部的位图数据中（矢量缩放）
+    */
+    virtual bool RenderToPixels(void* pPixelBits, size_t nRowBytes, const UiSize& szImageSize) override
+    {
+        ASSERT((pPixelBits != nullptr) && (szImageSize.cx > 0) && (szImageSize.cy > 0));
+        if ((pPixelBits == nullptr) || (szImageSize.cx <= 0) || (szImageSize.cy <= 0) || (m_svgDom == nullptr)) {
+            return false;
+        }
 #ifdef DUILIB_BUILD_FOR_WIN
-        SkImageInfo info = SkImageInfo::Make((int32_t)nImageWidth, (int32_t)nImageHeight, SkColorType::kN32_SkColorType, SkAlphaType::kPremul_SkAlphaType);
+        SkImageInfo info = SkImageInfo::Make(szImageSize.cx, szImageSize.cy, SkColorType::kN32_SkColorType, SkAlphaType::kPremul_SkAlphaType);
 #else
-        SkImageInfo info = SkImageInfo::Make((int32_t)nImageWidth, (int32_t)nImageHeight, SkColorType::kRGBA_8888_SkColorType, SkAlphaType::kPremul_SkAlphaType);
+        SkImageInfo info = SkImageInfo::Make(szImageSize.cx, szImageSize.cy, SkColorType::kRGBA_8888_SkColorType, SkAlphaType::kPremul_SkAlphaType);
 #endif
-        skBitmap.allocPixels(info);
-        SkCanvas canvas(skBitmap);
+        std::unique_ptr<SkCanvas> canvas = SkCanvas::MakeRasterDirect(info, pPixelBits, nRowBytes);
+        ASSERT(canvas != nullptr);
+        if (canvas == nullptr) {
+            return false;
+        }
 
         //设置容器大小与图片大小一致(图片大小为DPI缩放后的大小)
-        m_svgDom->getRoot()->setWidth(SkSVGLength((SkScalar)nImageWidth, SkSVGLength::Unit::kPX));
-        m_svgDom->getRoot()->setHeight(SkSVGLength((SkScalar)nImageHeight, SkSVGLength::Unit::kPX));
-        m_svgDom->setContainerSize(SkSize::Make(SkISize::Make((int32_t)nImageWidth, (int32_t)nImageHeight)));
+        m_svgDom->getRoot()->setWidth(SkSVGLength((SkScalar)szImageSize.cx, SkSVGLength::Unit::kPX));
+        m_svgDom->getRoot()->setHeight(SkSVGLength((SkScalar)szImageSize.cy, SkSVGLength::Unit::kPX));
+        m_svgDom->setContainerSize(SkSize::Make(SkISize::Make(szImageSize.cx, szImageSize.cy)));
 
         //绘制到位图
-        m_svgDom->render(&canvas);
-        if (!pBitmap->Init(nImageWidth, nImageHeight, skBitmap.getPixels())) {
-            pBitmap.reset();
-        }
-        //记录缓存位图，避免每次都重新生成位图
-        m_pBitmap = pBitmap;
-        return pBitmap;
+        m_svgDom->render(canvas.get());
+        return true;
     }
 
 public:
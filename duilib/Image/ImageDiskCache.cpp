@@ -0,0 +1,322 @@
+#include "ImageDiskCache.h"
+#include "duilib/Image/Image_Bitmap.h"
+#include "duilib/Image/ImageUtil.h"
+#include "duilib/Core/GlobalManager.h"
+#include "duilib/Utils/FileUtil.h"
+#include "duilib/Utils/MappedFile.h"
+#include "duilib/Utils/FilePathUtil.h"
+#include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/StringConvert.h"
+#include "duilib/Utils/PerformanceUtil.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace ui
+{
+/** 缓存文件的扩展名
+*/
+#define IMAGE_DISK_CACHE_FILE_EXT       _T(".img")
+
+/** 缓存文件的标识（"DUIC"）
+*/
+#define IMAGE_DISK_CACHE_MAGIC          (0x43495544u)
+
+/** 缓存文件的版本号（文件格式或者解码结果发生变化时，需要增加版本号，使原有的缓存失效）
+*/
+#define IMAGE_DISK_CACHE_VERSION        (2u)
+
+/** 缓存文件的文件头
+*/
+struct TImageDiskCacheHeader
+{
+    uint32_t m_nMagic;              //文件标识
+    uint32_t m_nVersion;            //版本号
+    uint64_t m_nSourceStamp;        //图片文件的标识（由文件大小和修改时间/CRC32计算）
+    uint32_t m_nWidth;              //位图宽度
+    uint32_t m_nHeight;             //位图高度
+    float m_fImageSizeScale;        //图片的缩放比例
+    uint32_t m_nReserved;           //保留字段
+    uint64_t m_nPixelBytes;         //位图数据的长度（字节）
+};
+static_assert(sizeof(TImageDiskCacheHeader) == 40, "TImageDiskCacheHeader size error!");
+
+/** 计算数据的哈希值（FNV-1a算法）
+*/
+static uint64_t ImageDiskCacheHash(const void* data, size_t nDataLen, uint64_t nHash = 14695981039346656037ull)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < nDataLen; ++i) {
+        nHash ^= p[i];
+        nHash *= 1099511628211ull;
+    }
+    return nHash;
+}
+
+/** 获取std::filesystem的路径
+*/
+static std::filesystem::path ImageDiskCachePath(const FilePath& filePath)
+{
+#ifdef DUILIB_BUILD_FOR_WIN
+    return std::filesystem::path(filePath.ToStringW());
+#else
+    return std::filesystem::path(filePath.ToStringA());
+#endif
+}
+
+ImageDiskCache::ImageDiskCache():
+    m_nMaxCacheBytes(0),
+    m_nCacheBytes(0),
+    m_bCacheBytesCounted(false)
+{
+}
+
+ImageDiskCache::~ImageDiskCache()
+{
+}
+
+bool ImageDiskCache::SetCacheDirectory(const FilePath& cacheDir, uint64_t nMaxCacheBytes)
+{
+    m_cacheDir.Clear();
+    m_nMaxCacheBytes = nMaxCacheBytes;
+    m_nCacheBytes = 0;
+    m_bCacheBytesCounted = false;
+    if (cacheDir.IsEmpty()) {
+        //关闭磁盘缓存
+        return true;
+    }
+    if (!cacheDir.IsExistsDirectory()) {
+        FilePathUtil::CreateDirectories(cacheDir.ToString());
+    }
+    ASSERT(cacheDir.IsExistsDirectory());
+    if (!cacheDir.IsExistsDirectory()) {
+        return false;
+    }
+    m_cacheDir = cacheDir;
+    m_cacheDir.NormalizeDirectoryPath();
+    return true;
+}
+
+const FilePath& ImageDiskCache::GetCacheDirectory() const
+{
+    return m_cacheDir;
+}
+
+void ImageDiskCache::ClearCache()
+{
+    if (m_cacheDir.IsEmpty()) {
+        return;
+    }
+    std::error_code ec;
+    std::filesystem::directory_iterator iter(ImageDiskCachePath(m_cacheDir), ec);
+    for (; !ec && (iter != std::filesystem::directory_iterator()); iter.increment(ec)) {
+        if (iter->is_regular_file(ec) && (iter->path().extension() == IMAGE_DISK_CACHE_FILE_EXT)) {
+            std::error_code ecRemove;
+            std::filesystem::remove(iter->path(), ecRemove);
+        }
+    }
+    m_nCacheBytes = 0;
+    m_bCacheBytesCounted = true;
+}
+
+DString ImageDiskCache::MakeCacheKey(const DString& imageFullPath, const ImageDecodeParam& decodeParam)
+{
+    //影响解码结果的参数，都需要参与KEY的计算
+    std::string keyData = StringConvert::TToUTF8(imageFullPath);
+    keyData += StringUtil::Printf("|%.4f|%d,%d|%u|%d|%d",
+                                  decodeParam.m_fImageSizeScale,
+                                  decodeParam.m_rcMaxDestRectSize.cx, decodeParam.m_rcMaxDestRectSize.cy,
+                                  decodeParam.m_nIconSize,
+                                  decodeParam.m_bIconAsAnimation ? 1 : 0,
+                                  decodeParam.m_bLoadAllFrames ? 1 : 0);
+    uint64_t nKeyHash = ImageDiskCacheHash(keyData.data(), keyData.size());
+    return StringUtil::Printf(_T("%016llx"), (unsigned long long)nKeyHash);
+}
+
+uint64_t ImageDiskCache::MakeSourceStamp(uint64_t nFileSize, uint64_t nFileVersion)
+{
+    uint64_t nStamp = ImageDiskCacheHash(&nFileSize, sizeof(nFileSize));
+    return ImageDiskCacheHash(&nFileVersion, sizeof(nFileVersion), nStamp);
+}
+
+FilePath ImageDiskCache::GetCacheFilePath(const DString& cacheKey) const
+{
+    return FilePathUtil::JoinFilePath(m_cacheDir, FilePath(cacheKey + IMAGE_DISK_CACHE_FILE_EXT));
+}
+
+std::unique_ptr<IImage> ImageDiskCache::LoadImageData(const DString& cacheKey, uint64_t nSourceStamp, float fImageSizeScale)
+{
+    if (m_cacheDir.IsEmpty() || cacheKey.empty()) {
+        return nullptr;
+    }
+    PerformanceStat statPerformance(_T("ImageDiskCache::LoadImageData"));
+    MappedFile mappedFile;
+    if (!mappedFile.Open(GetCacheFilePath(cacheKey))) {
+        //缓存不存在
+        return nullptr;
+    }
+    if (mappedFile.GetSize() < sizeof(TImageDiskCacheHeader)) {
+        return nullptr;
+    }
+    TImageDiskCacheHeader header;
+    ::memcpy(&header, mappedFile.GetData(), sizeof(header));
+    if ((header.m_nMagic != IMAGE_DISK_CACHE_MAGIC) ||
+        (header.m_nVersion != IMAGE_DISK_CACHE_VERSION) ||
+        (header.m_nSourceStamp != nSourceStamp)) {
+        //缓存已经过期（版本不同或者图片文件内容已经修改）
+        return nullptr;
+    }
+    if ((header.m_nWidth == 0) || (header.m_nHeight == 0) ||
+        (header.m_nPixelBytes != (uint64_t)header.m_nWidth * header.m_nHeight * sizeof(uint32_t)) ||
+        (header.m_nPixelBytes > (uint64_t)(mappedFile.GetSize() - sizeof(header))) ||
+        !ImageUtil::IsSameImageScale(header.m_fImageSizeScale, fImageSizeScale)) {
+        //缓存文件数据错误
+        return nullptr;
+    }
+
+    IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactory != nullptr);
+    if (pRenderFactory == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<IBitmap> pBitmap(pRenderFactory->CreateBitmap());
+    ASSERT(pBitmap != nullptr);
+    if (pBitmap == nullptr) {
+        return nullptr;
+    }
+    //缓存中保存的是缩放后的图片数据，加载时不再缩放（缩放比例仅用于图片的属性）
+    const uint8_t* pPixelBits = mappedFile.GetData() + sizeof(header);
+    if (!pBitmap->Init(header.m_nWidth, header.m_nHeight, pPixelBits,
+                       1.0f, BitmapAlphaType::kPremul_SkAlphaType)) {
+        return nullptr;
+    }
+    return Image_Bitmap::MakeImage(pBitmap, header.m_fImageSizeScale);
+}
+
+bool ImageDiskCache::StoreImageData(const DString& cacheKey, uint64_t nSourceStamp, const std::shared_ptr<IImage>& pImage)
+{
+    if (m_cacheDir.IsEmpty() || cacheKey.empty() || (pImage == nullptr)) {
+        return false;
+    }
+    if (pImage->GetImageType() != ImageType::kImageBitmap) {
+        //只缓存单帧位图（SVG矢量图按绘制大小栅格化，多帧图片数据量较大，不缓存）
+        return false;
+    }
+    if (pImage->IsAsyncDecodeEnabled() && !pImage->IsAsyncDecodeFinished()) {
+        //图片数据在子线程中解码，尚未完成
+        return false;
+    }
+    std::shared_ptr<IBitmapImage> pBitmapImage = pImage->GetImageBitmap();
+    if (pBitmapImage == nullptr) {
+        return false;
+    }
+    bool bDecodeError = false;
+    std::shared_ptr<IBitmap> pBitmap = pBitmapImage->GetBitmap(&bDecodeError);
+    if ((pBitmap == nullptr) || bDecodeError) {
+        return false;
+    }
+    const uint32_t nWidth = pBitmap->GetWidth();
+    const uint32_t nHeight = pBitmap->GetHeight();
+    if ((nWidth == 0) || (nHeight == 0)) {
+        return false;
+    }
+
+    TImageDiskCacheHeader header;
+    ::memset(&header, 0, sizeof(header));
+    header.m_nMagic = IMAGE_DISK_CACHE_MAGIC;
+    header.m_nVersion = IMAGE_DISK_CACHE_VERSION;
+    header.m_nSourceStamp = nSourceStamp;
+    header.m_nWidth = nWidth;
+    header.m_nHeight = nHeight;
+    header.m_fImageSizeScale = pBitmapImage->GetImageSizeScale();
+    header.m_nPixelBytes = (uint64_t)nWidth * nHeight * sizeof(uint32_t);
+
+    std::vector<uint8_t> fileData;
+    fileData.resize(sizeof(header) + (size_t)header.m_nPixelBytes);
+    ::memcpy(fileData.data(), &header, sizeof(header));
+    void* pPixelBits = pBitmap->LockPixelBits();
+    if (pPixelBits == nullptr) {
+        return false;
+    }
+    ::memcpy(fileData.data() + sizeof(header), pPixelBits, (size_t)header.m_nPixelBytes);
+    pBitmap->UnLockPixelBits();
+
+    //先写临时文件，再重命名，避免其他进程读到不完整的缓存文件
+    const FilePath cacheFilePath = GetCacheFilePath(cacheKey);
+    const FilePath tempFilePath(cacheFilePath.ToString() + _T(".tmp"));
+    if (!FileUtil::WriteFileData(tempFilePath, fileData)) {
+        return false;
+    }
+    const uint64_t nOldFileSize = cacheFilePath.IsExistsFile() ? cacheFilePath.GetFileSize() : 0;
+    std::error_code ec;
+    std::filesystem::rename(ImageDiskCachePath(tempFilePath), ImageDiskCachePath(cacheFilePath), ec);
+    if (ec) {
+        std::error_code ecRemove;
+        std::filesystem::remove(ImageDiskCachePath(tempFilePath), ecRemove);
+        return false;
+    }
+
+    if (!m_bCacheBytesCounted) {
+        TrimCacheFiles();
+    }
+    else {
+        m_nCacheBytes -= std::min(m_nCacheBytes, nOldFileSize);
+        m_nCacheBytes += fileData.size();
+        if (m_nCacheBytes > m_nMaxCacheBytes) {
+            TrimCacheFiles();
+        }
+    }
+    return true;
+}
+
+void ImageDiskCache::TrimCacheFiles()
+{
+    struct TCacheFile
+    {
+        std::filesystem::path m_path;
+        std::filesystem::file_time_type m_writeTime;
+        uint64_t m_nFileSize;
+    };
+    std::vector<TCacheFile> cacheFiles;
+    uint64_t nTotalBytes = 0;
+    std::error_code ec;
+    std::filesystem::directory_iterator iter(ImageDiskCachePath(m_cacheDir), ec);
+    for (; !ec && (iter != std::filesystem::directory_iterator()); iter.increment(ec)) {
+        std::error_code ecFile;
+        if (!iter->is_regular_file(ecFile) || (iter->path().extension() != IMAGE_DISK_CACHE_FILE_EXT)) {
+            continue;
+        }
+        TCacheFile cacheFile;
+        cacheFile.m_path = iter->path();
+        cacheFile.m_writeTime = iter->last_write_time(ecFile);
+        cacheFile.m_nFileSize = iter->file_size(ecFile);
+        if (ecFile) {
+            continue;
+        }
+        nTotalBytes += cacheFile.m_nFileSize;
+        cacheFiles.push_back(cacheFile);
+    }
+    m_bCacheBytesCounted = true;
+    m_nCacheBytes = nTotalBytes;
+    if (m_nCacheBytes <= m_nMaxCacheBytes) {
+        return;
+    }
+
+    //删除最早写入的缓存文件，直到总大小不超过上限的3/4（避免频繁清理）
+    std::sort(cacheFiles.begin(), cacheFiles.end(), [](const TCacheFile& a, const TCacheFile& b) {
+            return a.m_writeTime < b.m_writeTime;
+        });
+    const uint64_t nTargetBytes = m_nMaxCacheBytes / 4 * 3;
+    for (const TCacheFile& cacheFile : cacheFiles) {
+        if (m_nCacheBytes <= nTargetBytes) {
+            break;
+        }
+        std::error_code ecRemove;
+        if (std::filesystem::remove(cacheFile.m_path, ecRemove)) {
+            m_nCacheBytes -= std::min(m_nCacheBytes, cacheFile.m_nFileSize);
+        }
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,98 @@
+#ifndef UI_IMAGE_IMAGE_DISK_CACHE_H_
+#define UI_IMAGE_IMAGE_DISK_CACHE_H_
+
+#include "duilib/Image/ImageDecoder.h"
+#include "duilib/Utils/FilePath.h"
+#include <memory>
+#include <vector>
+
+namespace ui
+{
+/** 已解码图片的磁盘缓存（用于加快程序冷启动时皮肤图片的加载速度）
+*   缓存内容为解码后、按DPI缩放后的位图数据（预乘Alpha的ARGB格式），每个图片一个缓存文件
+*   缓存文件名由（图片路径，解码参数）计算得出，文件头中保存版本号和图片文件的标识（文件大小和修改时间/压缩包内的CRC32），
+*   加载时先于读取图片文件查询缓存，通过内存映射只读打开缓存文件，版本号或者文件标识不一致时视为过期，需要重新读取并解码图片
+*/
+class UILIB_API ImageDiskCache
+{
+public:
+    ImageDiskCache();
+    ~ImageDiskCache();
+    ImageDiskCache(const ImageDiskCache&) = delete;
+    ImageDiskCache& operator = (const ImageDiskCache&) = delete;
+
+public:
+    /** 设置缓存目录（目录不存在时自动创建）
+    * @param [in] cacheDir 缓存目录
+    * @param [in] nMaxCacheBytes 缓存目录中缓存文件的总大小上限（字节），超出时删除最早写入的缓存文件
+    * @return 成功返回true，失败返回false
+    */
+    bool SetCacheDirectory(const FilePath& cacheDir, uint64_t nMaxCacheBytes);
+
+    /** 获取缓存目录
+    */
+    const FilePath& GetCacheDirectory() const;
+
+    /** 删除缓存目录中的所有缓存文件
+    */
+    void ClearCache();
+
+public:
+    /** 计算缓存文件的KEY（与图片路径和影响解码结果的参数相关）
+    * @param [in] imageFullPath 图片路径
+    * @param [in] decodeParam 图片解码的相关参数
+    */
+    static DString MakeCacheKey(const DString& imageFullPath, const ImageDecodeParam& decodeParam);
+
+    /** 计算图片文件的标识（无需读取文件内容）
+    * @param [in] nFileSize 文件大小（字节）
+    * @param [in] nFileVersion 本地文件为最后修改时间，压缩包内的文件为CRC32校验值
+    */
+    static uint64_t MakeSourceStamp(uint64_t nFileSize, uint64_t nFileVersion);
+
+    /** 从磁盘缓存加载图片
+    * @param [in] cacheKey 缓存文件的KEY，由MakeCacheKey函数获取
+    * @param [in] nSourceStamp 图片文件的标识，由MakeSourceStamp函数获取
+    * @param [in] fImageSizeScale 请求加载的缩放比例
+    * @return 缓存不存在或者已经过期时返回nullptr
+    */
+    std::unique_ptr<IImage> LoadImageData(const DString& cacheKey, uint64_t nSourceStamp, float fImageSizeScale);
+
+    /** 将解码后的图片保存到磁盘缓存（仅支持单帧位图，且图片数据必须已经解码完成）
+    * @param [in] cacheKey 缓存文件的KEY，由MakeCacheKey函数获取
+    * @param [in] nSourceStamp 图片文件的标识，由MakeSourceStamp函数获取
+    * @param [in] pImage 图片数据
+    * @return 成功返回true，失败返回false
+    */
+    bool StoreImageData(const DString& cacheKey, uint64_t nSourceStamp, const std::shared_ptr<IImage>& pImage);
+
+private:
+    /** 获取缓存文件的路径
+    */
+    FilePath GetCacheFilePath(const DString& cacheKey) const;
+
+    /** 缓存文件总大小超出上限时，删除最早写入的缓存文件
+    */
+    void TrimCacheFiles();
+
+private:
+    /** 缓存目录
+    */
+    FilePath m_cacheDir;
+
+    /** 缓存文件的总大小上限（字节）
+    */
+    uint64_t m_nMaxCacheBytes;
+
+    /** 当前缓存文件的总大小（字节），首次写入缓存文件时统计
+    */
+    uint64_t m_nCacheBytes;
+
+    /** 是否已经统计过缓存文件的总大小
+    */
+    bool m_bCacheBytesCounted;
+};
+
+} // namespace ui
+
+#endif // UI_IMAGE_IMAGE_DISK_CACHE_H_
@@ -18,12 +18,23 @@ ImageInfo::ImageInfo():
     m_fCustomSizeScaleX(0),
     m_fCustomSizeScaleY(0),
     m_nImageFileDpiScale(100),
-    m_fImageSizeScale(1.0f)
+    m_fImageSizeScale(1.0f),
+    m_bInImageAtlas(false),
+    m_bImageAtlasFailed(false)
 {
 }
 
 ImageInfo::~ImageInfo()
 {
+    if (m_bInImageAtlas) {
+        //从共享图集中移除
+        ImageAtlas* pImageAtlas = GlobalManager::Instance().Image().GetImageAtlas();
+        if (pImageAtlas != nullptr) {
+            pImageAtlas->RemoveImage(GetLoadKey(), m_atlasEntry);
+        }
+        m_atlasEntry = ImageAtlasEntry();
+        m_bInImageAtlas = false;
+    }
     //延迟释放原图
     ReleaseImage();
 }
@@ -113,6 +124,13 @@ std::shared_ptr<IBitmap> ImageInfo::GetBitmap(bool* bDecodeError)
         if (m_pBitmap != nullptr) {
             return m_pBitmap;
         }
+        if (m_bInImageAtlas) {
+            //原图已经释放，从图集中复制出独立的位图（比如拉伸绘制时不能使用图集）
+            m_pBitmap = ImageAtlas::CopyBitmap(m_atlasEntry);
+            if (m_pBitmap != nullptr) {
+                return m_pBitmap;
+            }
+        }
     }
     else if (m_imageType == ImageType::kImageSvg) {
         //SVG图片
@@ -182,6 +200,74 @@ std::shared_ptr<IBitmap> ImageInfo::GetBitmap(bool* bDecodeError)
     return nullptr;
 }
 
+bool ImageInfo::GetAtlasBitmap(ImageAtlasEntry& atlasEntry)
+{
+    GlobalManager::Instance().AssertUIThread();
+    if (m_bImageAtlasFailed) {
+        return false;
+    }
+    if ((m_imageType != ImageType::kImageBitmap) && (m_imageType != ImageType::kImageSvg)) {
+        return false;
+    }
+    ImageAtlas* pImageAtlas = GlobalManager::Instance().Image().GetImageAtlas();
+    if (pImageAtlas == nullptr) {
+        return false;
+    }
+    const uint32_t nDpiScale = GetLoadDpiScale();
+    if (!pImageAtlas->IsAtlasImageSize((uint32_t)m_nImageInfoWidth, (uint32_t)m_nImageInfoHeight, nDpiScale)) {
+        m_bImageAtlasFailed = true;
+        return false;
+    }
+    if (m_bInImageAtlas) {
+        //图集位图由本对象持有引用，即使图集被清除也可以继续使用
+        atlasEntry = m_atlasEntry;
+        return true;
+    }
+    const DString loadKey = GetLoadKey();
+    const UiSize szImage(m_nImageInfoWidth, m_nImageInfoHeight);
+
+    bool bRet = false;
+    if (m_imageType == ImageType::kImageSvg) {
+        //SVG图片：直接光栅化到图集中，不生成独立的位图
+        std::shared_ptr<IImage> pImageData = m_pImageData;
+        std::shared_ptr<ISvgImage> pSvgImage = (pImageData != nullptr) ? pImageData->GetImageSvg() : nullptr;
+        if (pSvgImage != nullptr) {
+            bRet = pImageAtlas->AddSvgImage(loadKey, nDpiScale, pSvgImage.get(), szImage, atlasEntry);
+        }
+    }
+    else {
+        //位图图片：复制到图集中
+        bool bDecodeError = false;
+        std::shared_ptr<IBitmap> pBitmap = GetBitmap(&bDecodeError);
+        if (pBitmap == nullptr) {
+            //图片数据尚未完成解码（多线程解码），或者解码失败
+            if (bDecodeError) {
+                m_bImageAtlasFailed = true;
+            }
+            return false;
+        }
+        if ((pBitmap->GetWidth() != (uint32_t)m_nImageInfoWidth) || (pBitmap->GetHeight() != (uint32_t)m_nImageInfoHeight)) {
+            //位图大小与图片信息中的大小不一致（绘制时需要调整源区域），不使用图集，使用独立的位图
+            m_bImageAtlasFailed = true;
+            return false;
+        }
+        bRet = pImageAtlas->AddBitmap(loadKey, nDpiScale, pBitmap.get(), atlasEntry);
+        if (bRet) {
+            //像素数据已经复制到图集中，释放独立的位图和原图，避免重复占用内存
+            m_pBitmap.reset();
+            ReleaseImage();
+        }
+    }
+    if (bRet) {
+        m_atlasEntry = atlasEntry;
+        m_bInImageAtlas = true;
+    }
+    else {
+        m_bImageAtlasFailed = true;
+    }
+    return bRet;
+}
+
 std::shared_ptr<IAnimationImage> ImageInfo::GetAnimationImage(uint32_t nFrameIndex) const
 {
     GlobalManager::Instance().AssertUIThread();
@@ -5,6 +5,7 @@
 #include "duilib/Core/UiTypes.h"
 #include "duilib/Image/ImageDecoder.h"
 #include "duilib/Image/ImageLoadParam.h"
+#include "duilib/Image/ImageAtlas.h"
 
 namespace ui 
 {
@@ -64,6 +65,12 @@ public:
      */
     std::shared_ptr<IBitmap> GetBitmap(bool* bDecodeError);
 
+    /** 获取图片在共享图集中的位图（单帧位图和SVG图片，图片大小不超过图集的图片大小上限时可用）
+    * @param [out] atlasEntry 返回图片所在的图集位图和区域
+    * @return 如果图片不适合放入图集，或者图片数据尚未完成解码，返回false
+    */
+    bool GetAtlasBitmap(ImageAtlasEntry& atlasEntry);
+
 public:
     /** 查询是某帧的图片数据是否有准备完成（多线程解码时，帧数据在后台线程解码）
     * @param [in] nFrameIndex 图片帧的索引号，从0开始编号的下标值，取值范围:[0, GetFrameCount())
@@ -215,6 +222,18 @@ private:
     /** 原图加载的宽度和高度缩放比例(1.0f表示无缩放)
     */
     float m_fImageSizeScale;
+
+    /** 图片是否已经放入共享图集中
+    */
+    bool m_bInImageAtlas;
+
+    /** 图片在共享图集中的位图和区域（位图图片放入图集后，释放原图和独立的位图，需要时从图集中复制）
+    */
+    ImageAtlasEntry m_atlasEntry;
+
+    /** 图片放入共享图集时是否失败（失败后不再重试）
+    */
+    bool m_bImageAtlasFailed;
 };
 
 } // namespace ui
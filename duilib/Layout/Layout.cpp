@@ -4,6 +4,15 @@
 #include "duilib/Core/GlobalManager.h"
 #include "duilib/Core/Control.h"
 #include "duilib/Core/Box.h"
+#include "duilib/Core/Window.h"
+#include "duilib/Utils/ParallelUtil.h"
+#include <thread>
+
+//并行评估文本大小的最少任务个数（任务较少时，估算控件大小时在UI线程中评估）
+#define PARALLEL_MEASURE_TEXT_MIN_COUNT 64
+
+//并行评估文本大小的最大线程数
+#define PARALLEL_MEASURE_TEXT_MAX_THREADS 8
 
 namespace ui 
 {
@@ -429,4 +438,63 @@ void Layout::DeflatePadding(UiRect& rc) const
     }
 }
 
+void Layout::PrepareMeasureText(const std::vector<Control*>& items, UiSize szAvailable, bool bDeflateMargin)
+{
+    if (items.size() < PARALLEL_MEASURE_TEXT_MIN_COUNT) {
+        return;
+    }
+    const size_t nMaxThreadCount = std::min((size_t)std::thread::hardware_concurrency(), (size_t)PARALLEL_MEASURE_TEXT_MAX_THREADS);
+    if (nMaxThreadCount <= 1) {
+        return;
+    }
+    IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
+    const ITextMeasure* pTextMeasure = (pRenderFactory != nullptr) ? pRenderFactory->GetTextMeasure() : nullptr;
+    if (pTextMeasure == nullptr) {
+        return;
+    }
+    //窗口大小为0时，IRender::MeasureString返回空，与ITextMeasure的评估结果不一致，此时不并行评估
+    Control* pFirstControl = items.front();
+    Window* pWindow = (pFirstControl != nullptr) ? pFirstControl->GetWindow() : nullptr;
+    IRender* pRender = (pWindow != nullptr) ? pWindow->GetRender() : nullptr;
+    if ((pRender == nullptr) || (pRender->GetWidth() <= 0) || (pRender->GetHeight() <= 0)) {
+        return;
+    }
+
+    //在UI线程中准备评估任务（只有需要重新估算大小的子控件才会生成评估任务）
+    std::vector<Control*> taskControls;
+    std::vector<TextMeasureTask> tasks;
+    for (Control* pControl : items) {
+        if ((pControl == nullptr) || !pControl->IsVisible() || pControl->IsFloat()) {
+            continue;
+        }
+        UiSize szItemAvailable = szAvailable;
+        if (bDeflateMargin) {
+            UiMargin rcMargin = pControl->GetMargin();
+            szItemAvailable.cx -= (rcMargin.left + rcMargin.right);
+            szItemAvailable.cy -= (rcMargin.top + rcMargin.bottom);
+            szItemAvailable.Validate();
+        }
+        TextMeasureTask task;
+        if (pControl->PrepareMeasureText(szItemAvailable, task)) {
+            taskControls.push_back(pControl);
+            tasks.push_back(std::move(task));
+        }
+    }
+    if (tasks.size() < PARALLEL_MEASURE_TEXT_MIN_COUNT) {
+        return;
+    }
+
+    //在线程池中并行评估，UI线程也参与评估，所有任务完成后再返回
+    const size_t nThreadCount = std::min(nMaxThreadCount, tasks.size() / (PARALLEL_MEASURE_TEXT_MIN_COUNT / 2));
+    ParallelUtil::ParallelFor(tasks.size(), nThreadCount, [&tasks, pTextMeasure](size_t nTask) {
+            TextMeasureTask& task = tasks[nTask];
+            task.rcResult = pTextMeasure->MeasureString(task.text, task.measureParam);
+        });
+
+    //评估结果写回子控件（UI线程）
+    for (size_t nTask = 0; nTask < tasks.size(); ++nTask) {
+        taskControls[nTask]->SetMeasureTextResult(tasks[nTask]);
+    }
+}
+
 } // namespace ui
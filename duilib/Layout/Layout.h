@@ -202,6 +202,14 @@ protected:
     */
     static UiRect GetFloatPos(const Control* pControl, UiRect rcContainer, UiSize childSize);
 
+    /** 在多个线程中并行评估子控件的文本大小（需要评估的子控件较多时才执行），评估结果缓存在子控件中，
+     *  后续调用子控件的EstimateSize函数时，如果评估条件未变化，直接使用缓存的结果
+     * @param [in] items 子控件列表（只评估可见的、非浮动的子控件）
+     * @param [in] szAvailable 子控件的可用大小，与调用子控件EstimateSize函数时的参数相同
+     * @param [in] bDeflateMargin 为true时，每个子控件的可用大小需要减去该子控件的外边距
+     */
+    static void PrepareMeasureText(const std::vector<Control*>& items, UiSize szAvailable, bool bDeflateMargin);
+
 private:
     /** 设置浮动状态下的坐标信息
      * @param [in] pControl 控件句柄
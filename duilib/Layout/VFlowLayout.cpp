@@ -43,6 +43,9 @@ UiSize64 VFlowLayout::ArrangeChildInternal(const std::vector<Control*>& items, U
     const UiRect rcBox = rc; //容器的矩形范围
     const UiSize szAvailable(rc.Width(), rc.Height());
 
+    //子控件较多时，先并行评估子控件的文本大小
+    PrepareMeasureText(visibleControls, szAvailable, false);
+
     //需要进行布局处理的所有控件(KEY是控件，VALUE是宽度和高度)
     std::unordered_map<Control*, UiEstSize> itemsMap;
 
@@ -36,6 +36,9 @@ UiSize64 VLayout::ArrangeChildren(const std::vector<Control*>& items, UiRect rc,
     DeflatePadding(rc);
     const UiSize szAvailable(rc.Width(), rc.Height());
 
+    //子控件较多时，先并行评估子控件的文本大小
+    PrepareMeasureText(items, szAvailable, false);
+
     // 存储需要布局的控件尺寸（key：控件，value：宽高信息）
     std::unordered_map<Control*, UiEstSize> itemsMap;       // 非拉伸子控件
     std::vector<Control*> stretchControls;                  // 按顺序存储拉伸控件
@@ -434,6 +437,9 @@ UiSize64 VLayout::EstimateLayoutSize(const std::vector<Control*>& items, UiSize
     UiSize64 totalSize(0, 0);  // 64位计算避免溢出
     int32_t validCount = 0;    // 统计参与间隔计算的有效控件（有高度或边距）
 
+    // 子控件较多时，先并行评估子控件的文本大小
+    PrepareMeasureText(items, szAvailable, false);
+
     for (Control* pControl : items) {
         if ((pControl == nullptr) || !pControl->IsVisible() || pControl->IsFloat()) {
             continue;
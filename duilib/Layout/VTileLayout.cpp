@@ -155,6 +155,9 @@ UiSize64 VTileLayout::ArrangeFloatChild(const std::vector<Control*>& items,
                                        bool bEstimateOnly,
                                        std::vector<ItemSizeInfo>& normalItems)
 {
+    //子控件较多时，先并行评估子控件的文本大小（子控件的可用区域为总区域减去外边距，与CalcEstimateSize函数一致）
+    PrepareMeasureText(items, UiSize(rc.Width(), rc.Height()), true);
+
     int64_t cxNeededFloat = 0;    //浮动控件需要的总宽度
     int64_t cyNeededFloat = 0;    //浮动控件需要的总高度
     for (Control* pControl : items) {
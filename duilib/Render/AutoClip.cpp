@@ -32,6 +32,20 @@ AutoClip::AutoClip(IRender* pRender, const UiRect& rcRound, float fRoundWidth, f
     }
 }
 
+AutoClip::AutoClip(IRender* pRender, const std::vector<UiRect>& rcRegion, bool bClip)
+{
+    m_pRender = nullptr;
+    m_bClip = false;
+    if (bClip) {
+        m_bClip = bClip;
+        ASSERT(pRender != nullptr);
+        m_pRender = pRender;
+        if (m_pRender != nullptr) {
+            m_pRender->SetRegionClip(rcRegion);
+        }
+    }
+}
+
 AutoClip::~AutoClip()
 {
     if (m_bClip && (m_pRender != nullptr)) {
@@ -2,6 +2,7 @@
 #define UI_RENDER_AUTO_CLIP_H_
 
 #include "duilib/Core/UiRect.h"
+#include <vector>
 
 namespace ui 
 {
@@ -12,6 +13,7 @@ class UILIB_API AutoClip
 public:
     AutoClip(IRender* pRender, const UiRect& rc, bool bClip = true);
     AutoClip(IRender* pRender, const UiRect& rcRound, float fRoundWidth, float fRoundHeight, bool bClip = true);
+    AutoClip(IRender* pRender, const std::vector<UiRect>& rcRegion, bool bClip = true);
     ~AutoClip();
 
 private:
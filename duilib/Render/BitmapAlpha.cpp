@@ -66,18 +66,19 @@ void BitmapAlpha::RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowP
     nTop = std::max(nTop, rcShadowPadding.top);
     nBottom = std::min(nBottom, m_nHeight - rcShadowPadding.bottom);
 
-    for (int32_t i = nTop; i < nBottom; i++) {
-        for (int32_t j = nLeft; j < nRight; j++) {
-            uint8_t* a = (uint8_t*)(pBmpBits + i * m_nWidth + j) + 3;
-            // ClearAlpha时，把alpha通道设置为某个值
-            // 如果此值没有变化，则证明上面没有绘制任何内容，把alpha设为0
-            if (alpha != 0 && *a == alpha) {
-                *a = 0;
-            }
+    // ClearAlpha时，把alpha通道设置为某个值
+    // 如果此值没有变化，则证明上面没有绘制任何内容，把alpha设为0（alpha为0时，不存在这种情况，使用一个不可能匹配的值）
+    const uint32_t nUnchangedAlpha = (alpha != 0) ? ((uint32_t)alpha << 24) : 0xFFFFFFFF;
+    for (int32_t i = nTop; i < nBottom; ++i) {
+        uint32_t* pRowBits = pBmpBits + (size_t)i * m_nWidth;
+        //按行处理，循环内无分支，便于编译器生成SIMD指令
+        for (int32_t j = nLeft; j < nRight; ++j) {
+            const uint32_t nPixel = pRowBits[j];
+            const uint32_t a = nPixel & 0xFF000000;
             // 如果此值变为0，则证明上面被类似DrawText等GDI函数绘制过导致alpha被设为0，此时alpha设为255
-            else if (*a == 0) {
-                *a = 255;
-            }
+            uint32_t newAlpha = (a == 0) ? 0xFF000000 : a;
+            newAlpha = (a == nUnchangedAlpha) ? 0 : newAlpha;
+            pRowBits[j] = (nPixel & 0x00FFFFFF) | newAlpha;
         }
     }
 }
@@ -102,12 +103,11 @@ void BitmapAlpha::RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowP
     nTop = std::max(nTop, rcShadowPadding.top);
     nBottom = std::min(nBottom, m_nHeight - rcShadowPadding.bottom);
 
-    for (int i = nTop; i < nBottom; ++i) {
-        for (int j = nLeft; j < nRight; ++j) {            
-            uint8_t* a = (uint8_t*)(pBmpBits + i * m_nWidth + j) + 3;
-            if (*a != 255) {
-                *a = 255;
-            }
+    for (int32_t i = nTop; i < nBottom; ++i) {
+        uint32_t* pRowBits = pBmpBits + (size_t)i * m_nWidth;
+        //按行处理，循环内无分支，便于编译器生成SIMD指令
+        for (int32_t j = nLeft; j < nRight; ++j) {
+            pRowBits[j] |= 0xFF000000;
         }
     }
 }
@@ -5,6 +5,8 @@
 #include "duilib/Core/UiTypes.h"
 #include "duilib/Core/SharePtr.h"
 #include <map>
+#include <vector>
+#include <algorithm>
 
 namespace ui 
 {
@@ -143,6 +145,14 @@ public:
     *@return 返回新生成的位图接口，由调用方释放资源
     */
     virtual IBitmap* Clone() = 0;
+
+    /** 设置是否为图集位图（多个小图标共享的位图，见ImageAtlas）
+    */
+    virtual void SetAtlasBitmap(bool bAtlasBitmap) = 0;
+
+    /** 是否为图集位图（只有图集位图的原大小绘制才会合并为一次绘制调用）
+    */
+    virtual bool IsAtlasBitmap() const = 0;
 };
 
 /** 画笔接口
@@ -564,103 +574,141 @@ enum RichTextCharFlag: uint8_t
     kIsNewLine      = 0x08,     //当前字符是否为换行'\n'
 };
 
-/** 绘制的字符属性（共4个字节）
+/** 逻辑行(矩形区域内显示的行，物理行数据在自动换行的情况下会对应多个逻辑行)的基本信息，
+*   字符的宽度按累计偏移量连续存储（可按二分查找定位坐标对应的字符），字符标记位按每个字符4位压缩存储
 */
-struct RichTextCharInfo
+struct RichTextRowInfo
 {
-    /** 属性标志(读取)
+    /** 该行的文字所占矩形区域
+    */
+    UiRectF m_rowRect;
+
+    /** 本行的left坐标偏移量（用于支持居中和靠右对齐）
+    */
+    int32_t m_xOffset = 0;
+
+public:
+    /** 预分配字符的存储空间
+    * @param [in] nCharCount 字符个数
+    */
+    inline void ReserveChars(size_t nCharCount)
+    {
+        m_charOffsets.reserve(nCharCount);
+        m_charFlags.reserve((nCharCount + 1) / 2);
+    }
+
+    /** 在行尾添加一个字符
+    * @param [in] fCharWidth 字符宽度
+    * @param [in] charFlag 字符标记位，参见RichTextCharFlag
     */
-    inline uint8_t CharFlag() const
+    inline void AddChar(float fCharWidth, uint8_t charFlag)
     {
-        uint32_t v = m_value;
-        v >>= 24;
-        return (uint8_t)v;
+        const size_t nCharIndex = m_charOffsets.size();
+        m_charOffsets.push_back(GetCharOffset(nCharIndex) + fCharWidth);
+        if ((nCharIndex % 2) == 0) {
+            m_charFlags.push_back((uint8_t)(charFlag & 0x0F));
+        }
+        else {
+            m_charFlags.back() |= (uint8_t)((charFlag & 0x0F) << 4);
+        }
     }
 
-    /** 属性标志(设置)
+    /** 本行中的字符个数
     */
-    inline void SetCharFlag(uint8_t flag)
+    inline size_t GetCharCount() const { return m_charOffsets.size(); }
+
+    /** 本行是否无字符
+    */
+    inline bool IsEmpty() const { return m_charOffsets.empty(); }
+
+    /** 获取字符左侧相对于行首的偏移量（即该字符之前所有字符的宽度之和）
+    * @param [in] nCharIndex 字符在本行中的下标，有效范围：[0, GetCharCount()]，等于GetCharCount()时返回本行所有字符的宽度之和
+    */
+    inline float GetCharOffset(size_t nCharIndex) const
     {
-        uint32_t v = flag;
-        v <<= 24;
-        m_value &= 0x00FFFFFF;
-        m_value |= v;
+        ASSERT(nCharIndex <= m_charOffsets.size());
+        if ((nCharIndex == 0) || m_charOffsets.empty()) {
+            return 0.0f;
+        }
+        if (nCharIndex > m_charOffsets.size()) {
+            nCharIndex = m_charOffsets.size();
+        }
+        return m_charOffsets[nCharIndex - 1];
     }
 
-    /** 属性标志(添加)
+    /** 获取字符宽度
+    * @param [in] nCharIndex 字符在本行中的下标，有效范围：[0, GetCharCount())
     */
-    inline void AddCharFlag(uint8_t flag)
+    inline float GetCharWidth(size_t nCharIndex) const
     {
-        uint32_t v = flag;
-        v <<= 24;
-        m_value |= v;
+        ASSERT(nCharIndex < m_charOffsets.size());
+        if (nCharIndex >= m_charOffsets.size()) {
+            return 0.0f;
+        }
+        return m_charOffsets[nCharIndex] - GetCharOffset(nCharIndex);
     }
 
-    /** 字符宽度(读取)
+    /** 获取字符标记位，参见RichTextCharFlag
+    * @param [in] nCharIndex 字符在本行中的下标，有效范围：[0, GetCharCount())
     */
-    inline float CharWidth() const
+    inline uint8_t GetCharFlag(size_t nCharIndex) const
     {
-        uint32_t v = m_value & 0x00FFFFFF;
-        float fValue = (float)v;
-        fValue /= 1000.0f;
-        return fValue;
+        ASSERT(nCharIndex < m_charOffsets.size());
+        if ((nCharIndex / 2) >= m_charFlags.size()) {
+            return 0;
+        }
+        return (uint8_t)((m_charFlags[nCharIndex / 2] >> ((nCharIndex % 2) * 4)) & 0x0F);
     }
 
-    /** 字符宽度(设置)
+    /** 查找偏移量（相对于行首）所在的字符：返回第一个右侧边界大于该偏移量的字符下标（宽度为0的字符不会被返回），
+    *   偏移量超出本行所有字符的宽度之和时，返回GetCharCount()
+    * @param [in] fOffset 相对于行首的偏移量
     */
-    inline void SetCharWidth(float charWidth)
+    inline size_t GetCharIndexFromOffset(float fOffset) const
     {
-        uint32_t v = (uint32_t)(ui::CEILF(charWidth * 1000.0f));
-        ASSERT(v < 0x00FFFFFF);
-        v &= 0x00FFFFFF;
-        m_value &= 0xFF000000;
-        m_value |= v;
+        auto iter = std::upper_bound(m_charOffsets.begin(), m_charOffsets.end(), fOffset);
+        return (size_t)(iter - m_charOffsets.begin());
     }
 
     /** 该字符是否为回车
     */
-    inline bool IsReturn() const { return CharFlag() & RichTextCharFlag::kIsReturn; }
+    inline bool IsReturn(size_t nCharIndex) const { return GetCharFlag(nCharIndex) & RichTextCharFlag::kIsReturn; }
 
     /** 该字符是否为换行符
     */
-    inline bool IsNewLine() const { return CharFlag() & RichTextCharFlag::kIsNewLine; }
+    inline bool IsNewLine(size_t nCharIndex) const { return GetCharFlag(nCharIndex) & RichTextCharFlag::kIsNewLine; }
 
     /** 该字符是否为非绘制字符
     */
-    inline bool IsIgnoredChar() const { return CharFlag() & RichTextCharFlag::kIsIgnoredChar; }
+    inline bool IsIgnoredChar(size_t nCharIndex) const { return GetCharFlag(nCharIndex) & RichTextCharFlag::kIsIgnoredChar; }
 
     /** 该字符是否为低代理字符
     */
-    inline bool IsLowSurrogate() const { return CharFlag() & RichTextCharFlag::kIsLowSurrogate; }
+    inline bool IsLowSurrogate(size_t nCharIndex) const { return GetCharFlag(nCharIndex) & RichTextCharFlag::kIsLowSurrogate; }
 
-    /** 比较操作符
+    /** 比较两行的字符数据是否相同
     */
-    inline bool operator == (const RichTextCharInfo& r) const { return m_value == r.m_value; }
-    inline bool operator != (const RichTextCharInfo& r) const { return m_value != r.m_value; }
-
-private:
-    /** 使用整型存储，减少内存占有量
-    */
-    uint32_t m_value = 0;
-};
+    inline bool IsCharDataEqual(const RichTextRowInfo& r) const
+    {
+        return (m_charOffsets == r.m_charOffsets) && (m_charFlags == r.m_charFlags);
+    }
 
-/** 逻辑行(矩形区域内显示的行，物理行数据在自动换行的情况下会对应多个逻辑行)的基本信息
-*/
-struct RichTextRowInfo: public NVRefCount<RichTextRowInfo>
-{
-    /** 本行中的字符个数，字符属性
+    /** 获取字符数据占用的内存（字节）
     */
-    std::vector<RichTextCharInfo> m_charInfo;
+    inline size_t GetCharDataBytes() const
+    {
+        return m_charOffsets.capacity() * sizeof(float) + m_charFlags.capacity() * sizeof(uint8_t);
+    }
 
-    /** 该行的文字所占矩形区域
+private:
+    /** 每个字符右侧边界相对于行首的偏移量（即该字符及之前所有字符的宽度之和）
     */
-    UiRectF m_rowRect;
+    std::vector<float> m_charOffsets;
 
-    /** 本行的left坐标偏移量（用于支持居中和靠右对齐）
+    /** 字符标记位，每个字符占4位（偶数下标的字符在低4位）
     */
-    int32_t m_xOffset = 0;
+    std::vector<uint8_t> m_charFlags;
 };
-typedef SharePtr<RichTextRowInfo> RichTextRowInfoPtr;
 
 /** 物理行文本的数据
 */
@@ -674,9 +722,9 @@ struct RichTextLineInfo: public NVRefCount<RichTextLineInfo>
     */
     UiStringW m_lineText;
 
-    /** 逻辑行的基本信息
+    /** 逻辑行的基本信息（按值连续存储）
     */
-    std::vector<RichTextRowInfoPtr> m_rowInfo;
+    std::vector<RichTextRowInfo> m_rowInfo;
 };
 typedef SharePtr<RichTextLineInfo> RichTextLineInfoPtr;
 
@@ -764,6 +812,30 @@ struct DrawStringParam
     bool bRotate90ForAscii = true;      //纵向绘制时，对于字母数字等，旋转90度显示
 };
 
+/** 文本评估接口：不依赖画布，对象创建后内部状态不再修改，可以在多个线程中同时调用（用于并行评估大量控件的文本大小）
+*/
+class UILIB_API ITextMeasure
+{
+public:
+    virtual ~ITextMeasure() = default;
+
+    /** 计算指定文本字符串的宽度和高度，功能与IRender::MeasureString相同
+     * @param [in] strText 文字内容
+     * @param [in] measureParam 评估相关的参数（字体对象在评估过程中不能被修改或者释放）
+     * @return 返回文本字符串的宽度和高度，以矩形表示结果
+     */
+    virtual UiRect MeasureString(const DString& strText, const MeasureStringParam& measureParam) const = 0;
+};
+
+/** 文本评估任务：在UI线程中准备，可以在其他线程中评估，评估结果在UI线程中使用
+*/
+struct TextMeasureTask
+{
+    DString text;                       //文字内容
+    MeasureStringParam measureParam;    //评估相关的参数
+    UiRect rcResult;                    //评估结果
+};
+
 /** 渲染接口
 */
 class IRenderFactory;
@@ -832,6 +904,12 @@ public:
     */
     virtual void SetRoundClip(const UiRect& rcItem, float rx, float ry, bool bIntersect = true) = 0;
 
+    /** 设置多个矩形合并而成的剪辑区域，并保存当前设备上下文的状态
+    * @param [in] rcRegion 剪辑区域的矩形列表（取并集），与当前剪辑区取交集作为新的剪辑区域
+    * @param [in] bIntersect ClipOp操作标志，true表示kIntersect操作，false表示kDifference操作
+    */
+    virtual void SetRegionClip(const std::vector<UiRect>& rcRegion, bool bIntersect = true) = 0;
+
     /** 清除矩形剪辑区域，并恢复设备上下文到最近一次保存的状态
     */
     virtual void ClearClip() = 0;
@@ -922,6 +1000,16 @@ public:
                                const UiRect& rcDest, const UiRect& rcSource,
                                uint8_t uFade = 255, IMatrix* pMatrix = nullptr) = 0;
 
+    /** 开始合并绘制图片：在BeginDrawImageBatch与EndDrawImageBatch之间，
+    *   连续从同一图集位图（小图标的共享图集位图，见IBitmap::IsAtlasBitmap）中按原大小绘制的多个图片，合并为一次绘制调用
+    *   遇到其他绘制操作时，先完成已合并的图片绘制，以保证绘制顺序不变（支持嵌套调用）
+    */
+    virtual void BeginDrawImageBatch() = 0;
+
+    /** 结束合并绘制图片，完成所有已合并的图片绘制
+    */
+    virtual void EndDrawImageBatch() = 0;
+
     /** 绘制直线
     * @param [in] pt1 起始点坐标
     * @param [in] pt2 终止点坐标
@@ -1242,6 +1330,29 @@ public:
     */
     virtual void RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding = UiPadding()) = 0;
 
+    /** 将矩形区域内已绘制的位图数据平移（用于滚动时复用已绘制的内容），平移后超出矩形区域的部分丢弃
+    *   仅CPU绘制方式（位图数据在绘制之间保持不变）支持该功能
+    * @param [in] rcScroll 矩形区域（位图坐标，不受视图原点影响）
+    * @param [in] dx 横向平移的距离，正数表示向右平移
+    * @param [in] dy 纵向平移的距离，正数表示向下平移
+    * @return 返回true表示平移成功，返回false表示不支持或者无需平移（平移距离超出矩形区域）
+    */
+    virtual bool ScrollRect(const UiRect& rcScroll, int32_t dx, int32_t dy) = 0;
+
+    /** 开始记录绘制命令：之后的绘制操作不直接绘制到位图中，而是先记录下来，
+    *   在EndRecordPaint时将绘制区域分块，由多个线程并行回放到位图中（用于加速大面积区域的重绘）
+    *   仅CPU绘制方式支持该功能
+    * @param [in] rcPaint 需要绘制的区域（位图坐标，不受视图原点影响）
+    * @return 返回true表示已开始记录，返回false表示不支持，此时绘制操作仍直接绘制到位图中
+    */
+    virtual bool BeginRecordPaint(const UiRect& rcPaint) = 0;
+
+    /** 结束记录绘制命令，将记录的绘制命令分块并行回放到位图中，函数返回时所有分块均已绘制完成
+    * @return 返回true表示绘制完成；返回false表示记录期间有直接访问位图数据的操作（比如通过DC绘制、读写位图数据等），
+    *         记录的绘制命令无法按原顺序回放，已丢弃，调用方需要不使用记录功能重新绘制该区域
+    */
+    virtual bool EndRecordPaint() = 0;
+
 #ifdef DUILIB_BUILD_FOR_WIN
     /** 获取DC句柄，当不使用后，需要调用ReleaseDC接口释放资源
     */
@@ -1251,6 +1362,14 @@ public:
     * @param [in] hdc 需要释放的DC句柄
     */
     virtual void ReleaseRenderDC(HDC hdc) = 0;
+
+    /** 自上次调用ClearRenderDCUsed以来，是否通过GetRenderDC获取过DC（通过DC使用GDI绘制会导致位图的Alpha通道丢失）
+    */
+    virtual bool IsRenderDCUsed() const = 0;
+
+    /** 清除通过GetRenderDC获取过DC的标志
+    */
+    virtual void ClearRenderDCUsed() = 0;
 #endif
 
 public:
@@ -1380,6 +1499,14 @@ public:
     /** 获取字体管理器接口（每个factory共享一个对象）
     */
     virtual IFontMgr* GetFontMgr() const = 0;
+
+    /** 获取文本评估接口（每个factory共享一个对象，线程安全）
+    */
+    virtual ITextMeasure* GetTextMeasure() const = 0;
+
+    /** 获取RichText绘制缓存占用的内存（字节，按数据大小估算，用于内存统计）
+    */
+    virtual size_t GetDrawRichTextCacheBytes(const DrawRichTextCache& drawRichTextCache) const = 0;
 };
 
 } // namespace ui
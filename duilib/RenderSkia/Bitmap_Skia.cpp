@@ -8,7 +8,8 @@
 namespace ui
 {
 
-Bitmap_Skia::Bitmap_Skia()
+Bitmap_Skia::Bitmap_Skia():
+    m_bAtlasBitmap(false)
 {
     m_pSkBitmap = std::make_unique<SkBitmap>();
 }
@@ -164,6 +165,16 @@ IBitmap* Bitmap_Skia::Clone()
     return pBitmap;
 }
 
+void Bitmap_Skia::SetAtlasBitmap(bool bAtlasBitmap)
+{
+    m_bAtlasBitmap = bAtlasBitmap;
+}
+
+bool Bitmap_Skia::IsAtlasBitmap() const
+{
+    return m_bAtlasBitmap;
+}
+
 void Bitmap_Skia::UpdateAlphaFlag(uint8_t* pPixelBits)
 {
     if (pPixelBits == nullptr) {
@@ -54,6 +54,14 @@ public:
     */
     virtual IBitmap* Clone() override;
 
+    /** 设置是否为图集位图
+    */
+    virtual void SetAtlasBitmap(bool bAtlasBitmap) override;
+
+    /** 是否为图集位图
+    */
+    virtual bool IsAtlasBitmap() const override;
+
 public:
     /** 获取Skia 位图
     */
@@ -72,6 +80,10 @@ private:
     /** Skia 位图
     */
     std::unique_ptr<SkBitmap> m_pSkBitmap;
+
+    /** 是否为图集位图
+    */
+    bool m_bAtlasBitmap;
 };
 
 } // namespace ui
@@ -5,6 +5,7 @@
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/PerformanceUtil.h"
+#include "duilib/Core/MemoryStat.h"
 
 #include "SkiaHeaderBegin.h"
 
@@ -59,6 +60,35 @@ struct TPendingDrawRichText : public NVRefCount<TPendingDrawRichText>
 class DrawRichTextCache
 {
 public:
+    DrawRichTextCache()
+    {
+        MemoryStat::Add(MemoryCategory::kRichTextCache, 0, 1);
+    }
+
+    ~DrawRichTextCache()
+    {
+        MemoryStat::Add(MemoryCategory::kRichTextCache, -(int64_t)m_nMemoryBytes, -1);
+    }
+    DrawRichTextCache(const DrawRichTextCache&) = delete;
+    DrawRichTextCache& operator = (const DrawRichTextCache&) = delete;
+
+    /** 数据修改后，重新计算占用的内存，并更新内存统计的计数器
+    */
+    void UpdateMemoryStat()
+    {
+        size_t nMemoryBytes = sizeof(DrawRichTextCache);
+        nMemoryBytes += m_richTextData.capacity() * sizeof(RichTextData);
+        nMemoryBytes += m_pendingTextData.capacity() * sizeof(SharePtr<TPendingDrawRichText>);
+        nMemoryBytes += m_pendingTextData.size() * sizeof(TPendingDrawRichText);
+        MemoryStat::Add(MemoryCategory::kRichTextCache, (int64_t)nMemoryBytes - (int64_t)m_nMemoryBytes, 0);
+        m_nMemoryBytes = nMemoryBytes;
+    }
+
+public:
+    /** 占用的内存（字节，按数据大小估算）
+    */
+    size_t m_nMemoryBytes = 0;
+
     /** 原始参数
     */
     UiRect m_textRect;
@@ -240,6 +270,7 @@ void DrawRichText::InternalDrawRichText(const UiRect& rcTextRect,
         }
 
         const SkFont& skFont = *pSkFont;
+        FontFallback_Skia* pFontFallback = pSkiaFont->GetFontFallback();
         SkFontMetrics metrics;
         SkScalar fFontHeight = skFont.getMetrics(&metrics);     //字体高度，换行时使用
         fFontHeight = textData.m_fRowSpacingMul * fFontHeight + textData.m_fRowSpacingAdd; //运用行间距倍数和行间距附加量
@@ -330,7 +361,8 @@ void DrawRichText::InternalDrawRichText(const UiRect& rcTextRect,
                                                        skFont, skPaint,
                                                        maxWidth, &textMeasuredWidth, &textMeasuredHeight,
                                                        glyphs, glyphChars, glyphWidths,
-                                                       pGlyphCharList, pGlyphWidthList);
+                                                       pGlyphCharList, pGlyphWidthList,
+                                                       pFontFallback);
                     if (nDrawLength > 0) {
                         nDrawLength = textCount * sizeof(DStringW::value_type);
                         if (glyphs.empty()) {
@@ -352,7 +384,8 @@ void DrawRichText::InternalDrawRichText(const UiRect& rcTextRect,
                                                        skFont, skPaint,
                                                        maxWidth, &textMeasuredWidth, &textMeasuredHeight,
                                                        glyphs, glyphChars, glyphWidths,
-                                                       pGlyphCharList, pGlyphWidthList);
+                                                       pGlyphCharList, pGlyphWidthList,
+                                                       pFontFallback);
                 }
                 
                 if (nDrawLength == 0) {
@@ -498,6 +531,7 @@ void DrawRichText::InternalDrawRichText(const UiRect& rcTextRect,
         spDrawRichTextCache->m_textCharSize = textCharSize;
 
         spDrawRichTextCache->m_pendingTextData.swap(pendingTextData);
+        spDrawRichTextCache->UpdateMemoryStat();
     }
     else if (!bMeasureOnly) {
         UiRect rcTemp;
@@ -633,13 +667,9 @@ void DrawRichText::OnDrawUnicodeChar(RichTextLineInfoParam* pLineInfoParam,
             ASSERT(nLineTextRowIndex == lineInfo.m_rowInfo.size());
             return;
         }
-        lineInfo.m_rowInfo.push_back(RichTextRowInfoPtr(new RichTextRowInfo));        
-    }    
-    if (lineInfo.m_rowInfo[nLineTextRowIndex] == nullptr) {
-        ASSERT(lineInfo.m_rowInfo[nLineTextRowIndex] != nullptr);
-        return;
+        lineInfo.m_rowInfo.emplace_back();
     }
-    RichTextRowInfo& rowInfo = *lineInfo.m_rowInfo[nLineTextRowIndex];
+    RichTextRowInfo& rowInfo = lineInfo.m_rowInfo[nLineTextRowIndex];
     if (!bFound) {
         //该行的第一个字符
         rowInfo.m_rowRect.left = xPos;
@@ -648,38 +678,28 @@ void DrawRichText::OnDrawUnicodeChar(RichTextLineInfoParam* pLineInfoParam,
         rowInfo.m_rowRect.bottom = rowInfo.m_rowRect.top + nRowHeight;
         ASSERT(nRowHeight > 0);
 
-        rowInfo.m_charInfo.reserve(glyphCount + 2);
+        rowInfo.ReserveChars(glyphCount + 2);
     }
     else {
         rowInfo.m_rowRect.right += glyphWidth;
         ASSERT(nRowHeight == (int32_t)rowInfo.m_rowRect.Height());
     }
 
-    RichTextCharInfo charInfo;
-    charInfo.SetCharWidth(glyphWidth);    
     if (ch == '\r') {
         //回车
-        charInfo.SetCharFlag(0);
-        charInfo.AddCharFlag(RichTextCharFlag::kIsIgnoredChar);
-        charInfo.AddCharFlag(RichTextCharFlag::kIsReturn);
-        charInfo.SetCharWidth(0);
+        rowInfo.AddChar(0, RichTextCharFlag::kIsIgnoredChar | RichTextCharFlag::kIsReturn);
     }
     else if (ch == '\n') {
         //换行
-        charInfo.SetCharFlag(0);
-        charInfo.AddCharFlag(RichTextCharFlag::kIsNewLine);
-        charInfo.SetCharWidth(0);
+        rowInfo.AddChar(0, RichTextCharFlag::kIsNewLine);
+    }
+    else {
+        rowInfo.AddChar(glyphWidth, 0);
     }
-
-    rowInfo.m_charInfo.emplace_back(std::move(charInfo));
 
     if (glyphChars == 2) {
-        RichTextCharInfo charInfo2;
-        charInfo2.SetCharWidth(0);
-        charInfo2.SetCharFlag(0);
-        charInfo2.AddCharFlag(RichTextCharFlag::kIsIgnoredChar);
-        charInfo2.AddCharFlag(RichTextCharFlag::kIsLowSurrogate);
-        rowInfo.m_charInfo.emplace_back(std::move(charInfo2));
+        //低代理字符
+        rowInfo.AddChar(0, RichTextCharFlag::kIsIgnoredChar | RichTextCharFlag::kIsLowSurrogate);
     }
     ASSERT((glyphChars == 1) || (glyphChars == 2));
 }
@@ -886,9 +906,15 @@ bool DrawRichText::UpdateDrawRichTextCache(std::shared_ptr<DrawRichTextCache>& s
             }
         }
     }
+    oldData.UpdateMemoryStat();
     return true;
 }
 
+size_t DrawRichText::GetDrawRichTextCacheBytes(const DrawRichTextCache& drawRichTextCache)
+{
+    return drawRichTextCache.m_nMemoryBytes;
+}
+
 bool DrawRichText::IsDrawRichTextCacheEqual(const DrawRichTextCache& first, const DrawRichTextCache& second) const
 {
     ASSERT((m_pRender != nullptr) && (m_pSkCanvas != nullptr) && (m_pSkPaint != nullptr) && (m_pSkPointOrg != nullptr));
@@ -1163,6 +1189,7 @@ void DrawRichText::DrawTextString(const UiRect& textRect,
     //设置绘制属性
     SkTextBox skTextBox;
     skTextBox.setBox(rcSkDest);
+    skTextBox.setFontFallback(pSkiaFont->GetFontFallback());
     if (uFormat & DrawStringFormat::TEXT_SINGLELINE) {
         //单行文本
         skTextBox.setLineMode(SkTextBox::kOneLine_Mode);
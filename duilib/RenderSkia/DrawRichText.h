@@ -73,6 +73,10 @@ public:
     */
     bool IsDrawRichTextCacheEqual(const DrawRichTextCache& first, const DrawRichTextCache& second) const;
 
+    /** 获取绘制缓存占用的内存（字节，按数据大小估算）
+    */
+    static size_t GetDrawRichTextCacheBytes(const DrawRichTextCache& drawRichTextCache);
+
     /** 绘制RichText的缓存中的内容（绘制前，需要使用IsValidDrawRichTextCache判断缓存是否失效）
     * @param [in] spDrawRichTextCache 缓存的数据
     * @param [in] rcNewTextRect 绘制文本的矩形区域
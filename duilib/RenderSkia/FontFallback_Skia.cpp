@@ -0,0 +1,353 @@
+#include "FontFallback_Skia.h"
+#include "SkUtils.h"
+
+#include "SkiaHeaderBegin.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSpan.h"
+#include "SkiaHeaderEnd.h"
+
+/** 字符匹配缓存的最大条目数（超过后清空缓存，重新匹配）
+*/
+#define FONT_FALLBACK_MAX_CACHE_SIZE 4096
+
+namespace ui
+{
+
+FontFallback_Skia::FontFallback_Skia(const sk_sp<SkFontMgr>& spFontMgr):
+    m_spFontMgr(spFontMgr)
+{
+    ASSERT(m_spFontMgr != nullptr);
+}
+
+FontFallback_Skia::~FontFallback_Skia()
+{
+    ClearCache();
+}
+
+bool FontFallback_Skia::IsIgnorableChar(SkUnichar uni)
+{
+    if ((uni < 0x20) || (uni == 0x7F)) {
+        //控制字符（含回车、换行、TAB键）
+        return true;
+    }
+    if (((uni >= 0x200B) && (uni <= 0x200F)) || //零宽字符、方向控制符
+        ((uni >= 0x2028) && (uni <= 0x202E)) || //行分隔符、段分隔符、方向控制符
+        ((uni >= 0x2060) && (uni <= 0x2064)) || //零宽不换行空格等
+        (uni == 0xFEFF)) {                      //BOM
+        return true;
+    }
+    return SkUnichar_IsVariationSelector(uni);
+}
+
+bool FontFallback_Skia::DecodeText(const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                                   std::vector<SkUnichar>& unichars, std::vector<uint32_t>& byteOffsets)
+{
+    unichars.clear();
+    byteOffsets.clear();
+    if ((text == nullptr) || (byteLength == 0)) {
+        return false;
+    }
+    if (textEncoding == SkTextEncoding::kUTF8) {
+        const char* start = static_cast<const char*>(text);
+        const char* ptr = start;
+        const char* stop = start + byteLength;
+        while (ptr < stop) {
+            byteOffsets.push_back((uint32_t)(ptr - start));
+            SkUnichar uni = SkUTF8_NextUnicharWithError(&ptr, stop);
+            if (uni < 0) {
+                return false;
+            }
+            unichars.push_back(uni);
+        }
+    }
+    else if (textEncoding == SkTextEncoding::kUTF16) {
+        if ((byteLength % sizeof(uint16_t)) != 0) {
+            return false;
+        }
+        const uint16_t* start = static_cast<const uint16_t*>(text);
+        const uint16_t* src = start;
+        const uint16_t* stop = start + byteLength / sizeof(uint16_t);
+        while (src < stop) {
+            byteOffsets.push_back((uint32_t)((src - start) * sizeof(uint16_t)));
+            SkUnichar uni = *src++;
+            if (SkUTF16_IsHighSurrogate(uni)) {
+                if ((src >= stop) || !SkUTF16_IsLowSurrogate(*src)) {
+                    return false;
+                }
+                SkUnichar uni2 = *src++;
+                uni = (uni << 10) + uni2 + (0x10000 - (0xD800 << 10) - 0xDC00);
+            }
+            else if (SkUTF16_IsLowSurrogate(uni)) {
+                return false;
+            }
+            unichars.push_back(uni);
+        }
+    }
+    else if (textEncoding == SkTextEncoding::kUTF32) {
+        if ((byteLength % sizeof(uint32_t)) != 0) {
+            return false;
+        }
+        const uint32_t* start = static_cast<const uint32_t*>(text);
+        const size_t nCount = byteLength / sizeof(uint32_t);
+        unichars.reserve(nCount);
+        byteOffsets.reserve(nCount);
+        for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+            byteOffsets.push_back((uint32_t)(nIndex * sizeof(uint32_t)));
+            unichars.push_back((SkUnichar)start[nIndex]);
+        }
+    }
+    else {
+        return false;
+    }
+    return !unichars.empty();
+}
+
+bool FontFallback_Skia::NeedFallback(const void* text, size_t byteLength, SkTextEncoding textEncoding, const SkFont& font) const
+{
+    if ((text == nullptr) || (byteLength == 0)) {
+        return false;
+    }
+    const int nGlyphCount = font.countText(text, byteLength, textEncoding);
+    if (nGlyphCount <= 0) {
+        return false;
+    }
+    std::vector<SkGlyphID> glyphs;
+    glyphs.resize((size_t)nGlyphCount);
+    font.textToGlyphs(text, byteLength, textEncoding, SkSpan<SkGlyphID>(glyphs.data(), glyphs.size()));
+    bool bHasMissingGlyph = false;
+    for (SkGlyphID glyph : glyphs) {
+        if (glyph == 0) {
+            bHasMissingGlyph = true;
+            break;
+        }
+    }
+    if (!bHasMissingGlyph) {
+        //常见情况：基础字体可以显示全部字符
+        return false;
+    }
+    std::vector<SkUnichar> unichars;
+    std::vector<uint32_t> byteOffsets;
+    if (!DecodeText(text, byteLength, textEncoding, unichars, byteOffsets) || (unichars.size() != glyphs.size())) {
+        return false;
+    }
+    for (size_t nIndex = 0; nIndex < glyphs.size(); ++nIndex) {
+        if ((glyphs[nIndex] == 0) && !IsIgnorableChar(unichars[nIndex])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FontFallback_Skia::SegmentText(const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                                    const SkFont& font, std::vector<TextRun>& runs)
+{
+    runs.clear();
+    if ((text == nullptr) || (byteLength == 0)) {
+        return false;
+    }
+    const int nGlyphCount = font.countText(text, byteLength, textEncoding);
+    if (nGlyphCount <= 0) {
+        return false;
+    }
+    std::vector<SkGlyphID> glyphs;
+    glyphs.resize((size_t)nGlyphCount);
+    font.textToGlyphs(text, byteLength, textEncoding, SkSpan<SkGlyphID>(glyphs.data(), glyphs.size()));
+    bool bHasMissingGlyph = false;
+    for (SkGlyphID glyph : glyphs) {
+        if (glyph == 0) {
+            bHasMissingGlyph = true;
+            break;
+        }
+    }
+    if (!bHasMissingGlyph) {
+        //常见情况：基础字体可以显示全部字符，不需要切分
+        return false;
+    }
+
+    std::vector<SkUnichar> unichars;
+    std::vector<uint32_t> byteOffsets;
+    if (!DecodeText(text, byteLength, textEncoding, unichars, byteOffsets) || (unichars.size() != glyphs.size())) {
+        return false;
+    }
+
+    bool bFallbackUsed = false;
+    sk_sp<SkTypeface> spRunTypeface; //当前段的回退字体，nullptr表示基础字体
+    const size_t nCharCount = unichars.size();
+    for (size_t nIndex = 0; nIndex < nCharCount; ++nIndex) {
+        const SkUnichar uni = unichars[nIndex];
+        sk_sp<SkTypeface> spTypeface;
+        if (glyphs[nIndex] == 0) {
+            if (IsIgnorableChar(uni)) {
+                if (!runs.empty()) {
+                    //不可见字符跟随前面的字符
+                    continue;
+                }
+            }
+            else {
+                spTypeface = MatchFallbackTypeface(uni, font);
+            }
+        }
+        if (runs.empty() || (spTypeface != spRunTypeface)) {
+            //开始新的一段
+            TextRun& run = runs.emplace_back();
+            run.m_nByteOffset = byteOffsets[nIndex];
+            run.m_font = font;
+            if (spTypeface != nullptr) {
+                run.m_font.setTypeface(spTypeface);
+                bFallbackUsed = true;
+            }
+            spRunTypeface = spTypeface;
+        }
+    }
+    if (!bFallbackUsed) {
+        //没有找到可用的回退字体，按基础字体处理
+        runs.clear();
+        return false;
+    }
+
+    //计算每段的长度
+    const size_t nRunCount = runs.size();
+    for (size_t nIndex = 0; nIndex < nRunCount; ++nIndex) {
+        size_t nByteEnd = (nIndex + 1 < nRunCount) ? runs[nIndex + 1].m_nByteOffset : byteLength;
+        ASSERT(nByteEnd > runs[nIndex].m_nByteOffset);
+        runs[nIndex].m_nByteLength = nByteEnd - runs[nIndex].m_nByteOffset;
+    }
+    return true;
+}
+
+SkScalar FontFallback_Skia::MeasureText(const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                                        const SkFont& font, SkRect* bounds, const SkPaint* paint)
+{
+    std::vector<TextRun> runs;
+    if (!SegmentText(text, byteLength, textEncoding, font, runs)) {
+        return font.measureText(text, byteLength, textEncoding, bounds, paint);
+    }
+    SkScalar fTotalWidth = 0;
+    SkRect totalBounds = SkRect::MakeEmpty();
+    for (const TextRun& run : runs) {
+        SkRect runBounds = SkRect::MakeEmpty();
+        SkScalar fRunWidth = run.m_font.measureText(static_cast<const char*>(text) + run.m_nByteOffset,
+                                                    run.m_nByteLength, textEncoding,
+                                                    (bounds != nullptr) ? &runBounds : nullptr,
+                                                    paint);
+        if (bounds != nullptr) {
+            runBounds.offset(fTotalWidth, 0);
+            totalBounds.join(runBounds);
+        }
+        fTotalWidth += fRunWidth;
+    }
+    if (bounds != nullptr) {
+        *bounds = totalBounds;
+    }
+    return fTotalWidth;
+}
+
+void FontFallback_Skia::DrawSimpleText(SkCanvas* canvas, const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                                       SkScalar x, SkScalar y, const SkFont& font, const SkPaint& paint)
+{
+    ASSERT(canvas != nullptr);
+    if (canvas == nullptr) {
+        return;
+    }
+    std::vector<TextRun> runs;
+    if (!SegmentText(text, byteLength, textEncoding, font, runs)) {
+        canvas->drawSimpleText(text, byteLength, textEncoding, x, y, font, paint);
+        return;
+    }
+    for (const TextRun& run : runs) {
+        const char* runText = static_cast<const char*>(text) + run.m_nByteOffset;
+        canvas->drawSimpleText(runText, run.m_nByteLength, textEncoding, x, y, run.m_font, paint);
+        x += run.m_font.measureText(runText, run.m_nByteLength, textEncoding, nullptr, &paint);
+    }
+}
+
+bool FontFallback_Skia::GetGlyphWidths(const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                                       const SkFont& font, const SkPaint* paint, std::vector<SkScalar>& glyphWidths)
+{
+    std::vector<TextRun> runs;
+    if (!SegmentText(text, byteLength, textEncoding, font, runs)) {
+        return false;
+    }
+    std::vector<SkScalar> widths;
+    std::vector<SkGlyphID> glyphs;
+    std::vector<SkScalar> runWidths;
+    for (const TextRun& run : runs) {
+        const char* runText = static_cast<const char*>(text) + run.m_nByteOffset;
+        const int nGlyphCount = run.m_font.countText(runText, run.m_nByteLength, textEncoding);
+        if (nGlyphCount <= 0) {
+            return false;
+        }
+        glyphs.resize((size_t)nGlyphCount);
+        run.m_font.textToGlyphs(runText, run.m_nByteLength, textEncoding, SkSpan<SkGlyphID>(glyphs.data(), glyphs.size()));
+        runWidths.resize(glyphs.size());
+        run.m_font.getWidthsBounds(SkSpan<const SkGlyphID>(glyphs.data(), glyphs.size()),
+                                   SkSpan<SkScalar>(runWidths.data(), runWidths.size()),
+                                   SkSpan<SkRect>(), paint);
+        widths.insert(widths.end(), runWidths.begin(), runWidths.end());
+    }
+    glyphWidths.swap(widths);
+    return true;
+}
+
+SkFont FontFallback_Skia::MatchFont(SkUnichar uni, const SkFont& font)
+{
+    if (IsIgnorableChar(uni) || (font.unicharToGlyph(uni) != 0)) {
+        return font;
+    }
+    sk_sp<SkTypeface> spTypeface = MatchFallbackTypeface(uni, font);
+    if (spTypeface == nullptr) {
+        return font;
+    }
+    SkFont fallbackFont = font;
+    fallbackFont.setTypeface(spTypeface);
+    return fallbackFont;
+}
+
+sk_sp<SkTypeface> FontFallback_Skia::MatchFallbackTypeface(SkUnichar uni, const SkFont& font)
+{
+    SkTypeface* pBaseTypeface = font.getTypeface();
+    const uint32_t nBaseTypefaceId = (pBaseTypeface != nullptr) ? (uint32_t)pBaseTypeface->uniqueID() : 0;
+    const uint64_t nCacheKey = ((uint64_t)nBaseTypefaceId << 32) | (uint32_t)uni;
+    {
+        std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+        auto iter = m_fallbackCache.find(nCacheKey);
+        if (iter != m_fallbackCache.end()) {
+            return iter->second;
+        }
+    }
+
+    //通过字体管理器按字符匹配字体（该操作比较耗时，结果需要缓存）
+    sk_sp<SkTypeface> spTypeface;
+    if (m_spFontMgr != nullptr) {
+        SkString familyName;
+        SkFontStyle fontStyle;
+        if (pBaseTypeface != nullptr) {
+            pBaseTypeface->getFamilyName(&familyName);
+            fontStyle = pBaseTypeface->fontStyle();
+        }
+        spTypeface = m_spFontMgr->matchFamilyStyleCharacter(familyName.isEmpty() ? nullptr : familyName.c_str(),
+                                                            fontStyle, nullptr, 0, uni);
+        if ((spTypeface != nullptr) &&
+            ((spTypeface->unicharToGlyph(uni) == 0) || (spTypeface->uniqueID() == nBaseTypefaceId))) {
+            //匹配结果无效
+            spTypeface.reset();
+        }
+    }
+
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    if (m_fallbackCache.size() >= FONT_FALLBACK_MAX_CACHE_SIZE) {
+        //缓存已满：字体和字符组合过多时，避免缓存无限增长
+        m_fallbackCache.clear();
+    }
+    m_fallbackCache[nCacheKey] = spTypeface;
+    return spTypeface;
+}
+
+void FontFallback_Skia::ClearCache()
+{
+    std::lock_guard<std::mutex> threadGuard(m_cacheMutex);
+    m_fallbackCache.clear();
+}
+
+} // namespace ui
@@ -0,0 +1,127 @@
+#ifndef UI_RENDER_SKIA_FONT_FALLBACK_H_
+#define UI_RENDER_SKIA_FONT_FALLBACK_H_
+
+#include "duilib/duilib_defs.h"
+
+#include "SkiaHeaderBegin.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkFontMgr.h"
+#include "include/core/SkTypeface.h"
+#include "SkiaHeaderEnd.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class SkCanvas;
+class SkPaint;
+
+namespace ui
+{
+
+/** 字体回退（Font Fallback）的实现：当基础字体中不含某个字符时（比如中文、Emoji等），
+*   通过Skia字体管理器按字符匹配可显示该字符的字体，并将文本按字体切分为多段分别测量和绘制
+*   匹配结果按（基础字体，Unicode字符）缓存，缓存条目数有上限，超过上限后清空重新匹配
+*/
+class UILIB_API FontFallback_Skia
+{
+public:
+    explicit FontFallback_Skia(const sk_sp<SkFontMgr>& spFontMgr);
+    FontFallback_Skia(const FontFallback_Skia&) = delete;
+    FontFallback_Skia& operator=(const FontFallback_Skia&) = delete;
+    ~FontFallback_Skia();
+
+public:
+    /** 按字体切分后的一段文本
+    */
+    struct TextRun
+    {
+        //在原始文本中的起始位置（字节）
+        size_t m_nByteOffset = 0;
+
+        //文本长度（字节）
+        size_t m_nByteLength = 0;
+
+        //该段文本使用的字体
+        SkFont m_font;
+    };
+
+    /** 判断文本中是否含有基础字体无法显示的字符
+    * @param [in] text 文本
+    * @param [in] byteLength 文本长度（字节）
+    * @param [in] textEncoding 文本编码
+    * @param [in] font 基础字体
+    */
+    bool NeedFallback(const void* text, size_t byteLength, SkTextEncoding textEncoding, const SkFont& font) const;
+
+    /** 将文本按字体切分为多段
+    * @param [in] text 文本
+    * @param [in] byteLength 文本长度（字节）
+    * @param [in] textEncoding 文本编码
+    * @param [in] font 基础字体
+    * @param [out] runs 返回切分结果
+    * @return 如果需要使用回退字体，返回true；如果全部文本可以使用基础字体，返回false（此时runs为空）
+    */
+    bool SegmentText(const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                     const SkFont& font, std::vector<TextRun>& runs);
+
+    /** 测量文本宽度（含字体回退），功能与SkFont::measureText相同
+    */
+    SkScalar MeasureText(const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                         const SkFont& font, SkRect* bounds, const SkPaint* paint);
+
+    /** 绘制文本（含字体回退），功能与SkCanvas::drawSimpleText相同
+    */
+    void DrawSimpleText(SkCanvas* canvas, const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                        SkScalar x, SkScalar y, const SkFont& font, const SkPaint& paint);
+
+    /** 获取每个Unicode字符的绘制宽度（含字体回退），与SkFont::textToGlyphs得到的字形一一对应
+    * @return 如果需要使用回退字体，返回true并填充glyphWidths；否则返回false，glyphWidths不修改
+    */
+    bool GetGlyphWidths(const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                        const SkFont& font, const SkPaint* paint, std::vector<SkScalar>& glyphWidths);
+
+    /** 获取可显示该字符的字体
+    * @param [in] uni Unicode字符
+    * @param [in] font 基础字体
+    * @return 如果基础字体可以显示，返回基础字体；否则返回回退字体（找不到回退字体时返回基础字体）
+    */
+    SkFont MatchFont(SkUnichar uni, const SkFont& font);
+
+    /** 清除字符匹配缓存
+    */
+    void ClearCache();
+
+private:
+    /** 查找可显示该字符的回退字体（基础字体中不含该字符）
+    * @return 找不到时返回nullptr
+    */
+    sk_sp<SkTypeface> MatchFallbackTypeface(SkUnichar uni, const SkFont& font);
+
+    /** 将文本解码为Unicode字符，并返回每个字符在文本中的起始位置（字节）
+    */
+    static bool DecodeText(const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                           std::vector<SkUnichar>& unichars, std::vector<uint32_t>& byteOffsets);
+
+    /** 判断是否为不需要匹配字体的字符（控制字符、零宽字符、变体选择符等，跟随前面的字符）
+    */
+    static bool IsIgnorableChar(SkUnichar uni);
+
+private:
+    /** Skia的字体管理器
+    */
+    sk_sp<SkFontMgr> m_spFontMgr;
+
+    /** 字符匹配缓存：Key为(基础字体ID << 32 | Unicode字符)，Value为回退字体（nullptr表示无可用的回退字体）
+    *   条目数不超过FONT_FALLBACK_MAX_CACHE_SIZE
+    */
+    std::unordered_map<uint64_t, sk_sp<SkTypeface>> m_fallbackCache;
+
+    /** 缓存的多线程保护
+    */
+    std::mutex m_cacheMutex;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_FONT_FALLBACK_H_
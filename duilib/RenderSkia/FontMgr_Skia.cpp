@@ -1,4 +1,5 @@
 #include "FontMgr_Skia.h"
+#include "FontFallback_Skia.h"
 #include "duilib/Utils/StringConvert.h"
 #include "duilib/Utils/PerformanceUtil.h"
 
@@ -26,6 +27,7 @@
 #include "SkiaHeaderEnd.h"
 
 #include <map>
+#include <memory>
 
 namespace ui
 {
@@ -186,6 +188,10 @@ public:
     /** 字体名称对应的FontStyleSet缓存（发现部分Linux系统创建字体时，速度特别慢，调用一次需要几十毫秒，所以有必要做缓存）
     */
     std::map<std::string, sk_sp<SkFontStyleSet>> m_fontStyleSetMap;
+
+    /** 字体回退（按字符匹配字体，匹配结果有缓存）
+    */
+    std::unique_ptr<FontFallback_Skia> m_spFontFallback;
 };
 
 FontMgr_Skia::FontMgr_Skia()
@@ -205,6 +211,7 @@ FontMgr_Skia::FontMgr_Skia()
 #endif
 
     ASSERT(m_impl->m_pSkFontMgr != nullptr);
+    m_impl->m_spFontFallback = std::make_unique<FontFallback_Skia>(m_impl->m_pSkFontMgr);
 }
 
 FontMgr_Skia::~FontMgr_Skia()
@@ -329,11 +336,17 @@ bool FontMgr_Skia::LoadFontFileData(const void* data, size_t length)
 void FontMgr_Skia::ClearFontFiles()
 {
     m_impl->m_fontFileMgr.Clear();
+    if (m_impl->m_spFontFallback != nullptr) {
+        m_impl->m_spFontFallback->ClearCache();
+    }
 }
 
 void FontMgr_Skia::ClearFontCache()
 {
     m_impl->m_fontStyleSetMap.clear();
+    if (m_impl->m_spFontFallback != nullptr) {
+        m_impl->m_spFontFallback->ClearCache();
+    }
 }
 
 SkFont* FontMgr_Skia::CreateSkFont(const UiFont& fontInfo)
@@ -435,4 +448,9 @@ void* FontMgr_Skia::GetSkiaFontMgrPtr() const
     return &(m_impl->m_pSkFontMgr);
 }
 
+FontFallback_Skia* FontMgr_Skia::GetFontFallback() const
+{
+    return m_impl->m_spFontFallback.get();
+}
+
 } // namespace ui
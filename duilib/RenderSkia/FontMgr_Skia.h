@@ -9,6 +9,7 @@ class SkFont;
 
 namespace ui 
 {
+class FontFallback_Skia;
 
 /** 字体管理器接口的实现
 */
@@ -81,6 +82,10 @@ public:
     */
     void* GetSkiaFontMgrPtr() const;
 
+    /** 获取字体回退的实现对象（DrawString、MeasureString、DrawRichText共用）
+    */
+    FontFallback_Skia* GetFontFallback() const;
+
 private:
     /** 内部实现类
     */
@@ -53,5 +53,15 @@ const SkFont* Font_Skia::GetFontHandle()
     return m_skFont;
 }
 
+FontFallback_Skia* Font_Skia::GetFontFallback() const
+{
+    FontMgr_Skia* pSkiaFontMgr = dynamic_cast<FontMgr_Skia*>(m_spFontMgr.get());
+    ASSERT(pSkiaFontMgr != nullptr);
+    if (pSkiaFontMgr != nullptr) {
+        return pSkiaFontMgr->GetFontFallback();
+    }
+    return nullptr;
+}
+
 } // namespace ui
 
@@ -8,6 +8,7 @@ class SkFontMgr;
 
 namespace ui 
 {
+class FontFallback_Skia;
 
 /** Skia字体接口的实现
 */
@@ -52,6 +53,10 @@ public:
     */
     const SkFont* GetFontHandle();
 
+    /** 获取字体回退的实现对象（由字体管理器统一持有）
+    */
+    FontFallback_Skia* GetFontFallback() const;
+
 private:
     /** 删除Skia字体
     */
@@ -1,5 +1,6 @@
 #include "HorizontalDrawText.h"
 #include "duilib/RenderSkia/Font_Skia.h"
+#include "duilib/RenderSkia/FontFallback_Skia.h"
 
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/StringConvert.h"
@@ -33,7 +34,8 @@ UTF16String HorizontalDrawText::GetDrawStringUTF16(const DString& strText, bool
 #if defined DUILIB_UNICODE && defined WCHAR_T_IS_UTF16
     return text;
 #else
-    std::string textUTF8 = StringConvert::TToUTF8(text);
+    //DString为UTF8编码时直接转换，避免复制字符串
+    const std::string& textUTF8 = StringConvert::TToUTF8(text);
     return StringConvert::UTF8ToUTF16(textUTF8.c_str(), textUTF8.size());
 #endif
 }
@@ -43,12 +45,15 @@ UTF16String HorizontalDrawText::GetDrawStringUTF16(const DString& strText, bool
 struct THorizontalChar
 {
     DUTF16Char ch;
-    bool bNewLine;  //是否为换行符
+    DUTF16Char chLow;   //代理对的低位（ch为高位代理时有效，否则为0）
+    bool bNewLine;      //是否为换行符
+    bool bContinuation; //是否为代理对的低位（已合并到前一个字符中测量和绘制，本身不占位置）
     SkSize size;    //字符绘制后的宽度和高度
     SkRect bounds;  //字符绘制后的边界信息
 };
 
-bool HorizontalDrawText::CalculateTextCharBounds(const UTF16String& textUTF16, const SkFont* pSkFont, const SkPaint* skPaint,
+bool HorizontalDrawText::CalculateTextCharBounds(const UTF16String& textUTF16, const SkFont* pSkFont, FontFallback_Skia* pFontFallback,
+                                                 const SkPaint* skPaint,
                                                  float fFontHeight, std::vector<THorizontalChar>& charRects) const
 {
     if (textUTF16.empty()) {
@@ -71,8 +76,21 @@ bool HorizontalDrawText::CalculateTextCharBounds(const UTF16String& textUTF16, c
     charRects.reserve(textUTF16.size());
 
     THorizontalChar horizontalChar;
-    for (DUTF16Char ch : textUTF16) {
+    const size_t nTextLen = textUTF16.size();
+    for (size_t nTextIndex = 0; nTextIndex < nTextLen; ++nTextIndex) {
+        DUTF16Char ch = textUTF16[nTextIndex];
         horizontalChar.ch = ch;
+        horizontalChar.chLow = 0;
+        horizontalChar.bContinuation = false;
+        //代理对：按完整的Unicode字符匹配字体并测量，低位占一个不绘制的零宽位置
+        SkUnichar uni = (SkUnichar)ch;
+        if ((ch >= 0xD800) && (ch <= 0xDBFF) && ((nTextIndex + 1) < nTextLen)) {
+            const DUTF16Char chLow = textUTF16[nTextIndex + 1];
+            if ((chLow >= 0xDC00) && (chLow <= 0xDFFF)) {
+                horizontalChar.chLow = chLow;
+                uni = (((SkUnichar)ch - 0xD800) << 10) + ((SkUnichar)chLow - 0xDC00) + 0x10000;
+            }
+        }
         if (ch == L'\n') {
             //换行符
             horizontalChar.bNewLine = true;
@@ -82,11 +100,14 @@ bool HorizontalDrawText::CalculateTextCharBounds(const UTF16String& textUTF16, c
         }
         else {
             horizontalChar.bNewLine = false;
-            SkScalar fTextWidth = pSkFont->measureText(&ch,
-                                                       sizeof(DUTF16Char),
-                                                       SkTextEncoding::kUTF16,
-                                                       &horizontalChar.bounds,//斜体字时，这个宽度包含了外延的宽度
-                                                       skPaint);
+            //基础字体中不含该字符时，使用回退字体测量
+            const SkFont skCharFont = (pFontFallback != nullptr) ? pFontFallback->MatchFont(uni, *pSkFont) : *pSkFont;
+            const DUTF16Char chars[2] = { ch, horizontalChar.chLow };
+            SkScalar fTextWidth = skCharFont.measureText(chars,
+                                                         (horizontalChar.chLow != 0) ? sizeof(chars) : sizeof(DUTF16Char),
+                                                         SkTextEncoding::kUTF16,
+                                                         &horizontalChar.bounds,//斜体字时，这个宽度包含了外延的宽度
+                                                         skPaint);
             if ((horizontalChar.bounds.width() <= 0) || (horizontalChar.bounds.height() <= 0)) {
                 //空格或者不可见字符(按小写字母确定显示区域)
                 ch = 'a';
@@ -100,6 +121,18 @@ bool HorizontalDrawText::CalculateTextCharBounds(const UTF16String& textUTF16, c
             //用字体高度作为字的高度，所有字都等高
             horizontalChar.size = SkSize::Make(std::max(fTextWidth, horizontalChar.bounds.width()), (SkScalar)fFontHeight);
             charRects.push_back(horizontalChar);
+
+            if (horizontalChar.chLow != 0) {
+                //代理对的低位，保持与文本一一对应
+                THorizontalChar& lowChar = charRects.emplace_back();
+                lowChar.ch = horizontalChar.chLow;
+                lowChar.chLow = 0;
+                lowChar.bNewLine = false;
+                lowChar.bContinuation = true;
+                lowChar.size = SkSize::Make(0, (SkScalar)fFontHeight);
+                lowChar.bounds = SkRect::MakeEmpty();
+                ++nTextIndex;
+            }
         }
     }
     return (charRects.size() == textUTF16.size());
@@ -141,6 +174,10 @@ SkRect HorizontalDrawText::CalculateHorizontalTextBounds(const std::vector<THori
     const int32_t nCharCount = (int32_t)charRects.size();
     for (int32_t nCharIndex = 0; nCharIndex < nCharCount; ++nCharIndex) {
         const THorizontalChar& horizontalChar = charRects[nCharIndex];
+        if (horizontalChar.bContinuation) {
+            //代理对的低位，已经合并到前一个字符中
+            continue;
+        }
 
         // 处理换行
         if (!bSingleLineMode && (horizontalChar.bNewLine || bNextLine)) {
@@ -308,9 +345,9 @@ float HorizontalDrawText::CalculateDefaultCharWidth(const SkFont* pSkFont, const
 
 UiRect HorizontalDrawText::MeasureString(const DString& strText, const MeasureStringParam& measureParam)
 {
-    PerformanceStat statPerformance(_T("HorizontalDrawText::MeasureString"));
-    ASSERT((m_pSkCanvas != nullptr) && (m_pSkPaint != nullptr) && (m_pSkPointOrg != nullptr));
-    if ((m_pSkCanvas == nullptr) || (m_pSkPaint == nullptr) || (m_pSkPointOrg == nullptr)) {
+    //评估文本时不使用画布，可以在其他线程中调用（TextMeasure_Skia），所以此处不做性能统计
+    ASSERT(m_pSkPaint != nullptr);
+    if (m_pSkPaint == nullptr) {
         return UiRect();
     }
     ASSERT(!strText.empty());
@@ -333,6 +370,7 @@ UiRect HorizontalDrawText::MeasureString(const DString& strText, const MeasureSt
     if (pSkFont == nullptr) {
         return UiRect();
     }
+    FontFallback_Skia* pFontFallback = pSkiaFont->GetFontFallback();
 
     //绘制属性设置
     SkPaint skPaint = *m_pSkPaint;
@@ -351,7 +389,7 @@ UiRect HorizontalDrawText::MeasureString(const DString& strText, const MeasureSt
     const UTF16String textUTF16 = GetDrawStringUTF16(strText, bSingleLineMode);
 
     std::vector<THorizontalChar> charRects;
-    if (!CalculateTextCharBounds(textUTF16, pSkFont, &skPaint, (float)fFontHeight, charRects)) {
+    if (!CalculateTextCharBounds(textUTF16, pSkFont, pFontFallback, &skPaint, (float)fFontHeight, charRects)) {
         return UiRect();
     }
     ASSERT(charRects.size() == textUTF16.size());
@@ -415,6 +453,7 @@ void HorizontalDrawText::DrawString(const DString& strText, const DrawStringPara
     if (pSkFont == nullptr) {
         return;
     }
+    FontFallback_Skia* pFontFallback = pSkiaFont->GetFontFallback();
 
     // 设置绘制属性
     SkPaint skPaint = *m_pSkPaint;
@@ -458,7 +497,7 @@ void HorizontalDrawText::DrawString(const DString& strText, const DrawStringPara
     const UTF16String textUTF16 = GetDrawStringUTF16(strText, bSingleLineMode);
 
     std::vector<THorizontalChar> charRects;
-    if (!CalculateTextCharBounds(textUTF16, pSkFont, &skPaint, (float)fFontHeight, charRects)) {
+    if (!CalculateTextCharBounds(textUTF16, pSkFont, pFontFallback, &skPaint, (float)fFontHeight, charRects)) {
         return;
     }
     ASSERT(charRects.size() == textUTF16.size());
@@ -486,6 +525,7 @@ void HorizontalDrawText::DrawString(const DString& strText, const DrawStringPara
     struct TDrawCharPos
     {
         DUTF16Char ch = 0;          //字符
+        DUTF16Char chLow = 0;       //代理对的低位（0表示不是代理对）
         int32_t nRowIndex = 0;      //行序号
         int32_t nColumnIndex = 0;   //列序号
         SkScalar xPos = 0;          //绘制时的X坐标
@@ -522,6 +562,7 @@ void HorizontalDrawText::DrawString(const DString& strText, const DrawStringPara
 
             //记录该字符的绘制位置，处理对齐方式以后再绘制
             charPos.ch = horizontalChar.ch;
+            charPos.chLow = horizontalChar.chLow;
             charPos.nRowIndex = (int32_t)nRowIndex;
             charPos.nColumnIndex = (int32_t)nColIndex;
             charPos.chWidth = (int32_t)horizontalChar.size.width();
@@ -728,9 +769,23 @@ void HorizontalDrawText::DrawString(const DString& strText, const DrawStringPara
         }
 
         charPos.bDrew = true;
-        skCanvas->drawSimpleText(&charPos.ch, sizeof(charPos.ch), SkTextEncoding::kUTF16,
-                                 charPos.xPos, charPos.yPos,
-                                 *pSkFont, skPaint);
+        const DUTF16Char chars[2] = { charPos.ch, charPos.chLow };
+        const size_t nByteLength = (charPos.chLow != 0) ? sizeof(chars) : sizeof(DUTF16Char);
+        if (pFontFallback != nullptr) {
+            //基础字体中不含该字符时，使用回退字体绘制（代理对按完整的Unicode字符匹配）
+            SkUnichar uni = (SkUnichar)charPos.ch;
+            if (charPos.chLow != 0) {
+                uni = (((SkUnichar)charPos.ch - 0xD800) << 10) + ((SkUnichar)charPos.chLow - 0xDC00) + 0x10000;
+            }
+            skCanvas->drawSimpleText(chars, nByteLength, SkTextEncoding::kUTF16,
+                                     charPos.xPos, charPos.yPos,
+                                     pFontFallback->MatchFont(uni, *pSkFont), skPaint);
+        }
+        else {
+            skCanvas->drawSimpleText(chars, nByteLength, SkTextEncoding::kUTF16,
+                                     charPos.xPos, charPos.yPos,
+                                     *pSkFont, skPaint);
+        }
     }
 
     // 绘制下划线/删除线
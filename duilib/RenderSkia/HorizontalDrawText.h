@@ -15,6 +15,7 @@ namespace ui
 /** 横向绘制文本的字符属性
 */
 struct THorizontalChar;
+class FontFallback_Skia;
 
 /** 横向文本绘制的实现封装（从左到右，从上到下）
 */
@@ -27,7 +28,7 @@ public:
     ~HorizontalDrawText() = default;
 
 public:
-    /** 横向绘制文本的评估函数：文本绘制方向为从左到右，从上到下
+    /** 横向绘制文本的评估函数：文本绘制方向为从左到右，从上到下（不使用画布，构造时画布和视区原点可以为nullptr）
     * @param [in] strText 需要评估的文本内容
     * @param [in] measureParam 评估所需的参数
     */
@@ -47,11 +48,12 @@ private:
     /** 计算每个字符的绘制所占的矩形范围
     * @param [in] textUTF16 字符串
     * @param [in] pSkFont 字体
+    * @param [in] pFontFallback 字体回退（可以为nullptr）
     * @param [in] skPaint 绘制属性
     * @param [in] fFontHeight 字体高度
     */
-    bool CalculateTextCharBounds(const UTF16String& textUTF16, const SkFont* pSkFont, const SkPaint* skPaint,
-                                 float fFontHeight, std::vector<THorizontalChar>& charRects) const;
+    bool CalculateTextCharBounds(const UTF16String& textUTF16, const SkFont* pSkFont, FontFallback_Skia* pFontFallback,
+                                 const SkPaint* skPaint, float fFontHeight, std::vector<THorizontalChar>& charRects) const;
 
     /** 计算横向文本（从左到右、从上到下）的绘制区域总矩形
      * @param [in] charRects 每个字符的绘制矩形（宽或高为0表示换行）
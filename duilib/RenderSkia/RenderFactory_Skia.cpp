@@ -6,6 +6,8 @@
 #include "duilib/RenderSkia/Pen_Skia.h"
 #include "duilib/RenderSkia/Path_Skia.h"
 #include "duilib/RenderSkia/Matrix_Skia.h"
+#include "duilib/RenderSkia/TextMeasure_Skia.h"
+#include "duilib/RenderSkia/DrawRichText.h"
 
 #if defined (DUILIB_BUILD_FOR_SDL)
     #include "duilib/RenderSkia/Render_Skia_SDL.h"
@@ -21,6 +23,10 @@ public:
     /** Skia的字体管理器
     */
     std::shared_ptr<IFontMgr> m_pFontMgr;
+
+    /** 文本评估接口
+    */
+    std::unique_ptr<TextMeasure_Skia> m_pTextMeasure;
 };
 
 RenderFactory_Skia::RenderFactory_Skia()
@@ -30,6 +36,8 @@ RenderFactory_Skia::RenderFactory_Skia()
     //创建Skia的字体管理器对象，进程内唯一
     m_impl->m_pFontMgr = std::make_shared<FontMgr_Skia>();
     ASSERT(m_impl->m_pFontMgr != nullptr);
+
+    m_impl->m_pTextMeasure = std::make_unique<TextMeasure_Skia>();
 }
 
 RenderFactory_Skia::~RenderFactory_Skia()
@@ -96,4 +104,15 @@ IFontMgr* RenderFactory_Skia::GetFontMgr() const
     return m_impl->m_pFontMgr.get();
 }
 
+ITextMeasure* RenderFactory_Skia::GetTextMeasure() const
+{
+    ASSERT(m_impl->m_pTextMeasure != nullptr);
+    return m_impl->m_pTextMeasure.get();
+}
+
+size_t RenderFactory_Skia::GetDrawRichTextCacheBytes(const DrawRichTextCache& drawRichTextCache) const
+{
+    return DrawRichText::GetDrawRichTextCacheBytes(drawRichTextCache);
+}
+
 } // namespace ui
@@ -36,6 +36,14 @@ public:
     */
     virtual IFontMgr* GetFontMgr() const override;
 
+    /** 获取文本评估接口（每个factory共享一个对象，线程安全）
+    */
+    virtual ITextMeasure* GetTextMeasure() const override;
+
+    /** 获取RichText绘制缓存占用的内存（字节，按数据大小估算，用于内存统计）
+    */
+    virtual size_t GetDrawRichTextCacheBytes(const DrawRichTextCache& drawRichTextCache) const override;
+
 private:
     /** 内部实现类
     */
@@ -2,6 +2,7 @@
 #include "VerticalDrawText.h"
 #include "HorizontalDrawText.h"
 #include "DrawRichText.h"
+#include "TextMeasure_Skia.h"
 
 #include "SkUtils.h"
 #include "duilib/RenderSkia/Bitmap_Skia.h"
@@ -9,11 +10,13 @@
 #include "duilib/RenderSkia/Matrix_Skia.h"
 #include "duilib/RenderSkia/Font_Skia.h"
 #include "duilib/RenderSkia/SkTextBox.h"
+#include "duilib/RenderSkia/FontFallback_Skia.h"
 #include "duilib/RenderSkia/DrawSkiaImage.h"
 #include "duilib/Render/BitmapAlpha.h"
 
 #include "duilib/Utils/StringUtil.h"
 #include "duilib/Utils/PerformanceUtil.h"
+#include "duilib/Utils/ParallelUtil.h"
 #include "duilib/Core/SharePtr.h"
 
 #include "SkiaHeaderBegin.h"
@@ -22,8 +25,14 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkPixelRef.h"
+#include "include/core/SkData.h"
+#include "include/core/SkRSXform.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkBBHFactory.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathBuilder.h"
@@ -41,9 +50,77 @@
 
 #include <unordered_set>
 #include <unordered_map>
+#include <thread>
+
+//并行回放绘制命令时，分块的大小（像素）
+#define RECORD_PAINT_TILE_SIZE 256
+
+//并行回放绘制命令时，最多使用的线程数（包含当前线程）
+#define RECORD_PAINT_MAX_THREADS 8
 
 namespace ui {
 
+/** 合并绘制图片的数据
+*/
+struct Render_Skia::TDrawImageBatch
+{
+    //BeginDrawImageBatch的嵌套层数
+    int32_t m_nBatchLevel = 0;
+
+    //位图的像素数据（持有引用，确保完成绘制前位图数据有效）
+    sk_sp<SkPixelRef> m_spPixelRef;
+
+    //位图数据对应的图片
+    sk_sp<SkImage> m_skImage;
+
+    //透明度
+    uint8_t m_uFade = 255;
+
+    //每个图片的绘制位置
+    std::vector<SkRSXform> m_xforms;
+
+    //每个图片在位图中的区域
+    std::vector<SkRect> m_texRects;
+};
+
+/** 记录绘制命令的数据
+*/
+struct Render_Skia::TRecordPaint
+{
+    //是否正在记录绘制命令
+    bool m_bRecording = false;
+
+    //记录期间是否有直接访问位图数据的操作（如果有，记录的绘制命令无法按原顺序回放）
+    bool m_bInvalid = false;
+
+    //需要绘制的区域
+    UiRect m_rcPaint;
+
+    //绘制命令记录器
+    SkPictureRecorder m_skRecorder;
+};
+
+/** 从位图创建共享像素数据的图片（不复制像素数据）
+*   图片持有位图像素数据的引用，记录的绘制命令在回放时，即使原位图已经释放或者被替换，像素数据仍然有效
+*/
+static sk_sp<SkImage> MakeSkImageFromBitmap(const SkBitmap& skBitmap)
+{
+    SkPixmap skPixmap;
+    SkPixelRef* pPixelRef = skBitmap.pixelRef();
+    if ((pPixelRef != nullptr) && skBitmap.peekPixels(&skPixmap)) {
+        pPixelRef->ref();
+        sk_sp<SkData> skData = SkData::MakeWithProc(skPixmap.addr(), skPixmap.computeByteSize(),
+                                                    [](const void* /*ptr*/, void* pContext) {
+                                                        static_cast<SkPixelRef*>(pContext)->unref();
+                                                    }, pPixelRef);
+        sk_sp<SkImage> skImage = SkImages::RasterFromData(skPixmap.info(), skData, skPixmap.rowBytes());
+        if (skImage != nullptr) {
+            return skImage;
+        }
+    }
+    return skBitmap.asImage();
+}
+
 Render_Skia::Render_Skia():
     m_saveCount(0)
 {
@@ -52,6 +129,8 @@ Render_Skia::Render_Skia():
     m_pSkPaint = new SkPaint;
     m_pSkPaint->setAntiAlias(true);
     m_pSkPaint->setDither(true);
+    m_spDrawImageBatch = std::make_unique<TDrawImageBatch>();
+    m_spRecordPaint = std::make_unique<TRecordPaint>();
 }
 
 Render_Skia::~Render_Skia()
@@ -81,9 +160,126 @@ IRenderDpiPtr Render_Skia::GetRenderDpi() const
     return m_spRenderDpi;
 }
 
+SkCanvas* Render_Skia::GetDrawSkCanvas() const
+{
+    FlushDrawImageBatch();
+    return GetTargetSkCanvas();
+}
+
+SkCanvas* Render_Skia::GetTargetSkCanvas() const
+{
+    if (m_spRecordPaint->m_bRecording) {
+        return m_spRecordPaint->m_skRecorder.getRecordingCanvas();
+    }
+    return GetSkCanvas();
+}
+
+void Render_Skia::PrepareDirectPixelAccess() const
+{
+    FlushDrawImageBatch();
+    if (m_spRecordPaint->m_bRecording) {
+        m_spRecordPaint->m_bInvalid = true;
+    }
+    //位图数据将被直接修改：如果有图片快照与位图共享数据（比如记录的绘制命令中引用了该位图的快照），先复制一份
+    SkSurface* skSurface = GetSkSurface();
+    if (skSurface != nullptr) {
+        skSurface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+    }
+}
+
+void Render_Skia::BeginDrawImageBatch()
+{
+    ++m_spDrawImageBatch->m_nBatchLevel;
+}
+
+void Render_Skia::EndDrawImageBatch()
+{
+    TDrawImageBatch& batch = *m_spDrawImageBatch;
+    ASSERT(batch.m_nBatchLevel > 0);
+    if (batch.m_nBatchLevel > 0) {
+        --batch.m_nBatchLevel;
+    }
+    if (batch.m_nBatchLevel == 0) {
+        FlushDrawImageBatch();
+    }
+}
+
+bool Render_Skia::AddDrawImageBatch(IBitmap* pBitmap, const UiRect& rcDest, const UiRect& rcSource, uint8_t uFade)
+{
+    TDrawImageBatch& batch = *m_spDrawImageBatch;
+    if (batch.m_nBatchLevel <= 0) {
+        return false;
+    }
+    //仅合并图集位图（多个小图标共享同一个位图）的原大小绘制，独立位图逐个绘制即可
+    if ((pBitmap == nullptr) || !pBitmap->IsAtlasBitmap()) {
+        return false;
+    }
+    if (rcSource.IsEmpty() || (rcDest.Width() != rcSource.Width()) || (rcDest.Height() != rcSource.Height())) {
+        return false;
+    }
+    Bitmap_Skia* skiaBitmap = dynamic_cast<Bitmap_Skia*>(pBitmap);
+    if (skiaBitmap == nullptr) {
+        return false;
+    }
+    const SkBitmap& skSrcBitmap = skiaBitmap->GetSkBitmap();
+    SkPixelRef* pPixelRef = skSrcBitmap.pixelRef();
+    if (pPixelRef == nullptr) {
+        return false;
+    }
+    if ((batch.m_spPixelRef.get() != pPixelRef) || (batch.m_uFade != uFade)) {
+        //与已合并的图片不是同一个位图，先完成已合并的图片绘制
+        FlushDrawImageBatch();
+        sk_sp<SkImage> skImage = MakeSkImageFromBitmap(skSrcBitmap);
+        if (skImage == nullptr) {
+            return false;
+        }
+        batch.m_spPixelRef = sk_ref_sp(pPixelRef);
+        batch.m_skImage = skImage;
+        batch.m_uFade = uFade;
+    }
+    batch.m_xforms.push_back(SkRSXform::Make(1.0f, 0.0f,
+                                             SkIntToScalar(rcDest.left) + m_pSkPointOrg->fX,
+                                             SkIntToScalar(rcDest.top) + m_pSkPointOrg->fY));
+    batch.m_texRects.push_back(SkRect::MakeLTRB(SkIntToScalar(rcSource.left), SkIntToScalar(rcSource.top),
+                                                SkIntToScalar(rcSource.right), SkIntToScalar(rcSource.bottom)));
+    return true;
+}
+
+void Render_Skia::FlushDrawImageBatch() const
+{
+    TDrawImageBatch& batch = *m_spDrawImageBatch;
+    if (batch.m_xforms.empty()) {
+        return;
+    }
+    SkCanvas* skCanvas = GetTargetSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if ((skCanvas != nullptr) && (batch.m_skImage != nullptr)) {
+        PerformanceStat statPerformance(_T("Render_Skia::FlushDrawImageBatch"));
+        SkPaint skPaint = *m_pSkPaint;
+        if (batch.m_uFade != 0xFF) {
+            skPaint.setAlpha(batch.m_uFade);
+        }
+        skPaint.setBlendMode(SkBlendMode::kSrcOver);
+        //所有图片合并为一次drawAtlas调用（原大小绘制，无需插值采样）
+        skCanvas->drawAtlas(batch.m_skImage.get(),
+                            SkSpan<const SkRSXform>(batch.m_xforms.data(), batch.m_xforms.size()),
+                            SkSpan<const SkRect>(batch.m_texRects.data(), batch.m_texRects.size()),
+                            SkSpan<const SkColor>(),
+                            SkBlendMode::kModulate,
+                            SkSamplingOptions(),
+                            nullptr,
+                            &skPaint);
+    }
+    batch.m_xforms.clear();
+    batch.m_texRects.clear();
+    batch.m_skImage.reset();
+    batch.m_spPixelRef.reset();
+}
+
 void* Render_Skia::GetPixelBits() const
 {
     void* pPixelBits = nullptr;
+    PrepareDirectPixelAccess();
     SkCanvas* skCanvas = GetSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
@@ -187,6 +383,144 @@ void Render_Skia::RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowP
     }
 }
 
+bool Render_Skia::ScrollRect(const UiRect& rcScroll, int32_t dx, int32_t dy)
+{
+    if (GetRenderBackendType() != RenderBackendType::kRaster_BackendType) {
+        //GPU绘制方式，位图数据在绘制之间不保留
+        return false;
+    }
+    const int32_t nWidth = GetWidth();
+    const int32_t nHeight = GetHeight();
+    UiRect rcSrc = rcScroll;
+    rcSrc.Intersect(UiRect(0, 0, nWidth, nHeight));
+    if (rcSrc.IsEmpty() || ((dx == 0) && (dy == 0))) {
+        return false;
+    }
+    if ((std::abs(dx) >= rcSrc.Width()) || (std::abs(dy) >= rcSrc.Height())) {
+        //平移后不再有可复用的内容
+        return false;
+    }
+    uint32_t* pPixelBits = (uint32_t*)GetPixelBits();
+    if (pPixelBits == nullptr) {
+        return false;
+    }
+    //目标区域：平移后仍在矩形区域内的部分
+    UiRect rcDest = rcSrc;
+    rcDest.Offset(dx, dy);
+    rcDest.Intersect(rcSrc);
+    const size_t nRowBytes = (size_t)rcDest.Width() * sizeof(uint32_t);
+    if (dy > 0) {
+        //向下平移，从下往上复制，避免覆盖未复制的数据
+        for (int32_t y = rcDest.bottom - 1; y >= rcDest.top; --y) {
+            ::memmove(pPixelBits + (size_t)y * nWidth + rcDest.left,
+                      pPixelBits + (size_t)(y - dy) * nWidth + (rcDest.left - dx), nRowBytes);
+        }
+    }
+    else {
+        for (int32_t y = rcDest.top; y < rcDest.bottom; ++y) {
+            ::memmove(pPixelBits + (size_t)y * nWidth + rcDest.left,
+                      pPixelBits + (size_t)(y - dy) * nWidth + (rcDest.left - dx), nRowBytes);
+        }
+    }
+    return true;
+}
+
+bool Render_Skia::BeginRecordPaint(const UiRect& rcPaint)
+{
+    TRecordPaint& record = *m_spRecordPaint;
+    ASSERT(!record.m_bRecording);
+    if (record.m_bRecording) {
+        return false;
+    }
+    if (GetRenderBackendType() != RenderBackendType::kRaster_BackendType) {
+        //GPU绘制方式，不需要并行回放
+        return false;
+    }
+    UiRect rcRecord = rcPaint;
+    rcRecord.Intersect(UiRect(0, 0, GetWidth(), GetHeight()));
+    if (rcRecord.IsEmpty()) {
+        return false;
+    }
+    //先完成已合并的图片绘制，再开始记录
+    FlushDrawImageBatch();
+    SkRTreeFactory skRTreeFactory;
+    SkCanvas* skRecordCanvas = record.m_skRecorder.beginRecording(SkRect::MakeIWH(GetWidth(), GetHeight()), &skRTreeFactory);
+    ASSERT(skRecordCanvas != nullptr);
+    if (skRecordCanvas == nullptr) {
+        return false;
+    }
+    //记录的坐标与位图坐标一致，只记录需要绘制的区域
+    skRecordCanvas->clipIRect(SkIRect::MakeLTRB(rcRecord.left, rcRecord.top, rcRecord.right, rcRecord.bottom));
+    record.m_rcPaint = rcRecord;
+    record.m_bInvalid = false;
+    record.m_bRecording = true;
+    return true;
+}
+
+bool Render_Skia::EndRecordPaint()
+{
+    TRecordPaint& record = *m_spRecordPaint;
+    ASSERT(record.m_bRecording);
+    if (!record.m_bRecording) {
+        return false;
+    }
+    //已合并的图片绘制也需要记录
+    FlushDrawImageBatch();
+    record.m_bRecording = false;
+    sk_sp<SkPicture> skPicture = record.m_skRecorder.finishRecordingAsPicture();
+    if (record.m_bInvalid || (skPicture == nullptr)) {
+        record.m_bInvalid = false;
+        return false;
+    }
+    PerformanceStat statPerformance(_T("PaintWindow, Render_Skia::EndRecordPaint"));
+    PlaybackRecordPaint(skPicture.get(), record.m_rcPaint);
+    return true;
+}
+
+void Render_Skia::PlaybackRecordPaint(const SkPicture* skPicture, const UiRect& rcPaint)
+{
+    ASSERT(skPicture != nullptr);
+    SkCanvas* skCanvas = GetSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if ((skPicture == nullptr) || (skCanvas == nullptr)) {
+        return;
+    }
+    //将绘制区域分块
+    std::vector<SkIRect> tiles;
+    for (int32_t y = rcPaint.top; y < rcPaint.bottom; y += RECORD_PAINT_TILE_SIZE) {
+        for (int32_t x = rcPaint.left; x < rcPaint.right; x += RECORD_PAINT_TILE_SIZE) {
+            tiles.push_back(SkIRect::MakeLTRB(x, y,
+                                              std::min(x + RECORD_PAINT_TILE_SIZE, (int32_t)rcPaint.right),
+                                              std::min(y + RECORD_PAINT_TILE_SIZE, (int32_t)rcPaint.bottom)));
+        }
+    }
+    size_t nThreadCount = std::min((size_t)std::thread::hardware_concurrency(), (size_t)RECORD_PAINT_MAX_THREADS);
+    nThreadCount = std::min(nThreadCount, tiles.size());
+
+    SkPixmap pixmap;
+    if ((nThreadCount <= 1) || !skCanvas->peekPixels(&pixmap)) {
+        //不满足并行条件，直接在当前线程回放
+        skCanvas->save();
+        skCanvas->clipIRect(SkIRect::MakeLTRB(rcPaint.left, rcPaint.top, rcPaint.right, rcPaint.bottom));
+        skCanvas->drawPicture(skPicture);
+        skCanvas->restore();
+        return;
+    }
+
+    //各个线程使用各自的SkCanvas直接绘制到位图数据中，分块之间互不重叠
+    SkSurface* skSurface = GetSkSurface();
+    if (skSurface != nullptr) {
+        skSurface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+    }
+    ParallelUtil::ParallelFor(tiles.size(), nThreadCount, [&tiles, &pixmap, skPicture](size_t nTile) {
+            std::unique_ptr<SkCanvas> skTileCanvas = SkCanvas::MakeRasterDirect(pixmap.info(), pixmap.writable_addr(), pixmap.rowBytes());
+            if (skTileCanvas != nullptr) {
+                skTileCanvas->clipIRect(tiles[nTile]);
+                skTileCanvas->drawPicture(skPicture);
+            }
+        });
+}
+
 UiPoint Render_Skia::OffsetWindowOrg(UiPoint ptOffset)
 {
     UiPoint ptOldWindowOrg = { SkScalarTruncToInt(m_pSkPointOrg->fX), SkScalarTruncToInt(m_pSkPointOrg->fY) };
@@ -211,7 +545,7 @@ UiPoint Render_Skia::GetWindowOrg() const
 
 void Render_Skia::SaveClip(int32_t& nState)
 {
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         m_saveCount = skCanvas->save();
@@ -221,7 +555,7 @@ void Render_Skia::SaveClip(int32_t& nState)
 
 void Render_Skia::RestoreClip(int32_t nState)
 {
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     ASSERT(m_saveCount == nState);
     if (m_saveCount != nState) {
@@ -238,7 +572,7 @@ void Render_Skia::SetClip(const UiRect& rc, bool bIntersect)
     SkRect rcSk = SkRect::Make(rcSkI);
     rcSk.offset(*m_pSkPointOrg);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->save();
@@ -263,7 +597,29 @@ void Render_Skia::SetRoundClip(const UiRect& rc, float rx, float ry, bool bInter
     rgn.setPath(skPath, clip);
     rgn.translate((int)m_pSkPointOrg->fX, (int)m_pSkPointOrg->fY);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
+    ASSERT(skCanvas != nullptr);
+    if (skCanvas != nullptr) {
+        skCanvas->save();
+        if (bIntersect) {
+            skCanvas->clipRegion(rgn, SkClipOp::kIntersect);
+        }
+        else {
+            skCanvas->clipRegion(rgn, SkClipOp::kDifference);
+        }
+    }
+}
+
+void Render_Skia::SetRegionClip(const std::vector<UiRect>& rcRegion, bool bIntersect)
+{
+    SkRegion rgn;
+    for (const UiRect& rc : rcRegion) {
+        SkIRect rcSkI = { rc.left, rc.top, rc.right, rc.bottom };
+        rgn.op(rcSkI, SkRegion::kUnion_Op);
+    }
+    rgn.translate((int)m_pSkPointOrg->fX, (int)m_pSkPointOrg->fY);
+
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->save();
@@ -278,7 +634,7 @@ void Render_Skia::SetRoundClip(const UiRect& rc, float rx, float ry, bool bInter
 
 void Render_Skia::ClearClip()
 {
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->restore();
@@ -332,7 +688,7 @@ bool Render_Skia::BitBlt(int32_t x, int32_t y, int32_t cx, int32_t cy, IRender*
     SkIRect rcSkSrcI = SkIRect::MakeXYWH(xSrc, ySrc, cx, cy);
     SkRect rcSkSrc = SkRect::Make(rcSkSrcI);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawImageRect(skSrcImage, rcSkSrc, rcSkDest, SkSamplingOptions(), &skPaint, SkCanvas::kFast_SrcRectConstraint);
@@ -376,7 +732,7 @@ bool Render_Skia::StretchBlt(int32_t xDest, int32_t yDest, int32_t widthDest, in
     SkIRect rcSkSrcI = SkIRect::MakeXYWH(xSrc, ySrc, widthSrc, heightSrc);
     SkRect rcSkSrc = SkRect::Make(rcSkSrcI);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawImageRect(skSrcImage, rcSkSrc, rcSkDest, SkSamplingOptions(), &skPaint, SkCanvas::kFast_SrcRectConstraint);
@@ -422,7 +778,7 @@ bool Render_Skia::AlphaBlend(int32_t xDest, int32_t yDest, int32_t widthDest, in
     SkIRect rcSkSrcI = SkIRect::MakeXYWH(xSrc, ySrc, widthSrc, heightSrc);
     SkRect rcSkSrc = SkRect::Make(rcSkSrcI);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawImageRect(skSrcImage, rcSkSrc, rcSkDest, SkSamplingOptions(), &skPaint, SkCanvas::kFast_SrcRectConstraint);
@@ -509,7 +865,13 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
     if (pBitmap == nullptr) {
         return;
     }
-    SkCanvas* skCanvas = GetSkCanvas();
+    if (rcDestCorners.IsZero() && rcSourceCorners.IsZero() &&
+        ((pTiledDrawParam == nullptr) || (!pTiledDrawParam->m_bTiledX && !pTiledDrawParam->m_bTiledY)) &&
+        AddDrawImageBatch(pBitmap, rcDest, rcSource, uFade)) {
+        //已添加到合并绘制列表
+        return;
+    }
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas == nullptr) {
         return;
@@ -521,14 +883,7 @@ void Render_Skia::DrawImage(const UiRect& rcPaint, IBitmap* pBitmap,
     }
     
     const SkBitmap& skSrcBitmap = skiaBitmap->GetSkBitmap();
-    SkPixmap skSrcPixmap;
-    sk_sp<SkImage> skImage;
-    if (skSrcBitmap.peekPixels(&skSrcPixmap)) {
-        skImage = SkImages::RasterFromPixmap(skSrcPixmap, nullptr, nullptr);
-    }
-    if (skImage == nullptr) {
-        skImage = skSrcBitmap.asImage();
-    }
+    sk_sp<SkImage> skImage = MakeSkImageFromBitmap(skSrcBitmap);
 
     UiRect rcTemp;
     UiRect rcDrawSource;
@@ -876,8 +1231,12 @@ void Render_Skia::DrawImageRect(const UiRect& rcPaint, IBitmap* pBitmap,
     if (pBitmap == nullptr) {
         return;
     }
+    if ((pMatrix == nullptr) && AddDrawImageBatch(pBitmap, rcDest, rcSource, uFade)) {
+        //已添加到合并绘制列表
+        return;
+    }
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas == nullptr) {
         return;
@@ -897,14 +1256,7 @@ void Render_Skia::DrawImageRect(const UiRect& rcPaint, IBitmap* pBitmap,
         return;
     }
     const SkBitmap& skSrcBitmap = skiaBitmap->GetSkBitmap();
-    SkPixmap skSrcPixmap;
-    sk_sp<SkImage> skImage;
-    if (skSrcBitmap.peekPixels(&skSrcPixmap)) {
-        skImage = SkImages::RasterFromPixmap(skSrcPixmap, nullptr, nullptr);
-    }
-    if (skImage == nullptr) {
-        skImage = skSrcBitmap.asImage();
-    }
+    sk_sp<SkImage> skImage = MakeSkImageFromBitmap(skSrcBitmap);
 
     bool isMatrixSet = false;
     if (pMatrix != nullptr) {
@@ -933,7 +1285,7 @@ void Render_Skia::FillRect(const UiRectF& rc, UiColor dwColor, uint8_t uFade)
     SkRect rcSkDest = SkRect::MakeLTRB(rc.left, rc.top, rc.right, rc.bottom);
     rcSkDest.offset(*m_pSkPointOrg);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawRect(rcSkDest, skPaint);
@@ -993,7 +1345,7 @@ void Render_Skia::FillRect(const UiRectF& rc, UiColor dwColor, UiColor dwColor2,
 
     InitGradientColor(skPaint, rc, dwColor, dwColor2, nColor2Direction);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawRect(rcSkDest, skPaint);
@@ -1014,7 +1366,7 @@ void Render_Skia::DrawLine(const UiPointF& pt1, const UiPointF& pt2, UiColor pen
     SkPoint skPt2 = SkPoint::Make(pt2.x, pt2.y);
     skPt2.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawLine(skPt1, skPt2, skPaint);
@@ -1037,7 +1389,7 @@ void Render_Skia::DrawLine(const UiPointF& pt1, const UiPointF& pt2, IPen* pen)
     SkPoint skPt2 = SkPoint::Make(pt2.x, pt2.y);
     skPt2.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawLine(skPt1, skPt2, skPaint);
@@ -1063,7 +1415,7 @@ void Render_Skia::DrawRect(const UiRectF& rc, UiColor penColor, float fWidth, bo
     }
     rcSkDest.offset(*m_pSkPointOrg);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawRect(rcSkDest, skPaint);
@@ -1091,7 +1443,7 @@ void Render_Skia::DrawRect(const UiRectF& rc, IPen* pen, bool bLineInRect)
     }
     rcSkDest.offset(*m_pSkPointOrg);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawRect(rcSkDest, skPaint);
@@ -1109,7 +1461,7 @@ void Render_Skia::DrawRoundRect(const UiRectF& rc, float rx, float ry, UiColor p
     SkRect rcSkDest = SkRect::MakeLTRB(rc.left, rc.top, rc.right, rc.bottom);
     rcSkDest.offset(*m_pSkPointOrg);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawRoundRect(rcSkDest, rx, ry, skPaint);
@@ -1129,7 +1481,7 @@ void Render_Skia::DrawRoundRect(const UiRectF& rc, float rx, float ry, IPen* pen
     SkRect rcSkDest = SkRect::MakeLTRB(rc.left, rc.top, rc.right, rc.bottom);
     rcSkDest.offset(*m_pSkPointOrg);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawRoundRect(rcSkDest, rx, ry, skPaint);
@@ -1149,7 +1501,7 @@ void Render_Skia::FillRoundRect(const UiRectF& rc, float rx, float ry, UiColor d
     SkRect rcSkDest = SkRect::MakeLTRB(rc.left, rc.top, rc.right, rc.bottom);
     rcSkDest.offset(*m_pSkPointOrg);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawRoundRect(rcSkDest, rx, ry, skPaint);
@@ -1174,7 +1526,7 @@ void Render_Skia::FillRoundRect(const UiRectF& rc, float rx, float ry, UiColor d
 
     InitGradientColor(skPaint, rc, dwColor, dwColor2, nColor2Direction);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawRoundRect(rcSkDest, rx, ry, skPaint);
@@ -1192,7 +1544,7 @@ void Render_Skia::DrawCircle(const UiPointF& centerPt, float radius, UiColor pen
     SkPoint rcSkPoint = SkPoint::Make(centerPt.x, centerPt.y);
     rcSkPoint.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawCircle(rcSkPoint.fX, rcSkPoint.fY, radius, skPaint);
@@ -1212,7 +1564,7 @@ void Render_Skia::DrawCircle(const UiPointF& centerPt, float radius, IPen* pen)
     SkPoint rcSkPoint = SkPoint::Make(centerPt.x, centerPt.y);
     rcSkPoint.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawCircle(rcSkPoint.fX, rcSkPoint.fY, radius, skPaint);
@@ -1232,7 +1584,7 @@ void Render_Skia::FillCircle(const UiPointF& centerPt, float radius, UiColor dwC
     SkPoint rcSkPoint = SkPoint::Make(centerPt.x, centerPt.y);
     rcSkPoint.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY);
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawCircle(rcSkPoint.fX, rcSkPoint.fY, radius, skPaint);
@@ -1274,7 +1626,7 @@ void Render_Skia::DrawArc(const UiRect& rc, float startAngle, float sweepAngle,
         paint.setShader(shaderA);
     }
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawArc(ovalRect, startAngle, sweepAngle, useCenter, paint);
@@ -1300,7 +1652,7 @@ void Render_Skia::DrawPath(const IPath* path, const IPen* pen)
     SkPathBuilder skPathBuilder = *pSkiaPath->GetSkPathBuilder();
     skPathBuilder.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY);
     SkPath skPath = skPathBuilder.snapshot();
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawPath(skPath, paint);
@@ -1437,7 +1789,7 @@ void Render_Skia::FillPath(const IPath* path, const IBrush* brush)
     skPathBuilder.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY);
     SkPath skPath = skPathBuilder.snapshot();
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawPath(skPath, paint);
@@ -1465,7 +1817,7 @@ void Render_Skia::FillPath(const IPath* path, const UiRectF& rc, UiColor dwColor
     skPathBuilder.offset(m_pSkPointOrg->fX, m_pSkPointOrg->fY);
     SkPath skPath = skPathBuilder.snapshot();
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas != nullptr) {
         skCanvas->drawPath(skPath, skPaint);
@@ -1480,12 +1832,12 @@ void Render_Skia::DrawString(const DString& strText, const DrawStringParam& draw
     }
     if (drawParam.uFormat & TEXT_VERTICAL) {
         //纵向绘制文本
-        VerticalDrawText drawTextUtil(GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+        VerticalDrawText drawTextUtil(GetDrawSkCanvas(), m_pSkPaint, m_pSkPointOrg);
         return drawTextUtil.DrawString(strText, drawParam);
     }
     else if ((drawParam.uFormat & TEXT_HJUSTIFY) || (drawParam.fWordSpacing > 0.0001f)) {
         //当横向文本，对齐方式设置为两端对齐时，或者设置了字间距时，使用该实现方案（因为修改SkTextBox的实现比较困难，维护难度高）
-        HorizontalDrawText drawTextUtil(GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+        HorizontalDrawText drawTextUtil(GetDrawSkCanvas(), m_pSkPaint, m_pSkPointOrg);
         return drawTextUtil.DrawString(strText, drawParam);
     }
 
@@ -1503,7 +1855,7 @@ void Render_Skia::DrawString(const DString& strText, const DrawStringParam& draw
         return;
     }
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas == nullptr) {
         return;
@@ -1542,6 +1894,8 @@ void Render_Skia::DrawString(const DString& strText, const DrawStringParam& draw
     //设置绘制属性
     SkTextBox skTextBox;
     skTextBox.setBox(rcSkDest);
+    //字体回退（基础字体中不含的字符，使用匹配的回退字体绘制）
+    skTextBox.setFontFallback(pSkiaFont->GetFontFallback());
     if (drawParam.uFormat & DrawStringFormat::TEXT_SINGLELINE) {
         //单行文本
         skTextBox.setLineMode(SkTextBox::kOneLine_Mode);
@@ -1611,142 +1965,8 @@ UiRect Render_Skia::MeasureString(const DString& strText, const MeasureStringPar
         //这种情况是窗口大小为0的情况，返回空，不加断言
         return UiRect();
     }
-    if (measureParam.uFormat & TEXT_VERTICAL) {
-        //纵向绘制文本
-        VerticalDrawText drawTextUtil(GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
-        return drawTextUtil.MeasureString(strText, measureParam);
-    }
-    else if ((measureParam.uFormat & TEXT_HJUSTIFY) || (measureParam.fWordSpacing > 0.0001f)) {
-        //当横向文本，对齐方式设置为两端对齐时，或者设置了字间距时，使用该实现方案（因为修改SkTextBox的实现比较困难，维护难度高）
-        HorizontalDrawText drawTextUtil(GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
-        return drawTextUtil.MeasureString(strText, measureParam);
-    }
-
-    PerformanceStat statPerformance(_T("Render_Skia::MeasureString"));    
-    ASSERT(!strText.empty());
-    if (strText.empty()) {
-        return UiRect();
-    }
-    ASSERT(measureParam.pFont != nullptr);
-    if (measureParam.pFont == nullptr) {
-        return UiRect();
-    }
-
-    SkCanvas* skCanvas = GetSkCanvas();
-    ASSERT(skCanvas != nullptr);
-    if (skCanvas == nullptr) {
-        return UiRect();
-    }
-
-    //获取字体接口
-    Font_Skia* pSkiaFont = dynamic_cast<Font_Skia*>(measureParam.pFont);
-    ASSERT(pSkiaFont != nullptr);
-    if (pSkiaFont == nullptr) {
-        return UiRect();
-    }
-    const SkFont* pSkFont = pSkiaFont->GetFontHandle();
-    ASSERT(pSkFont != nullptr);
-    if (pSkFont == nullptr) {
-        return UiRect();
-    }
-
-    //绘制属性设置
-    SkPaint skPaint = *m_pSkPaint;
-
-    bool bSingleLineMode = false;
-    if (measureParam.uFormat & DrawStringFormat::TEXT_SINGLELINE) {
-        bSingleLineMode = true;
-    }
-        
-    //计算行高
-    SkFontMetrics fontMetrics;
-    SkScalar fontHeight = pSkFont->getMetrics(&fontMetrics);
-
-    if (bSingleLineMode) {
-        //单行模式
-        SkRect bounds; //斜体字时，这个宽度包含了外延的宽度
-        SkScalar textWidth = pSkFont->measureText(strText.c_str(),
-                                                  strText.size() * sizeof(DString::value_type),
-                                                  GetTextEncoding(),
-                                                  &bounds,
-                                                  &skPaint);
-        textWidth = std::max(textWidth, bounds.width());
-        int textIWidth = SkScalarTruncToInt(textWidth + 0.5f);
-        if (textWidth > textIWidth) {
-            textIWidth += 1;
-        }
-        if (textIWidth <= 0) {
-            return UiRect();
-        }
-        UiRect rc;
-        rc.left = 0;
-        rc.right = textIWidth;
-        rc.top = 0;
-        rc.bottom = SkScalarTruncToInt(fontHeight + 0.5f);
-        if (fontHeight > rc.bottom) {
-            rc.bottom += 1;
-        }
-        return rc;
-    }
-    else {
-        //多行模式
-        int32_t nRectWidth = measureParam.rectSize;
-        if (nRectWidth <= 0) {
-            nRectWidth = INT32_MAX;
-        }
-        std::vector<size_t> lineLenList; //每行文本数据的长度（字节）
-        int lineCount = SkTextLineBreaker::CountLines((const char*)strText.c_str(),
-                                                      strText.size() * sizeof(DString::value_type),
-                                                      GetTextEncoding(),
-                                                      *pSkFont,
-                                                      skPaint,
-                                                      SkScalar(nRectWidth),
-                                                      SkTextBox::kWordBreak_Mode,
-                                                      &lineLenList);
-        //计算所需宽度
-        int32_t textWidth = 0;
-        ASSERT((int)lineLenList.size() == lineCount);
-        if (!lineLenList.empty()) {
-            std::vector<DString> lineTextList; //每行的文本
-            size_t nTextPos = 0;
-            for (size_t len : lineLenList) {
-                ASSERT((len % sizeof(DString::value_type)) == 0);
-                size_t nTextLen = len / sizeof(DString::value_type);
-                lineTextList.push_back(strText.substr(nTextPos, nTextLen));
-                nTextPos += nTextLen;
-            }
-            for (const DString& lineText : lineTextList) {
-                //按单行评估每行文本，取最大宽度
-                SkRect bounds; //斜体字时，这个宽度包含了外延的宽度
-                SkScalar lineTextLen = pSkFont->measureText(lineText.c_str(),
-                                                            lineText.size() * sizeof(DString::value_type),
-                                                            GetTextEncoding(),
-                                                            &bounds,
-                                                            &skPaint);
-                lineTextLen = std::max(lineTextLen, bounds.width());
-                int32_t lineTextIWidth = SkScalarTruncToInt(lineTextLen + 0.5f);
-                if (lineTextLen > lineTextIWidth) {
-                    lineTextIWidth += 1;
-                }
-                textWidth = std::max(textWidth, lineTextIWidth);
-            }
-        }
-        float spacingMul = 1.0f;//行间距倍数，暂不支持设置
-        SkScalar scaledSpacing = fontHeight * spacingMul;
-        SkScalar textHeight = fontHeight;
-        if (lineCount > 0) {
-            textHeight += scaledSpacing * (lineCount - 1);
-        }
-        UiRect rc;
-        rc.left = 0;
-        rc.right = textWidth;
-        rc.top = 0;
-        rc.bottom = SkScalarTruncToInt(textHeight + 0.5f);
-        if (textHeight > rc.bottom) {
-            rc.bottom += 1;
-        }
-        return rc;
-    }
+    PerformanceStat statPerformance(_T("Render_Skia::MeasureString"));
+    return TextMeasure_Skia::MeasureString(*m_pSkPaint, strText, measureParam);
 }
 
 void Render_Skia::MeasureRichText(const UiRect& textRect,
@@ -1756,7 +1976,7 @@ void Render_Skia::MeasureRichText(const UiRect& textRect,
                                   std::vector<std::vector<UiRect>>* pRichTextRects)
 {
     PerformanceStat statPerformance(_T("Render_Skia::MeasureRichText"));
-    ui::DrawRichText drawRichText(this, GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+    ui::DrawRichText drawRichText(this, GetDrawSkCanvas(), m_pSkPaint, m_pSkPointOrg);
     drawRichText.InternalDrawRichText(textRect, szScrollOffset, pRenderFactory, richTextData, 255, true, nullptr, nullptr, pRichTextRects);
 }
 
@@ -1768,7 +1988,7 @@ void Render_Skia::MeasureRichText2(const UiRect& textRect,
                                    std::vector<std::vector<UiRect>>* pRichTextRects)
 {
     PerformanceStat statPerformance(_T("Render_Skia::MeasureRichText2"));
-    ui::DrawRichText drawRichText(this, GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+    ui::DrawRichText drawRichText(this, GetDrawSkCanvas(), m_pSkPaint, m_pSkPointOrg);
     drawRichText.InternalDrawRichText(textRect, szScrollOffset, pRenderFactory, richTextData, 255, true, pLineInfoParam, nullptr, pRichTextRects);
 }
 
@@ -1781,7 +2001,7 @@ void Render_Skia::MeasureRichText3(const UiRect& textRect,
                                    std::vector<std::vector<UiRect>>* pRichTextRects)
 {
     PerformanceStat statPerformance(_T("Render_Skia::MeasureRichText3"));
-    ui::DrawRichText drawRichText(this, GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+    ui::DrawRichText drawRichText(this, GetDrawSkCanvas(), m_pSkPaint, m_pSkPointOrg);
     drawRichText.InternalDrawRichText(textRect, szScrollOffset, pRenderFactory, richTextData, 255, true, pLineInfoParam, &spDrawRichTextCache, pRichTextRects);
 }
 
@@ -1793,7 +2013,7 @@ void Render_Skia::DrawRichText(const UiRect& textRect,
                                std::vector<std::vector<UiRect>>* pRichTextRects)
 {
     PerformanceStat statPerformance(_T("Render_Skia::DrawRichText"));
-    ui::DrawRichText drawRichText(this, GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+    ui::DrawRichText drawRichText(this, GetDrawSkCanvas(), m_pSkPaint, m_pSkPointOrg);
     drawRichText.InternalDrawRichText(textRect, szScrollOffset, pRenderFactory, richTextData, uFade, false, nullptr, nullptr, pRichTextRects);
 }
 
@@ -1805,7 +2025,7 @@ bool Render_Skia::CreateDrawRichTextCache(const UiRect& textRect,
 {
     PerformanceStat statPerformance(_T("Render_Skia::CreateDrawRichTextCache"));
     spDrawRichTextCache.reset();
-    ui::DrawRichText drawRichText(this, GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+    ui::DrawRichText drawRichText(this, GetDrawSkCanvas(), m_pSkPaint, m_pSkPointOrg);
     drawRichText.InternalDrawRichText(textRect, szScrollOffset, pRenderFactory, richTextData, 255, true, nullptr, &spDrawRichTextCache, nullptr);
     return spDrawRichTextCache != nullptr;
 }
@@ -1814,7 +2034,7 @@ bool Render_Skia::IsValidDrawRichTextCache(const UiRect& textRect,
                                            const std::vector<RichTextData>& richTextData,
                                            const std::shared_ptr<DrawRichTextCache>& spDrawRichTextCache)
 {
-    ui::DrawRichText drawRichText(this, GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+    ui::DrawRichText drawRichText(this, GetDrawSkCanvas(), m_pSkPaint, m_pSkPointOrg);
     return drawRichText.IsValidDrawRichTextCache(textRect, richTextData, spDrawRichTextCache);
 }
 
@@ -1829,7 +2049,7 @@ bool Render_Skia::UpdateDrawRichTextCache(std::shared_ptr<DrawRichTextCache>& sp
                                           const std::vector<int32_t>& rowRectTopList)
 {
     PerformanceStat statPerformance(_T("Render_Skia::UpdateDrawRichTextCache"));
-    ui::DrawRichText drawRichText(this, GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+    ui::DrawRichText drawRichText(this, GetDrawSkCanvas(), m_pSkPaint, m_pSkPointOrg);
     return drawRichText.UpdateDrawRichTextCache(spOldDrawRichTextCache,
                                                 spUpdateDrawRichTextCache,
                                                 richTextDataNew,
@@ -1843,7 +2063,7 @@ bool Render_Skia::UpdateDrawRichTextCache(std::shared_ptr<DrawRichTextCache>& sp
 
 bool Render_Skia::IsDrawRichTextCacheEqual(const DrawRichTextCache& first, const DrawRichTextCache& second) const
 {
-    ui::DrawRichText drawRichText(const_cast<Render_Skia*>(this), GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+    ui::DrawRichText drawRichText(const_cast<Render_Skia*>(this), GetDrawSkCanvas(), m_pSkPaint, m_pSkPointOrg);
     return drawRichText.IsDrawRichTextCacheEqual(first, second);
 }
 
@@ -1854,7 +2074,7 @@ void Render_Skia::DrawRichTextCacheData(const std::shared_ptr<DrawRichTextCache>
                                         uint8_t uFade,
                                         std::vector<std::vector<UiRect>>* pRichTextRects)
 {
-    ui::DrawRichText drawRichText(this, GetSkCanvas(), m_pSkPaint, m_pSkPointOrg);
+    ui::DrawRichText drawRichText(this, GetDrawSkCanvas(), m_pSkPaint, m_pSkPointOrg);
     return drawRichText.DrawRichTextCacheData(spDrawRichTextCache,
                                               rcNewTextRect,
                                               szNewScrollOffset,
@@ -1891,7 +2111,7 @@ void Render_Skia::DrawBoxShadow(const UiRect& rc,
         nBlurRadius = 0;
     }
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas == nullptr) {
         return;
@@ -1965,6 +2185,7 @@ bool Render_Skia::ReadPixels(const UiRect& rc, void* dstPixels, size_t dstPixels
         return false;
     }
 
+    PrepareDirectPixelAccess();
     SkCanvas* skCanvas = GetSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas == nullptr) {
@@ -1994,6 +2215,7 @@ bool Render_Skia::WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect
         return false;
     }
 
+    PrepareDirectPixelAccess();
     SkCanvas* skCanvas = GetSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas == nullptr) {
@@ -2027,6 +2249,7 @@ bool Render_Skia::WritePixels(void* srcPixels, size_t srcPixelsLen, const UiRect
         return false;
     }
 
+    PrepareDirectPixelAccess();
     SkCanvas* skCanvas = GetSkCanvas();
     ASSERT(skCanvas != nullptr);
     if (skCanvas == nullptr) {
@@ -2066,7 +2289,7 @@ RenderClipType Render_Skia::GetClipInfo(std::vector<UiRect>& clipRects)
     RenderClipType clipType = RenderClipType::kEmpty;
     clipRects.clear();
 
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     if (skCanvas != nullptr) {
         if (skCanvas->isClipEmpty()) {
             clipType = RenderClipType::kEmpty;
@@ -2107,7 +2330,7 @@ RenderClipType Render_Skia::GetClipInfo(std::vector<UiRect>& clipRects)
 
 bool Render_Skia::IsClipEmpty() const
 {
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     if ((skCanvas != nullptr) && (skCanvas->isClipEmpty())) {
         return true;
     }
@@ -2116,7 +2339,7 @@ bool Render_Skia::IsClipEmpty() const
 
 bool Render_Skia::IsEmpty() const
 {
-    SkCanvas* skCanvas = GetSkCanvas();
+    SkCanvas* skCanvas = GetDrawSkCanvas();
     return (skCanvas != nullptr) && (GetWidth() > 0) && (GetHeight() > 0);
 }
 
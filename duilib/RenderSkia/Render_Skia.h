@@ -3,10 +3,12 @@
 
 #include "duilib/Render/IRender.h"
 #include "duilib/Core/Callback.h"
+#include <memory>
 
 //Skia相关类的前置声明
 class SkSurface;
 class SkCanvas;
+class SkPicture;
 struct SkPoint;
 class SkPaint;
 enum class SkTextEncoding;
@@ -37,6 +39,9 @@ public:
     virtual void ClearAlpha(const UiRect& rcDirty, uint8_t alpha = 0) override;
     virtual void RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding, uint8_t alpha) override;
     virtual void RestoreAlpha(const UiRect& rcDirty, const UiPadding& rcShadowPadding = UiPadding()) override;
+    virtual bool ScrollRect(const UiRect& rcScroll, int32_t dx, int32_t dy) override;
+    virtual bool BeginRecordPaint(const UiRect& rcPaint) override;
+    virtual bool EndRecordPaint() override;
 
     virtual UiPoint OffsetWindowOrg(UiPoint ptOffset) override;
     virtual UiPoint SetWindowOrg(UiPoint ptOffset) override;
@@ -46,6 +51,7 @@ public:
     virtual void RestoreClip(int32_t nState) override;
     virtual void SetClip(const UiRect& rc, bool bIntersect = true) override;
     virtual void SetRoundClip(const UiRect& rc, float rx, float ry, bool bIntersect = true) override;
+    virtual void SetRegionClip(const std::vector<UiRect>& rcRegion, bool bIntersect = true) override;
     virtual void ClearClip() override;
 
     virtual bool BitBlt(int32_t x, int32_t y, int32_t cx, int32_t cy, IRender* pSrcRender, int32_t xSrc, int32_t ySrc, RopMode rop) override;
@@ -66,6 +72,8 @@ public:
     virtual void DrawImageRect(const UiRect& rcPaint, IBitmap* pBitmap,
                                const UiRect& rcDest, const UiRect& rcSource,
                                uint8_t uFade = 255, IMatrix* pMatrix = nullptr) override;
+    virtual void BeginDrawImageBatch() override;
+    virtual void EndDrawImageBatch() override;
 
     virtual void DrawLine(const UiPointF& pt1, const UiPointF& pt2, UiColor penColor, float fWidth) override;
     virtual void DrawLine(const UiPointF& pt1, const UiPointF& pt2, IPen* pen) override;
@@ -178,6 +186,15 @@ protected:
     */
      SkPoint& GetPointOrg() const;
 
+    /** 完成已合并的图片绘制（子类直接访问SkCanvas或者位图数据前，需要调用）
+    */
+    void FlushDrawImageBatch() const;
+
+    /** 子类直接访问位图数据前（比如通过DC绘制），需要调用：完成已合并的图片绘制，
+    *   如果正在记录绘制命令，记录的绘制命令将无法按原顺序回放，标记为失效
+    */
+    void PrepareDirectPixelAccess() const;
+
     /** 获取Render使用的DPI转换接口
     */
     IRenderDpiPtr GetRenderDpi() const;
@@ -212,6 +229,24 @@ private:
     */
     float GetScaleFloat(float fValue) const;
 
+    /** 获取用于绘制的SkCanvas接口（先完成已合并的图片绘制，以保证绘制顺序不变）
+    *   如果正在记录绘制命令，返回用于记录绘制命令的SkCanvas接口
+    */
+    SkCanvas* GetDrawSkCanvas() const;
+
+    /** 获取当前的绘制目标：如果正在记录绘制命令，返回用于记录绘制命令的SkCanvas接口，否则返回位图的SkCanvas接口
+    */
+    SkCanvas* GetTargetSkCanvas() const;
+
+    /** 将记录的绘制命令分块并行回放到位图中
+    */
+    void PlaybackRecordPaint(const SkPicture* skPicture, const UiRect& rcPaint);
+
+    /** 将图片绘制添加到合并绘制列表中
+    * @return 如果不满足合并绘制的条件，返回false
+    */
+    bool AddDrawImageBatch(IBitmap* pBitmap, const UiRect& rcDest, const UiRect& rcSource, uint8_t uFade);
+
 private:
     /** Canval保存的状态
     */
@@ -228,6 +263,16 @@ private:
     /** DPI转换辅助接口
     */
     IRenderDpiPtr m_spRenderDpi;
+
+    /** 合并绘制图片的数据
+    */
+    struct TDrawImageBatch;
+    std::unique_ptr<TDrawImageBatch> m_spDrawImageBatch;
+
+    /** 记录绘制命令的数据
+    */
+    struct TRecordPaint;
+    std::unique_ptr<TRecordPaint> m_spRecordPaint;
 };
 
 } // namespace ui
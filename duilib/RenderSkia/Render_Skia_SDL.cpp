@@ -245,6 +245,15 @@ void Render_Skia_SDL::ReleaseRenderDC(HDC /*hdc*/)
     ASSERT(0);
 }
 
+bool Render_Skia_SDL::IsRenderDCUsed() const
+{
+    return false;
+}
+
+void Render_Skia_SDL::ClearRenderDCUsed()
+{
+}
+
 #endif
 
 } // namespace ui
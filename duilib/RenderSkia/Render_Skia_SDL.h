@@ -91,6 +91,14 @@ private:
     * @param [in] hdc 需要释放的DC句柄
     */
     virtual void ReleaseRenderDC(HDC hdc) override;
+
+    /** 是否通过GetRenderDC获取过DC（不支持获取DC，始终返回false）
+    */
+    virtual bool IsRenderDCUsed() const override;
+
+    /** 清除通过GetRenderDC获取过DC的标志
+    */
+    virtual void ClearRenderDCUsed() override;
 #endif
    
 private:
@@ -43,7 +43,8 @@ Render_Skia_Windows::Render_Skia_Windows(HWND hWnd, RenderBackendType backendTyp
     m_hWnd(hWnd),
     m_backendType(backendType),
     m_hDC(nullptr),
-    m_hOldObj(nullptr)
+    m_hOldObj(nullptr),
+    m_bRenderDCUsed(false)
 {
     if (backendType == RenderBackendType::kNativeGL_BackendType) {
         //GPU的绘制，必须绑定窗口
@@ -183,7 +184,10 @@ SkCanvas* Render_Skia_Windows::GetSkCanvas() const
 
 HDC Render_Skia_Windows::GetRenderDC(HWND hWnd)
 {
+    //GDI直接绘制到位图数据中，需要先完成已合并的图片绘制（如果正在记录绘制命令，记录的绘制命令失效）
+    PrepareDirectPixelAccess();
     if (m_hDC != nullptr) {
+        m_bRenderDCUsed = true;
         return m_hDC;
     }
     SkCanvas* skCanvas = GetSkCanvas();
@@ -286,9 +290,20 @@ HDC Render_Skia_Windows::GetRenderDC(HWND hWnd)
                     mtx.get(IxForm::kMTransX),mtx.get(IxForm::kMTransY) };
     ::SetWorldTransform(hGetDC, &xForm);
     m_hDC = hGetDC;
+    m_bRenderDCUsed = true;
     return hGetDC;
 }
 
+bool Render_Skia_Windows::IsRenderDCUsed() const
+{
+    return m_bRenderDCUsed;
+}
+
+void Render_Skia_Windows::ClearRenderDCUsed()
+{
+    m_bRenderDCUsed = false;
+}
+
 void Render_Skia_Windows::ReleaseRenderDC(HDC hdc)
 {
     if (hdc == m_hDC) {
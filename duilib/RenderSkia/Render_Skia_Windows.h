@@ -88,6 +88,14 @@ public:
     * @param [in] hdc 需要释放的DC句柄
     */
     virtual void ReleaseRenderDC(HDC hdc) override;
+
+    /** 自上次调用ClearRenderDCUsed以来，是否通过GetRenderDC获取过DC
+    */
+    virtual bool IsRenderDCUsed() const override;
+
+    /** 清除通过GetRenderDC获取过DC的标志
+    */
+    virtual void ClearRenderDCUsed() override;
     
 private:
     /** 删除DC
@@ -114,6 +122,10 @@ private:
     /** 该DC原来的位图
     */
     HGDIOBJ m_hOldObj;
+
+    /** 是否通过GetRenderDC获取过DC
+    */
+    bool m_bRenderDCUsed;
 };
 
 } // namespace ui
@@ -7,6 +7,7 @@
 
 #include "SkTextBox.h"
 #include "SkUtils.h"
+#include "FontFallback_Skia.h"
 
 #include "SkiaHeaderBegin.h"
 #include "include/core/SkFont.h"
@@ -108,15 +109,43 @@ static int SkUTF_CountUTFBytes(const void* utf, SkTextEncoding textEncoding)
     }
 }
 
+/** 测量文本宽度（如果设置了字体回退，则含字体回退）
+*/
+static SkScalar TextBox_MeasureText(FontFallback_Skia* pFontFallback,
+                                    const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                                    const SkFont& font, SkRect* bounds, const SkPaint* paint)
+{
+    if (pFontFallback != nullptr) {
+        return pFontFallback->MeasureText(text, byteLength, textEncoding, font, bounds, paint);
+    }
+    return font.measureText(text, byteLength, textEncoding, bounds, paint);
+}
+
+/** 绘制文本（如果设置了字体回退，则含字体回退）
+*/
+static void TextBox_DrawSimpleText(FontFallback_Skia* pFontFallback, SkCanvas* canvas,
+                                   const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                                   SkScalar x, SkScalar y, const SkFont& font, const SkPaint& paint)
+{
+    if (pFontFallback != nullptr) {
+        pFontFallback->DrawSimpleText(canvas, text, byteLength, textEncoding, x, y, font, paint);
+    }
+    else {
+        canvas->drawSimpleText(text, byteLength, textEncoding, x, y, font, paint);
+    }
+}
+
 static size_t linebreak(const char text[], const char stop[], SkTextEncoding textEncoding,
                         const SkFont& font, const SkPaint& paint, 
                         SkScalar margin, SkTextBox::LineMode lineMode,
+                        FontFallback_Skia* pFontFallback,
                         size_t* trailing = nullptr)
 {
     size_t lengthBreak = stop - text;//单行模式
     if (lineMode != SkTextBox::kOneLine_Mode) {
         //多行模式
-        lengthBreak = SkTextBox::breakText(text, stop - text, textEncoding, font, paint, margin);
+        lengthBreak = SkTextBox::breakText(text, stop - text, textEncoding, font, paint, margin,
+                                           nullptr, nullptr, pFontFallback);
     }
     
     //Check for white space or line breakers before the lengthBreak
@@ -228,7 +257,8 @@ static size_t linebreak(const char text[], const char stop[], SkTextEncoding tex
 int SkTextLineBreaker::CountLines(const char text[], size_t len, SkTextEncoding textEncoding, 
                                   const SkFont& font, const SkPaint& paint, 
                                   SkScalar width, SkTextBox::LineMode lineMode,
-                                  std::vector<size_t>* lineLenList)
+                                  std::vector<size_t>* lineLenList,
+                                  FontFallback_Skia* pFontFallback)
 {
     const char* stop = text + len;
     int count = 0;
@@ -236,7 +266,7 @@ int SkTextLineBreaker::CountLines(const char text[], size_t len, SkTextEncoding
     if (width > 0) {
         do {
             count += 1;
-            size_t lineLen = linebreak(text, stop, textEncoding, font, paint, width, lineMode);
+            size_t lineLen = linebreak(text, stop, textEncoding, font, paint, width, lineMode, pFontFallback);
             if (lineLenList != nullptr) {
                 lineLenList->push_back(lineLen);
             }
@@ -269,6 +299,7 @@ SkTextBox::SkTextBox()
 
     fPaint = nullptr;
     fFont = nullptr;
+    fFontFallback = nullptr;
 }
 
 void SkTextBox::setLineMode(LineMode mode)
@@ -341,6 +372,11 @@ void SkTextBox::getSpacing(SkScalar* mul, SkScalar* add) const
     }
 }
 
+void SkTextBox::setFontFallback(FontFallback_Skia* pFontFallback)
+{
+    fFontFallback = pFontFallback;
+}
+
 void SkTextBox::setSpacing(SkScalar mul, SkScalar add)
 {
     fSpacingMul = mul;
@@ -361,6 +397,7 @@ SkScalar SkTextBox::visit(Visitor& visitor) const {
     SkScalar spacingAdd = fSpacingAdd;
     uint8_t spacingAlign = fSpacingAlign;
     uint8_t textAlign = fTextAlign;
+    FontFallback_Skia* pFontFallback = fFontFallback;
 
     SkScalar marginWidth = boxRect.width();
 
@@ -387,7 +424,8 @@ SkScalar SkTextBox::visit(Visitor& visitor) const {
 
         if (spacingAlign != kStart_SpacingAlign) {
             int count = SkTextLineBreaker::CountLines(text, textStop - text, textEncoding,
-                                                      font, paint, marginWidth, lineMode);
+                                                      font, paint, marginWidth, lineMode,
+                                                      nullptr, pFontFallback);
             SkASSERT(count > 0);
             textHeight += scaledSpacing * (count - 1);
         }
@@ -416,6 +454,7 @@ SkScalar SkTextBox::visit(Visitor& visitor) const {
         len = linebreak(text, textStop, textEncoding, 
                         font, paint, 
                         marginWidth, lineMode,
+                        pFontFallback,
                         &trailing);
         if (y + metrics.fDescent + metrics.fLeading > 0) {
 
@@ -425,11 +464,13 @@ SkScalar SkTextBox::visit(Visitor& visitor) const {
             }
             else {
                 //右对齐或者中对齐
-                SkScalar textWidth = font.measureText(text,
-                                                      len - trailing,
-                                                      textEncoding,
-                                                      nullptr,
-                                                      &paint);
+                SkScalar textWidth = TextBox_MeasureText(pFontFallback,
+                                                         text,
+                                                         len - trailing,
+                                                         textEncoding,
+                                                         font,
+                                                         nullptr,
+                                                         &paint);
                 if (textAlign == kCenter_Align) {
                     //横向：中对齐
                     x = boxRect.fLeft + (marginWidth / 2) - textWidth / 2;
@@ -468,6 +509,7 @@ template<typename T>
 static bool EllipsisTextUTF(const char text[], size_t length, SkTextEncoding textEncoding,
                             bool bEndEllipsis, bool bPathEllipsis,
                             const SkFont& font, const SkPaint& paint,
+                            FontFallback_Skia* pFontFallback,
                             SkScalar destWidth,
                             const char** textOut, 
                             size_t& lengthOut,
@@ -491,14 +533,14 @@ static bool EllipsisTextUTF(const char text[], size_t length, SkTextEncoding tex
     if (textEncoding == SkTextEncoding::kUTF32) {
         charBytes = 4;
     }
-    SkScalar ellipsisWidth = font.measureText(ellipsisStr.c_str(), ellipsisStr.size()* charBytes, textEncoding, nullptr, &paint);
+    SkScalar ellipsisWidth = TextBox_MeasureText(pFontFallback, ellipsisStr.c_str(), ellipsisStr.size()* charBytes, textEncoding, font, nullptr, &paint);
     SkScalar pathEndWidth = 0;    
     string.assign((const typename T::value_type*)text, length / charBytes);
     if (bPathEllipsis) {
         int pos = (int)string.find_last_of(pathSep);
         if (pos > 0) {
             pathEnd = string.substr(pos);
-            pathEndWidth = font.measureText(pathEnd.c_str(), pathEnd.size()* charBytes, textEncoding, nullptr, &paint);
+            pathEndWidth = TextBox_MeasureText(pFontFallback, pathEnd.c_str(), pathEnd.size()* charBytes, textEncoding, font, nullptr, &paint);
             if ((pathEndWidth + ellipsisWidth) > destWidth) {
                 //宽度不足以显示路径的最后一段文字
                 pathEnd.clear();
@@ -522,7 +564,8 @@ static bool EllipsisTextUTF(const char text[], size_t length, SkTextEncoding tex
         return false;
     }
 
-    size_t textLen = SkTextBox::breakText(string.c_str(), string.size() * charBytes, textEncoding, font, paint, leftWidth);
+    size_t textLen = SkTextBox::breakText(string.c_str(), string.size() * charBytes, textEncoding, font, paint, leftWidth,
+                                          nullptr, nullptr, pFontFallback);
     textLen /= charBytes;
     if ((textLen > 0) && (textLen <= (string.size()))) {
         string = string.substr(0, textLen);
@@ -544,6 +587,7 @@ static bool EllipsisText(const char text[], size_t length, SkTextEncoding textEn
                          std::u32string& string_utf32,
                          bool bEndEllipsis, bool bPathEllipsis,
                          const SkFont& font, const SkPaint& paint,
+                         FontFallback_Skia* pFontFallback,
                          SkScalar destWidth,
                          const char** textOut, size_t& lengthOut)
 {
@@ -551,6 +595,7 @@ static bool EllipsisText(const char text[], size_t length, SkTextEncoding textEn
         return EllipsisTextUTF<std::string>(text, length, SkTextEncoding::kUTF8,
                                             bEndEllipsis, bPathEllipsis,
                                             font, paint,
+                                            pFontFallback,
                                             destWidth,
                                             textOut, lengthOut,
                                             string_utf8,
@@ -561,6 +606,7 @@ static bool EllipsisText(const char text[], size_t length, SkTextEncoding textEn
         return EllipsisTextUTF<std::u16string>(text, length, SkTextEncoding::kUTF16,
                                             bEndEllipsis, bPathEllipsis,
                                             font, paint,
+                                            pFontFallback,
                                             destWidth,
                                             textOut, lengthOut,
                                             string_utf16,
@@ -571,6 +617,7 @@ static bool EllipsisText(const char text[], size_t length, SkTextEncoding textEn
         return EllipsisTextUTF<std::u32string>(text, length, SkTextEncoding::kUTF32,
                                             bEndEllipsis, bPathEllipsis,
                                             font, paint,
+                                            pFontFallback,
                                             destWidth,
                                             textOut, lengthOut,
                                             string_utf32,
@@ -603,16 +650,18 @@ static void TextBox_DrawText(SkTextBox* textBox,
     bool bStrikeOut = textBox->getStrikeOut();
     //单行模式
     bool isSingleLine = textBox->getLineMode() == SkTextBox::kOneLine_Mode;
+    //字体回退
+    FontFallback_Skia* pFontFallback = textBox->getFontFallback();
 
     if (!bEndEllipsis && !bPathEllipsis && !bUnderline && !bStrikeOut) {
-        canvas->drawSimpleText(text, length, textEncoding, x, y, font, paint);
+        TextBox_DrawSimpleText(pFontFallback, canvas, text, length, textEncoding, x, y, font, paint);
     }
     else {
         bool needEllipsis = false;
         if (bEndEllipsis || bPathEllipsis) {
             if (isSingleLine) {                
                 //单行模式
-                SkScalar textWidth = font.measureText(text, length, textEncoding, nullptr, &paint);
+                SkScalar textWidth = TextBox_MeasureText(pFontFallback, text, length, textEncoding, font, nullptr, &paint);
                 if ((x + textWidth) > boxRect.fRight) {
                     //文字超出边界，需要增加"..."替代无法显示的文字
                     needEllipsis = true;
@@ -627,7 +676,7 @@ static void TextBox_DrawText(SkTextBox* textBox,
             }
         }
         if(!needEllipsis && !bUnderline && !bStrikeOut) {
-            canvas->drawSimpleText(text, length, textEncoding, x, y, font, paint);
+            TextBox_DrawSimpleText(pFontFallback, canvas, text, length, textEncoding, x, y, font, paint);
         }
         else {
             std::string string_utf8;
@@ -640,6 +689,7 @@ static void TextBox_DrawText(SkTextBox* textBox,
                                  string_utf8, string_utf16, string_utf32,
                                  bEndEllipsis, bPathEllipsis,
                                  font, paint,
+                                 pFontFallback,
                                  boxRect.fRight - x,
                                  &textOut, lengthOut)) {
                     //修改text和length的值，但不改变textEncoding
@@ -650,9 +700,9 @@ static void TextBox_DrawText(SkTextBox* textBox,
                 }
             }
             //绘制文本
-            canvas->drawSimpleText(text, length, textEncoding, x, y, font, paint);
+            TextBox_DrawSimpleText(pFontFallback, canvas, text, length, textEncoding, x, y, font, paint);
             if (bUnderline || bStrikeOut) {
-                SkScalar width = font.measureText(text, length, textEncoding, nullptr, &paint);
+                SkScalar width = TextBox_MeasureText(pFontFallback, text, length, textEncoding, font, nullptr, &paint);
 
                 // Default fraction of the text size to use for a strike-through or underline.
                 static constexpr SkScalar kLineThicknessFactor = (SK_Scalar1 / 18);
@@ -802,7 +852,7 @@ void SkTextBox::draw(SkCanvas* canvas) {
 int SkTextBox::countLines() const {
     return SkTextLineBreaker::CountLines(fText, fLen, fTextEncoding, 
                                          *fFont, *fPaint, fBox.width(),
-                                         fLineMode);
+                                         fLineMode, nullptr, fFontFallback);
 }
 
 SkScalar SkTextBox::getTextHeight() const {
@@ -946,9 +996,29 @@ bool SkTextBox::TextToGlyphs(const void* text, size_t byteLength, SkTextEncoding
     return true;
 }
 
+/** 使用回退字体的宽度替换基础字体中缺失字符的宽度（字形与Unicode字符一一对应时才有效）
+*/
+static void ApplyFallbackGlyphWidths(FontFallback_Skia* pFontFallback,
+                                     const void* text, size_t byteLength, SkTextEncoding textEncoding,
+                                     const SkFont& font, const SkPaint& paint,
+                                     std::vector<SkScalar>& glyphWidths)
+{
+    if (pFontFallback == nullptr) {
+        return;
+    }
+    std::vector<SkScalar> fallbackWidths;
+    if (pFontFallback->GetGlyphWidths(text, byteLength, textEncoding, font, &paint, fallbackWidths)) {
+        SkASSERT(fallbackWidths.size() == glyphWidths.size());
+        if (fallbackWidths.size() == glyphWidths.size()) {
+            glyphWidths.swap(fallbackWidths);
+        }
+    }
+}
+
 size_t SkTextBox::breakText(const void* text, size_t byteLength, SkTextEncoding textEncoding,
                             const SkFont& font, const SkPaint& paint, SkScalar maxWidth,
-                            SkScalar* measuredWidth, SkScalar* measuredHeight)
+                            SkScalar* measuredWidth, SkScalar* measuredHeight,
+                            FontFallback_Skia* pFontFallback)
 {
     if ((maxWidth <= 0) || (byteLength == 0)){
         if (measuredWidth != nullptr) {
@@ -957,7 +1027,7 @@ size_t SkTextBox::breakText(const void* text, size_t byteLength, SkTextEncoding
         return 0;
     }
     SkRect bounds = SkRect::MakeEmpty();
-    SkScalar width = font.measureText(text, byteLength, textEncoding, &bounds);
+    SkScalar width = TextBox_MeasureText(pFontFallback, text, byteLength, textEncoding, font, &bounds, nullptr);
     if (measuredHeight != nullptr) {
         *measuredHeight = bounds.height();
         SkASSERT(*measuredHeight > 0);
@@ -987,6 +1057,7 @@ size_t SkTextBox::breakText(const void* text, size_t byteLength, SkTextEncoding
     font.getWidthsBounds(SkSpan<const SkGlyphID>(glyphs.data(), glyphs.size()),
                          SkSpan<SkScalar>(glyphWidths.data(), glyphWidths.size()),
                          SkSpan<SkRect>(), &paint);
+    ApplyFallbackGlyphWidths(pFontFallback, text, byteLength, textEncoding, font, paint, glyphWidths);
 
     size_t breakByteLength = 0;//单位是字节
     SkScalar totalWidth = 0;
@@ -1017,7 +1088,8 @@ size_t SkTextBox::breakText(const void* text, size_t byteLength, SkTextEncoding
                             std::vector<uint8_t>& glyphChars,
                             std::vector<SkScalar>& glyphWidths,
                             std::vector<uint8_t>* glyphCharList,
-                            std::vector<SkScalar>* glyphWidthList)
+                            std::vector<SkScalar>* glyphWidthList,
+                            FontFallback_Skia* pFontFallback)
 {
     if ((maxWidth <= 0) || (byteLength == 0)){
         if (measuredWidth != nullptr) {
@@ -1027,7 +1099,7 @@ size_t SkTextBox::breakText(const void* text, size_t byteLength, SkTextEncoding
     }
     bool bWantGlyphData = (glyphCharList != nullptr) || (glyphWidthList != nullptr);
     SkRect bounds = SkRect::MakeEmpty();
-    SkScalar width = font.measureText(text, byteLength, textEncoding, &bounds);
+    SkScalar width = TextBox_MeasureText(pFontFallback, text, byteLength, textEncoding, font, &bounds, nullptr);
     if (measuredHeight != nullptr) {
         *measuredHeight = bounds.height();
         SkASSERT(*measuredHeight > 0);
@@ -1058,6 +1130,7 @@ size_t SkTextBox::breakText(const void* text, size_t byteLength, SkTextEncoding
     font.getWidthsBounds(SkSpan<const SkGlyphID>(glyphs.data(), glyphs.size()),
                          SkSpan<SkScalar>(glyphWidths.data(), glyphWidths.size()),
                          SkSpan<SkRect>(), &paint);
+    ApplyFallbackGlyphWidths(pFontFallback, text, byteLength, textEncoding, font, paint, glyphWidths);
 
     if (bWantGlyphData && (width <= maxWidth)) {
         if (glyphCharList != nullptr) {
@@ -20,6 +20,7 @@
 
 namespace ui
 {
+class FontFallback_Skia;
 
 /** \class SkTextBox
 
@@ -45,11 +46,13 @@ public:
         @param maxWidth       advance limit; text is measured while advance is less than maxWidth
         @param measuredWidth  returns the width of the text less than or equal to maxWidth
         @param measuredHeight  returns the height of the text
+        @param pFontFallback  font fallback, may be nullptr (no font fallback)
         @return               bytes of text that fit, always less than or equal to length
     */
     static size_t breakText(const void* text, size_t byteLength, SkTextEncoding textEncoding,
                             const SkFont& font, const SkPaint& paint, SkScalar maxWidth,
-                            SkScalar* measuredWidth = nullptr, SkScalar* measuredHeight = nullptr);
+                            SkScalar* measuredWidth = nullptr, SkScalar* measuredHeight = nullptr,
+                            FontFallback_Skia* pFontFallback = nullptr);
 
     /** 特殊版本，进行了性能优化
     * @param [out] glyphs 绘制了多少个Glyph字符
@@ -57,6 +60,7 @@ public:
     * @param [out] glyphWidths 返回每个Glyph字符绘制的宽度
     * @param [out] glyphCharList 返回每个glyph字符由几个输入字符构成的
     * @param [out] glyphWidthList 返回每个glyph字符的输出宽度值
+    * @param [in] pFontFallback 字体回退的实现对象，为nullptr时不做字体回退
     */
     static size_t breakText(const void* text, size_t byteLength, SkTextEncoding textEncoding,
                             const SkFont& font, const SkPaint& paint, SkScalar maxWidth,
@@ -65,7 +69,8 @@ public:
                             std::vector<uint8_t>& glyphChars,
                             std::vector<SkScalar>& glyphWidths,
                             std::vector<uint8_t>* glyphCharList,
-                            std::vector<SkScalar>* glyphWidthList);
+                            std::vector<SkScalar>* glyphWidthList,
+                            FontFallback_Skia* pFontFallback = nullptr);
 public:
     //换行模式
     enum LineMode {
@@ -125,6 +130,10 @@ public:
     bool getClipBox() const { return fClipBox; }
     void setClipBox(bool bClipBox);
 
+    //字体回退：基础字体中不含的字符（比如中文、Emoji等），使用匹配到的回退字体测量和绘制
+    FontFallback_Skia* getFontFallback() const { return fFontFallback; }
+    void setFontFallback(FontFallback_Skia* pFontFallback);
+
     //行间距：mul为行间距的倍数，add 为增加多少
     //设置后，实际的行间距为：fontHeight * mul + add;
     void getSpacing(SkScalar* mul, SkScalar* add) const;
@@ -205,6 +214,9 @@ private:
     //绘制字体设置
     const SkFont* fFont;
 
+    //字体回退（可以为nullptr）
+    FontFallback_Skia* fFontFallback;
+
     //绘制区域不足时，自动在末尾绘制省略号
     bool fEndEllipsis;
 
@@ -230,11 +242,13 @@ public:
      * @param [in] width 绘制区域的宽度
      * @param [in] lineMode 换行模式
      * @param [out] lineLenList 返回每行文本数据的长度（字节）
+     * @param [in] pFontFallback 字体回退的实现对象，为nullptr时不做字体回退
      */
     static int CountLines(const char text[], size_t len, SkTextEncoding textEncoding,
                           const SkFont& font,  const SkPaint& paint,
                           SkScalar width, SkTextBox::LineMode lineMode,
-                          std::vector<size_t>* lineLenList = nullptr);
+                          std::vector<size_t>* lineLenList = nullptr,
+                          FontFallback_Skia* pFontFallback = nullptr);
 };
 
 } //namespace ui
@@ -0,0 +1,196 @@
+#include "TextMeasure_Skia.h"
+#include "VerticalDrawText.h"
+#include "HorizontalDrawText.h"
+#include "duilib/RenderSkia/Font_Skia.h"
+#include "duilib/RenderSkia/SkTextBox.h"
+#include "duilib/RenderSkia/FontFallback_Skia.h"
+
+#include "SkiaHeaderBegin.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkFontMetrics.h"
+#include "SkiaHeaderEnd.h"
+
+namespace ui {
+
+TextMeasure_Skia::TextMeasure_Skia()
+{
+    m_pSkPaint = std::make_unique<SkPaint>();
+    m_pSkPaint->setAntiAlias(true);
+    m_pSkPaint->setDither(true);
+}
+
+TextMeasure_Skia::~TextMeasure_Skia()
+{
+}
+
+UiRect TextMeasure_Skia::MeasureString(const DString& strText, const MeasureStringParam& measureParam) const
+{
+    return MeasureString(*m_pSkPaint, strText, measureParam);
+}
+
+UiRect TextMeasure_Skia::MeasureString(const SkPaint& paint, const DString& strText, const MeasureStringParam& measureParam)
+{
+    //绘制属性设置
+    SkPaint skPaint = paint;
+
+    if (measureParam.uFormat & TEXT_VERTICAL) {
+        //纵向绘制文本
+        VerticalDrawText drawTextUtil(nullptr, &skPaint, nullptr);
+        return drawTextUtil.MeasureString(strText, measureParam);
+    }
+    else if ((measureParam.uFormat & TEXT_HJUSTIFY) || (measureParam.fWordSpacing > 0.0001f)) {
+        //当横向文本，对齐方式设置为两端对齐时，或者设置了字间距时，使用该实现方案（因为修改SkTextBox的实现比较困难，维护难度高）
+        HorizontalDrawText drawTextUtil(nullptr, &skPaint, nullptr);
+        return drawTextUtil.MeasureString(strText, measureParam);
+    }
+
+    ASSERT(!strText.empty());
+    if (strText.empty()) {
+        return UiRect();
+    }
+    ASSERT(measureParam.pFont != nullptr);
+    if (measureParam.pFont == nullptr) {
+        return UiRect();
+    }
+
+    //获取字体接口
+    Font_Skia* pSkiaFont = dynamic_cast<Font_Skia*>(measureParam.pFont);
+    ASSERT(pSkiaFont != nullptr);
+    if (pSkiaFont == nullptr) {
+        return UiRect();
+    }
+    const SkFont* pSkFont = pSkiaFont->GetFontHandle();
+    ASSERT(pSkFont != nullptr);
+    if (pSkFont == nullptr) {
+        return UiRect();
+    }
+
+    bool bSingleLineMode = false;
+    if (measureParam.uFormat & DrawStringFormat::TEXT_SINGLELINE) {
+        bSingleLineMode = true;
+    }
+        
+    //计算行高
+    SkFontMetrics fontMetrics;
+    SkScalar fontHeight = pSkFont->getMetrics(&fontMetrics);
+
+    //字体回退（与DrawString的测量结果保持一致）
+    FontFallback_Skia* pFontFallback = pSkiaFont->GetFontFallback();
+    ASSERT(pFontFallback != nullptr);
+    if (pFontFallback == nullptr) {
+        return UiRect();
+    }
+
+    if (bSingleLineMode) {
+        //单行模式
+        SkRect bounds; //斜体字时，这个宽度包含了外延的宽度
+        SkScalar textWidth = pFontFallback->MeasureText(strText.c_str(),
+                                                        strText.size() * sizeof(DString::value_type),
+                                                        GetTextEncoding(),
+                                                        *pSkFont,
+                                                        &bounds,
+                                                        &skPaint);
+        textWidth = std::max(textWidth, bounds.width());
+        int textIWidth = SkScalarTruncToInt(textWidth + 0.5f);
+        if (textWidth > textIWidth) {
+            textIWidth += 1;
+        }
+        if (textIWidth <= 0) {
+            return UiRect();
+        }
+        UiRect rc;
+        rc.left = 0;
+        rc.right = textIWidth;
+        rc.top = 0;
+        rc.bottom = SkScalarTruncToInt(fontHeight + 0.5f);
+        if (fontHeight > rc.bottom) {
+            rc.bottom += 1;
+        }
+        return rc;
+    }
+    else {
+        //多行模式
+        int32_t nRectWidth = measureParam.rectSize;
+        if (nRectWidth <= 0) {
+            nRectWidth = INT32_MAX;
+        }
+        std::vector<size_t> lineLenList; //每行文本数据的长度（字节）
+        int lineCount = SkTextLineBreaker::CountLines((const char*)strText.c_str(),
+                                                      strText.size() * sizeof(DString::value_type),
+                                                      GetTextEncoding(),
+                                                      *pSkFont,
+                                                      skPaint,
+                                                      SkScalar(nRectWidth),
+                                                      SkTextBox::kWordBreak_Mode,
+                                                      &lineLenList,
+                                                      pFontFallback);
+        //计算所需宽度
+        int32_t textWidth = 0;
+        ASSERT((int)lineLenList.size() == lineCount);
+        if (!lineLenList.empty()) {
+            std::vector<DString> lineTextList; //每行的文本
+            size_t nTextPos = 0;
+            for (size_t len : lineLenList) {
+                ASSERT((len % sizeof(DString::value_type)) == 0);
+                size_t nTextLen = len / sizeof(DString::value_type);
+                lineTextList.push_back(strText.substr(nTextPos, nTextLen));
+                nTextPos += nTextLen;
+            }
+            for (const DString& lineText : lineTextList) {
+                //按单行评估每行文本，取最大宽度
+                SkRect bounds; //斜体字时，这个宽度包含了外延的宽度
+                SkScalar lineTextLen = pFontFallback->MeasureText(lineText.c_str(),
+                                                                  lineText.size() * sizeof(DString::value_type),
+                                                                  GetTextEncoding(),
+                                                                  *pSkFont,
+                                                                  &bounds,
+                                                                  &skPaint);
+                lineTextLen = std::max(lineTextLen, bounds.width());
+                int32_t lineTextIWidth = SkScalarTruncToInt(lineTextLen + 0.5f);
+                if (lineTextLen > lineTextIWidth) {
+                    lineTextIWidth += 1;
+                }
+                textWidth = std::max(textWidth, lineTextIWidth);
+            }
+        }
+        float spacingMul = 1.0f;//行间距倍数，暂不支持设置
+        SkScalar scaledSpacing = fontHeight * spacingMul;
+        SkScalar textHeight = fontHeight;
+        if (lineCount > 0) {
+            textHeight += scaledSpacing * (lineCount - 1);
+        }
+        UiRect rc;
+        rc.left = 0;
+        rc.right = textWidth;
+        rc.top = 0;
+        rc.bottom = SkScalarTruncToInt(textHeight + 0.5f);
+        if (textHeight > rc.bottom) {
+            rc.bottom += 1;
+        }
+        return rc;
+    }
+}
+
+SkTextEncoding TextMeasure_Skia::GetTextEncoding()
+{
+    constexpr const size_t nValueLen = sizeof(DString::value_type);
+    if constexpr (nValueLen == 1) {
+        return SkTextEncoding::kUTF8;
+    }
+    else if constexpr (nValueLen == 2) {
+        return SkTextEncoding::kUTF16;
+    }
+    else if constexpr (nValueLen == 4) {
+        return SkTextEncoding::kUTF32;
+    }
+    else {
+#ifdef DUILIB_UNICODE
+        return SkTextEncoding::kUTF16;
+#else
+        return SkTextEncoding::kUTF8;
+#endif
+    }
+}
+
+} // namespace ui
@@ -0,0 +1,47 @@
+#ifndef UI_RENDER_SKIA_TEXT_MEASURE_H_
+#define UI_RENDER_SKIA_TEXT_MEASURE_H_
+
+#include "duilib/Render/IRender.h"
+#include <memory>
+
+class SkPaint;
+enum class SkTextEncoding;
+
+namespace ui 
+{
+
+/** 文本评估接口的实现（不依赖画布，可以在多个线程中同时调用）
+*/
+class UILIB_API TextMeasure_Skia : public ITextMeasure
+{
+public:
+    TextMeasure_Skia();
+    TextMeasure_Skia(const TextMeasure_Skia& r) = delete;
+    TextMeasure_Skia& operator = (const TextMeasure_Skia& r) = delete;
+    virtual ~TextMeasure_Skia() override;
+
+    /** 计算指定文本字符串的宽度和高度，功能与IRender::MeasureString相同
+    */
+    virtual UiRect MeasureString(const DString& strText, const MeasureStringParam& measureParam) const override;
+
+    /** 使用指定的绘制属性，计算指定文本字符串的宽度和高度（Render_Skia::MeasureString与本类共用该实现）
+    * @param [in] paint 绘制属性
+    * @param [in] strText 文字内容
+    * @param [in] measureParam 评估相关的参数
+    */
+    static UiRect MeasureString(const SkPaint& paint, const DString& strText, const MeasureStringParam& measureParam);
+
+private:
+    /** 获取文本编码
+    */
+    static SkTextEncoding GetTextEncoding();
+
+private:
+    /** 绘制属性（与Render_Skia的默认绘制属性相同，创建后不再修改）
+    */
+    std::unique_ptr<SkPaint> m_pSkPaint;
+};
+
+} // namespace ui
+
+#endif // UI_RENDER_SKIA_TEXT_MEASURE_H_
@@ -36,7 +36,8 @@ UTF16String VerticalDrawText::GetDrawStringUTF16(const DString& strText, bool bS
 #if defined DUILIB_UNICODE && defined WCHAR_T_IS_UTF16
     return text;
 #else
-    std::string textUTF8 = StringConvert::TToUTF8(text);
+    //DString为UTF8编码时直接转换，避免复制字符串
+    const std::string& textUTF8 = StringConvert::TToUTF8(text);
     return StringConvert::UTF8ToUTF16(textUTF8.c_str(), textUTF8.size());
 #endif
 }
@@ -364,9 +365,9 @@ float VerticalDrawText::CalculateDefaultCharWidth(const SkFont* pSkFont, const S
 
 UiRect VerticalDrawText::MeasureString(const DString& strText, const MeasureStringParam& measureParam)
 {
-    PerformanceStat statPerformance(_T("VerticalDrawText::MeasureString"));
-    ASSERT((m_pSkCanvas != nullptr) && (m_pSkPaint != nullptr) && (m_pSkPointOrg != nullptr));
-    if ((m_pSkCanvas == nullptr) || (m_pSkPaint == nullptr) || (m_pSkPointOrg == nullptr)) {
+    //评估文本时不使用画布，可以在其他线程中调用（TextMeasure_Skia），所以此处不做性能统计
+    ASSERT(m_pSkPaint != nullptr);
+    if (m_pSkPaint == nullptr) {
         return UiRect();
     }
     ASSERT(!strText.empty());
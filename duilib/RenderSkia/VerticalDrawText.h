@@ -27,7 +27,7 @@ public:
     ~VerticalDrawText() = default;
 
 public:
-    /** 纵向绘制文本的评估函数：文本绘制方向为从上到下，从右到左
+    /** 纵向绘制文本的评估函数：文本绘制方向为从上到下，从右到左（不使用画布，构造时画布和视区原点可以为nullptr）
     * @param [in] strText 需要评估的文本内容
     * @param [in] measureParam 评估所需的参数
     */
@@ -107,6 +107,16 @@ uint64_t FilePath::GetFileSize() const noexcept
     return (uint64_t)fileSize;
 }
 
+int64_t FilePath::GetLastWriteTime() const noexcept
+{
+    std::error_code errorCode;
+    std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(m_filePath, errorCode);
+    if (errorCode.value() != 0) {
+        return 0;
+    }
+    return (int64_t)lastWriteTime.time_since_epoch().count();
+}
+
 DString::value_type FilePath::GetPathSeparator()
 {
 #ifdef DUILIB_BUILD_FOR_WIN
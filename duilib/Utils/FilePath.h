@@ -75,6 +75,10 @@ public:
     */
     uint64_t GetFileSize() const noexcept;
 
+    /** 获取文件的最后修改时间（与文件系统相关的时间计数值，仅用于比较文件是否被修改），失败返回0
+    */
+    int64_t GetLastWriteTime() const noexcept;
+
     /** 获取路径分隔符（字符）
     */
     static DString::value_type GetPathSeparator();
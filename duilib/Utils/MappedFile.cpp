@@ -0,0 +1,113 @@
+#include "MappedFile.h"
+
+#ifndef DUILIB_BUILD_FOR_WIN
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace ui
+{
+
+MappedFile::MappedFile():
+#ifdef DUILIB_BUILD_FOR_WIN
+    m_hFile(INVALID_HANDLE_VALUE),
+    m_hMapping(nullptr),
+#else
+    m_nFd(-1),
+#endif
+    m_pData(nullptr),
+    m_nSize(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const FilePath& filePath)
+{
+    Close();
+#ifdef DUILIB_BUILD_FOR_WIN
+    m_hFile = ::CreateFileW(filePath.ToStringW().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_hFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!::GetFileSizeEx(m_hFile, &fileSize) || (fileSize.QuadPart <= 0)) {
+        Close();
+        return false;
+    }
+    m_hMapping = ::CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_hMapping == nullptr) {
+        Close();
+        return false;
+    }
+    m_pData = ::MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (m_pData == nullptr) {
+        Close();
+        return false;
+    }
+    m_nSize = (size_t)fileSize.QuadPart;
+#else
+    m_nFd = ::open(filePath.ToStringA().c_str(), O_RDONLY);
+    if (m_nFd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if ((::fstat(m_nFd, &fileStat) != 0) || (fileStat.st_size <= 0)) {
+        Close();
+        return false;
+    }
+    void* pData = ::mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, m_nFd, 0);
+    if (pData == MAP_FAILED) {
+        Close();
+        return false;
+    }
+    m_pData = pData;
+    m_nSize = (size_t)fileStat.st_size;
+#endif
+    return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef DUILIB_BUILD_FOR_WIN
+    if (m_pData != nullptr) {
+        ::UnmapViewOfFile(m_pData);
+    }
+    if (m_hMapping != nullptr) {
+        ::CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+    if (m_hFile != INVALID_HANDLE_VALUE) {
+        ::CloseHandle(m_hFile);
+        m_hFile = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (m_pData != nullptr) {
+        ::munmap(m_pData, m_nSize);
+    }
+    if (m_nFd >= 0) {
+        ::close(m_nFd);
+        m_nFd = -1;
+    }
+#endif
+    m_pData = nullptr;
+    m_nSize = 0;
+}
+
+const uint8_t* MappedFile::GetData() const
+{
+    return static_cast<const uint8_t*>(m_pData);
+}
+
+size_t MappedFile::GetSize() const
+{
+    return m_nSize;
+}
+
+}
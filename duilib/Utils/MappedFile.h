@@ -0,0 +1,50 @@
+#ifndef UI_UTILS_MAPPED_FILE_H_
+#define UI_UTILS_MAPPED_FILE_H_
+
+#include "duilib/Utils/FilePath.h"
+
+namespace ui
+{
+
+/** 以只读方式映射到内存的文件（用于直接读取二进制格式的文件，避免将文件内容复制到内存中）
+*/
+class UILIB_API MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator = (const MappedFile&) = delete;
+
+public:
+    /** 打开文件，并以只读方式映射到内存（空文件返回false）
+    * @param [in] filePath 本地文件路径(绝对路径)
+    */
+    bool Open(const FilePath& filePath);
+
+    /** 关闭文件
+    */
+    void Close();
+
+    /** 映射的文件数据
+    */
+    const uint8_t* GetData() const;
+
+    /** 映射的文件数据长度
+    */
+    size_t GetSize() const;
+
+private:
+#ifdef DUILIB_BUILD_FOR_WIN
+    HANDLE m_hFile;
+    HANDLE m_hMapping;
+#else
+    int m_nFd;
+#endif
+    void* m_pData;
+    size_t m_nSize;
+};
+
+}
+
+#endif // UI_UTILS_MAPPED_FILE_H_
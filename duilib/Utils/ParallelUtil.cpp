@@ -0,0 +1,207 @@
+#include "ParallelUtil.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+//线程池中最多创建的工作线程数（不包含调用线程）
+#define PARALLEL_MAX_WORKER_THREADS 16
+
+namespace ui
+{
+
+/** 并行任务的工作线程池（工作线程按需创建，创建后常驻，直到关闭线程池）
+*/
+class ParallelThreadPool
+{
+public:
+    ParallelThreadPool():
+        m_bBusy(false),
+        m_bQuit(false),
+        m_nJobSeq(0),
+        m_nJobWorkers(0),
+        m_nActiveWorkers(0),
+        m_pTask(nullptr),
+        m_nTaskCount(0),
+        m_nNextTask(0)
+    {
+    }
+
+    ~ParallelThreadPool()
+    {
+        Shutdown();
+    }
+
+    ParallelThreadPool(const ParallelThreadPool&) = delete;
+    ParallelThreadPool& operator = (const ParallelThreadPool&) = delete;
+
+    static ParallelThreadPool& Instance()
+    {
+        static ParallelThreadPool self;
+        return self;
+    }
+
+    void ParallelFor(size_t nCount, size_t nMaxThreads, const std::function<void(size_t nIndex)>& task)
+    {
+        if ((nCount == 0) || !task) {
+            return;
+        }
+        size_t nWorkerCount = std::min(nMaxThreads, nCount);
+        nWorkerCount = (nWorkerCount > 1) ? std::min(nWorkerCount - 1, (size_t)PARALLEL_MAX_WORKER_THREADS) : 0;
+        if (nWorkerCount > 0) {
+            std::lock_guard<std::mutex> threadGuard(m_mutex);
+            if (m_bBusy || m_bQuit) {
+                //线程池正在使用中（嵌套调用或者其他线程正在使用）或者已经关闭：在当前线程中执行
+                nWorkerCount = 0;
+            }
+            else {
+                while (m_threads.size() < nWorkerCount) {
+                    m_threads.emplace_back(&ParallelThreadPool::WorkerThreadProc, this);
+                }
+                m_bBusy = true;
+                m_pTask = &task;
+                m_nTaskCount = nCount;
+                m_nNextTask = 0;
+                m_nJobWorkers = nWorkerCount;
+                m_nActiveWorkers = nWorkerCount;
+                ++m_nJobSeq;
+            }
+        }
+        if (nWorkerCount == 0) {
+            for (size_t nIndex = 0; nIndex < nCount; ++nIndex) {
+                task(nIndex);
+            }
+            return;
+        }
+        m_workCv.notify_all();
+
+        //调用线程也参与执行
+        ExecuteJob();
+
+        //任务已全部被领取，未被工作线程认领的名额作废，等待已认领的工作线程完成
+        std::unique_lock<std::mutex> threadGuard(m_mutex);
+        m_nActiveWorkers -= m_nJobWorkers;
+        m_nJobWorkers = 0;
+        m_doneCv.wait(threadGuard, [this]() { return m_nActiveWorkers == 0; });
+        m_pTask = nullptr;
+        m_nTaskCount = 0;
+        m_bBusy = false;
+    }
+
+    void Shutdown()
+    {
+        std::vector<std::thread> threads;
+        {
+            std::lock_guard<std::mutex> threadGuard(m_mutex);
+            m_bQuit = true;
+            threads.swap(m_threads);
+        }
+        m_workCv.notify_all();
+        for (std::thread& thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+private:
+    /** 工作线程的线程函数
+    */
+    void WorkerThreadProc()
+    {
+        uint64_t nLastJobSeq = 0;
+        std::unique_lock<std::mutex> threadGuard(m_mutex);
+        while (true) {
+            m_workCv.wait(threadGuard, [this, nLastJobSeq]() {
+                return m_bQuit || ((m_nJobSeq != nLastJobSeq) && (m_nJobWorkers > 0));
+                });
+            if (m_bQuit) {
+                break;
+            }
+            nLastJobSeq = m_nJobSeq;
+            --m_nJobWorkers;
+            threadGuard.unlock();
+            ExecuteJob();
+            threadGuard.lock();
+            if (--m_nActiveWorkers == 0) {
+                m_doneCv.notify_all();
+            }
+        }
+    }
+
+    /** 依次领取并执行任务，直到所有任务都被领取
+    */
+    void ExecuteJob()
+    {
+        const std::function<void(size_t nIndex)>& task = *m_pTask;
+        const size_t nTaskCount = m_nTaskCount;
+        size_t nIndex = m_nNextTask++;
+        while (nIndex < nTaskCount) {
+            task(nIndex);
+            nIndex = m_nNextTask++;
+        }
+    }
+
+private:
+    /** 线程同步锁
+    */
+    std::mutex m_mutex;
+
+    /** 通知工作线程有新任务或者需要退出
+    */
+    std::condition_variable m_workCv;
+
+    /** 通知调用线程工作线程已全部完成
+    */
+    std::condition_variable m_doneCv;
+
+    /** 工作线程
+    */
+    std::vector<std::thread> m_threads;
+
+    /** 线程池是否正在执行任务
+    */
+    bool m_bBusy;
+
+    /** 线程池是否已经关闭
+    */
+    bool m_bQuit;
+
+    /** 当前任务的序号（每次并行执行时递增）
+    */
+    uint64_t m_nJobSeq;
+
+    /** 当前任务中尚未被工作线程认领的名额
+    */
+    size_t m_nJobWorkers;
+
+    /** 当前任务中已认领（或尚可认领）且未完成的工作线程数
+    */
+    size_t m_nActiveWorkers;
+
+    /** 当前任务函数（仅在执行任务期间有效）
+    */
+    const std::function<void(size_t nIndex)>* m_pTask;
+
+    /** 当前任务的个数
+    */
+    size_t m_nTaskCount;
+
+    /** 下一个待领取的任务序号
+    */
+    std::atomic<size_t> m_nNextTask;
+};
+
+void ParallelUtil::ParallelFor(size_t nCount, size_t nMaxThreads, const std::function<void(size_t nIndex)>& task)
+{
+    ParallelThreadPool::Instance().ParallelFor(nCount, nMaxThreads, task);
+}
+
+void ParallelUtil::Shutdown()
+{
+    ParallelThreadPool::Instance().Shutdown();
+}
+
+} // namespace ui
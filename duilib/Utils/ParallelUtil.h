@@ -0,0 +1,30 @@
+#ifndef UI_UTILS_PARALLEL_UTIL_H_
+#define UI_UTILS_PARALLEL_UTIL_H_
+
+#include "duilib/duilib_defs.h"
+#include <functional>
+
+namespace ui
+{
+
+/** 并行执行任务的辅助类（使用常驻的工作线程池，避免每次并行时创建和销毁线程）
+*/
+class UILIB_API ParallelUtil
+{
+public:
+    /** 并行执行任务，调用线程也参与执行，所有任务执行完成后返回
+    * @param [in] nCount 任务个数，任务序号范围为[0, nCount)
+    * @param [in] nMaxThreads 最多使用的线程数（包含调用线程）
+    * @param [in] task 任务函数，参数为任务序号，各个任务可能在不同的线程中同时执行
+    * @note 线程池正在被使用（嵌套调用或者多个线程同时调用）或者已经关闭时，在调用线程中依次执行所有任务
+    */
+    static void ParallelFor(size_t nCount, size_t nMaxThreads, const std::function<void(size_t nIndex)>& task);
+
+    /** 关闭线程池，等待所有工作线程退出（程序退出前调用）
+    */
+    static void Shutdown();
+};
+
+} // namespace ui
+
+#endif // UI_UTILS_PARALLEL_UTIL_H_
@@ -1,8 +1,13 @@
 #include "PerformanceUtil.h"
 #include "duilib/Utils/StringUtil.h"
+#include "duilib/Utils/StringConvert.h"
+#include "duilib/Utils/FileUtil.h"
 #include "duilib/Utils/LogUtil.h"
 
-namespace ui 
+//每个统计项保留的最近采样数据个数（用于计算分位时间）
+#define MAX_PERFORMANCE_SAMPLE_COUNT 4096
+
+namespace ui
 {
 
 PerformanceUtil::PerformanceUtil()
@@ -15,14 +20,17 @@ PerformanceUtil::~PerformanceUtil()
         if (iter.second.totalCount == 0) {
             continue;
         }
-        DString log = StringUtil::Printf(_T("%s(%d): %d ms, average: %d ms, max: %d ms"), 
+        DString log = StringUtil::Printf(_T("%s(%d): %d ms, average: %d ms, max: %d ms"),
                                         iter.first.c_str(),
-                                        (int32_t)iter.second.totalCount, 
+                                        (int32_t)iter.second.totalCount,
                                         (int32_t)(iter.second.totalTimes.count() / 1000),
                                         (int32_t)(iter.second.totalTimes.count() / 1000 / iter.second.totalCount),
                                         (int32_t)(iter.second.maxTime.count() / 1000));
         LogUtil::OutputLine(log);
     }
+    if (!m_reportFile.IsEmpty()) {
+        SaveJsonFile(m_reportFile);
+    }
 }
 
 PerformanceUtil& PerformanceUtil::Instance()
@@ -54,6 +62,102 @@ void PerformanceUtil::EndStat(const DString& name)
     stat.totalTimes += thisTime;
     stat.nStartRefCount--;
     stat.maxTime = (std::max)(stat.maxTime, thisTime);
+
+    //记录采样数据
+    const uint32_t nSample = (uint32_t)(std::min)(thisTime.count(), (int64_t)UINT32_MAX);
+    if (stat.samples.size() < MAX_PERFORMANCE_SAMPLE_COUNT) {
+        stat.samples.push_back(nSample);
+    }
+    else {
+        stat.samples[stat.nextSample] = nSample;
+        stat.nextSample = (stat.nextSample + 1) % MAX_PERFORMANCE_SAMPLE_COUNT;
+    }
+}
+
+void PerformanceUtil::Reset()
+{
+    for (auto& iter : m_stat) {
+        //保留正在计时的统计项的开始状态
+        TStat& stat = iter.second;
+        stat.totalTimes = std::chrono::microseconds::zero();
+        stat.totalCount = 0;
+        stat.maxTime = std::chrono::microseconds::zero();
+        stat.samples.clear();
+        stat.nextSample = 0;
+    }
+}
+
+void PerformanceUtil::GetStatResults(std::vector<PerformanceStatResult>& results) const
+{
+    results.clear();
+    std::vector<uint32_t> samples;
+    for (const auto& iter : m_stat) {
+        const TStat& stat = iter.second;
+        if (stat.totalCount == 0) {
+            continue;
+        }
+        PerformanceStatResult result;
+        result.m_name = iter.first;
+        result.m_nCount = stat.totalCount;
+        result.m_nTotalTime = (uint64_t)stat.totalTimes.count();
+        result.m_nAvgTime = result.m_nTotalTime / stat.totalCount;
+        result.m_nMaxTime = (uint64_t)stat.maxTime.count();
+        if (!stat.samples.empty()) {
+            samples = stat.samples;
+            std::sort(samples.begin(), samples.end());
+            const size_t nLast = samples.size() - 1;
+            result.m_nP50Time = samples[nLast * 50 / 100];
+            result.m_nP90Time = samples[nLast * 90 / 100];
+            result.m_nP99Time = samples[nLast * 99 / 100];
+        }
+        results.push_back(result);
+    }
+}
+
+DString PerformanceUtil::ToJsonString() const
+{
+    std::vector<PerformanceStatResult> results;
+    GetStatResults(results);
+
+    DString json = _T("{\n  \"unit\": \"us\",\n  \"stats\": [");
+    for (size_t index = 0; index < results.size(); ++index) {
+        const PerformanceStatResult& result = results[index];
+        //统计项名称中的特殊字符需要转义
+        DString name;
+        for (DString::value_type ch : result.m_name) {
+            if ((ch == _T('"')) || (ch == _T('\\'))) {
+                name.push_back(_T('\\'));
+            }
+            name.push_back(ch);
+        }
+        json += (index == 0) ? _T("\n") : _T(",\n");
+        json += _T("    {\"name\": \"") + name + _T("\"");
+        json += _T(", \"count\": ") + StringUtil::UInt32ToString(result.m_nCount);
+        json += _T(", \"total\": ") + StringUtil::UInt64ToString(result.m_nTotalTime);
+        json += _T(", \"avg\": ") + StringUtil::UInt64ToString(result.m_nAvgTime);
+        json += _T(", \"max\": ") + StringUtil::UInt64ToString(result.m_nMaxTime);
+        json += _T(", \"p50\": ") + StringUtil::UInt64ToString(result.m_nP50Time);
+        json += _T(", \"p90\": ") + StringUtil::UInt64ToString(result.m_nP90Time);
+        json += _T(", \"p99\": ") + StringUtil::UInt64ToString(result.m_nP99Time);
+        json += _T("}");
+    }
+    json += _T("\n  ]\n}\n");
+    return json;
+}
+
+bool PerformanceUtil::SaveJsonFile(const FilePath& filePath) const
+{
+    ASSERT(!filePath.IsEmpty());
+    if (filePath.IsEmpty()) {
+        return false;
+    }
+    DStringA jsonData = StringConvert::TToUTF8(ToJsonString());
+    return FileUtil::WriteFileData(filePath, jsonData);
+}
+
+void PerformanceUtil::SetReportFile(const FilePath& filePath)
+{
+    m_reportFile = filePath;
 }
 
 }
@@ -2,15 +2,32 @@
 #define UI_UTILS_PERFORMANCE_UTIL_H_
 
 #include "duilib/duilib_defs.h"
+#include "duilib/Utils/FilePath.h"
 #include <string>
 #include <map>
+#include <vector>
 #include <chrono>
 #include <algorithm>
 
-namespace ui 
+namespace ui
 {
 
+/** 一个统计项的统计结果（时间单位均为微秒）
+*/
+struct UILIB_API PerformanceStatResult
+{
+    DString m_name;             //统计项的名称
+    uint32_t m_nCount = 0;      //统计总次数
+    uint64_t m_nTotalTime = 0;  //代码执行总时间
+    uint64_t m_nAvgTime = 0;    //平均时间
+    uint64_t m_nMaxTime = 0;    //单次最大时间
+    uint64_t m_nP50Time = 0;    //50%分位时间（按最近的采样计算）
+    uint64_t m_nP90Time = 0;    //90%分位时间（按最近的采样计算）
+    uint64_t m_nP99Time = 0;    //99%分位时间（按最近的采样计算）
+};
+
 /** 代码执行性能分析工具
+*   统计项的名称以阶段名称开头（如"BuildWindow, "、"LayoutWindow, "、"PaintWindow, "），便于按阶段汇总
 */
 class UILIB_API PerformanceUtil
 {
@@ -31,7 +48,28 @@ public:
     * @param [in] name 统计项的名称
     */
     void EndStat(const DString& name);
-    
+
+    /** 清除所有统计数据（比如在执行一组操作前调用，只统计这组操作的性能）
+    */
+    void Reset();
+
+    /** 获取所有统计项的统计结果
+    */
+    void GetStatResults(std::vector<PerformanceStatResult>& results) const;
+
+    /** 将所有统计项的统计结果转换为JSON格式的字符串（机器可读的格式，便于比较不同版本的性能数据）
+    */
+    DString ToJsonString() const;
+
+    /** 将所有统计项的统计结果以JSON格式保存到文件
+    * @param [in] filePath 文件路径
+    */
+    bool SaveJsonFile(const FilePath& filePath) const;
+
+    /** 设置程序退出时，统计结果保存的文件路径（JSON格式），为空表示不保存
+    */
+    void SetReportFile(const FilePath& filePath);
+
 private:
     /** 记录每项统计的结果
     */
@@ -55,9 +93,21 @@ private:
         /** 单次最大：：微秒(千分之一毫秒)
         */
         std::chrono::microseconds maxTime = std::chrono::microseconds::zero();
+
+        /** 最近的采样数据（循环使用）：微秒(千分之一毫秒)，用于计算分位时间
+        */
+        std::vector<uint32_t> samples;
+
+        /** 下一个采样数据写入的位置
+        */
+        size_t nextSample = 0;
     };
 
     std::map<DString, TStat> m_stat;
+
+    /** 程序退出时，统计结果保存的文件路径
+    */
+    FilePath m_reportFile;
 };
 
 class PerformanceStat
@@ -6,6 +6,9 @@
 
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 #include <cassert>
 #include <stdexcept>
 #include <cstdint>
@@ -69,6 +72,92 @@ static void ExtractRGBA(XImage* ximage, uint32_t pixel, uint8_t& r, uint8_t& g,
     }
 }
 
+// 像素格式转换参数（根据XImage的颜色掩码计算）
+struct TPixelFormat
+{
+    bool m_bFast = false;       // 是否可以使用快速转换（32位像素，每个颜色分量8位，字节序为本机的小端字节序）
+    uint32_t m_nRedShift = 0;   // 红色分量的位置
+    uint32_t m_nGreenShift = 0; // 绿色分量的位置
+    uint32_t m_nBlueShift = 0;  // 蓝色分量的位置
+};
+
+// 辅助函数：判断掩码是否为连续的8位，并返回其位置
+static bool GetMaskShift8(uint32_t mask, uint32_t& shift)
+{
+    if (mask == 0) {
+        return false;
+    }
+    shift = static_cast<uint32_t>(__builtin_ctz(mask));
+    return (mask >> shift) == 0xFF;
+}
+
+// 辅助函数：根据XImage的颜色掩码，计算像素格式转换参数
+static void InitPixelFormat(const XImage* ximage, TPixelFormat& format)
+{
+    format = TPixelFormat();
+    const uint16_t nEndianTest = 1;
+    const bool bHostLittleEndian = *reinterpret_cast<const uint8_t*>(&nEndianTest) == 1;
+    if ((ximage == nullptr) || (ximage->bits_per_pixel != 32) || (ximage->depth < 24) ||
+        !bHostLittleEndian || (ximage->byte_order != LSBFirst)) {
+        return;
+    }
+    const uint32_t redMask = static_cast<uint32_t>(ximage->red_mask);
+    const uint32_t greenMask = static_cast<uint32_t>(ximage->green_mask);
+    const uint32_t blueMask = static_cast<uint32_t>(ximage->blue_mask);
+    if (!GetMaskShift8(redMask, format.m_nRedShift) ||
+        !GetMaskShift8(greenMask, format.m_nGreenShift) ||
+        !GetMaskShift8(blueMask, format.m_nBlueShift)) {
+        return;
+    }
+    // 屏幕图像始终按完全不透明处理：32位深度时，未被RGB占用的位通常为0，不是有效的Alpha值
+    // （与ExtractRGBA的结果一致：标准的RGB掩码下，ExtractRGBA返回的Alpha值为0xFF）
+    format.m_bFast = true;
+}
+
+// 将XImage的图像数据转换为RGBA格式（每个像素4字节：R, G, B, A）
+// 参数:
+//   ximage      - 源图像
+//   format      - 像素格式转换参数（由InitPixelFormat计算）
+//   pDstBits    - 目标图像数据的起始地址
+//   nDstStride  - 目标图像每行的像素个数
+static void ConvertToRGBA(XImage* ximage, const TPixelFormat& format, uint32_t* pDstBits, size_t nDstStride)
+{
+    const int32_t width = ximage->width;
+    const int32_t height = ximage->height;
+    if (format.m_bFast) {
+        const uint32_t nRedShift = format.m_nRedShift;
+        const uint32_t nGreenShift = format.m_nGreenShift;
+        const uint32_t nBlueShift = format.m_nBlueShift;
+        for (int32_t y = 0; y < height; ++y) {
+            const uint32_t* pSrcRow = reinterpret_cast<const uint32_t*>(ximage->data + static_cast<size_t>(y) * ximage->bytes_per_line);
+            uint32_t* pDstRow = pDstBits + static_cast<size_t>(y) * nDstStride;
+            // 按行转换，循环内无分支，便于编译器生成SIMD指令
+            for (int32_t x = 0; x < width; ++x) {
+                const uint32_t pixel = pSrcRow[x];
+                pDstRow[x] = ((pixel >> nRedShift) & 0xFF) |
+                             (((pixel >> nGreenShift) & 0xFF) << 8) |
+                             (((pixel >> nBlueShift) & 0xFF) << 16) |
+                             0xFF000000; // 完全不透明
+            }
+        }
+    }
+    else {
+        // 其他像素格式：逐个像素转换（XGetPixel兼容性最好）
+        for (int32_t y = 0; y < height; ++y) {
+            uint8_t* pDstRow = reinterpret_cast<uint8_t*>(pDstBits + static_cast<size_t>(y) * nDstStride);
+            for (int32_t x = 0; x < width; ++x) {
+                const uint32_t pixel = static_cast<uint32_t>(XGetPixel(ximage, x, y));
+                uint8_t r, g, b, a;
+                ExtractRGBA(ximage, pixel, r, g, b, a);
+                pDstRow[x * 4] = r;
+                pDstRow[x * 4 + 1] = g;
+                pDstRow[x * 4 + 2] = b;
+                pDstRow[x * 4 + 3] = a;
+            }
+        }
+    }
+}
+
 // 捕获指定窗口所在屏幕的图像
 // 参数:
 //   display      - 与X服务器的连接
@@ -152,21 +241,9 @@ static bool CaptureScreenBitmap(::Display* display, ::Window targetWindow, std::
         bitmap.resize(pixelCount * 4);
 
         // 转换XImage数据到RGBA格式
-        for (int32_t y = 0; y < height && !s_x11ErrorOccurred; ++y) {
-            for (int32_t x = 0; x < width && !s_x11ErrorOccurred; ++x) {
-                // 获取像素值（XGetPixel兼容性最好，大图像可优化为直接访问data缓冲区）
-                const uint32_t pixel = XGetPixel(ximage, x, y);
-                const size_t index = (static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * 4;
-
-                uint8_t r, g, b, a;
-                ExtractRGBA(ximage, pixel, r, g, b, a);
-
-                bitmap[index] = r;
-                bitmap[index + 1] = g;
-                bitmap[index + 2] = b;
-                bitmap[index + 3] = a;
-            }
-        }
+        TPixelFormat pixelFormat;
+        InitPixelFormat(ximage, pixelFormat);
+        ConvertToRGBA(ximage, pixelFormat, reinterpret_cast<uint32_t*>(bitmap.data()), static_cast<size_t>(width));
 
         // 检查转换过程中是否发生错误
         if (s_x11ErrorOccurred) {
@@ -191,6 +268,225 @@ static bool CaptureScreenBitmap(::Display* display, ::Window targetWindow, std::
     return result;
 }
 
+/** X11相关的数据
+*/
+struct ScreenCaptureShm_X11::TShmData
+{
+    //与X服务器的连接
+    ::Display* m_display = nullptr;
+
+    //屏幕的根窗口
+    ::Window m_rootWindow = 0;
+
+    //根窗口的Visual和颜色深度
+    ::Visual* m_visual = nullptr;
+    int32_t m_nDepth = 0;
+
+    //屏幕的大小
+    int32_t m_nScreenWidth = 0;
+    int32_t m_nScreenHeight = 0;
+
+    //共享内存段
+    XShmSegmentInfo m_shmInfo = {};
+
+    //使用共享内存段的图像（其大小与截取区域的大小一致）
+    ::XImage* m_pXImage = nullptr;
+
+    //像素格式转换参数
+    TPixelFormat m_pixelFormat;
+};
+
+ScreenCaptureShm_X11::ScreenCaptureShm_X11()
+{
+    m_spShmData = std::make_unique<TShmData>();
+}
+
+ScreenCaptureShm_X11::~ScreenCaptureShm_X11()
+{
+    Clear();
+}
+
+bool ScreenCaptureShm_X11::Init(const Window* pWindow)
+{
+    Clear();
+    if (pWindow == nullptr) {
+        return false;
+    }
+    const NativeWindow* pNativeWnd = pWindow->NativeWnd();
+    if (pNativeWnd == nullptr) {
+        return false;
+    }
+    const ::Window targetWindow = pNativeWnd->GetX11WindowNumber();
+    if (targetWindow == BadWindow) {
+        return false;
+    }
+
+    ::Display* display = ::XOpenDisplay(nullptr);
+    if (display == nullptr) {
+        return false;
+    }
+    if (!::XShmQueryExtension(display)) {
+        //X服务器不支持MIT-SHM扩展
+        ::XCloseDisplay(display);
+        return false;
+    }
+
+    XErrorHandler originalErrorHandler = XSetErrorHandler(X11ErrorHandler);
+    if (originalErrorHandler == nullptr) {
+        ::XCloseDisplay(display);
+        return false;
+    }
+    s_x11ErrorOccurred = false;
+
+    // 获取目标窗口所在的屏幕及其根窗口的属性
+    ::XWindowAttributes attr;
+    ::XWindowAttributes rootAttr;
+    ::Window rootWindow = 0;
+    bool bRet = ::XGetWindowAttributes(display, targetWindow, &attr) && !s_x11ErrorOccurred && (attr.screen != nullptr);
+    if (bRet) {
+        rootWindow = RootWindowOfScreen(attr.screen);
+        bRet = ::XGetWindowAttributes(display, rootWindow, &rootAttr) && !s_x11ErrorOccurred;
+    }
+    XSetErrorHandler(originalErrorHandler);
+    s_x11ErrorOccurred = false;
+    if (!bRet || (attr.screen->width < 1) || (attr.screen->height < 1)) {
+        ::XCloseDisplay(display);
+        return false;
+    }
+
+    TShmData& shmData = *m_spShmData;
+    shmData.m_display = display;
+    shmData.m_rootWindow = rootWindow;
+    shmData.m_visual = rootAttr.visual;
+    shmData.m_nDepth = rootAttr.depth;
+    shmData.m_nScreenWidth = static_cast<int32_t>(attr.screen->width);
+    shmData.m_nScreenHeight = static_cast<int32_t>(attr.screen->height);
+    return true;
+}
+
+UiSize ScreenCaptureShm_X11::GetScreenSize() const
+{
+    return UiSize(m_spShmData->m_nScreenWidth, m_spShmData->m_nScreenHeight);
+}
+
+bool ScreenCaptureShm_X11::CheckShmImage(int32_t nWidth, int32_t nHeight)
+{
+    TShmData& shmData = *m_spShmData;
+    if ((shmData.m_pXImage != nullptr) && (shmData.m_pXImage->width == nWidth) && (shmData.m_pXImage->height == nHeight)) {
+        return true;
+    }
+    DestroyShmImage();
+
+    ::XImage* ximage = ::XShmCreateImage(shmData.m_display, shmData.m_visual, static_cast<unsigned int>(shmData.m_nDepth),
+                                         ZPixmap, nullptr, &shmData.m_shmInfo,
+                                         static_cast<unsigned int>(nWidth), static_cast<unsigned int>(nHeight));
+    if (ximage == nullptr) {
+        return false;
+    }
+    const size_t nImageBytes = static_cast<size_t>(ximage->bytes_per_line) * static_cast<size_t>(ximage->height);
+    shmData.m_shmInfo.shmid = ::shmget(IPC_PRIVATE, nImageBytes, IPC_CREAT | 0600);
+    if (shmData.m_shmInfo.shmid < 0) {
+        XDestroyImage(ximage);
+        return false;
+    }
+    shmData.m_shmInfo.shmaddr = static_cast<char*>(::shmat(shmData.m_shmInfo.shmid, nullptr, 0));
+    if (shmData.m_shmInfo.shmaddr == reinterpret_cast<char*>(-1)) {
+        ::shmctl(shmData.m_shmInfo.shmid, IPC_RMID, nullptr);
+        XDestroyImage(ximage);
+        return false;
+    }
+    ximage->data = shmData.m_shmInfo.shmaddr;
+    shmData.m_shmInfo.readOnly = False;
+
+    XErrorHandler originalErrorHandler = XSetErrorHandler(X11ErrorHandler);
+    s_x11ErrorOccurred = false;
+    bool bAttached = ::XShmAttach(shmData.m_display, &shmData.m_shmInfo) != 0;
+    ::XSync(shmData.m_display, False);
+    bAttached = bAttached && !s_x11ErrorOccurred;
+    XSetErrorHandler(originalErrorHandler);
+    s_x11ErrorOccurred = false;
+
+    //X服务器附加后即可标记删除，所有进程分离后共享内存段自动释放（避免进程异常退出时泄漏）
+    ::shmctl(shmData.m_shmInfo.shmid, IPC_RMID, nullptr);
+    if (!bAttached) {
+        ::shmdt(shmData.m_shmInfo.shmaddr);
+        ximage->data = nullptr;
+        XDestroyImage(ximage);
+        return false;
+    }
+    shmData.m_pXImage = ximage;
+    InitPixelFormat(ximage, shmData.m_pixelFormat);
+    return true;
+}
+
+void ScreenCaptureShm_X11::DestroyShmImage()
+{
+    TShmData& shmData = *m_spShmData;
+    if (shmData.m_pXImage == nullptr) {
+        return;
+    }
+    ::XShmDetach(shmData.m_display, &shmData.m_shmInfo);
+    ::XSync(shmData.m_display, False);
+    ::shmdt(shmData.m_shmInfo.shmaddr);
+    shmData.m_pXImage->data = nullptr;
+    XDestroyImage(shmData.m_pXImage);
+    shmData.m_pXImage = nullptr;
+    shmData.m_shmInfo = {};
+}
+
+bool ScreenCaptureShm_X11::CaptureRegion(const UiRect& rcRegion, void* pPixelBits, size_t nPixelBitsLen)
+{
+    TShmData& shmData = *m_spShmData;
+    if (shmData.m_display == nullptr) {
+        return false;
+    }
+    ASSERT(pPixelBits != nullptr);
+    if ((pPixelBits == nullptr) || rcRegion.IsEmpty()) {
+        return false;
+    }
+    ASSERT(nPixelBitsLen >= static_cast<size_t>(rcRegion.Width()) * rcRegion.Height() * 4);
+    if (nPixelBitsLen < static_cast<size_t>(rcRegion.Width()) * rcRegion.Height() * 4) {
+        return false;
+    }
+    UiRect rcCapture = rcRegion;
+    rcCapture.Intersect(UiRect(0, 0, shmData.m_nScreenWidth, shmData.m_nScreenHeight));
+    if (rcCapture.IsEmpty()) {
+        return false;
+    }
+    if (!CheckShmImage(rcCapture.Width(), rcCapture.Height())) {
+        return false;
+    }
+
+    XErrorHandler originalErrorHandler = XSetErrorHandler(X11ErrorHandler);
+    s_x11ErrorOccurred = false;
+    bool bRet = ::XShmGetImage(shmData.m_display, shmData.m_rootWindow, shmData.m_pXImage,
+                               rcCapture.left, rcCapture.top, AllPlanes) != 0;
+    bRet = bRet && !s_x11ErrorOccurred;
+    XSetErrorHandler(originalErrorHandler);
+    s_x11ErrorOccurred = false;
+    if (!bRet) {
+        return false;
+    }
+
+    // 转换到目标缓冲区中对应的位置
+    const size_t nDstStride = static_cast<size_t>(rcRegion.Width());
+    uint32_t* pDstBits = static_cast<uint32_t*>(pPixelBits) +
+                         static_cast<size_t>(rcCapture.top - rcRegion.top) * nDstStride +
+                         static_cast<size_t>(rcCapture.left - rcRegion.left);
+    ConvertToRGBA(shmData.m_pXImage, shmData.m_pixelFormat, pDstBits, nDstStride);
+    return true;
+}
+
+void ScreenCaptureShm_X11::Clear()
+{
+    TShmData& shmData = *m_spShmData;
+    if (shmData.m_display != nullptr) {
+        DestroyShmImage();
+        ::XCloseDisplay(shmData.m_display);
+    }
+    shmData = TShmData();
+}
+
 std::shared_ptr<IBitmap> ScreenCapture_X11::CaptureBitmap(const ui::Window* pWindow)
 {
     if (pWindow == nullptr) {
@@ -203,6 +499,25 @@ std::shared_ptr<IBitmap> ScreenCapture_X11::CaptureBitmap(const ui::Window* pWin
         return nullptr;
     }
 
+    // 优先使用MIT-SHM扩展截图（X服务器直接将图像写入共享内存，并直接转换到位图数据中）
+    IRenderFactory* pShmRenderFactory = GlobalManager::Instance().GetRenderFactory();
+    ScreenCaptureShm_X11 shmCapture;
+    if ((pShmRenderFactory != nullptr) && shmCapture.Init(pWindow)) {
+        const UiSize szScreen = shmCapture.GetScreenSize();
+        std::shared_ptr<IBitmap> spShmBitmap(pShmRenderFactory->CreateBitmap());
+        if ((spShmBitmap != nullptr) && spShmBitmap->Init(szScreen.cx, szScreen.cy, nullptr)) {
+            void* pPixelBits = spShmBitmap->LockPixelBits();
+            const size_t nPixelBitsLen = static_cast<size_t>(szScreen.cx) * static_cast<size_t>(szScreen.cy) * 4;
+            bool bCaptured = (pPixelBits != nullptr) &&
+                             shmCapture.CaptureRegion(UiRect(0, 0, szScreen.cx, szScreen.cy), pPixelBits, nPixelBitsLen);
+            spShmBitmap->UnLockPixelBits();
+            if (bCaptured) {
+                return spShmBitmap;
+            }
+        }
+    }
+    shmCapture.Clear();
+
     // 打开X服务器连接（使用环境变量DISPLAY）
     ::Display* display = ::XOpenDisplay(nullptr);
     if (!display) {
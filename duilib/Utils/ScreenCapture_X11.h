@@ -18,6 +18,56 @@ public:
     static std::shared_ptr<IBitmap> CaptureBitmap(const Window* pWindow);
 };
 
+/** 基于MIT-SHM扩展（XShmGetImage）的屏幕区域截图（Linux X11的实现）
+*   X服务器直接将图像写入共享内存段，共享内存段在多次截图之间重复使用，适合连续截图
+*   X服务器不支持MIT-SHM扩展时（比如远程X服务器），Init函数返回false
+*/
+class UILIB_API ScreenCaptureShm_X11
+{
+public:
+    ScreenCaptureShm_X11();
+    ~ScreenCaptureShm_X11();
+    ScreenCaptureShm_X11(const ScreenCaptureShm_X11&) = delete;
+    ScreenCaptureShm_X11& operator = (const ScreenCaptureShm_X11&) = delete;
+
+public:
+    /** 初始化：连接X服务器，并检查是否支持MIT-SHM扩展
+    * @param [in] pWindow 窗口（截取该窗口所在的屏幕）
+    */
+    bool Init(const Window* pWindow);
+
+    /** 获取屏幕的大小（Init成功后有效）
+    */
+    UiSize GetScreenSize() const;
+
+    /** 截取屏幕的一个区域，截取的图像数据为RGBA格式（每个像素4字节：R, G, B, A）
+    * @param [in] rcRegion 截取的区域（屏幕坐标，超出屏幕的部分被裁剪）
+    * @param [in] pPixelBits 图像数据的目标缓冲区，每行数据长度为：rcRegion.Width() * 4
+    * @param [in] nPixelBitsLen 目标缓冲区的长度，需要满足：nPixelBitsLen >= rcRegion.Width() * rcRegion.Height() * 4
+    * @return 成功返回true，失败返回false（目标缓冲区中超出屏幕的部分不写入数据）
+    */
+    bool CaptureRegion(const UiRect& rcRegion, void* pPixelBits, size_t nPixelBitsLen);
+
+    /** 释放共享内存段，并断开与X服务器的连接
+    */
+    void Clear();
+
+private:
+    /** 确保共享内存段中的图像大小与截取区域的大小一致（大小变化时重新创建）
+    */
+    bool CheckShmImage(int32_t nWidth, int32_t nHeight);
+
+    /** 释放共享内存段
+    */
+    void DestroyShmImage();
+
+private:
+    /** X11相关的数据
+    */
+    struct TShmData;
+    std::unique_ptr<TShmData> m_spShmData;
+};
+
 } // namespace ui
 
 #endif // UI_UTILS_SCREEN_CAPTURE_X11_H_
@@ -0,0 +1,175 @@
+#include "ScreenRegionCapture.h"
+#include "duilib/Core/GlobalManager.h"
+
+#if defined (DUILIB_BUILD_FOR_LINUX) || defined (DUILIB_BUILD_FOR_FREEBSD)
+    #include "ScreenCapture_X11.h"
+    #include "ScreenCapture_Wayland.h"
+#endif
+
+#include <cstring>
+#include <algorithm>
+
+//循环使用的位图个数上限
+#define MAX_CAPTURE_BITMAP_COUNT 3
+
+namespace ui
+{
+
+ScreenRegionCapture::ScreenRegionCapture()
+{
+}
+
+ScreenRegionCapture::~ScreenRegionCapture()
+{
+    Stop();
+}
+
+bool ScreenRegionCapture::IsSupported(const Window* pWindow)
+{
+#if defined (DUILIB_BUILD_FOR_LINUX) || defined (DUILIB_BUILD_FOR_FREEBSD)
+    if (ScreenCapture_Wayland::IsWaylandEnvironment()) {
+        return false;
+    }
+    ScreenCaptureShm_X11 shmCapture;
+    return shmCapture.Init(pWindow);
+#else
+    (void)pWindow;
+    return false;
+#endif
+}
+
+bool ScreenRegionCapture::Start(const Window* pWindow, const UiRect& rcRegion, int32_t nFrameRate,
+                                const ScreenCaptureFrameCallback& callback)
+{
+    GlobalManager::Instance().AssertUIThread();
+    Stop();
+#if defined (DUILIB_BUILD_FOR_LINUX) || defined (DUILIB_BUILD_FOR_FREEBSD)
+    if ((pWindow == nullptr) || ScreenCapture_Wayland::IsWaylandEnvironment()) {
+        return false;
+    }
+    m_spShmCapture = std::make_unique<ScreenCaptureShm_X11>();
+    if (!m_spShmCapture->Init(pWindow)) {
+        m_spShmCapture.reset();
+        return false;
+    }
+    m_rcRegion = rcRegion;
+    m_callback = callback;
+    CaptureFrame();
+
+    nFrameRate = std::max(nFrameRate, 1);
+    nFrameRate = std::min(nFrameRate, 120);
+    GlobalManager::Instance().Timer().AddTimer(m_timerFlag.GetWeakFlag(),
+                                               [this]() { CaptureFrame(); },
+                                               (uint32_t)(1000 / nFrameRate));
+    return true;
+#else
+    (void)pWindow;
+    (void)rcRegion;
+    (void)nFrameRate;
+    (void)callback;
+    return false;
+#endif
+}
+
+void ScreenRegionCapture::Stop()
+{
+    m_timerFlag.Cancel();
+    m_callback = nullptr;
+    m_bitmaps.clear();
+#if defined (DUILIB_BUILD_FOR_LINUX) || defined (DUILIB_BUILD_FOR_FREEBSD)
+    m_spShmCapture.reset();
+#endif
+}
+
+bool ScreenRegionCapture::IsRunning() const
+{
+#if defined (DUILIB_BUILD_FOR_LINUX) || defined (DUILIB_BUILD_FOR_FREEBSD)
+    return m_spShmCapture != nullptr;
+#else
+    return false;
+#endif
+}
+
+void ScreenRegionCapture::SetRegion(const UiRect& rcRegion)
+{
+    m_rcRegion = rcRegion;
+}
+
+const UiRect& ScreenRegionCapture::GetRegion() const
+{
+    return m_rcRegion;
+}
+
+bool ScreenRegionCapture::CaptureFrame()
+{
+#if defined (DUILIB_BUILD_FOR_LINUX) || defined (DUILIB_BUILD_FOR_FREEBSD)
+    if ((m_spShmCapture == nullptr) || m_rcRegion.IsEmpty()) {
+        return false;
+    }
+    const int32_t nWidth = m_rcRegion.Width();
+    const int32_t nHeight = m_rcRegion.Height();
+    std::shared_ptr<IBitmap> spBitmap = GetFreeBitmap(nWidth, nHeight);
+    if (spBitmap == nullptr) {
+        return false;
+    }
+    const size_t nPixelBitsLen = static_cast<size_t>(nWidth) * static_cast<size_t>(nHeight) * 4;
+    void* pPixelBits = spBitmap->LockPixelBits();
+    bool bCaptured = false;
+    if (pPixelBits != nullptr) {
+        const UiSize szScreen = m_spShmCapture->GetScreenSize();
+        UiRect rcScreen(0, 0, szScreen.cx, szScreen.cy);
+        if (!rcScreen.ContainsRect(m_rcRegion)) {
+            //超出屏幕的部分，填充为透明
+            ::memset(pPixelBits, 0, nPixelBitsLen);
+        }
+        bCaptured = m_spShmCapture->CaptureRegion(m_rcRegion, pPixelBits, nPixelBitsLen);
+    }
+    spBitmap->UnLockPixelBits();
+    if (!bCaptured) {
+        return false;
+    }
+    if (m_callback) {
+        //回调函数中可能调用Stop函数，所以使用副本
+        ScreenCaptureFrameCallback callback = m_callback;
+        callback(spBitmap);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::shared_ptr<IBitmap> ScreenRegionCapture::GetFreeBitmap(int32_t nWidth, int32_t nHeight)
+{
+    //截取区域的大小已经变化的位图，不再使用
+    auto iterRemove = std::remove_if(m_bitmaps.begin(), m_bitmaps.end(),
+                                     [nWidth, nHeight](const std::shared_ptr<IBitmap>& spBitmap) {
+                                         return ((int32_t)spBitmap->GetWidth() != nWidth) ||
+                                                ((int32_t)spBitmap->GetHeight() != nHeight);
+                                     });
+    m_bitmaps.erase(iterRemove, m_bitmaps.end());
+    for (const std::shared_ptr<IBitmap>& spBitmap : m_bitmaps) {
+        if (spBitmap.use_count() == 1) {
+            //没有被外部引用，可以重新写入
+            return spBitmap;
+        }
+    }
+
+    IRenderFactory* pRenderFactory = GlobalManager::Instance().GetRenderFactory();
+    ASSERT(pRenderFactory != nullptr);
+    if (pRenderFactory == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<IBitmap> spBitmap(pRenderFactory->CreateBitmap());
+    if ((spBitmap == nullptr) || !spBitmap->Init(nWidth, nHeight, nullptr)) {
+        return nullptr;
+    }
+    if (m_bitmaps.size() >= MAX_CAPTURE_BITMAP_COUNT) {
+        //所有位图都被外部引用，不再跟踪最早的位图
+        m_bitmaps.erase(m_bitmaps.begin());
+    }
+    m_bitmaps.push_back(spBitmap);
+    return spBitmap;
+}
+
+} // namespace ui
@@ -0,0 +1,101 @@
+#ifndef UI_UTILS_SCREEN_REGION_CAPTURE_H_
+#define UI_UTILS_SCREEN_REGION_CAPTURE_H_
+
+#include "duilib/Render/IRender.h"
+#include "duilib/Core/Window.h"
+#include "duilib/Core/Callback.h"
+#include <memory>
+#include <vector>
+#include <functional>
+
+namespace ui
+{
+class ScreenCaptureShm_X11;
+
+/** 连续截图时，每一帧的回调函数
+* @param [in] spBitmap 截取的位图，图像数据的格式与ScreenCapture::CaptureBitmap相同
+*                      位图在后续帧中循环使用：回调函数返回后，如果未保留该位图的引用，该位图会被后续帧重新写入
+*/
+typedef std::function<void(const std::shared_ptr<IBitmap>& spBitmap)> ScreenCaptureFrameCallback;
+
+/** 连续截取屏幕的一个区域（用于放大镜、屏幕标注等功能）：按目标帧率在UI线程中重复截取，
+*   截取的图像写入循环使用的位图中，避免每帧分配位图
+*   目前仅支持Linux X11平台（基于MIT-SHM扩展），其他平台Start函数返回false
+*/
+class UILIB_API ScreenRegionCapture
+{
+public:
+    ScreenRegionCapture();
+    ~ScreenRegionCapture();
+    ScreenRegionCapture(const ScreenRegionCapture&) = delete;
+    ScreenRegionCapture& operator = (const ScreenRegionCapture&) = delete;
+
+public:
+    /** 检查当前平台是否支持连续截图
+    * @param [in] pWindow 窗口（截取该窗口所在的屏幕）
+    */
+    static bool IsSupported(const Window* pWindow);
+
+    /** 开始连续截图（立即截取第一帧）
+    * @param [in] pWindow 窗口（截取该窗口所在的屏幕）
+    * @param [in] rcRegion 截取的区域（屏幕坐标）
+    * @param [in] nFrameRate 目标帧率（每秒截取的帧数），有效范围：[1, 120]
+    * @param [in] callback 每一帧的回调函数（在UI线程中调用）
+    * @return 当前平台不支持或者初始化失败时返回false
+    */
+    bool Start(const Window* pWindow, const UiRect& rcRegion, int32_t nFrameRate,
+               const ScreenCaptureFrameCallback& callback);
+
+    /** 停止连续截图
+    */
+    void Stop();
+
+    /** 是否正在连续截图
+    */
+    bool IsRunning() const;
+
+    /** 修改截取的区域（比如放大镜跟随鼠标移动），下一帧生效
+    * @param [in] rcRegion 截取的区域（屏幕坐标）
+    */
+    void SetRegion(const UiRect& rcRegion);
+
+    /** 获取截取的区域
+    */
+    const UiRect& GetRegion() const;
+
+    /** 立即截取一帧，并调用回调函数
+    */
+    bool CaptureFrame();
+
+private:
+    /** 获取一个可以写入的位图（没有被外部引用、大小与截取区域一致的位图）
+    */
+    std::shared_ptr<IBitmap> GetFreeBitmap(int32_t nWidth, int32_t nHeight);
+
+private:
+    /** 截取的区域
+    */
+    UiRect m_rcRegion;
+
+    /** 每一帧的回调函数
+    */
+    ScreenCaptureFrameCallback m_callback;
+
+    /** 循环使用的位图
+    */
+    std::vector<std::shared_ptr<IBitmap>> m_bitmaps;
+
+    /** 定时器的取消机制
+    */
+    WeakCallbackFlag m_timerFlag;
+
+#if defined (DUILIB_BUILD_FOR_LINUX) || defined (DUILIB_BUILD_FOR_FREEBSD)
+    /** 基于MIT-SHM扩展的截图实现
+    */
+    std::unique_ptr<ScreenCaptureShm_X11> m_spShmCapture;
+#endif
+};
+
+} // namespace ui
+
+#endif // UI_UTILS_SCREEN_REGION_CAPTURE_H_
@@ -1,42 +1,665 @@
 #include "StringConvert.h"
-#include "duilib/third_party/convert_utf/ConvertUTF.h"
-#include <vector>
+#include <cstring>
+#include <algorithm>
 
-using namespace llvm; //for ConvertUTF.h
+//ASCII字符的快速处理：x86/x64平台使用SSE2指令，ARM64平台使用NEON指令，其他平台每次处理8个字节
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define DUILIB_UTF_CONVERT_SSE2
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define DUILIB_UTF_CONVERT_NEON
+#endif
+
+//Unicode的替换字符
+#define UNICODE_REPLACEMENT_CHAR 0xFFFD
+
+//Unicode的最大字符
+#define UNICODE_MAX_CHAR 0x10FFFF
+
+//批量处理中断后（遇到非ASCII字符或者代理区字符），逐个字符处理的字符个数，之后再尝试批量处理
+#define UTF_CONVERT_BLOCK_SIZE 16
 
 namespace ui
 {
+/** 获取开头连续的ASCII字符个数（UTF8），只统计完整的块（每块16个字节，不支持SIMD指令时每块8个字节），
+*   不足一块的部分由调用方逐个字符处理
+*/
+static size_t GetASCIILength(const DUTF8Char* src, size_t length)
+{
+    size_t nIndex = 0;
+#if defined(DUILIB_UTF_CONVERT_SSE2)
+    for (; nIndex + 16 <= length; nIndex += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + nIndex));
+        if (_mm_movemask_epi8(chunk) != 0) {
+            break;
+        }
+    }
+#elif defined(DUILIB_UTF_CONVERT_NEON)
+    for (; nIndex + 16 <= length; nIndex += 16) {
+        if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(src + nIndex))) >= 0x80) {
+            break;
+        }
+    }
+#else
+    for (; nIndex + 8 <= length; nIndex += 8) {
+        uint64_t chunk = 0;
+        ::memcpy(&chunk, src + nIndex, sizeof(chunk));
+        if ((chunk & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+#endif
+    return nIndex;
+}
 
-std::basic_string<DUTF16Char> StringConvert::UTF8ToUTF16(const DUTF8Char* utf8, size_t length)
+/** 获取开头连续的ASCII字符个数（UTF16），只统计完整的块（每块8个字符，不支持SIMD指令时每块4个字符）
+*/
+static size_t GetASCIILength(const DUTF16Char* src, size_t length)
 {
-    if ((utf8 == nullptr) || (length == 0)) {
-        return std::basic_string<DUTF16Char>();
+    size_t nIndex = 0;
+#if defined(DUILIB_UTF_CONVERT_SSE2)
+    const __m128i mask = _mm_set1_epi16((short)0xFF80);
+    const __m128i zero = _mm_setzero_si128();
+    for (; nIndex + 8 <= length; nIndex += 8) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + nIndex));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(chunk, mask), zero)) != 0xFFFF) {
+            break;
+        }
+    }
+#elif defined(DUILIB_UTF_CONVERT_NEON)
+    for (; nIndex + 8 <= length; nIndex += 8) {
+        if (vmaxvq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(src + nIndex))) >= 0x80) {
+            break;
+        }
     }
-    std::vector<DUTF16Char> data;
-    data.resize(8192);
-    DUTF16Char* output = &data[0];
-    const UTF8* src_begin = reinterpret_cast<const UTF8*>(utf8);
-    const UTF8* src_end = src_begin + length;
-    UTF16* dst_begin = reinterpret_cast<UTF16*>(output);
+#else
+    for (; nIndex + 4 <= length; nIndex += 4) {
+        uint64_t chunk = 0;
+        ::memcpy(&chunk, src + nIndex, sizeof(chunk));
+        if ((chunk & 0xFF80FF80FF80FF80ULL) != 0) {
+            break;
+        }
+    }
+#endif
+    return nIndex;
+}
 
-    std::basic_string<DUTF16Char> utf16;
-    while (src_begin < src_end) {
-        ConversionResult result = ConvertUTF8toUTF16(&src_begin,
-                                                     src_end,
-                                                     &dst_begin,
-                                                     dst_begin + data.size(),
-                                                     lenientConversion);
-        utf16.append((const DUTF16Char*)output, dst_begin - reinterpret_cast<UTF16*>(output));
-        dst_begin = reinterpret_cast<UTF16*>(output);
-        if (result == sourceIllegal || result == sourceExhausted)
-        {
-            utf16.clear();
+/** 获取开头连续的ASCII字符个数（UTF32），只统计完整的块（每块4个字符，不支持SIMD指令时每块2个字符）
+*/
+static size_t GetASCIILength(const DUTF32Char* src, size_t length)
+{
+    size_t nIndex = 0;
+#if defined(DUILIB_UTF_CONVERT_SSE2)
+    const __m128i mask = _mm_set1_epi32((int)0xFFFFFF80);
+    const __m128i zero = _mm_setzero_si128();
+    for (; nIndex + 4 <= length; nIndex += 4) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + nIndex));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(chunk, mask), zero)) != 0xFFFF) {
+            break;
+        }
+    }
+#elif defined(DUILIB_UTF_CONVERT_NEON)
+    for (; nIndex + 4 <= length; nIndex += 4) {
+        if (vmaxvq_u32(vld1q_u32(reinterpret_cast<const uint32_t*>(src + nIndex))) >= 0x80) {
+            break;
+        }
+    }
+#else
+    for (; nIndex + 2 <= length; nIndex += 2) {
+        uint64_t chunk = 0;
+        ::memcpy(&chunk, src + nIndex, sizeof(chunk));
+        if ((chunk & 0xFFFFFF80FFFFFF80ULL) != 0) {
+            break;
+        }
+    }
+#endif
+    return nIndex;
+}
+
+/** ASCII字符转换为UTF16或者UTF32字符
+*/
+template<typename TChar>
+static void WidenASCII(const DUTF8Char* src, size_t length, TChar* output)
+{
+    static_assert((sizeof(TChar) == 2) || (sizeof(TChar) == 4), "invalid char type!");
+    size_t nIndex = 0;
+#if defined(DUILIB_UTF_CONVERT_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; nIndex + 16 <= length; nIndex += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + nIndex));
+        const __m128i lo = _mm_unpacklo_epi8(chunk, zero);
+        const __m128i hi = _mm_unpackhi_epi8(chunk, zero);
+        __m128i* dst = reinterpret_cast<__m128i*>(output + nIndex);
+        if constexpr (sizeof(TChar) == 2) {
+            _mm_storeu_si128(dst, lo);
+            _mm_storeu_si128(dst + 1, hi);
+        }
+        else {
+            _mm_storeu_si128(dst, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(hi, zero));
+        }
+    }
+#elif defined(DUILIB_UTF_CONVERT_NEON)
+    for (; nIndex + 16 <= length; nIndex += 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(src + nIndex));
+        const uint16x8_t lo = vmovl_u8(vget_low_u8(chunk));
+        const uint16x8_t hi = vmovl_high_u8(chunk);
+        if constexpr (sizeof(TChar) == 2) {
+            uint16_t* dst = reinterpret_cast<uint16_t*>(output + nIndex);
+            vst1q_u16(dst, lo);
+            vst1q_u16(dst + 8, hi);
+        }
+        else {
+            uint32_t* dst = reinterpret_cast<uint32_t*>(output + nIndex);
+            vst1q_u32(dst, vmovl_u16(vget_low_u16(lo)));
+            vst1q_u32(dst + 4, vmovl_high_u16(lo));
+            vst1q_u32(dst + 8, vmovl_u16(vget_low_u16(hi)));
+            vst1q_u32(dst + 12, vmovl_high_u16(hi));
+        }
+    }
+#endif
+    for (; nIndex < length; ++nIndex) {
+        output[nIndex] = (TChar)src[nIndex];
+    }
+}
+
+/** UTF16或者UTF32格式的ASCII字符转换为UTF8字符
+*/
+template<typename TChar>
+static void NarrowASCII(const TChar* src, size_t length, DUTF8Char* output)
+{
+    static_assert((sizeof(TChar) == 2) || (sizeof(TChar) == 4), "invalid char type!");
+    size_t nIndex = 0;
+#if defined(DUILIB_UTF_CONVERT_SSE2)
+    for (; nIndex + 16 <= length; nIndex += 16) {
+        const __m128i* chunk = reinterpret_cast<const __m128i*>(src + nIndex);
+        __m128i result;
+        if constexpr (sizeof(TChar) == 2) {
+            result = _mm_packus_epi16(_mm_loadu_si128(chunk), _mm_loadu_si128(chunk + 1));
+        }
+        else {
+            const __m128i lo = _mm_packs_epi32(_mm_loadu_si128(chunk), _mm_loadu_si128(chunk + 1));
+            const __m128i hi = _mm_packs_epi32(_mm_loadu_si128(chunk + 2), _mm_loadu_si128(chunk + 3));
+            result = _mm_packus_epi16(lo, hi);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + nIndex), result);
+    }
+#elif defined(DUILIB_UTF_CONVERT_NEON)
+    for (; nIndex + 16 <= length; nIndex += 16) {
+        uint8x16_t result;
+        if constexpr (sizeof(TChar) == 2) {
+            const uint16_t* chunk = reinterpret_cast<const uint16_t*>(src + nIndex);
+            result = vcombine_u8(vmovn_u16(vld1q_u16(chunk)), vmovn_u16(vld1q_u16(chunk + 8)));
+        }
+        else {
+            const uint32_t* chunk = reinterpret_cast<const uint32_t*>(src + nIndex);
+            const uint16x8_t lo = vcombine_u16(vmovn_u32(vld1q_u32(chunk)), vmovn_u32(vld1q_u32(chunk + 4)));
+            const uint16x8_t hi = vcombine_u16(vmovn_u32(vld1q_u32(chunk + 8)), vmovn_u32(vld1q_u32(chunk + 12)));
+            result = vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+        }
+        vst1q_u8(reinterpret_cast<uint8_t*>(output + nIndex), result);
+    }
+#endif
+    for (; nIndex < length; ++nIndex) {
+        output[nIndex] = (DUTF8Char)src[nIndex];
+    }
+}
+
+/** 获取一个UTF8字符的字节数，不是合法的UTF8编码（包括不完整的编码）时返回0
+*   合法的编码规则见Unicode标准的表3-7：不允许超长编码、代理区字符以及大于0x10FFFF的字符
+*/
+static inline size_t GetUTF8CharBytes(const uint8_t* src, size_t length)
+{
+    const uint8_t lead = src[0];
+    if (lead < 0x80) {
+        return 1;
+    }
+    if (lead < 0xC2) {
+        return 0;
+    }
+    if (lead < 0xE0) {
+        return ((length >= 2) && ((src[1] & 0xC0) == 0x80)) ? 2 : 0;
+    }
+    //第二个字节的取值范围与首字节相关
+    uint8_t lower = 0x80;
+    uint8_t upper = 0xBF;
+    if (lead < 0xF0) {
+        if (lead == 0xE0) {
+            lower = 0xA0;
+        }
+        else if (lead == 0xED) {
+            upper = 0x9F;
+        }
+        if ((length < 3) || (src[1] < lower) || (src[1] > upper) || ((src[2] & 0xC0) != 0x80)) {
+            return 0;
+        }
+        return 3;
+    }
+    if (lead < 0xF5) {
+        if (lead == 0xF0) {
+            lower = 0x90;
+        }
+        else if (lead == 0xF4) {
+            upper = 0x8F;
+        }
+        if ((length < 4) || (src[1] < lower) || (src[1] > upper) ||
+            ((src[2] & 0xC0) != 0x80) || ((src[3] & 0xC0) != 0x80)) {
+            return 0;
+        }
+        return 4;
+    }
+    return 0;
+}
+
+/** 读取一个已经校验过的UTF8字符
+*/
+static inline uint32_t ReadValidUTF8Char(const uint8_t* src, size_t& nIndex)
+{
+    //各个字节直接累加后，减去各个字节中的编码标记位
+    static const uint32_t offsetsFromUTF8[5] = { 0, 0x00000000, 0x00003080, 0x000E2080, 0x03C82080 };
+    const uint8_t lead = src[nIndex];
+    const size_t nBytes = 1 + (size_t)(lead >= 0xC0) + (size_t)(lead >= 0xE0) + (size_t)(lead >= 0xF0);
+    uint32_t ch = 0;
+    switch (nBytes) {
+    case 4:
+        ch += src[nIndex++];
+        ch <<= 6;
+        [[fallthrough]];
+    case 3:
+        ch += src[nIndex++];
+        ch <<= 6;
+        [[fallthrough]];
+    case 2:
+        ch += src[nIndex++];
+        ch <<= 6;
+        [[fallthrough]];
+    default:
+        ch += src[nIndex++];
+        break;
+    }
+    return ch - offsetsFromUTF8[nBytes];
+}
+
+/** 统计UTF8字符串中的字符个数，同时校验编码
+* @param [out] nCharCount 字符的个数
+* @param [out] nSupplementaryCount 其中大于0xFFFF的字符个数（转换为UTF16时需要两个字符）
+* @return 不是合法的UTF8编码时返回false
+*/
+static bool CountUTF8Chars(const DUTF8Char* utf8, size_t length, size_t& nCharCount, size_t& nSupplementaryCount)
+{
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(utf8);
+    nCharCount = 0;
+    nSupplementaryCount = 0;
+    size_t nIndex = 0;
+    while (nIndex < length) {
+        //连续的ASCII字符批量处理，遇到非ASCII字符时，所在的一组字符逐个处理
+        const size_t nASCIICount = GetASCIILength(utf8 + nIndex, length - nIndex);
+        nCharCount += nASCIICount;
+        nIndex += nASCIICount;
+        const size_t nBlockEnd = std::min(nIndex + UTF_CONVERT_BLOCK_SIZE, length);
+        while (nIndex < nBlockEnd) {
+            const size_t nCharBytes = GetUTF8CharBytes(src + nIndex, length - nIndex);
+            if (nCharBytes == 0) {
+                return false;
+            }
+            nSupplementaryCount += (nCharBytes == 4) ? 1 : 0;
+            ++nCharCount;
+            nIndex += nCharBytes;
+        }
+    }
+    return true;
+}
+
+/** 已经校验过的UTF8字符串转换为UTF16或者UTF32字符串（输出缓冲区的长度由CountUTF8Chars计算）
+*/
+template<typename TChar>
+static void ConvertValidUTF8(const DUTF8Char* utf8, size_t length, TChar* output)
+{
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(utf8);
+    size_t nIndex = 0;
+    while (nIndex < length) {
+        //连续的ASCII字符批量处理，遇到非ASCII字符时，所在的一组字符逐个处理
+        const size_t nASCIICount = GetASCIILength(utf8 + nIndex, length - nIndex);
+        if (nASCIICount > 0) {
+            WidenASCII(utf8 + nIndex, nASCIICount, output);
+            output += nASCIICount;
+            nIndex += nASCIICount;
+        }
+        const size_t nBlockEnd = std::min(nIndex + UTF_CONVERT_BLOCK_SIZE, length);
+        while (nIndex < nBlockEnd) {
+            const uint32_t ch = ReadValidUTF8Char(src, nIndex);
+            if constexpr (sizeof(TChar) == 2) {
+                if (ch > 0xFFFF) {
+                    *output++ = (TChar)(((ch - 0x10000) >> 10) + 0xD800);
+                    *output++ = (TChar)(((ch - 0x10000) & 0x3FF) + 0xDC00);
+                    continue;
+                }
+            }
+            *output++ = (TChar)ch;
+        }
+    }
+}
+
+/** 读取一个UTF16字符：代理对合并为一个字符，未配对的代理区字符按原值返回
+*/
+static inline uint32_t ReadUTF16Char(const DUTF16Char* utf16, size_t length, size_t& nIndex)
+{
+    uint32_t ch = (uint16_t)utf16[nIndex++];
+    if ((ch >= 0xD800) && (ch <= 0xDBFF) && (nIndex < length)) {
+        const uint32_t ch2 = (uint16_t)utf16[nIndex];
+        if ((ch2 >= 0xDC00) && (ch2 <= 0xDFFF)) {
+            ch = ((ch - 0xD800) << 10) + (ch2 - 0xDC00) + 0x10000;
+            ++nIndex;
+        }
+    }
+    return ch;
+}
+
+/** 获取一个字符按UTF8编码后的字节数
+*/
+static inline size_t GetUTF8EncodeBytes(uint32_t ch)
+{
+    return 1 + (size_t)(ch >= 0x80) + (size_t)(ch >= 0x800) + (size_t)(ch >= 0x10000);
+}
+
+/** 将一个字符（不大于0x10FFFF）按UTF8编码写入缓冲区，返回写入后的位置
+*/
+static inline DUTF8Char* WriteUTF8Char(uint32_t ch, DUTF8Char* output)
+{
+    static const uint8_t firstByteMark[5] = { 0x00, 0x00, 0xC0, 0xE0, 0xF0 };
+    const size_t nBytes = GetUTF8EncodeBytes(ch);
+    output += nBytes;
+    switch (nBytes) {
+    case 4:
+        *--output = (DUTF8Char)(0x80 | (ch & 0x3F));
+        ch >>= 6;
+        [[fallthrough]];
+    case 3:
+        *--output = (DUTF8Char)(0x80 | (ch & 0x3F));
+        ch >>= 6;
+        [[fallthrough]];
+    case 2:
+        *--output = (DUTF8Char)(0x80 | (ch & 0x3F));
+        ch >>= 6;
+        [[fallthrough]];
+    default:
+        *--output = (DUTF8Char)(ch | firstByteMark[nBytes]);
+        break;
+    }
+    return output + nBytes;
+}
+
+/** 计算开头连续的不含代理区字符的UTF16字符转换为UTF8后的长度（每次批量处理8个字符）
+* @param [out] nUTF8Length 累加转换为UTF8后的长度
+* @return 返回已经处理的字符个数，遇到代理区字符或者剩余不足8个字符时停止，由调用方逐个字符处理
+*/
+static size_t GetUTF16RunUTF8Length(const DUTF16Char* src, size_t length, size_t& nUTF8Length)
+{
+    size_t nIndex = 0;
+#if defined(DUILIB_UTF_CONVERT_SSE2)
+    //每个字符按3个字节计算，小于0x800的少1个字节，小于0x80的再少1个字节；
+    //比较结果为-1，按列累加（每列每次最多减2，每8192次汇总一次，避免溢出）
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i asciiMask = _mm_set1_epi16((short)0xFF80);
+    const __m128i highMask = _mm_set1_epi16((short)0xF800);
+    const __m128i surrogate = _mm_set1_epi16((short)0xD800);
+    const __m128i one = _mm_set1_epi16(1);
+    __m128i lessBytes = zero;
+    size_t nLessBytes = 0;
+    size_t nBlockCount = 0;
+    while (nIndex + 8 <= length) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + nIndex));
+        const __m128i high = _mm_and_si128(chunk, highMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, surrogate)) != 0) {
             break;
         }
+        lessBytes = _mm_add_epi16(lessBytes, _mm_cmpeq_epi16(_mm_and_si128(chunk, asciiMask), zero));
+        lessBytes = _mm_add_epi16(lessBytes, _mm_cmpeq_epi16(high, zero));
+        nIndex += 8;
+        if ((++nBlockCount % 8192) == 0) {
+            int32_t sums[4] = {0, };
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sums), _mm_madd_epi16(lessBytes, one));
+            nLessBytes += (size_t)(-(sums[0] + sums[1] + sums[2] + sums[3]));
+            lessBytes = zero;
+        }
+    }
+    int32_t sums[4] = {0, };
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(sums), _mm_madd_epi16(lessBytes, one));
+    nLessBytes += (size_t)(-(sums[0] + sums[1] + sums[2] + sums[3]));
+    nUTF8Length += nIndex * 3 - nLessBytes;
+#elif defined(DUILIB_UTF_CONVERT_NEON)
+    //每个字符按3个字节计算，小于0x800的少1个字节，小于0x80的再少1个字节（每8192次汇总一次，避免溢出）
+    uint16x8_t lessBytes = vdupq_n_u16(0);
+    size_t nLessBytes = 0;
+    size_t nBlockCount = 0;
+    while (nIndex + 8 <= length) {
+        const uint16x8_t chunk = vld1q_u16(reinterpret_cast<const uint16_t*>(src + nIndex));
+        if (vmaxvq_u16(vceqq_u16(vandq_u16(chunk, vdupq_n_u16(0xF800)), vdupq_n_u16(0xD800))) != 0) {
+            break;
+        }
+        lessBytes = vsubq_u16(lessBytes, vcltq_u16(chunk, vdupq_n_u16(0x80)));
+        lessBytes = vsubq_u16(lessBytes, vcltq_u16(chunk, vdupq_n_u16(0x800)));
+        nIndex += 8;
+        if ((++nBlockCount % 8192) == 0) {
+            nLessBytes += vaddlvq_u16(lessBytes);
+            lessBytes = vdupq_n_u16(0);
+        }
     }
+    nLessBytes += vaddlvq_u16(lessBytes);
+    nUTF8Length += nIndex * 3 - nLessBytes;
+#else
+    (void)src;
+    (void)length;
+    (void)nUTF8Length;
+#endif
+    return nIndex;
+}
+
+/** 统计UTF16字符串中的字符个数，并计算转换为UTF8后的长度
+*   未配对的代理区字符按原值转换，但最后一个字符是高代理区字符时，认为字符串不完整
+* @param [out] nCharCount 字符的个数（代理对按一个字符计算）
+* @param [out] nUTF8Length 转换为UTF8后的长度
+* @return 字符串不完整时返回false
+*/
+static bool CountUTF16Chars(const DUTF16Char* utf16, size_t length, size_t& nCharCount, size_t& nUTF8Length)
+{
+    nCharCount = 0;
+    nUTF8Length = 0;
+    size_t nIndex = 0;
+    while (nIndex < length) {
+        //不含代理区字符的部分批量处理，遇到代理区字符时，所在的一组字符逐个处理
+        const size_t nRunLength = GetUTF16RunUTF8Length(utf16 + nIndex, length - nIndex, nUTF8Length);
+        nCharCount += nRunLength;
+        nIndex += nRunLength;
+        const size_t nBlockEnd = std::min(nIndex + UTF_CONVERT_BLOCK_SIZE, length);
+        while (nIndex < nBlockEnd) {
+            const uint32_t ch = (uint16_t)utf16[nIndex];
+            if ((ch >= 0xD800) && (ch <= 0xDBFF) && (nIndex + 1 == length)) {
+                return false;
+            }
+            nUTF8Length += GetUTF8EncodeBytes(ReadUTF16Char(utf16, length, nIndex));
+            ++nCharCount;
+        }
+    }
+    return true;
+}
+
+/** 已经校验过的UTF16字符串转换为UTF8字符串（输出缓冲区的长度由CountUTF16Chars计算）
+*/
+static void ConvertValidUTF16ToUTF8(const DUTF16Char* utf16, size_t length, DUTF8Char* output)
+{
+    size_t nIndex = 0;
+    while (nIndex < length) {
+        //连续的ASCII字符批量处理，遇到非ASCII字符时，所在的一组字符逐个处理
+        const size_t nASCIICount = GetASCIILength(utf16 + nIndex, length - nIndex);
+        if (nASCIICount > 0) {
+            NarrowASCII(utf16 + nIndex, nASCIICount, output);
+            output += nASCIICount;
+            nIndex += nASCIICount;
+        }
+        const size_t nBlockEnd = std::min(nIndex + UTF_CONVERT_BLOCK_SIZE, length);
+        while (nIndex < nBlockEnd) {
+            const uint32_t ch = (uint16_t)utf16[nIndex];
+            if ((ch >= 0x800) && ((ch < 0xD800) || (ch > 0xDBFF))) {
+                //常用的汉字等字符（不是代理对）
+                output[0] = (DUTF8Char)(0xE0 | (ch >> 12));
+                output[1] = (DUTF8Char)(0x80 | ((ch >> 6) & 0x3F));
+                output[2] = (DUTF8Char)(0x80 | (ch & 0x3F));
+                output += 3;
+                ++nIndex;
+                continue;
+            }
+            output = WriteUTF8Char(ReadUTF16Char(utf16, length, nIndex), output);
+        }
+    }
+}
+
+/** 计算开头连续的合法UTF32字符转换为UTF8后的长度（每次批量处理4个字符）
+* @param [out] nUTF8Length 累加转换为UTF8后的长度
+* @return 返回已经处理的字符个数，遇到大于0x10FFFF的字符或者剩余不足4个字符时停止，由调用方逐个字符处理
+*/
+static size_t GetUTF32RunUTF8Length(const DUTF32Char* src, size_t length, size_t& nUTF8Length)
+{
+    size_t nIndex = 0;
+#if defined(DUILIB_UTF_CONVERT_SSE2)
+    //每个字符按1个字节计算，大于0x7F、0x7FF、0xFFFF时分别多1个字节；
+    //按有符号数比较（大于0x7FFFFFFF的值为负数），比较结果为-1，按列累加
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i maxChar = _mm_set1_epi32(UNICODE_MAX_CHAR);
+    const __m128i oneByteMax = _mm_set1_epi32(0x7F);
+    const __m128i twoBytesMax = _mm_set1_epi32(0x7FF);
+    const __m128i threeBytesMax = _mm_set1_epi32(0xFFFF);
+    __m128i extraBytes = zero;
+    while (nIndex + 4 <= length) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + nIndex));
+        const __m128i invalid = _mm_or_si128(_mm_cmpgt_epi32(chunk, maxChar), _mm_cmplt_epi32(chunk, zero));
+        if (_mm_movemask_epi8(invalid) != 0) {
+            break;
+        }
+        extraBytes = _mm_add_epi32(extraBytes, _mm_cmpgt_epi32(chunk, oneByteMax));
+        extraBytes = _mm_add_epi32(extraBytes, _mm_cmpgt_epi32(chunk, twoBytesMax));
+        extraBytes = _mm_add_epi32(extraBytes, _mm_cmpgt_epi32(chunk, threeBytesMax));
+        nIndex += 4;
+    }
+    int32_t sums[4] = {0, };
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(sums), extraBytes);
+    nUTF8Length += nIndex + (size_t)(-((int64_t)sums[0] + sums[1] + sums[2] + sums[3]));
+#elif defined(DUILIB_UTF_CONVERT_NEON)
+    //每个字符按1个字节计算，大于0x7F、0x7FF、0xFFFF时分别多1个字节
+    uint32x4_t extraBytes = vdupq_n_u32(0);
+    while (nIndex + 4 <= length) {
+        const uint32x4_t chunk = vld1q_u32(reinterpret_cast<const uint32_t*>(src + nIndex));
+        if (vmaxvq_u32(chunk) > UNICODE_MAX_CHAR) {
+            break;
+        }
+        extraBytes = vsubq_u32(extraBytes, vcgtq_u32(chunk, vdupq_n_u32(0x7F)));
+        extraBytes = vsubq_u32(extraBytes, vcgtq_u32(chunk, vdupq_n_u32(0x7FF)));
+        extraBytes = vsubq_u32(extraBytes, vcgtq_u32(chunk, vdupq_n_u32(0xFFFF)));
+        nIndex += 4;
+    }
+    nUTF8Length += nIndex + vaddvq_u32(extraBytes);
+#else
+    (void)src;
+    (void)length;
+    (void)nUTF8Length;
+#endif
+    return nIndex;
+}
+
+/** 计算UTF32字符串转换为UTF8后的长度（代理区字符按原值转换）
+* @return 包含大于0x10FFFF的字符时返回false
+*/
+static bool GetUTF32ToUTF8Length(const DUTF32Char* utf32, size_t length, size_t& nUTF8Length)
+{
+    nUTF8Length = 0;
+    size_t nIndex = 0;
+    while (nIndex < length) {
+        nIndex += GetUTF32RunUTF8Length(utf32 + nIndex, length - nIndex, nUTF8Length);
+        if (nIndex >= length) {
+            break;
+        }
+        const uint32_t ch = (uint32_t)utf32[nIndex];
+        if (ch > UNICODE_MAX_CHAR) {
+            return false;
+        }
+        nUTF8Length += GetUTF8EncodeBytes(ch);
+        ++nIndex;
+    }
+    return true;
+}
+
+/** 已经校验过的UTF32字符串转换为UTF8字符串（输出缓冲区的长度由GetUTF32ToUTF8Length计算）
+*/
+static void ConvertValidUTF32ToUTF8(const DUTF32Char* utf32, size_t length, DUTF8Char* output)
+{
+    size_t nIndex = 0;
+    while (nIndex < length) {
+        //连续的ASCII字符批量处理，遇到非ASCII字符时，所在的一组字符逐个处理
+        const size_t nASCIICount = GetASCIILength(utf32 + nIndex, length - nIndex);
+        if (nASCIICount > 0) {
+            NarrowASCII(utf32 + nIndex, nASCIICount, output);
+            output += nASCIICount;
+            nIndex += nASCIICount;
+        }
+        const size_t nBlockEnd = std::min(nIndex + UTF_CONVERT_BLOCK_SIZE, length);
+        for (; nIndex < nBlockEnd; ++nIndex) {
+            const uint32_t ch = (uint32_t)utf32[nIndex];
+            if ((ch >= 0x800) && (ch < 0x10000)) {
+                //常用的汉字等字符
+                output[0] = (DUTF8Char)(0xE0 | (ch >> 12));
+                output[1] = (DUTF8Char)(0x80 | ((ch >> 6) & 0x3F));
+                output[2] = (DUTF8Char)(0x80 | (ch & 0x3F));
+                output += 3;
+                continue;
+            }
+            output = WriteUTF8Char(ch, output);
+        }
+    }
+}
+
+std::basic_string<DUTF16Char> StringConvert::UTF8ToUTF16(const DUTF8Char* utf8, size_t length)
+{
+    std::basic_string<DUTF16Char> utf16;
+    UTF8ToUTF16(utf8, length, utf16);
     return utf16;
 }
 
+bool StringConvert::UTF8ToUTF16(const DUTF8Char* utf8, size_t length, std::basic_string<DUTF16Char>& output)
+{
+    output.clear();
+    if ((utf8 == nullptr) || (length == 0)) {
+        return true;
+    }
+    size_t nCharCount = 0;
+    size_t nSupplementaryCount = 0;
+    if (!CountUTF8Chars(utf8, length, nCharCount, nSupplementaryCount)) {
+        return false;
+    }
+    output.resize(nCharCount + nSupplementaryCount);
+    ConvertValidUTF8(utf8, length, &output[0]);
+    return true;
+}
+
+size_t StringConvert::UTF8ToUTF16(const DUTF8Char* utf8, size_t length, DUTF16Char* output, size_t outputSize)
+{
+    if ((utf8 == nullptr) || (length == 0)) {
+        return 0;
+    }
+    size_t nCharCount = 0;
+    size_t nSupplementaryCount = 0;
+    if (!CountUTF8Chars(utf8, length, nCharCount, nSupplementaryCount)) {
+        return 0;
+    }
+    const size_t nOutputLength = nCharCount + nSupplementaryCount;
+    if ((output != nullptr) && (nOutputLength <= outputSize)) {
+        ConvertValidUTF8(utf8, length, output);
+    }
+    return nOutputLength;
+}
+
 DStringW StringConvert::UTF8ToWString(const std::string& utf8)
 {
 #if defined(WCHAR_T_IS_UTF16)
@@ -48,32 +671,41 @@ DStringW StringConvert::UTF8ToWString(const std::string& utf8)
 
 std::string StringConvert::UTF16ToUTF8(const DUTF16Char* utf16, size_t length)
 {
+    std::string utf8;
+    UTF16ToUTF8(utf16, length, utf8);
+    return utf8;
+}
+
+bool StringConvert::UTF16ToUTF8(const DUTF16Char* utf16, size_t length, std::string& output)
+{
+    output.clear();
     if ((utf16 == nullptr) || (length == 0)) {
-        return std::string();
+        return true;
     }
-    std::vector<DUTF8Char> data;
-    data.resize(8192);
-    DUTF8Char* output = &data[0];
-    const UTF16* src_begin = reinterpret_cast<const UTF16*>(utf16);
-    const UTF16* src_end = src_begin + length;
-    UTF8* dst_begin = reinterpret_cast<UTF8*>(output);
-
-    std::string utf8;
-    while (src_begin < src_end) {
-        ConversionResult result = ConvertUTF16toUTF8(&src_begin,
-                                                     src_end,
-                                                     &dst_begin,
-                                                     dst_begin + data.size(),
-                                                     lenientConversion);
-        utf8.append(output, dst_begin - reinterpret_cast<UTF8*>(output));
-        dst_begin = reinterpret_cast<UTF8*>(output);
-        if (result == sourceIllegal || result == sourceExhausted) {
-            utf8.clear();
-            break;
-        }
+    size_t nCharCount = 0;
+    size_t nUTF8Length = 0;
+    if (!CountUTF16Chars(utf16, length, nCharCount, nUTF8Length)) {
+        return false;
     }
+    output.resize(nUTF8Length);
+    ConvertValidUTF16ToUTF8(utf16, length, &output[0]);
+    return true;
+}
 
-    return utf8;
+size_t StringConvert::UTF16ToUTF8(const DUTF16Char* utf16, size_t length, DUTF8Char* output, size_t outputSize)
+{
+    if ((utf16 == nullptr) || (length == 0)) {
+        return 0;
+    }
+    size_t nCharCount = 0;
+    size_t nUTF8Length = 0;
+    if (!CountUTF16Chars(utf16, length, nCharCount, nUTF8Length)) {
+        return 0;
+    }
+    if ((output != nullptr) && (nUTF8Length <= outputSize)) {
+        ConvertValidUTF16ToUTF8(utf16, length, output);
+    }
+    return nUTF8Length;
 }
 
 std::string StringConvert::WStringToUTF8(const std::wstring& wstr)
@@ -89,89 +721,96 @@ std::string StringConvert::WStringToUTF8(const std::wstring& wstr)
 
 std::basic_string<DUTF32Char> StringConvert::UTF8ToUTF32(const DUTF8Char* utf8, size_t length)
 {
-    std::vector<DUTF32Char> data;
-    data.resize(8192);
-    DUTF32Char* output = &data[0];
-    const UTF8* src_begin = reinterpret_cast<const UTF8*>(utf8);
-    const UTF8* src_end = src_begin + length;
-    UTF32* dst_begin = reinterpret_cast<UTF32*>(output);
-
     std::basic_string<DUTF32Char> utf32;
-    while (src_begin < src_end)
-    {
-        ConversionResult result = ConvertUTF8toUTF32(&src_begin,
-            src_end,
-            &dst_begin,
-            dst_begin + data.size(),
-            lenientConversion);
-
-        utf32.append(output, dst_begin - reinterpret_cast<UTF32*>(output));
-        dst_begin = reinterpret_cast<UTF32*>(output);
-        if (result == sourceIllegal || result == sourceExhausted)
-        {
-            utf32.clear();
-            break;
-        }
+    UTF8ToUTF32(utf8, length, utf32);
+    return utf32;
+}
+
+bool StringConvert::UTF8ToUTF32(const DUTF8Char* utf8, size_t length, std::basic_string<DUTF32Char>& output)
+{
+    output.clear();
+    if ((utf8 == nullptr) || (length == 0)) {
+        return true;
+    }
+    size_t nCharCount = 0;
+    size_t nSupplementaryCount = 0;
+    if (!CountUTF8Chars(utf8, length, nCharCount, nSupplementaryCount)) {
+        return false;
     }
+    output.resize(nCharCount);
+    ConvertValidUTF8(utf8, length, &output[0]);
+    return true;
+}
 
-    return utf32;
+size_t StringConvert::UTF8ToUTF32(const DUTF8Char* utf8, size_t length, DUTF32Char* output, size_t outputSize)
+{
+    if ((utf8 == nullptr) || (length == 0)) {
+        return 0;
+    }
+    size_t nCharCount = 0;
+    size_t nSupplementaryCount = 0;
+    if (!CountUTF8Chars(utf8, length, nCharCount, nSupplementaryCount)) {
+        return 0;
+    }
+    if ((output != nullptr) && (nCharCount <= outputSize)) {
+        ConvertValidUTF8(utf8, length, output);
+    }
+    return nCharCount;
 }
 
 std::string StringConvert::UTF32ToUTF8(const DUTF32Char* utf32, size_t length)
 {
-    std::vector<DUTF8Char> data;
-    data.resize(8192);
-    DUTF8Char* output = &data[0];
-    const UTF32* src_begin = reinterpret_cast<const UTF32*>(utf32);
-    const UTF32* src_end = src_begin + length;
-    UTF8* dst_begin = reinterpret_cast<UTF8*>(output);
-
     std::string utf8;
-    while (src_begin < src_end)
-    {
-        ConversionResult result = ConvertUTF32toUTF8(&src_begin,
-            src_end,
-            &dst_begin,
-            dst_begin + data.size(),
-            lenientConversion);
-
-        utf8.append(output, dst_begin - reinterpret_cast<UTF8*>(output));
-        dst_begin = reinterpret_cast<UTF8*>(output);
-        if (result == sourceIllegal || result == sourceExhausted)
-        {
-            utf8.clear();
-            break;
-        }
+    UTF32ToUTF8(utf32, length, utf8);
+    return utf8;
+}
+
+bool StringConvert::UTF32ToUTF8(const DUTF32Char* utf32, size_t length, std::string& output)
+{
+    output.clear();
+    if ((utf32 == nullptr) || (length == 0)) {
+        return true;
+    }
+    size_t nUTF8Length = 0;
+    if (!GetUTF32ToUTF8Length(utf32, length, nUTF8Length)) {
+        return false;
     }
+    output.resize(nUTF8Length);
+    ConvertValidUTF32ToUTF8(utf32, length, &output[0]);
+    return true;
+}
 
-    return utf8;
+size_t StringConvert::UTF32ToUTF8(const DUTF32Char* utf32, size_t length, DUTF8Char* output, size_t outputSize)
+{
+    if ((utf32 == nullptr) || (length == 0)) {
+        return 0;
+    }
+    size_t nUTF8Length = 0;
+    if (!GetUTF32ToUTF8Length(utf32, length, nUTF8Length)) {
+        return 0;
+    }
+    if ((output != nullptr) && (nUTF8Length <= outputSize)) {
+        ConvertValidUTF32ToUTF8(utf32, length, output);
+    }
+    return nUTF8Length;
 }
 
 std::basic_string<DUTF32Char> StringConvert::UTF16ToUTF32(const DUTF16Char* utf16, size_t length)
 {
+    std::basic_string<DUTF32Char> utf32;
     if ((utf16 == nullptr) || (length == 0)) {
-        return std::basic_string<DUTF32Char>();
+        return utf32;
     }
-    std::vector<DUTF32Char> data;
-    data.resize(8192);
-    DUTF32Char* output = &data[0];
-    const UTF16* src_begin = reinterpret_cast<const UTF16*>(utf16);
-    const UTF16* src_end = src_begin + length;
-    UTF32* dst_begin = reinterpret_cast<UTF32*>(output);
-
-    std::basic_string<DUTF32Char> utf32;
-    while (src_begin < src_end) {
-        ConversionResult result = ConvertUTF16toUTF32(&src_begin,
-                                                      src_end,
-                                                      &dst_begin,
-                                                      dst_begin + data.size(),
-                                                      lenientConversion);
-        utf32.append(output, dst_begin - reinterpret_cast<UTF32*>(output));
-        dst_begin = reinterpret_cast<UTF32*>(output);
-        if (result == sourceIllegal || result == sourceExhausted) {
-            utf32.clear();
-            break;
-        }
+    size_t nCharCount = 0;
+    size_t nUTF8Length = 0;
+    if (!CountUTF16Chars(utf16, length, nCharCount, nUTF8Length)) {
+        return utf32;
+    }
+    utf32.resize(nCharCount);
+    size_t nIndex = 0;
+    size_t nOutputIndex = 0;
+    while (nIndex < length) {
+        utf32[nOutputIndex++] = (DUTF32Char)ReadUTF16Char(utf16, length, nIndex);
     }
     return utf32;
 }
@@ -195,24 +834,27 @@ DStringW StringConvert::UTF32ToWString(const DUTF32Char* utf32, size_t length)
         return DStringW();
     }
 #if defined(WCHAR_T_IS_UTF16)
-    std::vector<DUTF16Char> data;
-    data.resize(8192);
-    DUTF16Char* output = &data[0];
-    const UTF32* src_begin = reinterpret_cast<const UTF32*>(utf32);
-    const UTF32* src_end = src_begin + length;
-    UTF16* dst_begin = reinterpret_cast<UTF16*>(output);
+    //代理区字符和大于0x10FFFF的字符，转换为替换字符
+    size_t nUTF16Length = 0;
+    for (size_t nIndex = 0; nIndex < length; ++nIndex) {
+        const uint32_t ch = (uint32_t)utf32[nIndex];
+        nUTF16Length += ((ch > 0xFFFF) && (ch <= UNICODE_MAX_CHAR)) ? 2 : 1;
+    }
     std::wstring utf16;
-    while (src_begin < src_end) {
-        ConversionResult result = ConvertUTF32toUTF16(&src_begin,
-                                                      src_end,
-                                                      &dst_begin,
-                                                      dst_begin + data.size(),
-                                                      lenientConversion);
-        utf16.append((const std::wstring::value_type*)output, dst_begin - reinterpret_cast<UTF16*>(output));
-        dst_begin = reinterpret_cast<UTF16*>(output);
-        if (result == sourceIllegal || result == sourceExhausted) {
-            utf16.clear();
-            break;
+    utf16.resize(nUTF16Length);
+    size_t nOutputIndex = 0;
+    for (size_t nIndex = 0; nIndex < length; ++nIndex) {
+        const uint32_t ch = (uint32_t)utf32[nIndex];
+        if (ch <= 0xFFFF) {
+            const bool bSurrogate = (ch >= 0xD800) && (ch <= 0xDFFF);
+            utf16[nOutputIndex++] = (wchar_t)(bSurrogate ? UNICODE_REPLACEMENT_CHAR : ch);
+        }
+        else if (ch > UNICODE_MAX_CHAR) {
+            utf16[nOutputIndex++] = (wchar_t)UNICODE_REPLACEMENT_CHAR;
+        }
+        else {
+            utf16[nOutputIndex++] = (wchar_t)(((ch - 0x10000) >> 10) + 0xD800);
+            utf16[nOutputIndex++] = (wchar_t)(((ch - 0x10000) & 0x3FF) + 0xDC00);
         }
     }
     return utf16;
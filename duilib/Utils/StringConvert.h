@@ -13,11 +13,21 @@ public:
     //UTF8字符串转换为UTF16
     static std::basic_string<DUTF16Char> UTF8ToUTF16(const DUTF8Char* utf8, size_t length);
 
+    //UTF8字符串转换为UTF16，结果写入output（复用output已分配的内存），不是合法的UTF8编码时返回false，output为空
+    static bool UTF8ToUTF16(const DUTF8Char* utf8, size_t length, std::basic_string<DUTF16Char>& output);
+
+    //UTF8字符串转换为UTF16，结果写入调用方提供的缓冲区（不写入结尾的'\0'，内部不分配内存）
+    //返回转换后的字符个数：返回值大于outputSize时表示缓冲区容量不足（或者output为nullptr），不写入数据；
+    //                     不是合法的UTF8编码时返回0
+    static size_t UTF8ToUTF16(const DUTF8Char* utf8, size_t length, DUTF16Char* output, size_t outputSize);
+
     //UTF8字符串转换为DStringW
     static DStringW UTF8ToWString(const std::string& utf8);
 
     //UTF16字符串转换为UTF8字符串
     static std::string UTF16ToUTF8(const DUTF16Char* utf16, size_t length);
+    static bool UTF16ToUTF8(const DUTF16Char* utf16, size_t length, std::string& output);
+    static size_t UTF16ToUTF8(const DUTF16Char* utf16, size_t length, DUTF8Char* output, size_t outputSize);
 
     //DStringW字符串转换为UTF8字符串
     static std::string WStringToUTF8(const DStringW& wstr);
@@ -44,10 +54,14 @@ public:
     //UTF8转换为UTF32字符串
     static std::basic_string<DUTF32Char> UTF8ToUTF32(const DUTF8Char* utf8, size_t length);
     static std::basic_string<DUTF32Char> UTF8ToUTF32(const std::string& utf8);
+    static bool UTF8ToUTF32(const DUTF8Char* utf8, size_t length, std::basic_string<DUTF32Char>& output);
+    static size_t UTF8ToUTF32(const DUTF8Char* utf8, size_t length, DUTF32Char* output, size_t outputSize);
 
     //UTF32转换为UTF8字符串
     static std::string UTF32ToUTF8(const DUTF32Char* utf32, size_t length);
     static std::string UTF32ToUTF8(const std::basic_string<DUTF32Char>& utf32);
+    static bool UTF32ToUTF8(const DUTF32Char* utf32, size_t length, std::string& output);
+    static size_t UTF32ToUTF8(const DUTF32Char* utf32, size_t length, DUTF8Char* output, size_t outputSize);
 
     //UTF16转换为UTF32字符串
     static std::basic_string<DUTF32Char> UTF16ToUTF32(const DUTF16Char* utf16, size_t length);
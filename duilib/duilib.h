@@ -20,6 +20,8 @@
 #include "Image/ImageLoadParam.h"
 #include "Image/ImageDecoder.h"
 #include "Image/ImageDecoderFactory.h"
+#include "Image/ImageDiskCache.h"
+#include "Image/ImageAtlas.h"
 
 #include "Animation/AnimationPlayer.h"
 #include "Animation/AnimationManager.h"
@@ -35,6 +37,7 @@
 #include "Core/UiSize.h"
 #include "Core/UiPoint.h"
 #include "Core/WindowBuilder.h"
+#include "Core/ControlPrototype.h"
 #include "Core/GlobalManager.h"
 #include "Core/Window.h"
 #include "Core/FrameworkThread.h"
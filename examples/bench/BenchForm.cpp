@@ -0,0 +1,27 @@
+#include "BenchForm.h"
+
+BenchForm::BenchForm(const DString& skinFolder, const DString& skinFile):
+    m_skinFolder(skinFolder),
+    m_skinFile(skinFile)
+{
+}
+
+BenchForm::~BenchForm()
+{
+}
+
+DString BenchForm::GetSkinFolder()
+{
+    return m_skinFolder;
+}
+
+DString BenchForm::GetSkinFile()
+{
+    return m_skinFile;
+}
+
+void BenchForm::SimulateMouseMove(const ui::UiPoint& pt)
+{
+    bool bHandled = false;
+    OnMouseMoveMsg(pt, 0, false, ui::NativeMsg(), bHandled);
+}
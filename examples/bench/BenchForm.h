@@ -0,0 +1,36 @@
+#ifndef EXAMPLES_BENCH_FORM_H_
+#define EXAMPLES_BENCH_FORM_H_
+
+// duilib
+#include "duilib/duilib.h"
+
+/** 性能测试窗口：加载示例程序的XML皮肤文件
+*/
+class BenchForm : public ui::WindowImplBase
+{
+public:
+    BenchForm(const DString& skinFolder, const DString& skinFile);
+    virtual ~BenchForm() override;
+
+    /** 资源相关接口
+     * GetSkinFolder 接口设置你要绘制的窗口皮肤资源路径
+     * GetSkinFile 接口设置你要绘制的窗口的 xml 描述文件
+     */
+    virtual DString GetSkinFolder() override;
+    virtual DString GetSkinFile() override;
+
+    /** 模拟鼠标移动到窗口客户区的指定位置（用于测试鼠标悬停时的界面更新）
+    */
+    void SimulateMouseMove(const ui::UiPoint& pt);
+
+private:
+    /** 皮肤文件所在目录
+    */
+    DString m_skinFolder;
+
+    /** 皮肤文件名
+    */
+    DString m_skinFile;
+};
+
+#endif //EXAMPLES_BENCH_FORM_H_
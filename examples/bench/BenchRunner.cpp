@@ -0,0 +1,313 @@
+#include "BenchRunner.h"
+#include "BenchForm.h"
+#include "duilib/Utils/PerformanceUtil.h"
+#include "duilib/Utils/LogUtil.h"
+
+//测试窗口的两种大小（调整窗口大小时交替使用）
+#define BENCH_WINDOW_WIDTH_1    1024
+#define BENCH_WINDOW_HEIGHT_1   768
+#define BENCH_WINDOW_WIDTH_2    800
+#define BENCH_WINDOW_HEIGHT_2   600
+
+//填充到列表中的数据行数
+#define BENCH_LIST_ITEM_COUNT   2000
+
+//填充到树中的节点数（父节点数 x 每个父节点的子节点数）
+#define BENCH_TREE_PARENT_COUNT 50
+#define BENCH_TREE_CHILD_COUNT  20
+
+//填充到RichEdit中的文本行数
+#define BENCH_TEXT_LINE_COUNT   500
+
+//测试DPI变化时，使用的DPI缩放比
+#define BENCH_DPI_SCALE_FACTOR  150
+
+BenchRunner::BenchRunner(const ui::FilePath& outputFile, int32_t nSteps):
+    m_outputFile(outputFile),
+    m_nSteps(std::max(nSteps, 1)),
+    m_nCurrentScenario(0),
+    m_nNextAction(0),
+    m_nOldDisplayScale(100)
+{
+    m_scenarios.push_back({ _T("controls"),  _T("controls"),  _T("controls.xml") });
+    m_scenarios.push_back({ _T("layout"),    _T("layout"),    _T("layout.xml") });
+    m_scenarios.push_back({ _T("list_ctrl"), _T("list_ctrl"), _T("list_ctrl.xml") });
+    m_scenarios.push_back({ _T("rich_edit"), _T("rich_edit"), _T("rich_edit.xml") });
+    m_scenarios.push_back({ _T("tree_view"), _T("tree_view"), _T("tree_view.xml") });
+}
+
+BenchRunner::~BenchRunner()
+{
+}
+
+void BenchRunner::Start()
+{
+    RunScenario(0);
+}
+
+void BenchRunner::PostBenchTask(const ui::StdClosure& task)
+{
+    ui::GlobalManager::Instance().Thread().PostTask(ui::kThreadUI, task);
+}
+
+void BenchRunner::RunScenario(size_t nScenario)
+{
+    if (nScenario >= m_scenarios.size()) {
+        FinishBench();
+        return;
+    }
+    m_nCurrentScenario = nScenario;
+    const BenchScenario& scenario = m_scenarios[nScenario];
+
+    //每个场景单独统计
+    ui::PerformanceUtil::Instance().Reset();
+    BenchForm* pBenchForm = nullptr;
+    {
+        ui::PerformanceStat statPerformance(_T("BuildWindow, Bench::CreateWindow"));
+        pBenchForm = new BenchForm(scenario.m_skinFolder, scenario.m_skinFile);
+        ui::WindowCreateParam createParam(scenario.m_name, true);
+        if (!pBenchForm->CreateWnd(nullptr, createParam)) {
+            pBenchForm = nullptr;
+        }
+    }
+    if (pBenchForm == nullptr) {
+        //窗口创建失败，跳过该场景
+        m_results.push_back(_T("null"));
+        PostBenchTask([this, nScenario]() { RunScenario(nScenario + 1); });
+        return;
+    }
+    m_pBenchForm = ui::ControlPtrT<BenchForm>(pBenchForm);
+    pBenchForm->Resize(BENCH_WINDOW_WIDTH_1, BENCH_WINDOW_HEIGHT_1, true, true);
+    pBenchForm->ShowWindow(ui::kSW_SHOW_NORMAL);
+    m_nOldDisplayScale = pBenchForm->Dpi().GetDisplayScaleFactor();
+
+    {
+        ui::PerformanceStat statPerformance(_T("BuildWindow, Bench::PrepareControls"));
+        PrepareControls();
+    }
+
+    //生成交互操作脚本
+    m_actions.clear();
+    m_nNextAction = 0;
+    const size_t nSteps = (size_t)m_nSteps;
+    m_actions.insert(m_actions.end(), nSteps, BenchAction::kScroll);
+    m_actions.insert(m_actions.end(), nSteps, BenchAction::kHover);
+    m_actions.insert(m_actions.end(), std::max(nSteps / 10, (size_t)2), BenchAction::kResize);
+    if (m_pRichEdit != nullptr) {
+        m_actions.insert(m_actions.end(), nSteps, BenchAction::kTextEdit);
+    }
+    m_actions.push_back(BenchAction::kDpiChange);
+    m_actions.push_back(BenchAction::kScroll);
+    m_actions.push_back(BenchAction::kDpiRestore);
+    PostBenchTask([this]() { RunNextAction(); });
+}
+
+void BenchRunner::RunNextAction()
+{
+    if ((m_pBenchForm == nullptr) || !m_pBenchForm->IsWindow() || (m_nNextAction >= m_actions.size())) {
+        FinishScenario();
+        return;
+    }
+    const size_t nStep = m_nNextAction++;
+    DoAction(m_actions[nStep], nStep);
+    PostBenchTask([this]() { RunNextAction(); });
+}
+
+void BenchRunner::FinishScenario()
+{
+    m_results.push_back(ui::PerformanceUtil::Instance().ToJsonString());
+    m_scrollBoxes.clear();
+    m_pRichEdit = nullptr;
+    if ((m_pBenchForm != nullptr) && m_pBenchForm->IsWindow()) {
+        m_pBenchForm->CloseWnd();
+    }
+    m_pBenchForm = nullptr;
+    const size_t nNextScenario = m_nCurrentScenario + 1;
+    PostBenchTask([this, nNextScenario]() { RunScenario(nNextScenario); });
+}
+
+void BenchRunner::FinishBench()
+{
+    DString json = _T("{\n\"steps\": ") + ui::StringUtil::Int32ToString(m_nSteps) + _T(",\n\"scenarios\": [");
+    for (size_t nScenario = 0; nScenario < m_scenarios.size(); ++nScenario) {
+        json += (nScenario == 0) ? _T("\n") : _T(",\n");
+        json += _T("{\"name\": \"") + m_scenarios[nScenario].m_name + _T("\", \"result\": ");
+        json += (nScenario < m_results.size()) ? m_results[nScenario] : DString(_T("null"));
+        json += _T("}");
+    }
+    json += _T("\n]\n}\n");
+    if (!m_outputFile.IsEmpty()) {
+        ui::FileUtil::WriteFileData(m_outputFile, ui::StringConvert::TToUTF8(json));
+    }
+    ui::LogUtil::OutputLine(json, false);
+    ui::WindowBase::PostQuitMsg(0);
+}
+
+template<typename T>
+void BenchRunner::FindControls(ui::Control* pControl, std::vector<T*>& controls)
+{
+    if (pControl == nullptr) {
+        return;
+    }
+    T* pTypedControl = dynamic_cast<T*>(pControl);
+    if (pTypedControl != nullptr) {
+        controls.push_back(pTypedControl);
+    }
+    ui::Box* pBox = dynamic_cast<ui::Box*>(pControl);
+    if (pBox != nullptr) {
+        const size_t nItemCount = pBox->GetItemCount();
+        for (size_t nItem = 0; nItem < nItemCount; ++nItem) {
+            FindControls(pBox->GetItemAt(nItem), controls);
+        }
+    }
+}
+
+void BenchRunner::PrepareControls()
+{
+    m_scrollBoxes.clear();
+    m_pRichEdit = nullptr;
+    BenchForm* pBenchForm = m_pBenchForm.get();
+    if ((pBenchForm == nullptr) || (pBenchForm->GetRoot() == nullptr)) {
+        return;
+    }
+
+    //列表：添加数据行
+    std::vector<ui::ListCtrl*> listCtrls;
+    FindControls(pBenchForm->GetRoot(), listCtrls);
+    for (ui::ListCtrl* pListCtrl : listCtrls) {
+        while (pListCtrl->GetColumnCount() < 4) {
+            ui::ListCtrlColumn columnInfo;
+            columnInfo.text = _T("Column ") + ui::StringUtil::UInt64ToString(pListCtrl->GetColumnCount());
+            pListCtrl->InsertColumn(-1, columnInfo);
+        }
+        const size_t nColumnCount = pListCtrl->GetColumnCount();
+        for (size_t nItem = 0; nItem < BENCH_LIST_ITEM_COUNT; ++nItem) {
+            ui::ListCtrlSubItemData dataItem;
+            dataItem.text = _T("Item ") + ui::StringUtil::UInt64ToString(nItem);
+            const size_t nItemIndex = pListCtrl->AddDataItem(dataItem);
+            for (size_t nColumn = 1; nColumn < nColumnCount; ++nColumn) {
+                pListCtrl->SetSubItemText(nItemIndex, nColumn, _T("Sub item ") + ui::StringUtil::UInt64ToString(nColumn));
+            }
+        }
+    }
+
+    //树：添加节点
+    std::vector<ui::TreeView*> treeViews;
+    FindControls(pBenchForm->GetRoot(), treeViews);
+    for (ui::TreeView* pTreeView : treeViews) {
+        ui::TreeNode* pRootNode = pTreeView->GetRootNode();
+        if (pRootNode == nullptr) {
+            continue;
+        }
+        for (size_t nParent = 0; nParent < BENCH_TREE_PARENT_COUNT; ++nParent) {
+            ui::TreeNode* pParentNode = new ui::TreeNode(pBenchForm);
+            pParentNode->SetText(_T("Node ") + ui::StringUtil::UInt64ToString(nParent));
+            pRootNode->AddChildNode(pParentNode);
+            for (size_t nChild = 0; nChild < BENCH_TREE_CHILD_COUNT; ++nChild) {
+                ui::TreeNode* pChildNode = new ui::TreeNode(pBenchForm);
+                pChildNode->SetText(_T("Child node ") + ui::StringUtil::UInt64ToString(nChild));
+                pParentNode->AddChildNode(pChildNode);
+            }
+        }
+    }
+
+    //RichEdit：填充文本
+    std::vector<ui::RichEdit*> richEdits;
+    FindControls(pBenchForm->GetRoot(), richEdits);
+    if (!richEdits.empty()) {
+        //取最大的一个RichEdit控件
+        ui::RichEdit* pRichEdit = richEdits.front();
+        for (ui::RichEdit* pItem : richEdits) {
+            if (pItem->GetRect().Height() > pRichEdit->GetRect().Height()) {
+                pRichEdit = pItem;
+            }
+        }
+        DString text;
+        for (size_t nLine = 0; nLine < BENCH_TEXT_LINE_COUNT; ++nLine) {
+            text += _T("The quick brown fox jumps over the lazy dog, line ") + ui::StringUtil::UInt64ToString(nLine) + _T("\n");
+        }
+        pRichEdit->SetText(text);
+        m_pRichEdit = ui::ControlPtrT<ui::RichEdit>(pRichEdit);
+    }
+
+    //可滚动的容器（RichEdit也是可滚动的容器）
+    std::vector<ui::ScrollBox*> scrollBoxes;
+    FindControls(pBenchForm->GetRoot(), scrollBoxes);
+    for (ui::ScrollBox* pScrollBox : scrollBoxes) {
+        m_scrollBoxes.push_back(ui::ControlPtrT<ui::ScrollBox>(pScrollBox));
+    }
+}
+
+void BenchRunner::DoAction(BenchAction action, size_t nStep)
+{
+    BenchForm* pBenchForm = m_pBenchForm.get();
+    if (pBenchForm == nullptr) {
+        return;
+    }
+    switch (action) {
+    case BenchAction::kScroll:
+        {
+            ui::PerformanceStat statPerformance(_T("Bench, Scroll"));
+            for (ui::ControlPtrT<ui::ScrollBox>& pScrollBox : m_scrollBoxes) {
+                if ((pScrollBox == nullptr) || !pScrollBox->IsVisible()) {
+                    continue;
+                }
+                const int64_t nRange = pScrollBox->GetScrollRange().cy;
+                if (nRange <= 0) {
+                    continue;
+                }
+                int64_t nPos = pScrollBox->GetScrollPos().cy + pScrollBox->GetRect().Height() / 3 + 1;
+                if (nPos > nRange) {
+                    nPos = 0;
+                }
+                pScrollBox->SetScrollPosY(nPos);
+            }
+        }
+        break;
+    case BenchAction::kHover:
+        {
+            ui::PerformanceStat statPerformance(_T("Bench, Hover"));
+            ui::UiRect rcClient;
+            pBenchForm->GetClientRect(rcClient);
+            if (!rcClient.IsEmpty()) {
+                //按固定步长在窗口中扫过，覆盖不同的控件
+                ui::UiPoint pt;
+                pt.x = rcClient.left + (int32_t)((nStep * 37) % (size_t)rcClient.Width());
+                pt.y = rcClient.top + (int32_t)((nStep * 53) % (size_t)rcClient.Height());
+                pBenchForm->SimulateMouseMove(pt);
+            }
+        }
+        break;
+    case BenchAction::kResize:
+        {
+            ui::PerformanceStat statPerformance(_T("Bench, Resize"));
+            if ((nStep % 2) == 0) {
+                pBenchForm->Resize(BENCH_WINDOW_WIDTH_2, BENCH_WINDOW_HEIGHT_2, true, true);
+            }
+            else {
+                pBenchForm->Resize(BENCH_WINDOW_WIDTH_1, BENCH_WINDOW_HEIGHT_1, true, true);
+            }
+        }
+        break;
+    case BenchAction::kTextEdit:
+        if (m_pRichEdit != nullptr) {
+            ui::PerformanceStat statPerformance(_T("Bench, TextEdit"));
+            m_pRichEdit->AppendText(_T("Appended text ") + ui::StringUtil::UInt64ToString(nStep) + _T("\n"), false, true);
+        }
+        break;
+    case BenchAction::kDpiChange:
+        {
+            ui::PerformanceStat statPerformance(_T("Bench, DpiChange"));
+            pBenchForm->ChangeDisplayScale(BENCH_DPI_SCALE_FACTOR, true);
+        }
+        break;
+    case BenchAction::kDpiRestore:
+        {
+            ui::PerformanceStat statPerformance(_T("Bench, DpiChange"));
+            pBenchForm->ChangeDisplayScale(m_nOldDisplayScale, true);
+        }
+        break;
+    default:
+        break;
+    }
+}
@@ -0,0 +1,128 @@
+#ifndef EXAMPLES_BENCH_RUNNER_H_
+#define EXAMPLES_BENCH_RUNNER_H_
+
+// duilib
+#include "duilib/duilib.h"
+
+class BenchForm;
+
+/** 界面性能测试的执行器：按顺序加载各个示例的XML皮肤，执行脚本化的交互操作（滚动、鼠标悬停、调整窗口大小、文本编辑、DPI变化），
+*   每个测试场景结束后，记录各阶段（BuildWindow/LayoutWindow/PaintWindow，其中PaintWindow包含Swap）的耗时统计，全部完成后以JSON格式保存
+*/
+class BenchRunner
+{
+public:
+    /** 构造函数
+    * @param [in] outputFile 测试结果文件路径（JSON格式）
+    * @param [in] nSteps 每种交互操作的执行次数
+    */
+    BenchRunner(const ui::FilePath& outputFile, int32_t nSteps);
+    ~BenchRunner();
+
+    /** 开始执行测试（在UI线程中调用），全部完成后退出消息循环
+    */
+    void Start();
+
+private:
+    /** 交互操作的类型
+    */
+    enum class BenchAction
+    {
+        kScroll,        //滚动所有可滚动的容器
+        kHover,         //鼠标在窗口中扫过
+        kResize,        //调整窗口大小
+        kTextEdit,      //在RichEdit中编辑文本
+        kDpiChange,     //改变窗口的DPI缩放比
+        kDpiRestore     //恢复窗口的DPI缩放比
+    };
+
+    /** 测试场景
+    */
+    struct BenchScenario
+    {
+        DString m_name;         //场景名称
+        DString m_skinFolder;   //皮肤文件所在目录
+        DString m_skinFile;     //皮肤文件名
+    };
+
+private:
+    /** 开始执行指定的测试场景
+    */
+    void RunScenario(size_t nScenario);
+
+    /** 执行下一个交互操作（每个操作都通过消息队列投递，确保上一个操作引起的重绘已经完成）
+    */
+    void RunNextAction();
+
+    /** 结束当前测试场景，记录统计结果
+    */
+    void FinishScenario();
+
+    /** 全部测试场景完成，保存测试结果，退出消息循环
+    */
+    void FinishBench();
+
+    /** 投递任务到UI线程的消息队列
+    */
+    void PostBenchTask(const ui::StdClosure& task);
+
+    /** 填充测试数据（列表、树、文本），并查找需要操作的控件
+    */
+    void PrepareControls();
+
+    /** 查找容器中所有指定类型的控件
+    */
+    template<typename T>
+    static void FindControls(ui::Control* pControl, std::vector<T*>& controls);
+
+    /** 执行一个交互操作
+    */
+    void DoAction(BenchAction action, size_t nStep);
+
+private:
+    /** 测试结果文件路径
+    */
+    ui::FilePath m_outputFile;
+
+    /** 每种交互操作的执行次数
+    */
+    int32_t m_nSteps;
+
+    /** 测试场景列表
+    */
+    std::vector<BenchScenario> m_scenarios;
+
+    /** 当前测试场景的序号
+    */
+    size_t m_nCurrentScenario;
+
+    /** 当前测试场景的窗口
+    */
+    ui::ControlPtrT<BenchForm> m_pBenchForm;
+
+    /** 当前测试场景的交互操作列表
+    */
+    std::vector<BenchAction> m_actions;
+
+    /** 下一个交互操作的序号
+    */
+    size_t m_nNextAction;
+
+    /** 窗口中可滚动的容器
+    */
+    std::vector<ui::ControlPtrT<ui::ScrollBox>> m_scrollBoxes;
+
+    /** 窗口中的RichEdit控件
+    */
+    ui::ControlPtrT<ui::RichEdit> m_pRichEdit;
+
+    /** 窗口原来的DPI缩放比
+    */
+    uint32_t m_nOldDisplayScale;
+
+    /** 各个测试场景的统计结果（JSON格式）
+    */
+    std::vector<DString> m_results;
+};
+
+#endif //EXAMPLES_BENCH_RUNNER_H_
@@ -0,0 +1,31 @@
+#include "MainThread.h"
+#include "BenchRunner.h"
+
+MainThread::MainThread(const ui::FilePath& outputFile, int32_t nSteps) :
+    FrameworkThread(_T("MainThread"), ui::kThreadUI),
+    m_outputFile(outputFile),
+    m_nSteps(nSteps)
+{
+}
+
+MainThread::~MainThread()
+{
+}
+
+void MainThread::OnInit()
+{
+    //使用本地文件夹作为资源（与示例程序共用资源）
+    ui::FilePath resourcePath = ui::FilePathUtil::GetCurrentModuleDirectory();
+    resourcePath += _T("resources\\");
+    ui::GlobalManager::Instance().Startup(ui::LocalFilesResParam(resourcePath));
+
+    //开始执行测试，全部完成后退出消息循环
+    m_pBenchRunner = std::make_unique<BenchRunner>(m_outputFile, m_nSteps);
+    m_pBenchRunner->Start();
+}
+
+void MainThread::OnCleanup()
+{
+    m_pBenchRunner.reset();
+    ui::GlobalManager::Instance().Shutdown();
+}
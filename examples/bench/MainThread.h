@@ -0,0 +1,44 @@
+#ifndef EXAMPLES_MAIN_THREAD_H_
+#define EXAMPLES_MAIN_THREAD_H_
+
+// duilib
+#include "duilib/duilib.h"
+
+class BenchRunner;
+
+/** 主线程
+*/
+class MainThread : public ui::FrameworkThread
+{
+public:
+    /** 构造函数
+    * @param [in] outputFile 测试结果文件路径（JSON格式）
+    * @param [in] nSteps 每种交互操作的执行次数
+    */
+    MainThread(const ui::FilePath& outputFile, int32_t nSteps);
+    virtual ~MainThread() override;
+
+private:
+    /** 运行前初始化，在进入消息循环前调用
+    */
+    virtual void OnInit() override;
+
+    /** 退出时清理，在退出消息循环后调用
+    */
+    virtual void OnCleanup() override;
+
+private:
+    /** 测试结果文件路径
+    */
+    ui::FilePath m_outputFile;
+
+    /** 每种交互操作的执行次数
+    */
+    int32_t m_nSteps;
+
+    /** 性能测试的执行器
+    */
+    std::unique_ptr<BenchRunner> m_pBenchRunner;
+};
+
+#endif // EXAMPLES_MAIN_THREAD_H_
@@ -0,0 +1,31 @@
+#if defined(linux) || defined(__linux) || defined(__linux__)
+
+#include "duilib/duilib_config_linux.h"
+#include "duilib/Core/MessageLoop_SDL.h"
+#include "MainThread.h"
+#include <cstring>
+
+//定义应用程序的入口点
+//命令行参数：duilib_bench [--output <测试结果文件(JSON)>] [--steps <每种交互操作的执行次数>]
+//默认使用SDL的offscreen显示驱动（无需显示设备），可通过环境变量SDL_VIDEO_DRIVER指定其他驱动
+int main(int argc, char** argv)
+{
+    ui::FilePath outputFile(DString(_T("duilib_bench.json")));
+    int32_t nSteps = 100;
+    for (int i = 1; i < argc; ++i) {
+        if ((std::strcmp(argv[i], "--output") == 0) && (i + 1 < argc)) {
+            outputFile = ui::FilePath(DString(argv[++i]));
+        }
+        else if ((std::strcmp(argv[i], "--steps") == 0) && (i + 1 < argc)) {
+            nSteps = std::atoi(argv[++i]);
+        }
+    }
+
+    ui::MessageLoop_SDL::CheckInitSDL(_T("offscreen"));
+
+    MainThread thread(outputFile, nSteps);
+    thread.RunMessageLoop();
+    return 0;
+}
+
+#endif